@@ -107,10 +107,12 @@ def plot(genList, **kwargs):
 
   numdim = len(genList[lastGen]['Variables'])
   samples = genList[lastGen]['Solver']['Sample Database']
-  numentries = len(samples)
+
+  # Databases may be nested (one entry per sample) or contiguous
+  samplesTmp = np.reshape(samples, (-1, numdim))
+  numentries = samplesTmp.shape[0]
 
   fig, ax = plt.subplots(numdim, numdim, figsize=(8, 8))
-  samplesTmp = np.reshape(samples, (numentries, numdim))
   plt.suptitle(
       'MCMC Plotter - \nNumber of Samples {0}\n'.format(str(numentries)),
       fontweight='bold',
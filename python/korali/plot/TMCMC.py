@@ -99,7 +99,8 @@ def plot_lower_triangle(ax, theta):
 
 def plotGen(genList, idx):
   numdim = len(genList[idx]['Variables'])
-  samples = genList[idx]['Solver']['Sample Database']
+  samples = np.reshape(genList[idx]['Solver']['Sample Database'],
+                       (-1, numdim)).tolist()
   llk = np.array(genList[idx]['Solver']['Sample LogLikelihood Database'])
   lpr = np.array(genList[idx]['Solver']['Sample LogPrior Database'])
   lpo = (llk + lpr).tolist()
@@ -81,10 +81,18 @@ def main(path, test, output, plotAll=False):
    solverDir = curdir + '/MOCMAES'
    moduleName = '.MOCMAES'
 
+  if ("ensemble" in solverName):
+   solverDir = curdir + '/MCMC'
+   moduleName = '.MCMC'
+
   if ("mcmc" in solverName):
    solverDir = curdir + '/MCMC'
    moduleName = '.MCMC'
 
+  if ("paralleltempering" in solverName):
+   solverDir = curdir + '/MCMC'
+   moduleName = '.MCMC'
+
   if ("nested" in solverName):
    solverDir = curdir + '/Nested'
    moduleName = '.Nested'
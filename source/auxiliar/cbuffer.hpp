@@ -7,6 +7,7 @@
 *        by Jose Herrera https://gist.github.com/xstherrera1987/3196485
 ******************************************************************************/
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -121,6 +122,17 @@ class cBuffer
     return vector;
   }
 
+  /**
+  * @brief Copies a range of elements into contiguous storage
+  * @param pos The position of the first element
+  * @param count The number of elements
+  * @param dst The destination, with space for count elements
+  */
+  void copyTo(size_t pos, size_t count, T *dst)
+  {
+    for (size_t i = 0; i < count; i++) dst[i] = (*this)[pos + i];
+  }
+
   /**
   * @brief Eliminates all contents of the buffer
   */
@@ -142,5 +154,190 @@ class cBuffer
   }
 };
 
+/**
+* \class cStridedBuffer
+* @brief This class defines a circular buffer of fixed-length rows (e.g., state vectors), stored contiguously in a
+*        single allocation, with overwrite policy on add. Row i occupies positions [i * stride, (i + 1) * stride).
+*/
+template <typename T>
+class cStridedBuffer
+{
+  private:
+  /**
+  * @brief Maximum number of rows in the buffer
+  */
+  size_t _maxSize;
+
+  /**
+  * @brief Number of elements per row
+  */
+  size_t _stride;
+
+  /**
+  * @brief Number of rows already added
+  */
+  size_t _size;
+
+  /**
+  * @brief Container for data
+  */
+  std::unique_ptr<T[]> _data;
+
+  /**
+   * @brief Position of the start of the buffer
+   */
+  size_t _start;
+
+  /**
+   * @brief Position of the end of the buffer
+   */
+  size_t _end;
+
+  public:
+  /**
+   * @brief Default constructor
+   */
+  cStridedBuffer()
+  {
+    _maxSize = 0;
+    _stride = 0;
+    _size = 0;
+    _start = 0;
+    _end = 0;
+  };
+
+  /**
+   * @brief Constructor with a specific size
+   * @param size The maximum number of rows
+   * @param stride The number of elements per row
+   */
+  cStridedBuffer(size_t size, size_t stride)
+  {
+    resize(size, stride);
+  };
+
+  /**
+  * @brief Returns the current number of rows in the buffer
+  * @return The number of rows
+  */
+  size_t size() { return _size; };
+
+  /**
+  * @brief Returns the number of elements per row
+  * @return The row length
+  */
+  size_t stride() { return _stride; };
+
+  /**
+  * @brief Sets the maximum number of rows and their length, and removes all contents
+  * @param maxSize The maximum number of rows
+  * @param stride The number of elements per row
+  */
+  void resize(size_t maxSize, size_t stride)
+  {
+    _data = std::make_unique<T[]>(maxSize * stride);
+
+    _size = 0;
+    _maxSize = maxSize;
+    _stride = stride;
+    _start = 0;
+    _end = 0;
+  }
+
+  /**
+  * @brief Adds a row to the buffer. Missing trailing elements are value-initialized and extra ones are ignored.
+  * @param v The row to add
+  */
+  void add(const std::vector<T> &v)
+  {
+    // Storing value
+    T *row = &_data[_end * _stride];
+    const size_t count = std::min(v.size(), _stride);
+    std::copy(v.begin(), v.begin() + count, row);
+    std::fill(row + count, row + _stride, T());
+
+    // Increasing size until we reach the max size
+    if (_size < _maxSize) _size++;
+
+    // Increasing end pointer, and continuing from beginning if exceeding size
+    _end++;
+    if (_end == _maxSize) _end = 0;
+
+    // If the buffer is full, the _start pointer follows the end pointer
+    if (_size == _maxSize) _start = _end;
+  }
+
+  /**
+  * @brief Adds a row to the buffer
+  * @param v Pointer to the stride elements of the row
+  */
+  void add(const T *v)
+  {
+    std::copy(v, v + _stride, &_data[_end * _stride]);
+
+    if (_size < _maxSize) _size++;
+
+    _end++;
+    if (_end == _maxSize) _end = 0;
+
+    if (_size == _maxSize) _start = _end;
+  }
+
+  /**
+  * @brief Copies a range of rows into contiguous storage
+  * @param pos The position of the first row
+  * @param count The number of rows
+  * @param dst The destination, with space for count * stride elements
+  */
+  void copyTo(size_t pos, size_t count, T *dst)
+  {
+    for (size_t i = 0; i < count; i++) std::copy((*this)[pos + i], (*this)[pos + i] + _stride, dst + i * _stride);
+  }
+
+  /**
+  * @brief Returns a copy of the row at the required position
+  * @param pos The access position
+  * @return The vector with the row elements
+  */
+  std::vector<T> getVector(size_t pos)
+  {
+    const T *row = (*this)[pos];
+    return std::vector<T>(row, row + _stride);
+  }
+
+  /**
+  * @brief Overwrites the row at the required position, with the same semantics as add
+  * @param pos The access position
+  * @param v The new row
+  */
+  void set(size_t pos, const std::vector<T> &v)
+  {
+    T *row = (*this)[pos];
+    const size_t count = std::min(v.size(), _stride);
+    std::copy(v.begin(), v.begin() + count, row);
+    std::fill(row + count, row + _stride, T());
+  }
+
+  /**
+  * @brief Eliminates all contents of the buffer
+  */
+  void clear()
+  {
+    _size = 0;
+    _start = 0;
+    _end = 0;
+  }
+
+  /**
+  * @brief Accesses the row at the required position
+  * @param pos The access position
+  * @return Pointer to the first element of the row
+  */
+  T *operator[](size_t pos)
+  {
+    return &_data[((_start + pos) % _maxSize) * _stride];
+  }
+};
+
 } // namespace korali
 
@@ -1,8 +1,15 @@
 #include "auxiliar/fs.hpp"
 #include "string.h"
+#include <algorithm>
+#include <cerrno>
 #include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <string>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
 namespace korali
 {
@@ -39,4 +46,83 @@ bool dirExists(const std::string dirPath)
   return false;
 }
 
+bool fileExists(const std::string filePath)
+{
+  return ::access(filePath.c_str(), R_OK) == 0;
+}
+
+int writeBlocksToFile(const std::string filePath, const std::vector<std::pair<const void *, size_t>> &blocks, const bool append)
+{
+  int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), S_IRUSR | S_IWUSR);
+  if (fd < 0) return errno;
+
+  std::vector<struct iovec> iov;
+  iov.reserve(blocks.size());
+  for (const auto &b : blocks)
+    if (b.second > 0) iov.push_back({const_cast<void *>(b.first), b.second});
+
+  // writev may write fewer bytes than requested and accepts at most IOV_MAX blocks per call
+  size_t cur = 0;
+  while (cur < iov.size())
+  {
+    const int count = (int)std::min(iov.size() - cur, (size_t)IOV_MAX);
+    ssize_t written = ::writev(fd, &iov[cur], count);
+    if (written < 0)
+    {
+      if (errno == EINTR) continue;
+      int err = errno;
+      ::close(fd);
+      return err;
+    }
+
+    while (cur < iov.size() && (size_t)written >= iov[cur].iov_len)
+    {
+      written -= iov[cur].iov_len;
+      cur++;
+    }
+
+    if (written > 0)
+    {
+      iov[cur].iov_base = (char *)iov[cur].iov_base + written;
+      iov[cur].iov_len -= written;
+    }
+  }
+
+  if (::close(fd) != 0) return errno;
+  return 0;
+}
+
+mappedFile::mappedFile(const std::string filePath)
+{
+  _data = nullptr;
+  _size = 0;
+  _isOpen = false;
+
+  int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if (::fstat(fd, &st) == 0)
+  {
+    _isOpen = true;
+    _size = st.st_size;
+    if (_size > 0)
+    {
+      void *ptr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ptr == MAP_FAILED)
+        _isOpen = false;
+      else
+        _data = (const char *)ptr;
+    }
+  }
+
+  // The mapping remains valid after closing the descriptor
+  ::close(fd);
+}
+
+mappedFile::~mappedFile()
+{
+  if (_data != nullptr) ::munmap(const_cast<char *>(_data), _size);
+}
+
 } // namespace korali
@@ -5,7 +5,9 @@
 #pragma once
 
 
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace korali
@@ -24,5 +26,74 @@ void mkdir(const std::string dirPath);
 
 bool dirExists(const std::string dirPath);
 
+/**
+ * @brief Checks whether a file exists and can be read.
+ * @param filePath path to the file.
+ * @return True, if it exists; false, otherwise.
+ */
+bool fileExists(const std::string filePath);
+
+/**
+ * @brief Writes a sequence of memory blocks into a file with gathered writes (writev), without intermediate copies.
+ * @param filePath path to the file.
+ * @param blocks (pointer, size in bytes) pairs, written in order.
+ * @param append whether to append to the end of the file instead of truncating it.
+ * @return Zero on success, the errno of the failed operation otherwise.
+ */
+int writeBlocksToFile(const std::string filePath, const std::vector<std::pair<const void *, size_t>> &blocks, const bool append);
+
+/**
+ * \class mappedFile
+ * @brief Read-only memory mapping of a whole file, released when the object is destroyed.
+ */
+class mappedFile
+{
+  public:
+  /**
+   * @brief Maps the given file. If it cannot be opened or mapped, isOpen() returns false.
+   * @param filePath path to the file.
+   */
+  mappedFile(const std::string filePath);
+
+  ~mappedFile();
+
+  mappedFile(const mappedFile &) = delete;
+  mappedFile &operator=(const mappedFile &) = delete;
+
+  /**
+   * @brief Indicates whether the file was mapped
+   * @return True, if mapped; false, otherwise.
+   */
+  bool isOpen() const { return _isOpen; }
+
+  /**
+   * @brief Returns the start of the mapped contents
+   * @return Pointer to the first byte of the file
+   */
+  const char *data() const { return _data; }
+
+  /**
+   * @brief Returns the size of the mapped file
+   * @return Size in bytes
+   */
+  size_t size() const { return _size; }
+
+  private:
+  /**
+   * @brief Start of the mapping
+   */
+  const char *_data;
+
+  /**
+   * @brief Size of the mapping
+   */
+  size_t _size;
+
+  /**
+   * @brief Whether the file could be opened (an empty file has no mapping)
+   */
+  bool _isOpen;
+};
+
 } // namespace korali
 
@@ -4,6 +4,9 @@
 
 #include "auxiliar/jsonInterface.hpp"
 #include "auxiliar/logger.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <iostream>
 
@@ -119,4 +122,205 @@ int saveJsonToFile(const char *fileName, const knlohmann::json &js)
   return 0;
 }
 
+/**
+  * @brief Alphabet of the base64 encoding
+ */
+static const char _base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+  * @brief Encodes binary data in base64
+  * @param data The data to encode
+  * @param size The size of the data in bytes
+  * @return The base64 string
+ */
+static std::string base64Encode(const uint8_t *data, const size_t size)
+{
+  std::string result;
+  result.reserve(4 * ((size + 2) / 3));
+
+  for (size_t i = 0; i < size; i += 3)
+  {
+    const uint32_t b0 = data[i];
+    const uint32_t b1 = i + 1 < size ? data[i + 1] : 0;
+    const uint32_t b2 = i + 2 < size ? data[i + 2] : 0;
+    const uint32_t triple = (b0 << 16) | (b1 << 8) | b2;
+
+    result += _base64Alphabet[(triple >> 18) & 0x3F];
+    result += _base64Alphabet[(triple >> 12) & 0x3F];
+    result += i + 1 < size ? _base64Alphabet[(triple >> 6) & 0x3F] : '=';
+    result += i + 2 < size ? _base64Alphabet[triple & 0x3F] : '=';
+  }
+
+  return result;
+}
+
+/**
+  * @brief Decodes a base64 string
+  * @param text The base64 string
+  * @return The decoded binary data
+ */
+static std::vector<uint8_t> base64Decode(const std::string &text)
+{
+  if (text.size() % 4 != 0) KORALI_LOG_ERROR("Invalid base64 string length: %lu.\n", text.size());
+
+  int8_t lookup[256];
+  std::fill(lookup, lookup + 256, -1);
+  for (int i = 0; i < 64; i++) lookup[(uint8_t)_base64Alphabet[i]] = i;
+
+  std::vector<uint8_t> result;
+  result.reserve(3 * text.size() / 4);
+
+  for (size_t i = 0; i < text.size(); i += 4)
+  {
+    uint32_t triple = 0;
+    size_t padding = 0;
+    for (size_t j = 0; j < 4; j++)
+    {
+      const char c = text[i + j];
+      if (c == '=' && i + 4 == text.size() && j >= 2)
+      {
+        padding++;
+        triple <<= 6;
+        continue;
+      }
+
+      const int8_t value = lookup[(uint8_t)c];
+      if (value < 0 || padding > 0) KORALI_LOG_ERROR("Invalid character in base64 string at position %lu.\n", i + j);
+      triple = (triple << 6) | (uint32_t)value;
+    }
+
+    result.push_back((triple >> 16) & 0xFF);
+    if (padding < 2) result.push_back((triple >> 8) & 0xFF);
+    if (padding < 1) result.push_back(triple & 0xFF);
+  }
+
+  return result;
+}
+
+/**
+  * @brief Converts a single precision number to half precision, rounding to the nearest even
+  * @param value The single precision number
+  * @return The bits of the half precision number
+ */
+static uint16_t floatToHalf(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t exponent = (bits >> 23) & 0xFF;
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  // Infinity and NaN
+  if (exponent == 0xFF) return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+
+  // Overflow
+  const int halfExponent = (int)exponent - 127 + 15;
+  if (halfExponent >= 31) return sign | 0x7C00;
+
+  // Subnormal numbers and underflow
+  if (halfExponent <= 0)
+  {
+    if (halfExponent < -10) return sign;
+    mantissa |= 0x800000;
+    const uint32_t shift = 14 - halfExponent;
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+    return sign | half;
+  }
+
+  // Normal numbers, a carry from rounding correctly increments the exponent
+  uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1FFF;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+  return sign | half;
+}
+
+/**
+  * @brief Converts a half precision number to single precision
+  * @param half The bits of the half precision number
+  * @return The single precision number
+ */
+static float halfToFloat(const uint16_t half)
+{
+  const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+  uint32_t bits;
+
+  if (exponent == 0x1F)
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  else if (exponent == 0 && mantissa == 0)
+    bits = sign;
+  else if (exponent == 0)
+  {
+    // Normalizing subnormal numbers
+    exponent = 113;
+    while ((mantissa & 0x400) == 0)
+    {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+  }
+  else
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+knlohmann::json encodeFloatArrays(const knlohmann::json &js, const bool halfPrecision)
+{
+  if (js.is_object())
+  {
+    knlohmann::json result = knlohmann::json::object();
+    for (auto it = js.begin(); it != js.end(); ++it) result[it.key()] = encodeFloatArrays(it.value(), halfPrecision);
+    return result;
+  }
+
+  const bool isNumberArray = js.is_array() && js.empty() == false && std::all_of(js.begin(), js.end(), [](const knlohmann::json &x) { return x.is_number(); });
+  if (isNumberArray == false) return js;
+
+  const auto values = js.get<std::vector<float>>();
+
+  if (halfPrecision == false) return base64Encode((const uint8_t *)values.data(), values.size() * sizeof(float));
+
+  std::vector<uint16_t> halfValues(values.size());
+  for (size_t i = 0; i < values.size(); i++) halfValues[i] = floatToHalf(values[i]);
+  return base64Encode((const uint8_t *)halfValues.data(), halfValues.size() * sizeof(uint16_t));
+}
+
+knlohmann::json decodeFloatArrays(const knlohmann::json &js, const bool halfPrecision)
+{
+  if (js.is_object())
+  {
+    knlohmann::json result = knlohmann::json::object();
+    for (auto it = js.begin(); it != js.end(); ++it) result[it.key()] = decodeFloatArrays(it.value(), halfPrecision);
+    return result;
+  }
+
+  if (js.is_string() == false) return js;
+
+  const auto bytes = base64Decode(js.get<std::string>());
+  const size_t valueSize = halfPrecision ? sizeof(uint16_t) : sizeof(float);
+  if (bytes.size() % valueSize != 0) KORALI_LOG_ERROR("Encoded array of %lu bytes is not a multiple of the value size (%lu).\n", bytes.size(), valueSize);
+
+  std::vector<float> values(bytes.size() / valueSize);
+  if (halfPrecision == false)
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+  else
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      uint16_t half;
+      std::memcpy(&half, bytes.data() + i * sizeof(uint16_t), sizeof(uint16_t));
+      values[i] = halfToFloat(half);
+    }
+
+  return values;
+}
+
 } // namespace korali
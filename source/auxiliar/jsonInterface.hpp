@@ -146,4 +146,21 @@ bool loadJsonFromFile(knlohmann::json &dst, const char *fileName);
 */
 int saveJsonToFile(const char *fileName, const knlohmann::json &js);
 
+/**
+  * @brief Replaces every array of numbers within a JSON object by a string with the base64 encoding of their binary (floating point) representation.
+  *        This is several times more compact than their decimal representation.
+  * @param js The input JSON object.
+  * @param halfPrecision If true, the numbers are stored with 16 bits (IEEE half precision), otherwise with 32 bits.
+  * @return The encoded JSON object.
+*/
+knlohmann::json encodeFloatArrays(const knlohmann::json &js, const bool halfPrecision);
+
+/**
+  * @brief Restores the arrays of numbers of a JSON object encoded with encodeFloatArrays. Every string within the object is expected to be an encoded array.
+  * @param js The encoded JSON object.
+  * @param halfPrecision Whether the numbers were stored with 16 bits.
+  * @return The decoded JSON object.
+*/
+knlohmann::json decodeFloatArrays(const knlohmann::json &js, const bool halfPrecision);
+
 } // namespace korali
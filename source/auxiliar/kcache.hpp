@@ -3,13 +3,18 @@
 
 /** \file
 * @brief Implements an LRU cache that returns a pre-calculated value if it is not
-*        too old. Age is determined by an external timer. Mutual exclusion mechanisms
-*        have been added for thread-safe access.
+*        too old. Age is determined by an external timer. Entries are kept in hash
+*        maps with O(1) lookup and least-recently-used eviction once the capacity
+*        is reached. The key space is split into independently locked shards for
+*        thread-safe access with low contention.
 *        by Sergio Martin (2020)
 ******************************************************************************/
 
 #include <functional>
-#include <map>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -38,19 +43,52 @@ struct cacheElement_t
 };
 
 /**
-* @brief This class defines a circular buffer with overwrite policy on add
+* @brief This class defines a hash-based cache with least-recently-used eviction
 */
-template <typename keyType, typename valType, typename timerType>
+template <typename keyType, typename valType, typename timerType, typename hashType = std::hash<keyType>>
 class kCache
 {
   private:
+  /**
+  * @brief Recency list entry: key and element, most recently used first
+  */
+  typedef std::pair<keyType, cacheElement_t<valType, timerType>> entry_t;
+
+  /**
+  * @brief Independently locked partition of the key space
+  */
+  struct shard_t
+  {
+    /**
+    * @brief Cache elements ordered by recency of use (front = most recent)
+    */
+    std::list<entry_t> _recency;
+
+    /**
+    * @brief Key to recency list position
+    */
+    std::unordered_map<keyType, typename std::list<entry_t>::iterator, hashType> _index;
+
+#ifdef _OPENMP
+    /**
+     * @brief Lock for thread-safe operation on this shard
+     */
+    omp_lock_t _lock;
+#endif
+  };
+
   /**
   * @brief Container for cache elements
   */
-  std::map<keyType, cacheElement_t<valType, timerType>> _data;
+  std::vector<shard_t> _shards;
 
   /**
-  * @brief Pointer to the external timer
+  * @brief Maximum number of elements per shard (0 = unbounded)
+  */
+  size_t _shardCapacity;
+
+  /**
+  * @brief Pointer to the external timer (NULL = elements never expire)
   */
   timerType *_timer;
 
@@ -60,22 +98,86 @@ class kCache
   timerType _maxAge;
 
   /**
-   * @brief Lock for thread-safe operation
+   * @brief Hash function used to distribute keys among shards
+   */
+  hashType _hash;
+
+  /**
+   * @brief Returns the shard responsible for a key
+   * @param key Key of the data element
+   * @return Reference to the shard
+   */
+  shard_t &getShard(const keyType &key) { return _shards[_hash(key) % _shards.size()]; }
+
+  /**
+   * @brief Locks a shard
+   * @param shard The shard to lock
+   */
+  void lock(shard_t &shard)
+  {
+#ifdef _OPENMP
+    omp_set_lock(&shard._lock);
+#endif
+  }
+
+  /**
+   * @brief Unlocks a shard
+   * @param shard The shard to unlock
    */
+  void unlock(shard_t &shard)
+  {
 #ifdef _OPENMP
-  omp_lock_t _lock;
+    omp_unset_lock(&shard._lock);
 #endif
+  }
+
+  /**
+   * @brief Inserts or updates an element in a (locked) shard, evicting the least recently used element if full
+   * @param shard The shard to modify
+   * @param key Key of the data element
+   * @param val Value of the data element
+   * @param time Time assigned to the data element
+   */
+  void insert(shard_t &shard, const keyType &key, const valType &val, const timerType &time)
+  {
+    auto it = shard._index.find(key);
+    if (it != shard._index.end())
+    {
+      it->second->second.value = val;
+      it->second->second.time = time;
+      shard._recency.splice(shard._recency.begin(), shard._recency, it->second);
+      return;
+    }
+
+    if (_shardCapacity > 0 && shard._index.size() >= _shardCapacity)
+    {
+      shard._index.erase(shard._recency.back().first);
+      shard._recency.pop_back();
+    }
+
+    shard._recency.push_front(entry_t(key, cacheElement_t<valType, timerType>{val, time}));
+    shard._index[key] = shard._recency.begin();
+  }
 
   public:
   /**
    * @brief Default constructor
+   * @param shardCount Number of independently locked partitions of the key space
    */
-  kCache()
+  kCache(size_t shardCount = 16) : _shards(shardCount > 0 ? shardCount : 1)
+  {
+    _timer = NULL;
+    _maxAge = timerType();
+    _shardCapacity = 0;
+#ifdef _OPENMP
+    for (auto &s : _shards) omp_init_lock(&s._lock);
+#endif
+  }
+
+  ~kCache()
   {
-    _timer = &_maxAge;
-    _maxAge = 0;
 #ifdef _OPENMP
-    omp_init_lock(&_lock);
+    for (auto &s : _shards) omp_destroy_lock(&s._lock);
 #endif
   }
 
@@ -97,6 +199,15 @@ class kCache
     _timer = timer;
   }
 
+  /**
+   * @brief Sets the maximum number of elements kept in cache. Least recently used elements are evicted first.
+   * @param capacity The maximum number of elements (0 = unbounded), rounded up to a multiple of the shard count
+   */
+  void setCapacity(const size_t capacity)
+  {
+    _shardCapacity = capacity == 0 ? 0 : (capacity + _shards.size() - 1) / _shards.size();
+  }
+
   /**
    * @brief Updates the value of a data element in the cache
    * @param key Key of the data element to update
@@ -104,14 +215,7 @@ class kCache
    */
   void set(const keyType &key, const valType &val)
   {
-#ifdef _OPENMP
-    omp_set_lock(&_lock);
-#endif
-    _data[key].value = val;
-    _data[key].time = *_timer;
-#ifdef _OPENMP
-    omp_unset_lock(&_lock);
-#endif
+    set(key, val, _timer == NULL ? timerType() : *_timer);
   }
 
   /**
@@ -122,14 +226,10 @@ class kCache
    */
   void set(const keyType &key, const valType &val, const timerType &time)
   {
-#ifdef _OPENMP
-    omp_set_lock(&_lock);
-#endif
-    _data[key].value = val;
-    _data[key].time = time;
-#ifdef _OPENMP
-    omp_unset_lock(&_lock);
-#endif
+    auto &shard = getShard(key);
+    lock(shard);
+    insert(shard, key, val, time);
+    unlock(shard);
   }
 
   /**
@@ -139,44 +239,51 @@ class kCache
    */
   bool contains(const keyType &key)
   {
-#ifdef _OPENMP
-    omp_set_lock(&_lock);
-#endif
-    if (_data.count(key) == 0)
-    {
-#ifdef _OPENMP
-      omp_unset_lock(&_lock);
-#endif
-      return false;
-    }
-
-    timerType age = *_timer - _data[key].time;
-#ifdef _OPENMP
-    omp_unset_lock(&_lock);
-#endif
-
-    if (age >= _maxAge) return false;
+    auto &shard = getShard(key);
+    lock(shard);
+    auto it = shard._index.find(key);
+    bool isPresent = it != shard._index.end();
+    if (isPresent && _timer != NULL) isPresent = *_timer - it->second->second.time < _maxAge;
+    unlock(shard);
 
-    return true;
+    return isPresent;
   }
 
   /**
-   * @brief Reads the value of a data element from the cache. The data element should be present, or an error will occur.
+   * @brief Reads the value of a data element from the cache. The data element should be present, or a default-constructed value is returned.
    * @param key Key of the data element to access
    * @return The value of the element stored in cache
    */
   valType get(const keyType &key)
   {
-#ifdef _OPENMP
-    omp_set_lock(&_lock);
-#endif
-    valType val = _data[key].value;
-#ifdef _OPENMP
-    omp_unset_lock(&_lock);
-#endif
+    valType val = valType();
+    tryGet(key, val);
     return val;
   }
 
+  /**
+   * @brief Reads the value of a data element, if present and not expired, and marks it as most recently used.
+   * @param key Key of the data element to access
+   * @param val Storage for the value of the element
+   * @return Whether or not the element was found
+   */
+  bool tryGet(const keyType &key, valType &val)
+  {
+    auto &shard = getShard(key);
+    lock(shard);
+    auto it = shard._index.find(key);
+    bool isPresent = it != shard._index.end();
+    if (isPresent && _timer != NULL) isPresent = *_timer - it->second->second.time < _maxAge;
+    if (isPresent)
+    {
+      shard._recency.splice(shard._recency.begin(), shard._recency, it->second);
+      val = it->second->second.value;
+    }
+    unlock(shard);
+
+    return isPresent;
+  }
+
   /**
   * @brief Reads the value of a data element from the cache. If the element is not present, it calls the provided function to generate it.
   * @param key Key of the data element to access
@@ -187,11 +294,7 @@ class kCache
   {
     valType val;
 
-    if (contains(key))
-    {
-      val = get(key);
-    }
-    else
+    if (tryGet(key, val) == false)
     {
       val = func();
       set(key, val);
@@ -201,38 +304,70 @@ class kCache
   }
 
   /**
-  * @brief Returns the stored entry keys as an ordered vector
-  * @return A vector containing all ordered keys
+   * @brief Returns the number of elements stored in cache
+   * @return The number of elements
+   */
+  size_t size()
+  {
+    size_t count = 0;
+    for (auto &s : _shards)
+    {
+      lock(s);
+      count += s._index.size();
+      unlock(s);
+    }
+    return count;
+  }
+
+  /**
+   * @brief Removes all elements from the cache
+   */
+  void clear()
+  {
+    for (auto &s : _shards)
+    {
+      lock(s);
+      s._index.clear();
+      s._recency.clear();
+      unlock(s);
+    }
+  }
+
+  /**
+  * @brief Returns the stored entry keys, least recently used first within each shard
+  * @return A vector containing all keys
   */
   std::vector<keyType> getKeys()
   {
     std::vector<keyType> v;
-    for (auto it = _data.begin(); it != _data.end(); ++it) v.push_back(it->first);
+    for (auto &s : _shards)
+      for (auto it = s._recency.rbegin(); it != s._recency.rend(); ++it) v.push_back(it->first);
     return v;
   }
 
   /**
    * @brief Returns the stored entry values in the cache
-   * @return A vector containing all stored entry values, ordered by key
+   * @return A vector containing all stored entry values, in the same order as getKeys()
    */
   std::vector<valType> getValues()
   {
     std::vector<valType> v;
-    for (auto it = _data.begin(); it != _data.end(); ++it) v.push_back(it->second.value);
+    for (auto &s : _shards)
+      for (auto it = s._recency.rbegin(); it != s._recency.rend(); ++it) v.push_back(it->second.value);
     return v;
   }
 
   /**
    * @brief Returns the stored entry times in the cache
-   * @return A vector containing all stored entry times, ordered by key
+   * @return A vector containing all stored entry times, in the same order as getKeys()
    */
   std::vector<timerType> getTimes()
   {
     std::vector<timerType> v;
-    for (auto it = _data.begin(); it != _data.end(); ++it) v.push_back(it->second.time);
+    for (auto &s : _shards)
+      for (auto it = s._recency.rbegin(); it != s._recency.rend(); ++it) v.push_back(it->second.time);
     return v;
   }
 };
 
 } // namespace korali
-
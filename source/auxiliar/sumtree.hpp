@@ -0,0 +1,195 @@
+#pragma once
+
+/** \file
+* @brief Implements a sum tree over a circular buffer, for sampling its entries proportionally to their priority
+******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+/**
+* \namespace korali
+* @brief The Korali namespace includes all Korali-specific functions, variables, and modules.
+*/
+namespace korali
+{
+/**
+* \class sumTree
+* @brief This class stores non-negative priorities with the same circular (overwrite on full) layout as cBuffer,
+*        and allows updating and sampling them in logarithmic time. Positions are relative to the oldest entry, as in cBuffer.
+*/
+class sumTree
+{
+  private:
+  /**
+  * @brief Maximum number of entries
+  */
+  size_t _maxSize;
+
+  /**
+  * @brief Number of entries already added
+  */
+  size_t _size;
+
+  /**
+   * @brief Position of the oldest entry
+   */
+  size_t _start;
+
+  /**
+   * @brief Position of the next entry to add
+   */
+  size_t _end;
+
+  /**
+   * @brief Index of the first leaf, the smallest power of two larger or equal than the maximum size
+   */
+  size_t _leafOffset;
+
+  /**
+  * @brief Binary tree in array layout (root at index 1), every inner node holds the sum of its children
+  */
+  std::vector<double> _nodes;
+
+  /**
+  * @brief Sets the priority of a leaf and updates the sums of its ancestors
+  * @param leaf The leaf (storage position) to update
+  * @param priority The new priority
+  */
+  void setLeaf(size_t leaf, const double priority)
+  {
+    size_t node = _leafOffset + leaf;
+    _nodes[node] = priority;
+
+    // Recomputing (instead of accumulating differences) avoids the drift of the sums
+    for (node /= 2; node > 0; node /= 2) _nodes[node] = _nodes[2 * node] + _nodes[2 * node + 1];
+  }
+
+  public:
+  /**
+   * @brief Default constructor
+   */
+  sumTree()
+  {
+    _maxSize = 0;
+    _size = 0;
+    _start = 0;
+    _end = 0;
+    _leafOffset = 1;
+    _nodes.assign(2, 0.0);
+  };
+
+  /**
+   * @brief Constructor with a specific size
+   * @param size The maximum number of entries
+   */
+  sumTree(size_t size)
+  {
+    resize(size);
+  };
+
+  /**
+  * @brief Returns the current number of entries in the tree
+  * @return The number of entries
+  */
+  size_t size() const { return _size; };
+
+  /**
+  * @brief Sets the maximum number of entries and removes all entries
+  * @param maxSize The maximum number of entries
+  */
+  void resize(size_t maxSize)
+  {
+    _maxSize = maxSize;
+    _leafOffset = 1;
+    while (_leafOffset < maxSize) _leafOffset *= 2;
+    _nodes.assign(2 * _leafOffset, 0.0);
+
+    _size = 0;
+    _start = 0;
+    _end = 0;
+  }
+
+  /**
+  * @brief Adds an entry, overwriting the oldest one if the tree is full
+  * @param priority The priority of the new entry
+  */
+  void add(const float priority)
+  {
+    setLeaf(_end, priority);
+
+    if (_size < _maxSize) _size++;
+
+    _end++;
+    if (_end == _maxSize) _end = 0;
+
+    if (_size == _maxSize) _start = _end;
+  }
+
+  /**
+  * @brief Removes all entries
+  */
+  void clear()
+  {
+    std::fill(_nodes.begin(), _nodes.end(), 0.0);
+    _size = 0;
+    _start = 0;
+    _end = 0;
+  }
+
+  /**
+  * @brief Updates the priority of an entry
+  * @param pos The position of the entry
+  * @param priority The new priority
+  */
+  void update(size_t pos, const float priority)
+  {
+    setLeaf((_start + pos) % _maxSize, priority);
+  }
+
+  /**
+  * @brief Returns the priority of an entry
+  * @param pos The position of the entry
+  * @return The priority of the entry
+  */
+  float operator[](size_t pos) const
+  {
+    return _nodes[_leafOffset + (_start + pos) % _maxSize];
+  }
+
+  /**
+  * @brief Returns the sum of the priorities of all entries
+  * @return The sum of priorities
+  */
+  double getTotal() const { return _nodes[1]; }
+
+  /**
+  * @brief Finds the entry at which the cumulative sum of priorities (in storage order) exceeds the given value
+  * @param value Value in [0, total)
+  * @return The position of the selected entry
+  */
+  size_t sample(double value) const
+  {
+    size_t node = 1;
+    while (node < _leafOffset)
+    {
+      const size_t left = 2 * node;
+      if (value < _nodes[left])
+        node = left;
+      else
+      {
+        value -= _nodes[left];
+        node = left + 1;
+      }
+    }
+
+    // Rounding may descend into an empty leaf beyond the stored entries
+    size_t leaf = node - _leafOffset;
+    if (leaf >= _maxSize) leaf = _maxSize - 1;
+    size_t pos = (leaf + _maxSize - _start) % _maxSize;
+    if (pos >= _size) pos = _size - 1;
+    return pos;
+  }
+};
+
+} // namespace korali
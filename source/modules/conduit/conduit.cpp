@@ -35,6 +35,9 @@ void Conduit::runSample(Sample *sample, Engine *engine)
   (*sample)["Current Generation"] = engine->_currentExperiment->_currentGeneration;
   (*sample)["Has Finished"] = false;
 
+  // Samples whose parameters were already evaluated finish without a worker
+  if (engine->_currentExperiment->retrieveCachedEvaluation(*sample) == true) return;
+
   // Check whether there are available workers to compute this sample.
   while (engine->_conduit->_workerQueue.empty())
   {
@@ -76,6 +79,7 @@ void Conduit::runSample(Sample *sample, Engine *engine)
 
   // Now replacing sample's information by that of the end message
   sample->_js.getJson() = endMessage;
+  engine->_currentExperiment->storeCachedEvaluation(*sample);
 
   // Putting worker back to the available worker queue
   engine->_conduit->_workerQueue.push(sample->_workerId);
@@ -99,6 +103,8 @@ void Conduit::worker()
     if (js["Conduit Action"] == "Process Sample") workerProcessSample(js);
     if (js["Conduit Action"] == "Stack Engine") workerStackEngine(js);
     if (js["Conduit Action"] == "Pop Engine") workerPopEngine();
+    if (js["Conduit Action"] == "Allocate Shards") workerAllocateShards(js);
+    if (js["Conduit Action"] == "Free Shards") workerFreeShards();
   }
 }
 
@@ -137,6 +143,16 @@ void Conduit::workerPopEngine()
   _engineStack.pop();
 }
 
+void Conduit::workerAllocateShards(const knlohmann::json &js)
+{
+  KORALI_LOG_ERROR("The %s conduit does not support shards.\n", _type.c_str());
+}
+
+void Conduit::workerFreeShards()
+{
+  KORALI_LOG_ERROR("The %s conduit does not support shards.\n", _type.c_str());
+}
+
 void Conduit::start(Sample &sample)
 {
   // Checking if sample id was defined
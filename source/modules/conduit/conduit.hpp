@@ -98,6 +98,17 @@ class Conduit : public Module
    */
   void workerPopEngine();
 
+  /**
+   * @brief (Worker Side) Allocates this worker's shard, as requested by the engine. Only conduits with one-sided communication support shards.
+   * @param js Contains the shard dimensions
+   */
+  virtual void workerAllocateShards(const knlohmann::json &js);
+
+  /**
+   * @brief (Worker Side) Frees this worker's shard, as requested by the engine
+   */
+  virtual void workerFreeShards();
+
   /**
    * @brief Starts the execution of the sample.
    * @param sample A Korali sample
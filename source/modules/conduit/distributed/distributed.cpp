@@ -5,6 +5,7 @@
 #include "modules/problem/problem.hpp"
 #include "modules/solver/solver.hpp"
 #include "sample/sample.hpp"
+#include <climits>
 
 using namespace std;
 
@@ -250,6 +251,141 @@ void Distributed::sendMessageToSample(Sample &sample, knlohmann::json &message)
 #endif
 }
 
+void Distributed::createShardWindow(const size_t rowCount, const size_t rowSize)
+{
+#ifdef _KORALI_USE_MPI
+  _shardRowCount = rowCount;
+  _shardRowSize = rowSize;
+
+  // The engine and the non-lead ranks of every worker take part in the window, but expose no memory
+  MPI_Aint shardBytes = 0;
+  if (isRoot() == false && isWorkerLeadRank() == true) shardBytes = rowCount * rowSize * sizeof(float);
+
+  float *shardData;
+  MPI_Win_allocate(shardBytes, sizeof(float), MPI_INFO_NULL, __KoraliGlobalMPIComm, &shardData, &_shardWindow);
+  _areShardsAllocated = true;
+#endif
+}
+
+void Distributed::allocateShards(const size_t rowCount, const size_t rowSize)
+{
+#ifdef _KORALI_USE_MPI
+  if (_areShardsAllocated == true) KORALI_LOG_ERROR("Shards have already been allocated.\n");
+  if (rowCount == 0 || rowSize == 0) KORALI_LOG_ERROR("Shards need at least one row of one element (requested %lu rows of %lu elements).\n", rowCount, rowSize);
+
+  // Workers allocate their shards from their idle loop, window creation is collective
+  knlohmann::json allocateJs;
+  allocateJs["Conduit Action"] = "Allocate Shards";
+  allocateJs["Row Count"] = rowCount;
+  allocateJs["Row Size"] = rowSize;
+  broadcastMessageToWorkers(allocateJs);
+
+  createShardWindow(rowCount, rowSize);
+#endif
+}
+
+void Distributed::freeShards()
+{
+#ifdef _KORALI_USE_MPI
+  if (_areShardsAllocated == false) return;
+
+  knlohmann::json freeJs;
+  freeJs["Conduit Action"] = "Free Shards";
+  broadcastMessageToWorkers(freeJs);
+
+  workerFreeShards();
+#endif
+}
+
+void Distributed::workerAllocateShards(const knlohmann::json &js)
+{
+  createShardWindow(js["Row Count"].get<size_t>(), js["Row Size"].get<size_t>());
+}
+
+void Distributed::workerFreeShards()
+{
+#ifdef _KORALI_USE_MPI
+  MPI_Win_free(&_shardWindow);
+  _areShardsAllocated = false;
+#endif
+}
+
+size_t Distributed::getShardCount()
+{
+  return _workerCount;
+}
+
+size_t Distributed::getShardId()
+{
+  return _rankToWorkerMap[_rankId];
+}
+
+void Distributed::writeShard(const size_t shardId, const std::vector<size_t> &rows, const float *src)
+{
+#ifdef _KORALI_USE_MPI
+  if (_areShardsAllocated == false) KORALI_LOG_ERROR("Writing to a shard before the shards were allocated.\n");
+  if (shardId >= (size_t)_workerCount) KORALI_LOG_ERROR("Writing to shard %lu, but there are only %d shards.\n", shardId, _workerCount);
+
+  const int rankId = _workerTeams[shardId][0];
+
+  // MPI counts are ints, so consecutive rows are transferred in chunks below INT_MAX elements
+  const size_t maxRowsPerTransfer = INT_MAX / _shardRowSize;
+  if (maxRowsPerTransfer == 0) KORALI_LOG_ERROR("Shard rows of %lu elements exceed the maximum MPI transfer size.\n", _shardRowSize);
+
+  // Writers lock exclusively, so that readers never see partially written rows
+  MPI_Win_lock(MPI_LOCK_EXCLUSIVE, rankId, 0, _shardWindow);
+  for (size_t i = 0; i < rows.size();)
+  {
+    size_t count = 1;
+    while (i + count < rows.size() && count < maxRowsPerTransfer && rows[i + count] == rows[i] + count) count++;
+    if (rows[i] + count > _shardRowCount) KORALI_LOG_ERROR("Writing row %lu of a shard with %lu rows.\n", rows[i] + count - 1, _shardRowCount);
+
+    const int elementCount = (int)(count * _shardRowSize);
+    MPI_Put(src + i * _shardRowSize, elementCount, MPI_FLOAT, rankId, rows[i] * _shardRowSize, elementCount, MPI_FLOAT, _shardWindow);
+    i += count;
+  }
+  MPI_Win_unlock(rankId, _shardWindow);
+#endif
+}
+
+void Distributed::readShard(const size_t shardId, const std::vector<size_t> &rows, float *dst)
+{
+#ifdef _KORALI_USE_MPI
+  if (_areShardsAllocated == false) KORALI_LOG_ERROR("Reading from a shard before the shards were allocated.\n");
+  if (shardId >= (size_t)_workerCount) KORALI_LOG_ERROR("Reading from shard %lu, but there are only %d shards.\n", shardId, _workerCount);
+
+  const int rankId = _workerTeams[shardId][0];
+
+  // MPI counts are ints, so consecutive rows are transferred in chunks below INT_MAX elements
+  const size_t maxRowsPerTransfer = INT_MAX / _shardRowSize;
+  if (maxRowsPerTransfer == 0) KORALI_LOG_ERROR("Shard rows of %lu elements exceed the maximum MPI transfer size.\n", _shardRowSize);
+
+  MPI_Win_lock(MPI_LOCK_SHARED, rankId, 0, _shardWindow);
+  for (size_t i = 0; i < rows.size();)
+  {
+    size_t count = 1;
+    while (i + count < rows.size() && count < maxRowsPerTransfer && rows[i + count] == rows[i] + count) count++;
+    if (rows[i] + count > _shardRowCount) KORALI_LOG_ERROR("Reading row %lu of a shard with %lu rows.\n", rows[i] + count - 1, _shardRowCount);
+
+    const int elementCount = (int)(count * _shardRowSize);
+    MPI_Get(dst + i * _shardRowSize, elementCount, MPI_FLOAT, rankId, rows[i] * _shardRowSize, elementCount, MPI_FLOAT, _shardWindow);
+    i += count;
+  }
+  MPI_Win_unlock(rankId, _shardWindow);
+#endif
+}
+
+bool Distributed::isMultithreaded()
+{
+#ifdef _KORALI_USE_MPI
+  int threadLevel;
+  MPI_Query_thread(&threadLevel);
+  return threadLevel == MPI_THREAD_MULTIPLE;
+#endif
+
+  return false;
+}
+
 void Distributed::stackEngine(Engine *engine)
 {
 #ifdef _KORALI_USE_MPI
@@ -93,11 +93,89 @@ class Distributed : public Conduit
    */
   std::vector<int> _rankToWorkerMap;
 
+#ifdef _KORALI_USE_MPI
+  /**
+   * @brief One-sided communication window that exposes the shard of every worker's lead rank
+   */
+  MPI_Win _shardWindow;
+#endif
+
+  /**
+   * @brief Signals whether the shards are allocated
+   */
+  bool _areShardsAllocated = false;
+
+  /**
+   * @brief Number of rows in every shard
+   */
+  size_t _shardRowCount = 0;
+
+  /**
+   * @brief Number of floats in every shard row
+   */
+  size_t _shardRowSize = 0;
+
   /**
    * @brief Checks whether the number of MPI workers satisfies the requirement
    */
   void checkRankCount();
 
+  /**
+   * @brief Collectively creates the shard window. Only the lead rank of every worker exposes memory.
+   * @param rowCount Number of rows in every shard
+   * @param rowSize Number of floats in every shard row
+   */
+  void createShardWindow(const size_t rowCount, const size_t rowSize);
+
+  /**
+   * @brief (Engine Side) Allocates a shard on every worker, which workers write locally and the engine reads with one-sided communication
+   * @param rowCount Number of rows in every shard
+   * @param rowSize Number of floats in every shard row
+   */
+  void allocateShards(const size_t rowCount, const size_t rowSize);
+
+  /**
+   * @brief (Engine Side) Frees the shards of all workers
+   */
+  void freeShards();
+
+  void workerAllocateShards(const knlohmann::json &js) override;
+  void workerFreeShards() override;
+
+  /**
+   * @brief Returns the number of shards, one per worker
+   * @return The number of shards
+   */
+  size_t getShardCount();
+
+  /**
+   * @brief (Worker Side) Returns the shard of the calling worker
+   * @return The id of the worker's shard
+   */
+  size_t getShardId();
+
+  /**
+   * @brief Writes rows into a shard
+   * @param shardId The shard to write
+   * @param rows The rows to write, consecutive rows are written in a single operation
+   * @param src The contents of the rows, one after the other
+   */
+  void writeShard(const size_t shardId, const std::vector<size_t> &rows, const float *src);
+
+  /**
+   * @brief Reads rows from a shard
+   * @param shardId The shard to read
+   * @param rows The rows to read, consecutive rows are read in a single operation
+   * @param dst Storage for the contents of the rows, one after the other
+   */
+  void readShard(const size_t shardId, const std::vector<size_t> &rows, float *dst);
+
+  /**
+   * @brief Checks whether MPI supports calls from several threads at once (MPI_THREAD_MULTIPLE)
+   * @return True, if it does; false, otherwise.
+   */
+  bool isMultithreaded();
+
   void initServer() override;
   void initialize() override;
   void terminateServer() override;
@@ -92,6 +92,7 @@ void Experiment::run()
           _timestamp = getTimestamp();
           getConfiguration(_js.getJson());
           saveState();
+          saveEvaluationCache();
         }
 
     _currentGeneration++;
@@ -111,12 +112,94 @@ void Experiment::run()
   _timestamp = getTimestamp();
   getConfiguration(_js.getJson());
   if (_fileOutputEnabled) saveState();
+  saveEvaluationCache();
 
   _logger->logInfo("Minimal", "--------------------------------------------------------------------\n");
   _logger->logInfo("Minimal", "%s finished correctly.\n", _solver->getType().c_str());
   for (size_t i = 0; i < _solver->_terminationCriteria.size(); i++) _logger->logInfo("Normal", "Termination Criterion Met: %s\n", _solver->_terminationCriteria[i].c_str());
   _logger->logInfo("Normal", "Final Generation: %lu\n", _currentGeneration);
   _logger->logInfo("Normal", "Elapsed Time: %.3fs\n", std::chrono::duration<double>(t1 - t0).count());
+
+  if (_evaluationCacheEnabled)
+  {
+    size_t lookupCount = _evaluationCacheHitCount + _evaluationCacheMissCount;
+    double hitRate = lookupCount > 0 ? 100.0 * (double)_evaluationCacheHitCount / (double)lookupCount : 0.0;
+    _logger->logInfo("Normal", "Evaluation Cache Hits: %lu/%lu (%.2f%%)\n", _evaluationCacheHitCount, lookupCount, hitRate);
+  }
+}
+
+bool Experiment::getEvaluationCacheKey(Sample &sample, std::string &key)
+{
+  // Only problem evaluations depend on nothing but their parameters
+  if (sample.contains("Module") == false || sample["Module"] != "Problem") return false;
+  if (sample.contains("Operation") == false || sample.contains("Parameters") == false) return false;
+
+  key = sample["Operation"].dump() + sample["Parameters"].dump();
+  return true;
+}
+
+bool Experiment::retrieveCachedEvaluation(Sample &sample)
+{
+  if (_evaluationCacheEnabled == false) return false;
+
+  std::string key;
+  if (getEvaluationCacheKey(sample, key) == false) return false;
+
+  knlohmann::json cachedJs;
+  if (_evaluationCache.tryGet(key, cachedJs) == false)
+  {
+    _evaluationCacheMissCount++;
+    return false;
+  }
+
+  // Keeping this sample's bookkeeping fields
+  cachedJs["Sample Id"] = sample["Sample Id"];
+  cachedJs["Experiment Id"] = sample["Experiment Id"];
+  cachedJs["Current Generation"] = sample["Current Generation"];
+  sample._js.getJson() = cachedJs;
+
+  _evaluationCacheHitCount++;
+  return true;
+}
+
+void Experiment::storeCachedEvaluation(Sample &sample)
+{
+  if (_evaluationCacheEnabled == false) return;
+
+  std::string key;
+  if (getEvaluationCacheKey(sample, key) == false) return;
+
+  _evaluationCache.set(key, sample._js.getJson());
+}
+
+void Experiment::loadEvaluationCache()
+{
+  _evaluationCache.clear();
+  _evaluationCache.setCapacity(_evaluationCacheCapacity);
+
+  if (_evaluationCacheEnabled == false || _evaluationCachePath.empty()) return;
+
+  knlohmann::json cacheJs;
+  if (loadJsonFromFile(cacheJs, _evaluationCachePath.c_str()) == false) return;
+
+  if (cacheJs["Keys"].size() != cacheJs["Values"].size()) KORALI_LOG_ERROR("Evaluation cache file %s is corrupted.\n", _evaluationCachePath.c_str());
+
+  // Entries are stored least recently used first, so that insertion restores their recency
+  for (size_t i = 0; i < cacheJs["Keys"].size(); i++)
+    _evaluationCache.set(cacheJs["Keys"][i].get<std::string>(), cacheJs["Values"][i]);
+
+  _logger->logInfo("Normal", "Loaded %lu cached evaluations from %s.\n", cacheJs["Keys"].size(), _evaluationCachePath.c_str());
+}
+
+void Experiment::saveEvaluationCache()
+{
+  if (_evaluationCacheEnabled == false || _evaluationCachePath.empty()) return;
+
+  knlohmann::json cacheJs;
+  cacheJs["Keys"] = _evaluationCache.getKeys();
+  cacheJs["Values"] = _evaluationCache.getValues();
+
+  if (saveJsonToFile(_evaluationCachePath.c_str(), cacheJs) != 0) KORALI_LOG_ERROR("Error trying to save evaluation cache file: %s.\n", _evaluationCachePath.c_str());
 }
 
 void Experiment::saveState()
@@ -200,6 +283,9 @@ void Experiment::initialize()
   // Updating verbosity level
   _logger = new Logger(_consoleOutputVerbosity, stdout);
 
+  // Reusing evaluations of previous runs, if requested
+  loadEvaluationCache();
+
   // Initializing problem and solver modules
   _problem->initialize();
   _solver->initialize();
@@ -280,6 +366,22 @@ void Experiment::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Run ID");
  }
 
+ if (isDefined(js, "Evaluation Cache", "Hit Count"))
+ {
+ try { _evaluationCacheHitCount = js["Evaluation Cache"]["Hit Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['Evaluation Cache']['Hit Count']\n%s", e.what()); } 
+   eraseValue(js, "Evaluation Cache", "Hit Count");
+ }
+
+ if (isDefined(js, "Evaluation Cache", "Miss Count"))
+ {
+ try { _evaluationCacheMissCount = js["Evaluation Cache"]["Miss Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['Evaluation Cache']['Miss Count']\n%s", e.what()); } 
+   eraseValue(js, "Evaluation Cache", "Miss Count");
+ }
+
  if (isDefined(js, "Timestamp"))
  {
  try { _timestamp = js["Timestamp"].get<std::string>();
@@ -384,6 +486,33 @@ void Experiment::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Store Sample Information'] required by experiment.\n"); 
 
+ if (isDefined(js, "Evaluation Cache", "Enabled"))
+ {
+ try { _evaluationCacheEnabled = js["Evaluation Cache"]["Enabled"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['Evaluation Cache']['Enabled']\n%s", e.what()); } 
+   eraseValue(js, "Evaluation Cache", "Enabled");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluation Cache']['Enabled'] required by experiment.\n"); 
+
+ if (isDefined(js, "Evaluation Cache", "Capacity"))
+ {
+ try { _evaluationCacheCapacity = js["Evaluation Cache"]["Capacity"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['Evaluation Cache']['Capacity']\n%s", e.what()); } 
+   eraseValue(js, "Evaluation Cache", "Capacity");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluation Cache']['Capacity'] required by experiment.\n"); 
+
+ if (isDefined(js, "Evaluation Cache", "Path"))
+ {
+ try { _evaluationCachePath = js["Evaluation Cache"]["Path"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['Evaluation Cache']['Path']\n%s", e.what()); } 
+   eraseValue(js, "Evaluation Cache", "Path");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluation Cache']['Path'] required by experiment.\n"); 
+
  if (isDefined(js, "Console Output", "Verbosity"))
  {
  try { _consoleOutputVerbosity = js["Console Output"]["Verbosity"].get<std::string>();
@@ -430,11 +559,16 @@ void Experiment::getConfiguration(knlohmann::json& js)
    js["File Output"]["Enabled"] = _fileOutputEnabled;
    js["File Output"]["Frequency"] = _fileOutputFrequency;
    js["Store Sample Information"] = _storeSampleInformation;
+   js["Evaluation Cache"]["Enabled"] = _evaluationCacheEnabled;
+   js["Evaluation Cache"]["Capacity"] = _evaluationCacheCapacity;
+   js["Evaluation Cache"]["Path"] = _evaluationCachePath;
    js["Console Output"]["Verbosity"] = _consoleOutputVerbosity;
    js["Console Output"]["Frequency"] = _consoleOutputFrequency;
    js["Current Generation"] = _currentGeneration;
    js["Is Finished"] = _isFinished;
    js["Run ID"] = _runID;
+   js["Evaluation Cache"]["Hit Count"] = _evaluationCacheHitCount;
+   js["Evaluation Cache"]["Miss Count"] = _evaluationCacheMissCount;
    js["Timestamp"] = _timestamp;
  Module::getConfiguration(js);
 } 
@@ -442,7 +576,7 @@ void Experiment::getConfiguration(knlohmann::json& js)
 void Experiment::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Random Seed\": 0, \"Preserve Random Number Generator States\": false, \"Distributions\": [], \"Current Generation\": 0, \"File Output\": {\"Enabled\": true, \"Path\": \"_korali_result\", \"Frequency\": 1, \"Use Multiple Files\": true}, \"Console Output\": {\"Verbosity\": \"Normal\", \"Frequency\": 1}, \"Store Sample Information\": false, \"Is Finished\": false}";
+ std::string defaultString = "{\"Random Seed\": 0, \"Preserve Random Number Generator States\": false, \"Distributions\": [], \"Current Generation\": 0, \"File Output\": {\"Enabled\": true, \"Path\": \"_korali_result\", \"Frequency\": 1, \"Use Multiple Files\": true}, \"Console Output\": {\"Verbosity\": \"Normal\", \"Frequency\": 1}, \"Evaluation Cache\": {\"Enabled\": false, \"Capacity\": 1000000, \"Path\": \"\", \"Hit Count\": 0, \"Miss Count\": 0}, \"Store Sample Information\": false, \"Is Finished\": false}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Module::applyModuleDefaults(js);
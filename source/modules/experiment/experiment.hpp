@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "auxiliar/kcache.hpp"
 #include "auxiliar/koraliJson.hpp"
 #include "auxiliar/libco/libco.h"
 #include "config.hpp"
@@ -89,6 +90,18 @@ class Experiment : public Module
   */
    int _storeSampleInformation;
   /**
+  * @brief If true, the results of computational model evaluations are cached, keyed on the operation and its parameters. Samples with already evaluated parameters finish immediately without occupying a worker. Only enable it for deterministic models.
+  */
+   int _evaluationCacheEnabled;
+  /**
+  * @brief Maximum number of evaluations kept in cache. Least recently used evaluations are evicted first. 0 means unbounded.
+  */
+   size_t _evaluationCacheCapacity;
+  /**
+  * @brief If not empty, the cache is loaded from this file at initialization (if it exists) and stored to it whenever results are saved, so that a restarted run reuses prior evaluations.
+  */
+   std::string _evaluationCachePath;
+  /**
   * @brief Specifies how much information will be displayed on console when running Korali.
   */
    std::string _consoleOutputVerbosity;
@@ -109,6 +122,14 @@ class Experiment : public Module
   */
    size_t _runID;
   /**
+  * @brief [Internal Use] Number of samples served from the evaluation cache.
+  */
+   size_t _evaluationCacheHitCount;
+  /**
+  * @brief [Internal Use] Number of cacheable samples that required a model evaluation.
+  */
+   size_t _evaluationCacheMissCount;
+  /**
   * @brief [Internal Use] Indicates the current time when saving a result file.
   */
    std::string _timestamp;
@@ -180,6 +201,42 @@ class Experiment : public Module
    */
   double _resultSavingTime;
 
+  /**
+   * @brief Cache of finished sample information, keyed on the module, operation and parameters of the sample.
+   */
+  kCache<std::string, knlohmann::json, size_t> _evaluationCache;
+
+  /**
+   * @brief Builds the evaluation cache key of a sample.
+   * @param sample A Korali sample
+   * @param key Storage for the key
+   * @return False, if the sample is not cacheable (it does not target the problem or has no parameters); true, otherwise.
+   */
+  bool getEvaluationCacheKey(Sample &sample, std::string &key);
+
+  /**
+   * @brief Replaces the information of a sample by that of a cached evaluation with the same key, if any.
+   * @param sample A Korali sample, before its execution
+   * @return True, if the sample was served from cache; false, otherwise.
+   */
+  bool retrieveCachedEvaluation(Sample &sample);
+
+  /**
+   * @brief Stores the information of a finished sample in the evaluation cache.
+   * @param sample A finished Korali sample
+   */
+  void storeCachedEvaluation(Sample &sample);
+
+  /**
+   * @brief Loads the evaluation cache from 'Evaluation Cache/Path', if it exists.
+   */
+  void loadEvaluationCache();
+
+  /**
+   * @brief Stores the evaluation cache into 'Evaluation Cache/Path'.
+   */
+  void saveEvaluationCache();
+
   /**
    * @brief For testing purposes, this field establishes whether the engine is the one to run samples (default = false) or a custom function (true)
    */
@@ -55,15 +55,18 @@
 #include "solver/optimizer/AdaBelief/AdaBelief.hpp"
 #include "solver/optimizer/Adam/Adam.hpp"
 #include "solver/optimizer/CMAES/CMAES.hpp"
+#include "solver/optimizer/BayesianOptimization/BayesianOptimization.hpp"
 #include "solver/optimizer/DEA/DEA.hpp"
 #include "solver/optimizer/MADGRAD/MADGRAD.hpp"
 #include "solver/optimizer/MOCMAES/MOCMAES.hpp"
 #include "solver/optimizer/Rprop/Rprop.hpp"
 #include "solver/optimizer/gridSearch/gridSearch.hpp"
 #include "solver/optimizer/optimizer.hpp"
+#include "solver/sampler/Ensemble/Ensemble.hpp"
 #include "solver/sampler/HMC/HMC.hpp"
 #include "solver/sampler/MCMC/MCMC.hpp"
 #include "solver/sampler/Nested/Nested.hpp"
+#include "solver/sampler/ParallelTempering/ParallelTempering.hpp"
 #include "solver/sampler/TMCMC/TMCMC.hpp"
 #include "solver/sampler/sampler.hpp"
 
@@ -148,6 +151,7 @@ Module *Module::getModule(knlohmann::json &js, Experiment *e)
   if (iCompare(moduleType, "Agent/Continuous/VRACER")) module = new korali::solver::agent::continuous::VRACER();
   if (iCompare(moduleType, "Agent/Discrete/dVRACER")) module = new korali::solver::agent::discrete::dVRACER();
   if (iCompare(moduleType, "Optimizer/CMAES")) module = new korali::solver::optimizer::CMAES();
+  if (iCompare(moduleType, "Optimizer/BayesianOptimization")) module = new korali::solver::optimizer::BayesianOptimization();
   if (iCompare(moduleType, "Optimizer/DEA")) module = new korali::solver::optimizer::DEA();
   if (iCompare(moduleType, "Optimizer/Rprop")) module = new korali::solver::optimizer::Rprop();
   if (iCompare(moduleType, "Optimizer/Adam")) module = new korali::solver::optimizer::Adam();
@@ -155,8 +159,10 @@ Module *Module::getModule(knlohmann::json &js, Experiment *e)
   if (iCompare(moduleType, "Optimizer/MADGRAD")) module = new korali::solver::optimizer::MADGRAD();
   if (iCompare(moduleType, "Optimizer/MOCMAES")) module = new korali::solver::optimizer::MOCMAES();
   if (iCompare(moduleType, "Optimizer/GridSearch")) module = new korali::solver::optimizer::GridSearch();
+  if (iCompare(moduleType, "Sampler/Ensemble")) module = new korali::solver::sampler::Ensemble();
   if (iCompare(moduleType, "Sampler/Nested")) module = new korali::solver::sampler::Nested();
   if (iCompare(moduleType, "Sampler/MCMC")) module = new korali::solver::sampler::MCMC();
+  if (iCompare(moduleType, "Sampler/ParallelTempering")) module = new korali::solver::sampler::ParallelTempering();
   if (iCompare(moduleType, "Sampler/HMC")) module = new korali::solver::sampler::HMC();
   if (iCompare(moduleType, "Sampler/TMCMC")) module = new korali::solver::sampler::TMCMC();
   if (iCompare(moduleType, "NeuralNetwork")) module = new korali::NeuralNetwork();
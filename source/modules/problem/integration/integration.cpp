@@ -11,8 +11,17 @@ void Integration::initialize()
 {
   if (_k->_variables.size() == 0) KORALI_LOG_ERROR("Integration problems require at least one variable.\n");
 
+  bool isAdaptive = _integrationMethod == "Sparse Grid" || _integrationMethod == "Sobol" || _integrationMethod == "Halton";
+
   for (size_t i = 0; i < _k->_variables.size(); i++)
   {
+    // Adaptive methods place their own points inside the bounds
+    if (isAdaptive)
+    {
+      if (_k->_variables[i]->_upperBound <= _k->_variables[i]->_lowerBound) KORALI_LOG_ERROR("'Upper Bound' is not strictly bigger then 'Lower Bound' for variable %s.\n", _k->_variables[i]->_name.c_str());
+      continue;
+    }
+
     if (_k->_variables[i]->_numberOfGridpoints <= 0) KORALI_LOG_ERROR("'Number Of Gridpoints' for variable %s must be a strictly positive integer", _k->_variables[i]->_name.c_str());
 
     if (_k->_variables[i]->_upperBound <= _k->_variables[i]->_lowerBound) KORALI_LOG_ERROR("'Upper Bound' is not strictly bigger then 'Lower Bound' for variable %s.\n", _k->_variables[i]->_name.c_str());
@@ -113,6 +122,9 @@ void Integration::setConfiguration(knlohmann::json& js)
  if (_integrationMethod == "Simpson") validOption = true; 
  if (_integrationMethod == "Monte Carlo") validOption = true; 
  if (_integrationMethod == "Custom") validOption = true; 
+ if (_integrationMethod == "Sparse Grid") validOption = true; 
+ if (_integrationMethod == "Sobol") validOption = true; 
+ if (_integrationMethod == "Halton") validOption = true; 
  if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Integration Method'] required by integration.\n", _integrationMethod.c_str()); 
 }
    eraseValue(js, "Integration Method");
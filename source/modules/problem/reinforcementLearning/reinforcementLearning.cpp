@@ -103,8 +103,9 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
   // Setting mode to traing to add exploratory noise or random actions
   agent["Mode"] = "Training";
 
-  // Reserving message storage for sending back the episodes
-  knlohmann::json episodes;
+  // Experiences taken since the last chunk was sent to the agent, as flat arrays (one row per experience) for every sub-agent
+  knlohmann::json chunks;
+  size_t chunkExperienceCount = 0;
 
   // Storage to keep track of cumulative reward
   std::vector<float> trainingRewards(_agentsPerEnvironment, 0.0);
@@ -133,8 +134,26 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
   // Check whether the env id provided does not exceed the maximum specified
   if (environmentId >= _environmentCount) KORALI_LOG_ERROR("Environment Id provided (%lu) exceeds the maximum environment count defined (>= %lu).\n", environmentId, _environmentCount);
 
-  // Store the current environment Id in the experience
-  for (size_t i = 0; i < _agentsPerEnvironment; i++) episodes[i]["Environment Id"] = environmentId;
+  // Sends the experiences of the current chunk to the agent and starts a new chunk
+  auto sendChunk = [&](const std::string &action) {
+    for (size_t i = 0; i < _agentsPerEnvironment; i++)
+    {
+      chunks[i]["Environment Id"] = environmentId;
+      chunks[i]["Experience Count"] = chunkExperienceCount;
+      chunks[i]["Termination"] = agent["Termination"];
+      if (agent["Termination"] == "Truncated") chunks[i]["Truncated State"] = agent["State"][i];
+      writeStateShard(chunks[i], chunkExperienceCount);
+    }
+
+    knlohmann::json message;
+    message["Action"] = action;
+    message["Sample Id"] = agent["Sample Id"];
+    message["Episodes"] = std::move(chunks);
+    KORALI_SEND_MSG_TO_ENGINE(message);
+
+    chunks = knlohmann::json();
+    chunkExperienceCount = 0;
+  };
 
   // Saving experiences
   while (agent["Termination"] == "Non Terminal")
@@ -142,17 +161,24 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
     // Generating new action from the agent's policy
     getAction(agent);
 
-    // Store the current state in the experience
-    for (size_t i = 0; i < _agentsPerEnvironment; i++)
-      episodes[i]["Experiences"][actionCount]["State"] = agent["State"][i];
-
-    // Storing the current action
-    for (size_t i = 0; i < _agentsPerEnvironment; i++)
-      episodes[i]["Experiences"][actionCount]["Action"] = agent["Action"][i];
-
-    // Storing the experience's policy
+    // Storing the current state, action and the experience's policy
     for (size_t i = 0; i < _agentsPerEnvironment; i++)
-      episodes[i]["Experiences"][actionCount]["Policy"] = agent["Policy"][i];
+    {
+      auto &chunk = chunks[i];
+      const auto &policy = agent["Policy"][i];
+
+      for (const auto &s : agent["State"][i]) chunk["States"].push_back(s);
+      for (const auto &a : agent["Action"][i]) chunk["Actions"].push_back(a);
+
+      chunk["Policy"]["State Values"].push_back(policy["State Value"]);
+      if (isDefined(policy, "Distribution Parameters"))
+        for (const auto &p : policy["Distribution Parameters"]) chunk["Policy"]["Distribution Parameters"].push_back(p);
+      if (isDefined(policy, "Action Probabilities"))
+        for (const auto &p : policy["Action Probabilities"]) chunk["Policy"]["Action Probabilities"].push_back(p);
+      if (isDefined(policy, "Action Index")) chunk["Policy"]["Action Indexes"].push_back(policy["Action Index"]);
+      if (isDefined(policy, "Unbounded Action"))
+        for (const auto &u : policy["Unbounded Action"]) chunk["Policy"]["Unbounded Actions"].push_back(u);
+    }
 
     // If single agent, put action into a single vector
     // In case of this being a single agent, support returning state as only vector
@@ -161,18 +187,9 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
     // Jumping back into the agent's environment
     runEnvironment(agent);
 
-    // Storing experience's reward
-    for (size_t i = 0; i < _agentsPerEnvironment; i++)
-      episodes[i]["Experiences"][actionCount]["Reward"] = agent["Reward"][i];
-
-    // Storing termination status
+    // Storing experience's reward. The termination status (and truncated state) is sent with the chunk.
     for (size_t i = 0; i < _agentsPerEnvironment; i++)
-      episodes[i]["Experiences"][actionCount]["Termination"] = agent["Termination"];
-
-    // If the episodes was truncated, then save the terminal state
-    if (agent["Termination"] == "Truncated")
-      for (size_t i = 0; i < _agentsPerEnvironment; i++)
-        episodes[i]["Experiences"][actionCount]["Truncated State"] = agent["State"][i];
+      chunks[i]["Rewards"].push_back(agent["Reward"][i]);
 
     // Adding to cumulative training rewards
     for (size_t i = 0; i < _agentsPerEnvironment; i++)
@@ -180,6 +197,12 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
 
     // Increasing counter for generated actions
     actionCount++;
+    chunkExperienceCount++;
+
+    // Streaming the experiences to the agent while the episode runs, so they can be used for training before it finishes
+    if ((_experiencesPerChunk > 0) &&
+        (agent["Termination"] == "Non Terminal") &&
+        (chunkExperienceCount == _experiencesPerChunk)) sendChunk("Send Experiences");
 
     // Checking if we requested the given number of actions in between policy updates and it is not a terminal state
     if ((_actionsBetweenPolicyUpdates > 0) &&
@@ -193,11 +216,7 @@ void ReinforcementLearning::runTrainingEpisode(Sample &agent)
   // Sending last experience last (after testing)
   // This is important to prevent the engine for block-waiting for the return of the sample
   // while the testing runs are being performed.
-  knlohmann::json message;
-  message["Action"] = "Send Episodes";
-  message["Sample Id"] = agent["Sample Id"];
-  message["Episodes"] = episodes;
-  KORALI_SEND_MSG_TO_ENGINE(message);
+  sendChunk("Send Episodes");
 
   // Finalizing Environment
   finalizeEnvironment();
@@ -266,12 +285,25 @@ void ReinforcementLearning::initializeEnvironment(Sample &agent)
   // Getting agent's conduit
   _conduit = _agent->_k->_engine->_conduit;
 
-  // First, we update the initial policy's hyperparameters
-  _agent->setAgentPolicy(agent["Policy Hyperparameters"]);
+  // First, we update the initial policy's hyperparameters. Testing episodes carry their policy, training episodes only
+  // the version of the current training policy, which is requested from the engine if the cached one is older.
+  if (agent.contains("Policy Hyperparameters"))
+  {
+    _agent->setAgentPolicy(agent["Policy Hyperparameters"]);
+    _policyVersion = 0;
+  }
+  else if (_conduit->isWorkerLeadRank())
+  {
+    auto policyVersion = KORALI_GET(size_t, agent, "Policy Version");
+    if (policyVersion != _policyVersion) requestNewPolicy(agent);
+  }
 
   // Then, we reset the state sequence for time-dependent learners
   _agent->resetTimeSequence();
 
+  // With a sharded replay, the engine reports which states of this worker's shard it no longer needs
+  if (agent.contains("State Shards")) updateStateShardReleasedCount(agent["State Shards"]);
+
   // Define state rescaling variables
   _stateRescalingMeans = agent["State Rescaling"]["Means"].get<std::vector<float>>();
   _stateRescalingSdevs = agent["State Rescaling"]["Standard Deviations"].get<std::vector<float>>();
@@ -305,19 +337,56 @@ void ReinforcementLearning::requestNewPolicy(Sample &agent)
   // Reserving message storage for requesting new policy
   knlohmann::json message;
 
-  // Sending request to engine
+  // Sending request to engine, with the version of the cached policy
   message["Sample Id"] = agent["Sample Id"];
   message["Action"] = "Request New Policy";
+  message["Policy Version"] = _policyVersion;
   KORALI_SEND_MSG_TO_ENGINE(message);
 
-  // If requested new policy, wait for incoming message containing new hyperparameters
-  agent["Policy Hyperparameters"] = KORALI_RECV_MSG_FROM_ENGINE();
-  _agent->setAgentPolicy(agent["Policy Hyperparameters"]);
+  // Wait for the incoming message, which only contains the hyperparameters if the cached policy is outdated
+  auto policyMessage = KORALI_RECV_MSG_FROM_ENGINE();
+  if (policyMessage.contains("State Shards")) updateStateShardReleasedCount(policyMessage["State Shards"]);
+  if (policyMessage.contains("Hyperparameters"))
+  {
+    _agent->setTrainingPolicyMessage(policyMessage);
+    _policyVersion = policyMessage["Version"].get<size_t>();
+  }
 
   auto t1 = std::chrono::steady_clock::now();                                                       // Profiling
   _agentCommunicationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(); // Profiling
 }
 
+void ReinforcementLearning::writeStateShard(knlohmann::json &chunk, const size_t experienceCount)
+{
+  // Only the workers of the distributed conduit hold shards
+  auto conduit = dynamic_cast<conduit::Distributed *>(_conduit);
+  if (conduit == nullptr || conduit->_areShardsAllocated == false || experienceCount == 0) return;
+
+  // If the shard has no room left for the chunk, its states are sent to the engine along with the experiences
+  const size_t shardSize = conduit->_shardRowCount;
+  if (_stateShardWrittenCount + experienceCount - _stateShardReleasedCount > shardSize) return;
+
+  const auto states = chunk["States"].get<std::vector<float>>();
+  std::vector<size_t> rows(experienceCount);
+  for (size_t i = 0; i < experienceCount; i++) rows[i] = (_stateShardWrittenCount + i) % shardSize;
+  conduit->writeShard(conduit->getShardId(), rows, states.data());
+
+  chunk.erase("States");
+  chunk["State Shard"]["Id"] = conduit->getShardId();
+  chunk["State Shard"]["First Index"] = _stateShardWrittenCount;
+  _stateShardWrittenCount += experienceCount;
+}
+
+void ReinforcementLearning::updateStateShardReleasedCount(const knlohmann::json &stateShards)
+{
+  auto conduit = dynamic_cast<conduit::Distributed *>(_conduit);
+  if (conduit == nullptr) return;
+
+  // Released states are never reclaimed, so the count only grows
+  const size_t releasedCount = stateShards["Released Counts"][conduit->getShardId()].get<size_t>();
+  _stateShardReleasedCount = std::max(_stateShardReleasedCount, releasedCount);
+}
+
 void ReinforcementLearning::getAction(Sample &agent)
 {
   // Generating new action from policy
@@ -464,6 +533,15 @@ void ReinforcementLearning::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Actions Between Policy Updates'] required by reinforcementLearning.\n"); 
 
+ if (isDefined(js, "Experiences Per Chunk"))
+ {
+ try { _experiencesPerChunk = js["Experiences Per Chunk"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ reinforcementLearning ] \n + Key:    ['Experiences Per Chunk']\n%s", e.what()); } 
+   eraseValue(js, "Experiences Per Chunk");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experiences Per Chunk'] required by reinforcementLearning.\n"); 
+
  if (isDefined(js, "Custom Settings"))
  {
  _customSettings = js["Custom Settings"].get<knlohmann::json>();
@@ -531,6 +609,7 @@ void ReinforcementLearning::getConfiguration(knlohmann::json& js)
    js["Environment Count"] = _environmentCount;
    js["Environment Function"] = _environmentFunction;
    js["Actions Between Policy Updates"] = _actionsBetweenPolicyUpdates;
+   js["Experiences Per Chunk"] = _experiencesPerChunk;
    js["Custom Settings"] = _customSettings;
    js["Action Vector Size"] = _actionVectorSize;
    js["State Vector Size"] = _stateVectorSize;
@@ -547,7 +626,7 @@ void ReinforcementLearning::getConfiguration(knlohmann::json& js)
 void ReinforcementLearning::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Agents Per Environment\": 1, \"Environment Count\": 1, \"Actions Between Policy Updates\": 0, \"Custom Settings\": {}}";
+ std::string defaultString = "{\"Agents Per Environment\": 1, \"Environment Count\": 1, \"Actions Between Policy Updates\": 0, \"Experiences Per Chunk\": 256, \"Custom Settings\": {}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Problem::applyModuleDefaults(js);
@@ -29,7 +29,7 @@ class ReinforcementLearning : public Problem
 {
   public: 
   /**
-  * @brief Number of agents in a given environment. All agents share the same policy .
+  * @brief Number of agents in a given environment. All agents share the same policy, which is evaluated for all of their states in a single batched inference. An environment can hence step several copies of itself in lockstep, returning one state and reward per copy.
   */
    size_t _agentsPerEnvironment;
   /**
@@ -45,6 +45,10 @@ class ReinforcementLearning : public Problem
   */
    size_t _actionsBetweenPolicyUpdates;
   /**
+  * @brief Number of experiences sent to the agent in each message while an episode runs. The experiences count towards the next policy update as soon as they arrive. If zero, the experiences are sent when the episode finishes.
+  */
+   size_t _experiencesPerChunk;
+  /**
   * @brief Any used-defined settings required by the environment.
   */
    knlohmann::json _customSettings;
@@ -137,6 +141,19 @@ class ReinforcementLearning : public Problem
    */
   void getAction(Sample &agent);
 
+  /**
+   * @brief [Sharded replay] Moves the states of a chunk into this worker's shard, if it has room for them
+   * @param chunk The chunk of experiences to send to the engine
+   * @param experienceCount The number of experiences in the chunk
+   */
+  void writeStateShard(knlohmann::json &chunk, const size_t experienceCount);
+
+  /**
+   * @brief [Sharded replay] Takes the number of states of this worker's shard that the engine no longer needs
+   * @param stateShards Message from the engine with the released state counts of every shard
+   */
+  void updateStateShardReleasedCount(const knlohmann::json &stateShards);
+
   /**
    * @brief Contains the state rescaling means
    */
@@ -147,6 +164,21 @@ class ReinforcementLearning : public Problem
    */
   std::vector<float> _stateRescalingSdevs;
 
+  /**
+   * @brief Version of the training policy cached by this worker (0, if none)
+   */
+  size_t _policyVersion = 0;
+
+  /**
+   * @brief [Sharded replay] Number of states this worker has written to its shard
+   */
+  size_t _stateShardWrittenCount = 0;
+
+  /**
+   * @brief [Sharded replay] Number of states written to this worker's shard that the engine no longer needs, and may be overwritten
+   */
+  size_t _stateShardReleasedCount = 0;
+
   /**
    * @brief [Profiling] Stores policy evaluation time per episode
    */
@@ -1,8 +1,12 @@
 #include "auxiliar/fs.hpp"
 #include "engine.hpp"
+#include "modules/conduit/sequential/sequential.hpp"
 #include "modules/solver/agent/agent.hpp"
 #include "sample/sample.hpp"
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
 
 namespace korali
 {
@@ -10,6 +14,79 @@ namespace solver
 {
 ;
 
+namespace
+{
+/**
+ * @brief Header preceding every chunk of experiences appended to the binary replay log (replay.bin)
+ */
+struct replayLogHeader
+{
+  char magic[8];
+  uint64_t firstExperience;
+  uint64_t count;
+  uint64_t strides[5];
+};
+
+/**
+ * @brief Header of the binary replay metadata file (replay.meta.bin)
+ */
+struct replayMetaHeader
+{
+  char magic[8];
+  uint64_t lastExperience;
+  uint64_t count;
+  uint64_t strides[5];
+};
+
+const char _replayLogMagic[8] = {'K', 'R', 'L', 'O', 'G', '0', '0', '1'};
+const char _replayMetaMagic[8] = {'K', 'R', 'M', 'E', 'T', 'A', '0', '1'};
+
+/**
+ * @brief Columns are padded to 8 bytes, so that every column of a memory-mapped file is aligned
+ */
+size_t paddedColumnSize(size_t bytes) { return (bytes + 7) / 8 * 8; }
+
+/**
+ * @brief Size of a block of padded columns with the given row sizes
+ */
+size_t columnBlockSize(size_t count, const std::vector<size_t> &rowBytes)
+{
+  size_t size = 0;
+  for (const auto b : rowBytes) size += paddedColumnSize(count * b);
+  return size;
+}
+
+template <typename T>
+void stageColumn(std::vector<std::vector<char>> &columns, cBuffer<T> &buffer, size_t first, size_t count)
+{
+  columns.emplace_back(paddedColumnSize(count * sizeof(T)));
+  buffer.copyTo(first, count, reinterpret_cast<T *>(columns.back().data()));
+}
+
+template <typename T>
+void stageColumn(std::vector<std::vector<char>> &columns, cStridedBuffer<T> &buffer, size_t first, size_t count)
+{
+  columns.emplace_back(paddedColumnSize(count * buffer.stride() * sizeof(T)));
+  buffer.copyTo(first, count, reinterpret_cast<T *>(columns.back().data()));
+}
+
+template <typename T>
+const char *loadColumn(const char *src, size_t first, size_t count, size_t total, cBuffer<T> &buffer)
+{
+  const T *values = reinterpret_cast<const T *>(src);
+  for (size_t i = first; i < first + count; i++) buffer.add(values[i]);
+  return src + paddedColumnSize(total * sizeof(T));
+}
+
+template <typename T>
+const char *loadColumn(const char *src, size_t first, size_t count, size_t total, cStridedBuffer<T> &buffer)
+{
+  const T *values = reinterpret_cast<const T *>(src);
+  for (size_t i = first; i < first + count; i++) buffer.add(values + i * buffer.stride());
+  return src + paddedColumnSize(total * buffer.stride() * sizeof(T));
+}
+} // namespace
+
 void Agent::initialize()
 {
   _variableCount = _k->_variables.size();
@@ -45,9 +122,18 @@ void Agent::initialize()
   if (_experienceReplayStartSize == 0)
     _experienceReplayStartSize = _experienceReplayMaximumSize;
 
-  //  Pre-allocating space for the experience replay memory
-  _stateVector.resize(_experienceReplayMaximumSize);
-  _actionVector.resize(_experienceReplayMaximumSize);
+  // The shards live in the worker processes, which do not survive the run
+  if (_experienceReplayShardingEnabled == true && _experienceReplaySerialize == true)
+    KORALI_LOG_ERROR("A sharded experience replay cannot be serialized, disable ['Experience Replay']['Serialize'].\n");
+
+  //  Pre-allocating space for the experience replay memory. With a sharded replay, the engine only keeps where the states are.
+  if (_experienceReplayShardingEnabled == false) _stateVector.resize(_experienceReplayMaximumSize, _problem->_stateVectorSize);
+  if (_experienceReplayShardingEnabled == true) _stateShardIdVector.resize(_experienceReplayMaximumSize);
+  if (_experienceReplayShardingEnabled == true) _stateShardIndexVector.resize(_experienceReplayMaximumSize);
+  _stateShardLocalStates.clear();
+  _stateShardLocalFirstIndex = 0;
+  _stateShardConduit = nullptr;
+  _actionVector.resize(_experienceReplayMaximumSize, _problem->_actionVectorSize);
   _retraceValueVector.resize(_experienceReplayMaximumSize);
   _rewardVector.resize(_experienceReplayMaximumSize);
   _environmentIdVector.resize(_experienceReplayMaximumSize);
@@ -55,16 +141,24 @@ void Agent::initialize()
   _importanceWeightVector.resize(_experienceReplayMaximumSize);
   _truncatedImportanceWeightVector.resize(_experienceReplayMaximumSize);
   _truncatedStateValueVector.resize(_experienceReplayMaximumSize);
-  _truncatedStateVector.resize(_experienceReplayMaximumSize);
+  _truncatedStateVector.resize(_experienceReplayMaximumSize, _problem->_stateVectorSize);
   _terminationVector.resize(_experienceReplayMaximumSize);
-  _expPolicyVector.resize(_experienceReplayMaximumSize);
-  _curPolicyVector.resize(_experienceReplayMaximumSize);
+  _expPolicyStateValueVector.resize(_experienceReplayMaximumSize);
+  _expPolicyParameterVector.resize(_experienceReplayMaximumSize, _policyParameterCount);
+  _expPolicyActionProbabilityVector.resize(_experienceReplayMaximumSize, _policyActionProbabilityCount);
+  _expPolicyActionIndexVector.resize(_experienceReplayMaximumSize);
+  _expPolicyUnboundedActionVector.resize(_experienceReplayMaximumSize, _policyUnboundedActionCount);
+  _curPolicyParameterVector.resize(_experienceReplayMaximumSize, _policyParameterCount);
+  _curPolicyActionProbabilityVector.resize(_experienceReplayMaximumSize, _policyActionProbabilityCount);
+  _curPolicyUnboundedActionVector.resize(_experienceReplayMaximumSize, _policyUnboundedActionCount);
   _isOnPolicyVector.resize(_experienceReplayMaximumSize);
   _episodePosVector.resize(_experienceReplayMaximumSize);
   _episodeIdVector.resize(_experienceReplayMaximumSize);
+  _priorityTree.resize(_experienceReplayMaximumSize);
 
-  //  Pre-allocating space for state time sequence
-  _stateTimeSequence.resize(_timeSequenceLength);
+  //  Pre-allocating space for the state time sequence of every agent in the environment
+  _stateTimeSequence.resize(_problem->_agentsPerEnvironment);
+  for (auto &sequence : _stateTimeSequence) sequence.resize(_timeSequenceLength);
 
   /*********************************************************************
    *   // If initial generation, set initial agent configuration
@@ -93,6 +187,13 @@ void Agent::initialize()
     _experienceReplayOffPolicyCurrentCutoff = _experienceReplayOffPolicyCutoffScale;
     _currentLearningRate = _learningRate;
 
+    // New experiences enter the prioritized replay with the largest priority seen so far
+    _experienceReplayPriorityMax = 1.0f;
+
+    // Nothing has been written to the binary replay log yet
+    _experienceReplaySnapshotCount = 0;
+    _experienceReplaySnapshotLogSize = 0;
+
     // State Rescaling information
     _stateRescalingMeans = std::vector<float>(_problem->_stateVectorSize, 0.0);
     _stateRescalingSigmas = std::vector<float>(_problem->_stateVectorSize, 1.0);
@@ -109,6 +210,7 @@ void Agent::initialize()
 
   // Setting current agent's training state
   setAgentPolicy(_trainingCurrentPolicy);
+  _trainingCurrentPolicyVersion++;
 
   // If this continues a previous training run, deserialize previous input experience replay
   if (_k->_currentGeneration > 0)
@@ -126,18 +228,21 @@ void Agent::initialize()
 
   // Initializing session-specific counters
   _sessionExperienceCount = 0;
+  _receivedExperienceCount = 0;
   _sessionEpisodeCount = 0;
   _sessionGeneration = 1;
   _sessionPolicyUpdateCount = 0;
 
   // Calculating how many more experiences do we need in this session to reach the starting size
-  _sessionExperiencesUntilStartSize = _stateVector.size() > _experienceReplayStartSize ? 0 : _experienceReplayStartSize - _stateVector.size();
+  _sessionExperiencesUntilStartSize = _rewardVector.size() > _experienceReplayStartSize ? 0 : _experienceReplayStartSize - _rewardVector.size();
 
   if (_mode == "Training")
   {
     // Creating storate for _agents and their status
     _agents.resize(_concurrentEnvironments);
     _isAgentRunning.resize(_concurrentEnvironments, false);
+    _pendingEpisodes.resize(_concurrentEnvironments);
+    for (auto &episodes : _pendingEpisodes) episodes.resize(_problem->_agentsPerEnvironment);
   }
 
   if (_mode == "Testing")
@@ -176,68 +281,87 @@ void Agent::trainingGeneration()
   _generationPolicyUpdateTime = 0.0;
   _generationAgentAttendingTime = 0.0;
 
+  // The environments of the sequential conduit run in this process, on the same policy network the learner thread trains.
+  // This is checked here, since the conduit is only created after the solver is initialized.
+  if (_asynchronousPolicyUpdates == true && dynamic_cast<conduit::Sequential *>(_k->_engine->_conduit) != nullptr)
+    KORALI_LOG_ERROR("Asynchronous policy updates require a concurrent or distributed conduit.\n");
+
+  // The shards are allocated by the workers, which are only running once the conduit exists
+  if (_experienceReplayShardingEnabled == true && _stateShardConduit == nullptr) allocateStateShards();
+
   // Running until all _agents have finished
-  while (_sessionEpisodeCount < _episodesPerGeneration * _sessionGeneration)
+  try
   {
-    // Launching (or re-launching) agents
-    for (size_t agentId = 0; agentId < _concurrentEnvironments; agentId++)
-      if (_isAgentRunning[agentId] == false)
+    while (_sessionEpisodeCount < _episodesPerGeneration * _sessionGeneration)
+    {
+      // Launching (or re-launching) agents
+      for (size_t agentId = 0; agentId < _concurrentEnvironments; agentId++)
+        if (_isAgentRunning[agentId] == false)
+        {
+          _agents[agentId]["Sample Id"] = _currentSampleID++;
+          _agents[agentId]["Module"] = "Problem";
+          _agents[agentId]["Operation"] = "Run Training Episode";
+          _agents[agentId]["Policy Version"] = _trainingCurrentPolicyVersion;
+          if (_stateShardConduit != nullptr) _agents[agentId]["State Shards"]["Released Counts"] = _stateShardReleasedCounts;
+          _agents[agentId]["State Rescaling"]["Means"] = _stateRescalingMeans;
+          _agents[agentId]["State Rescaling"]["Standard Deviations"] = _stateRescalingSigmas;
+
+          KORALI_START(_agents[agentId]);
+          _isAgentRunning[agentId] = true;
+        }
+
+      // Listening to _agents for incoming experiences
+      KORALI_LISTEN(_agents);
+
+      // Attending to running agents, checking if any experience has been received
+      for (size_t agentId = 0; agentId < _concurrentEnvironments; agentId++)
+        if (_isAgentRunning[agentId] == true)
+          attendAgent(agentId);
+
+      // If the learner thread is running, it performs the policy updates. We only take its latest policy.
+      if (_learnerThread.joinable())
       {
-        _agents[agentId]["Sample Id"] = _currentSampleID++;
-        _agents[agentId]["Module"] = "Problem";
-        _agents[agentId]["Operation"] = "Run Training Episode";
-        _agents[agentId]["Policy Hyperparameters"] = _trainingCurrentPolicy;
-        _agents[agentId]["State Rescaling"]["Means"] = _stateRescalingMeans;
-        _agents[agentId]["State Rescaling"]["Standard Deviations"] = _stateRescalingSigmas;
-
-        KORALI_START(_agents[agentId]);
-        _isAgentRunning[agentId] = true;
+        fetchLearnerPolicy();
+        continue;
       }
 
-    // Listening to _agents for incoming experiences
-    KORALI_LISTEN(_agents);
-
-    // Attending to running agents, checking if any experience has been received
-    for (size_t agentId = 0; agentId < _concurrentEnvironments; agentId++)
-      if (_isAgentRunning[agentId] == true)
-        attendAgent(agentId);
-
-    // Perform optimization steps on the critic/policy, if reached the minimum replay memory size
-    if (_experienceCount >= _experienceReplayStartSize)
-    {
-      // If we accumulated enough experiences, we rescale the states (once)
-      if (_stateRescalingEnabled == true)
-        if (_policyUpdateCount == 0)
-          rescaleStates();
-
-      // If we accumulated enough experiences between updates in this session, update now
-      while (_sessionExperienceCount > (_experiencesBetweenPolicyUpdates * _sessionPolicyUpdateCount + _sessionExperiencesUntilStartSize))
+      // Perform optimization steps on the critic/policy, if reached the minimum replay memory size
+      if (_experienceCount >= _experienceReplayStartSize)
       {
-        auto beginTime = std::chrono::steady_clock::now(); // Profiling
-
-        // Calling the algorithm specific policy training algorithm
-        trainPolicy();
-
-        auto endTime = std::chrono::steady_clock::now();                                                                  // Profiling
-        _sessionPolicyUpdateTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count();    // Profiling
-        _generationPolicyUpdateTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count(); // Profiling
-
-        // Increasing policy update counters
-        _policyUpdateCount++;
-        _sessionPolicyUpdateCount++;
-
-        // Updating REFER learning rate and beta parameters
-        _currentLearningRate = _learningRate / (1.0f + _experienceReplayOffPolicyAnnealingRate * (float)_policyUpdateCount);
-        if (_experienceReplayOffPolicyRatio > _experienceReplayOffPolicyTarget)
-          _experienceReplayOffPolicyREFERBeta = (1.0f - _currentLearningRate) * _experienceReplayOffPolicyREFERBeta;
-        else
-          _experienceReplayOffPolicyREFERBeta = (1.0f - _currentLearningRate) * _experienceReplayOffPolicyREFERBeta + _currentLearningRate;
+        // If we accumulated enough experiences, we rescale the states (once)
+        if (_stateRescalingEnabled == true)
+          if (_policyUpdateCount == 0)
+            rescaleStates();
+
+        // If we accumulated enough experiences between updates in this session, update now
+        bool isPolicyUpdated = false;
+        while (isPolicyUpdateDue())
+        {
+          runPolicyUpdate();
+          isPolicyUpdated = true;
+        }
+
+        // Getting new policy hyperparameters (for agents to generate actions)
+        if (isPolicyUpdated)
+        {
+          _trainingCurrentPolicy = getAgentPolicy();
+          _trainingCurrentPolicyVersion++;
+        }
+
+        // The remaining policy updates of this generation run in the learner thread
+        if (_asynchronousPolicyUpdates == true && _policyUpdateCount > 0) startLearnerThread();
       }
-
-      // Getting new policy hyperparameters (for agents to generate actions)
-      _trainingCurrentPolicy = getAgentPolicy();
     }
   }
+  catch (...)
+  {
+    stopLearnerThread();
+    throw;
+  }
+
+  // Waiting for the learner's current policy update, and taking its last policy
+  stopLearnerThread();
+  fetchLearnerPolicy();
 
   // Now serializing experience replay database
   if (_experienceReplaySerialize == true)
@@ -292,27 +416,187 @@ void Agent::testingGeneration()
     _testingReward[agentId] = testingAgents[agentId]["Testing Reward"].get<float>();
 }
 
+bool Agent::isPolicyUpdateDue()
+{
+  _sessionExperienceCount += _receivedExperienceCount.exchange(0);
+
+  if (_experienceCount < _experienceReplayStartSize) return false;
+  return _sessionExperienceCount > (_experiencesBetweenPolicyUpdates * _sessionPolicyUpdateCount + _sessionExperiencesUntilStartSize);
+}
+
+void Agent::runPolicyUpdate()
+{
+  auto beginTime = std::chrono::steady_clock::now(); // Profiling
+
+  // Calling the algorithm specific policy training algorithm
+  trainPolicy();
+
+  auto endTime = std::chrono::steady_clock::now();                                                                  // Profiling
+  _sessionPolicyUpdateTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count();    // Profiling
+  _generationPolicyUpdateTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count(); // Profiling
+
+  // Increasing policy update counters
+  _policyUpdateCount++;
+  _sessionPolicyUpdateCount++;
+
+  // Updating REFER learning rate and beta parameters
+  _currentLearningRate = _learningRate / (1.0f + _experienceReplayOffPolicyAnnealingRate * (float)_policyUpdateCount);
+  if (_experienceReplayOffPolicyRatio > _experienceReplayOffPolicyTarget)
+    _experienceReplayOffPolicyREFERBeta = (1.0f - _currentLearningRate) * _experienceReplayOffPolicyREFERBeta;
+  else
+    _experienceReplayOffPolicyREFERBeta = (1.0f - _currentLearningRate) * _experienceReplayOffPolicyREFERBeta + _currentLearningRate;
+}
+
+void Agent::startLearnerThread()
+{
+  _learnerStopRequested = false;
+  _learnerThread = std::thread(&Agent::runLearnerThread, this);
+}
+
+void Agent::stopLearnerThread()
+{
+  if (_learnerThread.joinable() == false) return;
+
+  {
+    std::lock_guard<std::mutex> wakeLock(_learnerWakeMutex);
+    _learnerStopRequested = true;
+  }
+
+  _learnerCondition.notify_one();
+  _learnerThread.join();
+}
+
+void Agent::runLearnerThread()
+{
+  try
+  {
+    while (true)
+    {
+      // Sleeping until the engine reports enough experiences for a policy update, or asks us to stop
+      {
+        std::unique_lock<std::mutex> wakeLock(_learnerWakeMutex);
+        _learnerCondition.wait(wakeLock, [this]() {
+          if (_learnerStopRequested == true) return true;
+          std::lock_guard<std::mutex> lock(_learnerMutex);
+          return isPolicyUpdateDue();
+        });
+
+        if (_learnerStopRequested == true) break;
+      }
+
+      // The engine adds finished episodes to the replay memory in between policy updates
+      knlohmann::json policy;
+      {
+        std::lock_guard<std::mutex> lock(_learnerMutex);
+        runPolicyUpdate();
+        policy = getAgentPolicy();
+      }
+
+      // Publishing the new policy, built aside and swapped in
+      {
+        std::lock_guard<std::mutex> policyLock(_learnerPolicyMutex);
+        std::swap(_learnerPublishedPolicy, policy);
+        _learnerPublishedPolicyVersion++;
+      }
+    }
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> policyLock(_learnerPolicyMutex);
+    _learnerException = std::current_exception();
+  }
+}
+
+void Agent::notifyLearner()
+{
+  // Passing through the wake mutex, the learner is either about to check for a due update (and sees the new experiences) or already waiting
+  {
+    std::lock_guard<std::mutex> wakeLock(_learnerWakeMutex);
+  }
+
+  _learnerCondition.notify_one();
+}
+
+void Agent::fetchLearnerPolicy()
+{
+  std::lock_guard<std::mutex> policyLock(_learnerPolicyMutex);
+
+  // Reporting errors from the learner thread
+  if (_learnerException)
+  {
+    auto exception = _learnerException;
+    _learnerException = nullptr;
+    std::rethrow_exception(exception);
+  }
+
+  // Taking the latest policy, if a new one was published
+  const size_t publishedVersion = _learnerPublishedPolicyVersion;
+  if (publishedVersion == _learnerFetchedPolicyVersion) return;
+
+  _trainingCurrentPolicy = _learnerPublishedPolicy;
+  _trainingCurrentPolicyVersion++;
+  _learnerFetchedPolicyVersion = publishedVersion;
+}
+
+const knlohmann::json &Agent::getTrainingPolicyMessage()
+{
+  // The policy is encoded once per version, no matter how many environments request it
+  if (_trainingCurrentPolicyMessage.is_null() || _trainingCurrentPolicyMessage["Version"] != _trainingCurrentPolicyVersion)
+  {
+    _trainingCurrentPolicyMessage = knlohmann::json();
+    _trainingCurrentPolicyMessage["Version"] = _trainingCurrentPolicyVersion;
+    _trainingCurrentPolicyMessage["Precision"] = _policyBroadcastPrecision;
+    _trainingCurrentPolicyMessage["Hyperparameters"] = encodeFloatArrays(_trainingCurrentPolicy, _policyBroadcastPrecision == "Half");
+  }
+
+  return _trainingCurrentPolicyMessage;
+}
+
+void Agent::setTrainingPolicyMessage(const knlohmann::json &message)
+{
+  const bool halfPrecision = message["Precision"] == "Half";
+  setAgentPolicy(decodeFloatArrays(message["Hyperparameters"], halfPrecision));
+}
+
 void Agent::rescaleStates()
 {
+  const size_t experienceCount = _rewardVector.size();
+
+  // With a sharded replay, the states are fetched from the shards, and written back once rescaled
+  std::vector<size_t> shardedExpIds;
+  std::vector<float> shardedStates;
+  if (_experienceReplayShardingEnabled == true)
+  {
+    shardedExpIds.resize(experienceCount);
+    std::iota(shardedExpIds.begin(), shardedExpIds.end(), 0);
+    shardedStates.resize(experienceCount * _problem->_stateVectorSize);
+    loadStates(shardedExpIds, shardedStates.data());
+  }
+
+  auto getState = [&](const size_t expId) -> float * {
+    if (_experienceReplayShardingEnabled == true) return shardedStates.data() + expId * _problem->_stateVectorSize;
+    return _stateVector[expId];
+  };
+
   // Calculation of state moments
   std::vector<float> sumStates(_problem->_stateVectorSize, 0.0);
   std::vector<float> squaredSumStates(_problem->_stateVectorSize, 0.0);
 
-  for (size_t i = 0; i < _stateVector.size(); ++i)
+  for (size_t i = 0; i < experienceCount; ++i)
     for (size_t d = 0; d < _problem->_stateVectorSize; ++d)
     {
-      sumStates[d] += _stateVector[i][d];
-      squaredSumStates[d] += _stateVector[i][d] * _stateVector[i][d];
+      sumStates[d] += getState(i)[d];
+      squaredSumStates[d] += getState(i)[d] * getState(i)[d];
     }
 
   _k->_logger->logInfo("Detailed", " + Using State Normalization N(Mean, Sigma):\n");
 
   for (size_t d = 0; d < _problem->_stateVectorSize; ++d)
   {
-    _stateRescalingMeans[d] = sumStates[d] / (float)_stateVector.size();
+    _stateRescalingMeans[d] = sumStates[d] / (float)experienceCount;
     if (std::isfinite(_stateRescalingMeans[d]) == false) _stateRescalingMeans[d] = 0.0f;
 
-    _stateRescalingSigmas[d] = std::sqrt(squaredSumStates[d] / (float)_stateVector.size() - _stateRescalingMeans[d] * _stateRescalingMeans[d]);
+    _stateRescalingSigmas[d] = std::sqrt(squaredSumStates[d] / (float)experienceCount - _stateRescalingMeans[d] * _stateRescalingMeans[d]);
     if (std::isfinite(_stateRescalingSigmas[d]) == false) _stateRescalingSigmas[d] = 1.0f;
     if (_stateRescalingSigmas[d] <= 1e-9) _stateRescalingSigmas[d] = 1.0f;
 
@@ -320,9 +604,155 @@ void Agent::rescaleStates()
   }
 
   // Actual rescaling of initial states
-  for (size_t i = 0; i < _stateVector.size(); ++i)
+  for (size_t i = 0; i < experienceCount; ++i)
     for (size_t d = 0; d < _problem->_stateVectorSize; ++d)
-      _stateVector[i][d] = (_stateVector[i][d] - _stateRescalingMeans[d]) / _stateRescalingSigmas[d];
+      getState(i)[d] = (getState(i)[d] - _stateRescalingMeans[d]) / _stateRescalingSigmas[d];
+
+  if (_experienceReplayShardingEnabled == true) storeStates(shardedExpIds, shardedStates.data());
+
+  // The states already in the binary replay log are outdated, the next snapshot rewrites it
+  _experienceReplaySnapshotCount = 0;
+}
+
+void Agent::allocateStateShards()
+{
+  auto conduit = dynamic_cast<conduit::Distributed *>(_k->_engine->_conduit);
+  if (conduit == nullptr) KORALI_LOG_ERROR("A sharded experience replay requires the Distributed conduit.\n");
+
+  // Workers only take part in the allocation from their idle loop, which those running samples of other experiments never reach
+  if (_k->_engine->_experimentVector.size() > 1) KORALI_LOG_ERROR("A sharded experience replay requires the agent to be the only experiment of the engine.\n");
+
+  // The learner thread reads the shards while the engine thread communicates with the environments
+  if (_asynchronousPolicyUpdates == true && conduit->isMultithreaded() == false)
+    KORALI_LOG_ERROR("Asynchronous policy updates with a sharded experience replay require MPI to be initialized with MPI_THREAD_MULTIPLE.\n");
+
+  // If not set, every worker can hold twice its even share of the replay memory
+  const size_t shardCount = conduit->getShardCount();
+  size_t shardSize = _experienceReplayShardingShardSize;
+  if (shardSize == 0) shardSize = 2 * ((_experienceReplayMaximumSize + shardCount - 1) / shardCount);
+
+  conduit->allocateShards(shardSize, _problem->_stateVectorSize);
+  _stateShardReleasedCounts.assign(shardCount, 0);
+  _stateShardEvictedIndexes.assign(shardCount, {});
+  _stateShardConduit = conduit;
+
+  _k->_logger->logInfo("Detailed", " + Allocated %lu shards of %lu states for the experience replay\n", shardCount, shardSize);
+}
+
+void Agent::addShardedState(const episode_t &episode, const size_t expId, size_t &localStateId)
+{
+  // Releasing the state of the experience that is about to be replaced
+  if (_stateShardIdVector.size() == _experienceReplayMaximumSize)
+  {
+    const int evictedShardId = _stateShardIdVector[0];
+    if (evictedShardId < 0)
+    {
+      _stateShardLocalStates.pop_front();
+      _stateShardLocalFirstIndex++;
+    }
+    else
+    {
+      // The episodes of the agents in an environment interleave their states in the shard, hence they are not evicted in order.
+      // Only the states before the earliest one still in the replay memory are released.
+      auto &evictedIndexes = _stateShardEvictedIndexes[evictedShardId];
+      auto &releasedCount = _stateShardReleasedCounts[evictedShardId];
+      evictedIndexes.push(_stateShardIndexVector[0]);
+      while (evictedIndexes.empty() == false && evictedIndexes.top() == releasedCount)
+      {
+        evictedIndexes.pop();
+        releasedCount++;
+      }
+    }
+  }
+
+  const int shardId = episode.stateShardIds[expId];
+  _stateShardIdVector.add(shardId);
+
+  // States that did not fit in the shard of their worker are kept by the engine
+  if (shardId < 0)
+  {
+    const auto state = episode.states.begin() + localStateId * _problem->_stateVectorSize;
+    _stateShardLocalStates.emplace_back(state, state + _problem->_stateVectorSize);
+    _stateShardIndexVector.add(_stateShardLocalFirstIndex + _stateShardLocalStates.size() - 1);
+    localStateId++;
+  }
+  else
+    _stateShardIndexVector.add(episode.stateShardIndexes[expId]);
+}
+
+void Agent::loadStates(const std::vector<size_t> &expIds, float *dst)
+{
+  const size_t stateSize = _problem->_stateVectorSize;
+
+  if (_experienceReplayShardingEnabled == false)
+  {
+    for (size_t i = 0; i < expIds.size(); i++) std::copy_n(_stateVector[expIds[i]], stateSize, dst + i * stateSize);
+    return;
+  }
+
+  // Grouping the states by shard, to read every shard in a single access epoch
+  const size_t shardCount = _stateShardReleasedCounts.size();
+  std::vector<std::vector<size_t>> shardRows(shardCount);
+  std::vector<std::vector<size_t>> shardPositions(shardCount);
+
+  for (size_t i = 0; i < expIds.size(); i++)
+  {
+    const int shardId = _stateShardIdVector[expIds[i]];
+    const size_t index = _stateShardIndexVector[expIds[i]];
+
+    if (shardId < 0)
+      std::copy_n(_stateShardLocalStates[index - _stateShardLocalFirstIndex].data(), stateSize, dst + i * stateSize);
+    else
+    {
+      shardRows[shardId].push_back(index % _stateShardConduit->_shardRowCount);
+      shardPositions[shardId].push_back(i);
+    }
+  }
+
+  std::vector<float> shardStates;
+  for (size_t shardId = 0; shardId < shardCount; shardId++)
+    if (shardRows[shardId].empty() == false)
+    {
+      shardStates.resize(shardRows[shardId].size() * stateSize);
+      _stateShardConduit->readShard(shardId, shardRows[shardId], shardStates.data());
+
+      for (size_t j = 0; j < shardPositions[shardId].size(); j++)
+        std::copy_n(shardStates.data() + j * stateSize, stateSize, dst + shardPositions[shardId][j] * stateSize);
+    }
+}
+
+void Agent::storeStates(const std::vector<size_t> &expIds, const float *src)
+{
+  const size_t stateSize = _problem->_stateVectorSize;
+
+  if (_experienceReplayShardingEnabled == false)
+  {
+    for (size_t i = 0; i < expIds.size(); i++) std::copy_n(src + i * stateSize, stateSize, _stateVector[expIds[i]]);
+    return;
+  }
+
+  // Grouping the states by shard, to write every shard in a single access epoch
+  const size_t shardCount = _stateShardReleasedCounts.size();
+  std::vector<std::vector<size_t>> shardRows(shardCount);
+  std::vector<std::vector<float>> shardStates(shardCount);
+
+  for (size_t i = 0; i < expIds.size(); i++)
+  {
+    const int shardId = _stateShardIdVector[expIds[i]];
+    const size_t index = _stateShardIndexVector[expIds[i]];
+
+    if (shardId < 0)
+      std::copy_n(src + i * stateSize, stateSize, _stateShardLocalStates[index - _stateShardLocalFirstIndex].data());
+    else
+    {
+      shardRows[shardId].push_back(index % _stateShardConduit->_shardRowCount);
+      shardStates[shardId].insert(shardStates[shardId].end(), src + i * stateSize, src + (i + 1) * stateSize);
+    }
+  }
+
+  for (size_t shardId = 0; shardId < shardCount; shardId++)
+    if (shardRows[shardId].empty() == false)
+      _stateShardConduit->writeShard(shardId, shardRows[shardId], shardStates[shardId].data());
 }
 
 void Agent::attendAgent(size_t agentId)
@@ -332,19 +762,49 @@ void Agent::attendAgent(size_t agentId)
   // Storage for the incoming message
   knlohmann::json message;
 
-  // Retrieving the experience, if any has arrived for the current agent.
-  if (_agents[agentId].retrievePendingMessage(message))
+  // Retrieving all the messages that have arrived for the current agent
+  while (_isAgentRunning[agentId] && _agents[agentId].retrievePendingMessage(message))
   {
-    // If agent requested new policy, send the new hyperparameters
+    // If agent requested new policy, send the new hyperparameters, unless the agent already has them
     if (message["Action"] == "Request New Policy")
-      KORALI_SEND_MSG_TO_SAMPLE(_agents[agentId], _trainingCurrentPolicy);
+    {
+      knlohmann::json policyMessage;
+      if (message["Policy Version"] == _trainingCurrentPolicyVersion)
+        policyMessage["Version"] = _trainingCurrentPolicyVersion;
+      else
+        policyMessage = getTrainingPolicyMessage();
+      if (_stateShardConduit != nullptr) policyMessage["State Shards"]["Released Counts"] = _stateShardReleasedCounts;
+      KORALI_SEND_MSG_TO_SAMPLE(_agents[agentId], policyMessage);
+    }
+
+    // Stage the experiences of the episodes in progress. They count towards the next policy update already.
+    if (message["Action"] == "Send Experiences")
+    {
+      for (size_t i = 0; i < _problem->_agentsPerEnvironment; i++)
+      {
+        appendExperienceChunk(_pendingEpisodes[agentId][i], message["Episodes"][i]);
+        _receivedExperienceCount += message["Episodes"][i]["Experience Count"].get<size_t>();
+      }
+      notifyLearner();
+    }
 
     // Process episode(s) incoming from the agent(s)
     if (message["Action"] == "Send Episodes")
     {
-      // Process every episode received and its experiences (add them to replay memory)
+      // Stage the last chunk of every episode
       for (size_t i = 0; i < _problem->_agentsPerEnvironment; i++)
-        processEpisode(message["Episodes"][i]);
+      {
+        appendExperienceChunk(_pendingEpisodes[agentId][i], message["Episodes"][i]);
+        _receivedExperienceCount += message["Episodes"][i]["Experience Count"].get<size_t>();
+      }
+
+      // Process every episode received and its experiences (add them to replay memory)
+      {
+        std::lock_guard<std::mutex> lock(_learnerMutex);
+        for (size_t i = 0; i < _problem->_agentsPerEnvironment; i++)
+          processEpisode(_pendingEpisodes[agentId][i]);
+      }
+      notifyLearner();
 
       // Waiting for the agent to come back with all the information
       KORALI_WAIT(_agents[agentId]);
@@ -354,9 +814,12 @@ void Agent::attendAgent(size_t agentId)
       {
         float cumulativeAgentReward = _agents[agentId]["Training Rewards"][i].get<float>();
         _trainingRewardHistory.push_back(cumulativeAgentReward);
-        _trainingEnvironmentIdHistory.push_back(message["Episodes"][i]["Environment Id"].get<size_t>());
-        _trainingExperienceHistory.push_back(message["Episodes"][i]["Experiences"].size());
+        _trainingEnvironmentIdHistory.push_back(_pendingEpisodes[agentId][i].environmentId);
+        _trainingExperienceHistory.push_back(_pendingEpisodes[agentId][i].experienceCount);
         _trainingLastReward = cumulativeAgentReward;
+
+        // Releasing the staged episode for the next one
+        _pendingEpisodes[agentId][i] = episode_t();
       }
 
       // Obtaining profiling information
@@ -377,7 +840,137 @@ void Agent::attendAgent(size_t agentId)
   _generationAgentAttendingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count(); // Profiling
 }
 
+void Agent::appendExperienceChunk(episode_t &episode, const knlohmann::json &chunk)
+{
+  // Getting the number of experiences in the chunk
+  const size_t count = chunk.at("Experience Count").get<size_t>();
+
+  // Appends a column of the chunk, checking it has one row per experience. Optional columns may be empty.
+  auto appendColumn = [&](auto &column, const knlohmann::json &values, const size_t rowSize, const char *name, const bool isRequired) {
+    using value_t = typename std::remove_reference_t<decltype(column)>::value_type;
+    const size_t valueCount = values.is_array() ? values.size() : 0;
+
+    if (valueCount == count * rowSize)
+    {
+      for (const auto &v : values) column.push_back(v.get<value_t>());
+      return;
+    }
+
+    if (valueCount == 0 && isRequired == false)
+    {
+      column.resize(column.size() + count * rowSize, value_t(0));
+      return;
+    }
+
+    KORALI_LOG_ERROR("Received %lu values for '%s' in a chunk of %lu experiences, expected %lu per experience.\n", valueCount, name, count, rowSize);
+  };
+
+  // Missing columns are treated as empty
+  const knlohmann::json emptyColumn = knlohmann::json::array();
+  auto getColumn = [&](const knlohmann::json &parent, const char *name) -> const knlohmann::json & {
+    const auto it = parent.find(name);
+    return it == parent.end() ? emptyColumn : *it;
+  };
+
+  // Termination status of the last experience in the chunk, only the last chunk of an episode may be terminal
+  termination_t termination = e_nonTerminal;
+  const auto terminationStatus = chunk.at("Termination").get<std::string>();
+  if (terminationStatus == "Non Terminal") termination = e_nonTerminal;
+  else if (terminationStatus == "Terminal") termination = e_terminal;
+  else if (terminationStatus == "Truncated") termination = e_truncated;
+  else KORALI_LOG_ERROR("Unrecognized termination status: '%s'.\n", terminationStatus.c_str());
+
+  if (termination == e_truncated && getColumn(chunk, "Truncated State").size() != _problem->_stateVectorSize)
+    KORALI_LOG_ERROR("Received a truncated state of size %lu, but the problem defines %lu state variables.\n", getColumn(chunk, "Truncated State").size(), _problem->_stateVectorSize);
+
+  if (count > 0 && isDefined(chunk, "Policy", "State Values") == false)
+    KORALI_LOG_ERROR("Policy has not produced state value for the current experience.\n");
+
+  // With a sharded replay, the states may have been written to the shard of the environment's worker instead
+  const auto &policy = getColumn(chunk, "Policy");
+  const auto stateShard = chunk.find("State Shard");
+  if (stateShard == chunk.end())
+  {
+    appendColumn(episode.states, getColumn(chunk, "States"), _problem->_stateVectorSize, "States", true);
+    if (_experienceReplayShardingEnabled == true) episode.stateShardIds.resize(episode.stateShardIds.size() + count, -1);
+    if (_experienceReplayShardingEnabled == true) episode.stateShardIndexes.resize(episode.stateShardIndexes.size() + count, 0);
+  }
+  else
+  {
+    if (_experienceReplayShardingEnabled == false) KORALI_LOG_ERROR("Received states stored in a shard, but the experience replay is not sharded.\n");
+    const int shardId = stateShard->at("Id").get<int>();
+    const size_t firstIndex = stateShard->at("First Index").get<size_t>();
+    if (shardId < 0 || (size_t)shardId >= _stateShardReleasedCounts.size()) KORALI_LOG_ERROR("Received states stored in shard %d, but there are %lu shards.\n", shardId, _stateShardReleasedCounts.size());
+    for (size_t i = 0; i < count; i++) episode.stateShardIds.push_back(shardId);
+    for (size_t i = 0; i < count; i++) episode.stateShardIndexes.push_back(firstIndex + i);
+  }
+  appendColumn(episode.actions, getColumn(chunk, "Actions"), _problem->_actionVectorSize, "Actions", true);
+  appendColumn(episode.rewards, getColumn(chunk, "Rewards"), 1, "Rewards", true);
+  appendColumn(episode.stateValues, getColumn(policy, "State Values"), 1, "State Values", true);
+  appendColumn(episode.distributionParameters, getColumn(policy, "Distribution Parameters"), _expPolicyParameterVector.stride(), "Distribution Parameters", false);
+  appendColumn(episode.actionProbabilities, getColumn(policy, "Action Probabilities"), _expPolicyActionProbabilityVector.stride(), "Action Probabilities", false);
+  appendColumn(episode.actionIndexes, getColumn(policy, "Action Indexes"), 1, "Action Indexes", false);
+  appendColumn(episode.unboundedActions, getColumn(policy, "Unbounded Actions"), _expPolicyUnboundedActionVector.stride(), "Unbounded Actions", false);
+
+  episode.environmentId = chunk.at("Environment Id").get<size_t>();
+  episode.experienceCount += count;
+  episode.termination = termination;
+  if (termination == e_truncated) episode.truncatedState = getColumn(chunk, "Truncated State").get<std::vector<float>>();
+}
+
 void Agent::processEpisode(knlohmann::json &episode)
+{
+  // Converting the per-experience episode format into a single chunk
+  const size_t curExperienceCount = episode["Experiences"].size();
+  const auto &experiences = episode["Experiences"];
+
+  knlohmann::json chunk;
+  chunk["Environment Id"] = episode["Environment Id"];
+  chunk["Experience Count"] = curExperienceCount;
+  chunk["Termination"] = "Non Terminal";
+
+  for (size_t expId = 0; expId < curExperienceCount; expId++)
+  {
+    const auto state = experiences[expId]["State"].get<std::vector<float>>();
+    if (state.size() != _problem->_stateVectorSize)
+      KORALI_LOG_ERROR("Experience %lu has a state of size %lu, but the problem defines %lu state variables.\n", expId, state.size(), _problem->_stateVectorSize);
+    for (const auto s : state) chunk["States"].push_back(s);
+
+    const auto action = experiences[expId]["Action"].get<std::vector<float>>();
+    if (action.size() != _problem->_actionVectorSize)
+      KORALI_LOG_ERROR("Experience %lu has an action of size %lu, but the problem defines %lu action variables.\n", expId, action.size(), _problem->_actionVectorSize);
+    for (const auto a : action) chunk["Actions"].push_back(a);
+
+    chunk["Rewards"].push_back(experiences[expId]["Reward"]);
+
+    if (isDefined(experiences[expId], "Policy", "State Value") == false)
+      KORALI_LOG_ERROR("Policy has not produced state value for the current experience.\n");
+    chunk["Policy"]["State Values"].push_back(experiences[expId]["Policy"]["State Value"]);
+
+    if (isDefined(experiences[expId], "Policy", "Distribution Parameters"))
+      for (const auto &p : experiences[expId]["Policy"]["Distribution Parameters"]) chunk["Policy"]["Distribution Parameters"].push_back(p);
+
+    if (isDefined(experiences[expId], "Policy", "Action Probabilities"))
+      for (const auto &p : experiences[expId]["Policy"]["Action Probabilities"]) chunk["Policy"]["Action Probabilities"].push_back(p);
+
+    if (isDefined(experiences[expId], "Policy", "Action Index"))
+      chunk["Policy"]["Action Indexes"].push_back(experiences[expId]["Policy"]["Action Index"]);
+
+    if (isDefined(experiences[expId], "Policy", "Unbounded Action"))
+      for (const auto &u : experiences[expId]["Policy"]["Unbounded Action"]) chunk["Policy"]["Unbounded Actions"].push_back(u);
+
+    if (isDefined(experiences[expId], "Termination")) chunk["Termination"] = experiences[expId]["Termination"];
+    if (isDefined(experiences[expId], "Truncated State")) chunk["Truncated State"] = experiences[expId]["Truncated State"];
+  }
+
+  episode_t stagedEpisode;
+  appendExperienceChunk(stagedEpisode, chunk);
+  processEpisode(stagedEpisode);
+
+  _sessionExperienceCount += curExperienceCount;
+}
+
+void Agent::processEpisode(episode_t &episode)
 {
   /*********************************************************************
    * Adding episode's experiences into the replay memory
@@ -387,25 +980,36 @@ void Agent::processEpisode(knlohmann::json &episode)
   size_t episodeId = _currentEpisode;
 
   // Getting experience count from the episode
-  size_t curExperienceCount = episode["Experiences"].size();
+  const size_t curExperienceCount = episode.experienceCount;
 
   // Getting environment id
-  auto environmentId = episode["Environment Id"].get<size_t>();
+  const size_t environmentId = episode.environmentId;
+
+  // Row sizes of the staged columns
+  const size_t stateSize = _problem->_stateVectorSize;
+  const size_t actionSize = _problem->_actionVectorSize;
+  const size_t parameterSize = _expPolicyParameterVector.stride();
+  const size_t probabilitySize = _expPolicyActionProbabilityVector.stride();
+  const size_t unboundedSize = _expPolicyUnboundedActionVector.stride();
 
   // Storage for the episode's cumulative reward
   float cumulativeReward = 0.0f;
 
+  // With a sharded replay, position of the next state sent along with the episode
+  size_t localStateId = 0;
+
   for (size_t expId = 0; expId < curExperienceCount; expId++)
   {
     // Getting state
-    _stateVector.add(episode["Experiences"][expId]["State"].get<std::vector<float>>());
+    if (_experienceReplayShardingEnabled == false) _stateVector.add(episode.states.data() + expId * stateSize);
+    if (_experienceReplayShardingEnabled == true) addShardedState(episode, expId, localStateId);
 
     // Getting action
-    const auto action = episode["Experiences"][expId]["Action"].get<std::vector<float>>();
+    const float *action = episode.actions.data() + expId * actionSize;
     _actionVector.add(action);
 
     // Getting reward
-    float reward = episode["Experiences"][expId]["Reward"].get<float>();
+    float reward = episode.rewards[expId];
 
     // If the action is outside the boundary, applying penalization factor
     if (_rewardOutboundPenalizationEnabled == true)
@@ -452,49 +1056,27 @@ void Agent::processEpisode(knlohmann::json &episode)
     // Keeping global statistics on reward
     cumulativeReward += reward;
 
-    // Checking experience termination status and truncated state
-    termination_t termination;
-    std::vector<float> truncatedState;
-
-    if (episode["Experiences"][expId]["Termination"] == "Non Terminal") termination = e_nonTerminal;
-    if (episode["Experiences"][expId]["Termination"] == "Terminal") termination = e_terminal;
-    if (episode["Experiences"][expId]["Termination"] == "Truncated")
-    {
-      termination = e_truncated;
-      truncatedState = episode["Experiences"][expId]["Truncated State"].get<std::vector<float>>();
-    }
-
+    // Only the last experience of the episode carries its termination status and truncated state
+    const bool isLastExperience = expId == curExperienceCount - 1;
+    const termination_t termination = isLastExperience ? episode.termination : e_nonTerminal;
     _terminationVector.add(termination);
-    _truncatedStateVector.add(truncatedState);
-
-    // Getting policy information and state value
-    policy_t expPolicy;
-    float stateValue;
-
-    if (isDefined(episode["Experiences"][expId], "Policy", "State Value"))
-    {
-      expPolicy.stateValue = episode["Experiences"][expId]["Policy"]["State Value"].get<float>();
-      stateValue = episode["Experiences"][expId]["Policy"]["State Value"].get<float>();
-    }
-    else
-    {
-      KORALI_LOG_ERROR("Policy has not produced state value for the current experience.\n");
-    }
-
-    if (isDefined(episode["Experiences"][expId], "Policy", "Distribution Parameters"))
-      expPolicy.distributionParameters = episode["Experiences"][expId]["Policy"]["Distribution Parameters"].get<std::vector<float>>();
-
-    if (isDefined(episode["Experiences"][expId], "Policy", "Action Probabilities"))
-      expPolicy.actionProbabilities = episode["Experiences"][expId]["Policy"]["Action Probabilities"].get<std::vector<float>>();
-    if (isDefined(episode["Experiences"][expId], "Policy", "Action Index"))
-      expPolicy.actionIndex = episode["Experiences"][expId]["Policy"]["Action Index"].get<size_t>();
-
-    if (isDefined(episode["Experiences"][expId], "Policy", "Unbounded Action"))
-      expPolicy.unboundedAction = episode["Experiences"][expId]["Policy"]["Unbounded Action"].get<std::vector<float>>();
-
-    // Storing policy information
-    _expPolicyVector.add(expPolicy);
-    _curPolicyVector.add(expPolicy);
+    _truncatedStateVector.add(termination == e_truncated ? episode.truncatedState : std::vector<float>());
+
+    // Storing policy information, the current policy is the one that produced the experience
+    const float stateValue = episode.stateValues[expId];
+    const float *distributionParameters = episode.distributionParameters.data() + expId * parameterSize;
+    const float *actionProbabilities = episode.actionProbabilities.data() + expId * probabilitySize;
+    const float *unboundedAction = episode.unboundedActions.data() + expId * unboundedSize;
+    const size_t actionIndex = episode.actionIndexes[expId];
+
+    _expPolicyStateValueVector.add(stateValue);
+    _expPolicyParameterVector.add(distributionParameters);
+    _expPolicyActionProbabilityVector.add(actionProbabilities);
+    _expPolicyActionIndexVector.add(actionIndex);
+    _expPolicyUnboundedActionVector.add(unboundedAction);
+    _curPolicyParameterVector.add(distributionParameters);
+    _curPolicyActionProbabilityVector.add(actionProbabilities);
+    _curPolicyUnboundedActionVector.add(unboundedAction);
     _stateValueVector.add(stateValue);
 
     // Storing Episode information
@@ -515,8 +1097,14 @@ void Agent::processEpisode(knlohmann::json &episode)
     // Updating experience's importance weight. Initially assumed to be 1.0 because its freshly produced
     _importanceWeightVector.add(1.0f);
     _truncatedImportanceWeightVector.add(1.0f);
+
+    // New experiences get the maximum priority, so that they are replayed at least once
+    _priorityTree.add(_experienceReplayPriorityMax);
   }
 
+  // Nothing else to do for an empty episode
+  if (curExperienceCount == 0) return;
+
   /*********************************************************************
    * Computing initial retrace value for the newly added experiences
    *********************************************************************/
@@ -525,10 +1113,10 @@ void Agent::processEpisode(knlohmann::json &episode)
   float retV = 0.0f;
 
   // Getting position of the final experience of the episode in the replay memory
-  ssize_t endId = (ssize_t)_stateVector.size() - 1;
+  ssize_t endId = (ssize_t)_rewardVector.size() - 1;
 
   // Getting the starting ID of the initial experience of the episode in the replay memory
-  ssize_t startId = endId - (ssize_t)episode.size() + 1;
+  ssize_t startId = std::max(endId - (ssize_t)curExperienceCount + 1, (ssize_t)0);
 
   // If it was a truncated episode, add the value function for the terminal state to retV
   if (_terminationVector[endId] == e_truncated)
@@ -537,7 +1125,7 @@ void Agent::processEpisode(knlohmann::json &episode)
     auto expTruncatedStateSequence = getTruncatedStateSequence(endId);
 
     // Calculating the state value function of the truncated state
-    auto truncatedPolicy = runPolicy({expTruncatedStateSequence})[0];
+    auto truncatedPolicy = runInferencePolicy({expTruncatedStateSequence})[0];
     float truncatedV = truncatedPolicy.stateValue;
 
     // Sanity checks for truncated state value
@@ -570,9 +1158,8 @@ void Agent::processEpisode(knlohmann::json &episode)
   _sessionEpisodeCount++;
   _currentEpisode++;
 
-  // Increasing total experience counters
+  // Increasing total experience counter. The session counter was increased as the experiences arrived.
   _experienceCount += curExperienceCount;
-  _sessionExperienceCount += curExperienceCount;
 }
 
 std::vector<size_t> Agent::generateMiniBatch(size_t miniBatchSize)
@@ -580,13 +1167,44 @@ std::vector<size_t> Agent::generateMiniBatch(size_t miniBatchSize)
   // Allocating storage for mini batch experiecne indexes
   std::vector<size_t> miniBatch(miniBatchSize);
 
+  // Prioritized replay: stratified sampling of the priorities, one experience per segment of the sum tree
+  if (_miniBatchStrategy == "Prioritized" && _priorityTree.getTotal() > 0.0)
+  {
+    const double totalPriority = _priorityTree.getTotal();
+    const double segment = totalPriority / (double)miniBatchSize;
+
+    for (size_t i = 0; i < miniBatchSize; i++)
+    {
+      const double x = ((double)i + _uniformGenerator->getRandomNumber()) * segment;
+      miniBatch[i] = _priorityTree.sample(x);
+    }
+
+    std::sort(miniBatch.begin(), miniBatch.end());
+
+    // Importance sampling correction w = (N * P(i))^-beta, normalized by its maximum within the mini batch
+    const float beta = std::min(1.0f, _experienceReplayPriorityImportanceWeightExponent + _experienceReplayPriorityImportanceWeightAnnealingRate * (float)_policyUpdateCount);
+    const double memorySize = (double)_priorityTree.size();
+
+    _miniBatchSamplingWeights.resize(miniBatchSize);
+    float maxWeight = 0.0f;
+    for (size_t i = 0; i < miniBatchSize; i++)
+    {
+      const double probability = std::max((double)_priorityTree[miniBatch[i]], 1e-12) / totalPriority;
+      _miniBatchSamplingWeights[i] = (float)std::pow(memorySize * probability, -(double)beta);
+      maxWeight = std::max(maxWeight, _miniBatchSamplingWeights[i]);
+    }
+    for (size_t i = 0; i < miniBatchSize; i++) _miniBatchSamplingWeights[i] /= maxWeight;
+
+    return miniBatch;
+  }
+
   for (size_t i = 0; i < miniBatchSize; i++)
   {
     // Producing random (uniform) number for the selection of the experience
     float x = _uniformGenerator->getRandomNumber();
 
     // Selecting experience
-    size_t expId = std::floor(x * (float)(_stateVector.size() - 1));
+    size_t expId = std::floor(x * (float)(_rewardVector.size() - 1));
 
     // Setting experience
     miniBatch[i] = expId;
@@ -596,6 +1214,9 @@ std::vector<size_t> Agent::generateMiniBatch(size_t miniBatchSize)
   // to quickly detect duplicates when updating metadata
   std::sort(miniBatch.begin(), miniBatch.end());
 
+  // Uniform sampling needs no correction
+  _miniBatchSamplingWeights.assign(miniBatchSize, 1.0f);
+
   // Returning generated minibatch
   return miniBatch;
 }
@@ -622,8 +1243,8 @@ void Agent::updateExperienceMetadata(const std::vector<size_t> &miniBatch, const
     auto expId = miniBatch[batchId];
 
     // Get state, action, mean, Sigma for this experience
-    const auto &expAction = _actionVector[expId];
-    const auto &expPolicy = _expPolicyVector[expId];
+    const auto expAction = _actionVector.getVector(expId);
+    const auto expPolicy = getExperiencePolicy(expId);
     const auto &curPolicy = policyData[batchId];
 
     // Grabbing state value from the latest policy
@@ -652,7 +1273,7 @@ void Agent::updateExperienceMetadata(const std::vector<size_t> &miniBatch, const
       offPolicyCountDelta--;
 
     // Store computed information for use in replay memory.
-    _curPolicyVector[expId] = curPolicy;
+    setCurrentPolicy(expId, curPolicy);
     _stateValueVector[expId] = stateValue;
     _truncatedStateValueVector[expId] = 0.0f;
     _importanceWeightVector[expId] = importanceWeight;
@@ -660,19 +1281,26 @@ void Agent::updateExperienceMetadata(const std::vector<size_t> &miniBatch, const
     _truncatedImportanceWeightVector[expId] = truncatedImportanceWeight;
   }
 
-  // Calculating updated truncated policy state values
+  // Calculating updated truncated policy state values, evaluating all truncated states together
+  std::vector<size_t> truncatedExpIds;
+  std::vector<std::vector<std::vector<float>>> truncatedStateSequences;
   for (size_t i = 0; i < updateBatch.size(); i++)
   {
     auto batchId = updateBatch[i];
     auto expId = miniBatch[batchId];
     if (_terminationVector[expId] == e_truncated)
     {
-      auto truncatedState = getTruncatedStateSequence(expId);
-      auto truncatedPolicy = runPolicy({getTruncatedStateSequence(expId)})[0];
-      _truncatedStateValueVector[expId] = truncatedPolicy.stateValue;
+      truncatedExpIds.push_back(expId);
+      truncatedStateSequences.push_back(getTruncatedStateSequence(expId));
     }
   }
 
+  if (truncatedExpIds.empty() == false)
+  {
+    const auto truncatedPolicies = runInferencePolicy(truncatedStateSequences);
+    for (size_t i = 0; i < truncatedExpIds.size(); i++) _truncatedStateValueVector[truncatedExpIds[i]] = truncatedPolicies[i].stateValue;
+  }
+
   // Updating the off policy count and ratio
   _experienceReplayOffPolicyCount += offPolicyCountDelta;
   _experienceReplayOffPolicyRatio = (float)_experienceReplayOffPolicyCount / (float)_isOnPolicyVector.size();
@@ -680,28 +1308,37 @@ void Agent::updateExperienceMetadata(const std::vector<size_t> &miniBatch, const
   // Updating the off policy cutoff
   _experienceReplayOffPolicyCurrentCutoff = _experienceReplayOffPolicyCutoffScale / (1.0f + _experienceReplayOffPolicyAnnealingRate * (float)_policyUpdateCount);
 
-  // Now filtering experiences from the same episode
-  std::vector<size_t> retraceMiniBatch;
+  // Now finding the range of updated experiences in every episode of the (sorted) minibatch.
+  // Pairs of first and last updated experience, filled from the newest episode to the oldest.
+  std::vector<std::pair<size_t, size_t>> retraceRanges;
 
   // Adding last experience from the sorted minibatch
-  retraceMiniBatch.push_back(miniBatch[miniBatchSize - 1]);
+  retraceRanges.push_back({miniBatch[miniBatchSize - 1], miniBatch[miniBatchSize - 1]});
 
-  // Adding experiences so long as they do not repeat episodes
+  // Adding experiences so long as they do not repeat episodes, otherwise extending the range of the episode
   for (ssize_t i = miniBatchSize - 2; i >= 0; i--)
   {
     size_t currExpId = miniBatch[i];
     size_t nextExpId = miniBatch[i + 1];
     size_t curEpisode = _episodeIdVector[currExpId];
     size_t nextEpisode = _episodeIdVector[nextExpId];
-    if (curEpisode != nextEpisode) retraceMiniBatch.push_back(currExpId);
+    if (curEpisode != nextEpisode)
+      retraceRanges.push_back({currExpId, currExpId});
+    else
+      retraceRanges.back().first = currExpId;
   }
 
+  // Before the first updated experience of an episode only the following retrace value changes, so we can stop once a
+  // recomputed value is identical to the cached one. This does not hold if reward rescaling changes all rewards.
+  const bool isEarlyStopAllowed = _rewardRescalingEnabled == false;
+
 // Calculating retrace value for the oldest experiences of unique episodes
 #pragma omp parallel for schedule(guided, 1)
-  for (size_t i = 0; i < retraceMiniBatch.size(); i++)
+  for (size_t i = 0; i < retraceRanges.size(); i++)
   {
     // Finding the earliest experience corresponding to the same episode as this experience
-    ssize_t endId = retraceMiniBatch[i];
+    const ssize_t firstUpdatedId = retraceRanges[i].first;
+    ssize_t endId = retraceRanges[i].second;
     ssize_t startId = endId - _episodePosVector[endId];
 
     // If the starting experience has already been discarded, take the earliest one that still remains
@@ -732,10 +1369,24 @@ void Agent::updateExperienceMetadata(const std::vector<size_t> &miniBatch, const
       // Calculating retrace value
       retV = curV + truncatedImportanceWeight * (curReward + _discountFactor * retV - curV);
 
+      // The earlier experiences of the episode are up to date already
+      if (isEarlyStopAllowed && curId < firstUpdatedId && _retraceValueVector[curId] == retV) break;
+
       // Storing retrace value into the experience's cache
       _retraceValueVector[curId] = retV;
     }
   }
+
+  // Updating the priorities of the replayed experiences with their (new) absolute retrace error
+  if (_miniBatchStrategy == "Prioritized")
+    for (size_t i = 0; i < updateBatch.size(); i++)
+    {
+      auto expId = miniBatch[updateBatch[i]];
+      const float error = std::abs(_retraceValueVector[expId] - _stateValueVector[expId]);
+      const float priority = std::pow(error + 1e-6f, _experienceReplayPriorityExponent);
+      _priorityTree.update(expId, priority);
+      _experienceReplayPriorityMax = std::max(_experienceReplayPriorityMax, priority);
+    }
 }
 
 size_t Agent::getTimeSequenceStartExpId(size_t expId)
@@ -764,7 +1415,34 @@ size_t Agent::getTimeSequenceStartExpId(size_t expId)
 
 void Agent::resetTimeSequence()
 {
-  _stateTimeSequence.clear();
+  for (auto &sequence : _stateTimeSequence) sequence.clear();
+}
+
+std::vector<policy_t> Agent::runInferencePolicy(const std::vector<std::vector<std::vector<float>>> &stateBatch)
+{
+  // The inference network is configured with one state per agent in the environment
+  const size_t inferenceBatchSize = _problem->_agentsPerEnvironment;
+
+  // Common case: one state per agent in the environment
+  if (stateBatch.size() == inferenceBatchSize) return runPolicy(stateBatch);
+
+  // Storage for the policies
+  std::vector<policy_t> policyVector;
+  policyVector.reserve(stateBatch.size());
+
+  // Evaluating full batches, padding the last one with copies of its first entry
+  for (size_t start = 0; start < stateBatch.size(); start += inferenceBatchSize)
+  {
+    const size_t count = std::min(inferenceBatchSize, stateBatch.size() - start);
+
+    std::vector<std::vector<std::vector<float>>> batch(stateBatch.begin() + start, stateBatch.begin() + start + count);
+    batch.resize(inferenceBatchSize, stateBatch[start]);
+
+    const auto batchPolicies = runPolicy(batch);
+    policyVector.insert(policyVector.end(), batchPolicies.begin(), batchPolicies.begin() + count);
+  }
+
+  return policyVector;
 }
 
 std::vector<std::vector<std::vector<float>>> Agent::getMiniBatchStateSequence(const std::vector<size_t> &miniBatch, const bool includeAction)
@@ -778,6 +1456,28 @@ std::vector<std::vector<std::vector<float>>> Agent::getMiniBatchStateSequence(co
   // Calculating size of state vector
   const size_t stateSize = includeAction ? _problem->_stateVectorSize + _problem->_actionVectorSize : _problem->_stateVectorSize;
 
+  // Getting the starting expId of every sequence, and the position of its first state among the states of all sequences
+  std::vector<size_t> startIds(miniBatchSize);
+  std::vector<size_t> sequenceOffsets(miniBatchSize + 1, 0);
+  for (size_t b = 0; b < miniBatchSize; b++)
+  {
+    startIds[b] = getTimeSequenceStartExpId(miniBatch[b]);
+    sequenceOffsets[b + 1] = sequenceOffsets[b] + miniBatch[b] - startIds[b] + 1;
+  }
+
+  // With a sharded replay, the states of all sequences are fetched from the shards at once
+  std::vector<float> shardedStates;
+  if (_experienceReplayShardingEnabled == true)
+  {
+    std::vector<size_t> sequenceExpIds;
+    sequenceExpIds.reserve(sequenceOffsets[miniBatchSize]);
+    for (size_t b = 0; b < miniBatchSize; b++)
+      for (size_t curId = startIds[b]; curId <= miniBatch[b]; curId++) sequenceExpIds.push_back(curId);
+
+    shardedStates.resize(sequenceExpIds.size() * _problem->_stateVectorSize);
+    loadStates(sequenceExpIds, shardedStates.data());
+  }
+
 #pragma omp parallel for
   for (size_t b = 0; b < miniBatch.size(); b++)
   {
@@ -785,7 +1485,7 @@ std::vector<std::vector<std::vector<float>>> Agent::getMiniBatchStateSequence(co
     const size_t expId = miniBatch[b];
 
     // Getting starting expId
-    const size_t startId = getTimeSequenceStartExpId(expId);
+    const size_t startId = startIds[b];
 
     // Calculating time sequence length
     const size_t T = expId - startId + 1;
@@ -793,13 +1493,15 @@ std::vector<std::vector<std::vector<float>>> Agent::getMiniBatchStateSequence(co
     // Resizing state sequence vector to the correct time sequence length
     stateSequence[b].resize(T);
 
-    // Now adding states (and actions, if required)
+    // Now copying the rows of states (preceded by actions, if required)
     for (size_t t = 0; t < T; t++)
     {
       size_t curId = startId + t;
-      stateSequence[b][t].reserve(stateSize);
-      stateSequence[b][t].insert(stateSequence[b][t].begin(), _stateVector[curId].begin(), _stateVector[curId].end());
-      if (includeAction) stateSequence[b][t].insert(stateSequence[b][t].begin(), _actionVector[curId].begin(), _actionVector[curId].end());
+      stateSequence[b][t].resize(stateSize);
+      float *dst = stateSequence[b][t].data();
+      if (includeAction) dst = std::copy_n(_actionVector[curId], _problem->_actionVectorSize, dst);
+      if (_experienceReplayShardingEnabled == false) std::copy_n(_stateVector[curId], _problem->_stateVectorSize, dst);
+      if (_experienceReplayShardingEnabled == true) std::copy_n(shardedStates.data() + (sequenceOffsets[b] + t) * _problem->_stateVectorSize, _problem->_stateVectorSize, dst);
     }
   }
 
@@ -815,22 +1517,75 @@ std::vector<std::vector<float>> Agent::getTruncatedStateSequence(size_t expId)
   std::vector<std::vector<float>> timeSequence;
 
   // Now adding states, except for the initial one
-  for (size_t e = startId + 1; e <= expId; e++)
-    timeSequence.push_back(_stateVector[e]);
+  std::vector<size_t> sequenceExpIds;
+  for (size_t e = startId + 1; e <= expId; e++) sequenceExpIds.push_back(e);
+  std::vector<float> states(sequenceExpIds.size() * _problem->_stateVectorSize);
+  loadStates(sequenceExpIds, states.data());
+
+  for (size_t i = 0; i < sequenceExpIds.size(); i++)
+    timeSequence.emplace_back(states.begin() + i * _problem->_stateVectorSize, states.begin() + (i + 1) * _problem->_stateVectorSize);
 
   // Lastly, adding truncated state
-  timeSequence.push_back(_truncatedStateVector[expId]);
+  timeSequence.push_back(_truncatedStateVector.getVector(expId));
 
   return timeSequence;
 }
 
+policy_t Agent::getExperiencePolicy(size_t expId)
+{
+  policy_t policy;
+  policy.stateValue = _expPolicyStateValueVector[expId];
+  policy.distributionParameters = _expPolicyParameterVector.getVector(expId);
+  policy.actionProbabilities = _expPolicyActionProbabilityVector.getVector(expId);
+  policy.actionIndex = _expPolicyActionIndexVector[expId];
+  policy.unboundedAction = _expPolicyUnboundedActionVector.getVector(expId);
+  return policy;
+}
+
+policy_t Agent::getCurrentPolicy(size_t expId)
+{
+  policy_t policy;
+  policy.stateValue = _stateValueVector[expId];
+  policy.distributionParameters = _curPolicyParameterVector.getVector(expId);
+  policy.actionProbabilities = _curPolicyActionProbabilityVector.getVector(expId);
+  policy.actionIndex = _expPolicyActionIndexVector[expId];
+  policy.unboundedAction = _curPolicyUnboundedActionVector.getVector(expId);
+  return policy;
+}
+
+void Agent::addExperiencePolicy(const policy_t &policy)
+{
+  _expPolicyStateValueVector.add(policy.stateValue);
+  _expPolicyParameterVector.add(policy.distributionParameters);
+  _expPolicyActionProbabilityVector.add(policy.actionProbabilities);
+  _expPolicyActionIndexVector.add(policy.actionIndex);
+  _expPolicyUnboundedActionVector.add(policy.unboundedAction);
+}
+
+void Agent::addCurrentPolicy(const policy_t &policy)
+{
+  _curPolicyParameterVector.add(policy.distributionParameters);
+  _curPolicyActionProbabilityVector.add(policy.actionProbabilities);
+  _curPolicyUnboundedActionVector.add(policy.unboundedAction);
+}
+
+void Agent::setCurrentPolicy(size_t expId, const policy_t &policy)
+{
+  _curPolicyParameterVector.set(expId, policy.distributionParameters);
+  _curPolicyActionProbabilityVector.set(expId, policy.actionProbabilities);
+  _curPolicyUnboundedActionVector.set(expId, policy.unboundedAction);
+}
+
 void Agent::finalize()
 {
   if (_mode != "Training") return;
 
   if (_experienceReplaySerialize == true)
     if (_k->_fileOutputEnabled)
+    {
       serializeExperienceReplay();
+      waitForExperienceReplaySerialization();
+    }
 
   _k->_logger->logInfo("Normal", "Waiting for pending agents to finish...\n");
 
@@ -848,10 +1603,23 @@ void Agent::finalize()
 
     if (agentsRemain) KORALI_LISTEN(_agents);
   } while (agentsRemain == true);
+
+  // The workers are idle now, and can free their shards
+  if (_stateShardConduit != nullptr)
+  {
+    _stateShardConduit->freeShards();
+    _stateShardConduit = nullptr;
+  }
 }
 
 void Agent::serializeExperienceReplay()
 {
+  if (_experienceReplaySerializationFormat == "Binary")
+  {
+    serializeExperienceReplayBinary();
+    return;
+  }
+
   _k->_logger->logInfo("Detailed", "Serializing Agent's Training State...\n");
   auto beginTime = std::chrono::steady_clock::now(); // Profiling
 
@@ -863,8 +1631,8 @@ void Agent::serializeExperienceReplay()
   {
     stateJson["Experience Replay"][i]["Episode Id"] = _episodeIdVector[i];
     stateJson["Experience Replay"][i]["Episode Pos"] = _episodePosVector[i];
-    stateJson["Experience Replay"][i]["State"] = _stateVector[i];
-    stateJson["Experience Replay"][i]["Action"] = _actionVector[i];
+    stateJson["Experience Replay"][i]["State"] = _stateVector.getVector(i);
+    stateJson["Experience Replay"][i]["Action"] = _actionVector.getVector(i);
     stateJson["Experience Replay"][i]["Reward"] = _rewardVector[i];
     stateJson["Experience Replay"][i]["Environment Id"] = _environmentIdVector[i];
     stateJson["Experience Replay"][i]["State Value"] = _stateValueVector[i];
@@ -872,21 +1640,24 @@ void Agent::serializeExperienceReplay()
     stateJson["Experience Replay"][i]["Importance Weight"] = _importanceWeightVector[i];
     stateJson["Experience Replay"][i]["Truncated Importance Weight"] = _truncatedImportanceWeightVector[i];
     stateJson["Experience Replay"][i]["Is On Policy"] = _isOnPolicyVector[i];
-    stateJson["Experience Replay"][i]["Truncated State"] = _truncatedStateVector[i];
+    stateJson["Experience Replay"][i]["Truncated State"] = _terminationVector[i] == e_truncated ? _truncatedStateVector.getVector(i) : std::vector<float>();
     stateJson["Experience Replay"][i]["Truncated State Value"] = _truncatedStateValueVector[i];
     stateJson["Experience Replay"][i]["Termination"] = _terminationVector[i];
-
-    stateJson["Experience Replay"][i]["Experience Policy"]["State Value"] = _expPolicyVector[i].stateValue;
-    stateJson["Experience Replay"][i]["Experience Policy"]["Distribution Parameters"] = _expPolicyVector[i].distributionParameters;
-    stateJson["Experience Replay"][i]["Experience Policy"]["Unbounded Action"] = _expPolicyVector[i].unboundedAction;
-    stateJson["Experience Replay"][i]["Experience Policy"]["Action Index"] = _expPolicyVector[i].actionIndex;
-    stateJson["Experience Replay"][i]["Experience Policy"]["Action Probabilities"] = _expPolicyVector[i].actionProbabilities;
-
-    stateJson["Experience Replay"][i]["Current Policy"]["State Value"] = _curPolicyVector[i].stateValue;
-    stateJson["Experience Replay"][i]["Current Policy"]["Distribution Parameters"] = _curPolicyVector[i].distributionParameters;
-    stateJson["Experience Replay"][i]["Current Policy"]["Unbounded Action"] = _curPolicyVector[i].unboundedAction;
-    stateJson["Experience Replay"][i]["Current Policy"]["Action Index"] = _curPolicyVector[i].actionIndex;
-    stateJson["Experience Replay"][i]["Current Policy"]["Action Probabilities"] = _curPolicyVector[i].actionProbabilities;
+    stateJson["Experience Replay"][i]["Priority"] = _priorityTree[i];
+
+    const auto expPolicy = getExperiencePolicy(i);
+    stateJson["Experience Replay"][i]["Experience Policy"]["State Value"] = expPolicy.stateValue;
+    stateJson["Experience Replay"][i]["Experience Policy"]["Distribution Parameters"] = expPolicy.distributionParameters;
+    stateJson["Experience Replay"][i]["Experience Policy"]["Unbounded Action"] = expPolicy.unboundedAction;
+    stateJson["Experience Replay"][i]["Experience Policy"]["Action Index"] = expPolicy.actionIndex;
+    stateJson["Experience Replay"][i]["Experience Policy"]["Action Probabilities"] = expPolicy.actionProbabilities;
+
+    const auto curPolicy = getCurrentPolicy(i);
+    stateJson["Experience Replay"][i]["Current Policy"]["State Value"] = curPolicy.stateValue;
+    stateJson["Experience Replay"][i]["Current Policy"]["Distribution Parameters"] = curPolicy.distributionParameters;
+    stateJson["Experience Replay"][i]["Current Policy"]["Unbounded Action"] = curPolicy.unboundedAction;
+    stateJson["Experience Replay"][i]["Current Policy"]["Action Index"] = curPolicy.actionIndex;
+    stateJson["Experience Replay"][i]["Current Policy"]["Action Probabilities"] = curPolicy.actionProbabilities;
   }
 
   // If results directory doesn't exist, create it
@@ -911,6 +1682,14 @@ void Agent::deserializeExperienceReplay()
   // Creating JSON storage variable
   knlohmann::json stateJson;
 
+  // Runs that predate the binary format only have the JSON state
+  if (_experienceReplaySerializationFormat == "Binary")
+    if (fileExists(_k->_fileOutputPath + "/replay.meta.bin"))
+    {
+      deserializeExperienceReplayBinary();
+      return;
+    }
+
   // Resolving file path
   std::string statePath = _k->_fileOutputPath + "/state.json";
 
@@ -920,24 +1699,7 @@ void Agent::deserializeExperienceReplay()
     KORALI_LOG_ERROR("Trying to resume training or test policy but could not find or deserialize agent's state from from file %s...\n", statePath.c_str());
 
   // Clearing existing database
-  _stateVector.clear();
-  _actionVector.clear();
-  _retraceValueVector.clear();
-  _rewardVector.clear();
-  _environmentIdVector.clear();
-  _stateValueVector.clear();
-  _importanceWeightVector.clear();
-  _truncatedImportanceWeightVector.clear();
-  _truncatedStateValueVector.clear();
-  _truncatedStateVector.clear();
-  _terminationVector.clear();
-  _expPolicyVector.clear();
-  _curPolicyVector.clear();
-  _isOnPolicyVector.clear();
-  _priorityVector.clear();
-  _probabilityVector.clear();
-  _episodePosVector.clear();
-  _episodeIdVector.clear();
+  clearExperienceReplay();
 
   // Deserializing database from JSON to the agent's state
   for (size_t i = 0; i < stateJson["Experience Replay"].size(); i++)
@@ -957,21 +1719,26 @@ void Agent::deserializeExperienceReplay()
     _truncatedStateValueVector.add(stateJson["Experience Replay"][i]["Truncated State Value"].get<float>());
     _terminationVector.add(stateJson["Experience Replay"][i]["Termination"].get<termination_t>());
 
+    // States written before prioritized replay existed carry no priority
+    if (isDefined(stateJson["Experience Replay"][i], "Priority"))
+      _priorityTree.add(stateJson["Experience Replay"][i]["Priority"].get<float>());
+    else
+      _priorityTree.add(_experienceReplayPriorityMax);
+
     policy_t expPolicy;
     expPolicy.stateValue = stateJson["Experience Replay"][i]["Experience Policy"]["State Value"].get<float>();
     expPolicy.distributionParameters = stateJson["Experience Replay"][i]["Experience Policy"]["Distribution Parameters"].get<std::vector<float>>();
     expPolicy.actionProbabilities = stateJson["Experience Replay"][i]["Experience Policy"]["Action Probabilities"].get<std::vector<float>>();
     expPolicy.unboundedAction = stateJson["Experience Replay"][i]["Experience Policy"]["Unbounded Action"].get<std::vector<float>>();
     expPolicy.actionIndex = stateJson["Experience Replay"][i]["Experience Policy"]["Action Index"].get<size_t>();
-    _expPolicyVector.add(expPolicy);
+    addExperiencePolicy(expPolicy);
 
+    // The state value of the current policy is the one stored in the experience's state value
     policy_t curPolicy;
-    curPolicy.stateValue = stateJson["Experience Replay"][i]["Current Policy"]["State Value"].get<float>();
     curPolicy.distributionParameters = stateJson["Experience Replay"][i]["Current Policy"]["Distribution Parameters"].get<std::vector<float>>();
     curPolicy.actionProbabilities = stateJson["Experience Replay"][i]["Current Policy"]["Action Probabilities"].get<std::vector<float>>();
-    curPolicy.actionIndex = stateJson["Experience Replay"][i]["Current Policy"]["Action Index"].get<size_t>();
     curPolicy.unboundedAction = stateJson["Experience Replay"][i]["Current Policy"]["Unbounded Action"].get<std::vector<float>>();
-    _curPolicyVector.add(curPolicy);
+    addCurrentPolicy(curPolicy);
   }
 
   auto endTime = std::chrono::steady_clock::now();                                                                         // Profiling
@@ -979,6 +1746,253 @@ void Agent::deserializeExperienceReplay()
   _k->_logger->logInfo("Detailed", "Took %fs to deserialize training state.\n", deserializationTime);
 }
 
+void Agent::clearExperienceReplay()
+{
+  _stateVector.clear();
+  _actionVector.clear();
+  _retraceValueVector.clear();
+  _rewardVector.clear();
+  _environmentIdVector.clear();
+  _stateValueVector.clear();
+  _importanceWeightVector.clear();
+  _truncatedImportanceWeightVector.clear();
+  _truncatedStateValueVector.clear();
+  _truncatedStateVector.clear();
+  _terminationVector.clear();
+  _expPolicyStateValueVector.clear();
+  _expPolicyParameterVector.clear();
+  _expPolicyActionProbabilityVector.clear();
+  _expPolicyActionIndexVector.clear();
+  _expPolicyUnboundedActionVector.clear();
+  _curPolicyParameterVector.clear();
+  _curPolicyActionProbabilityVector.clear();
+  _curPolicyUnboundedActionVector.clear();
+  _isOnPolicyVector.clear();
+  _priorityTree.clear();
+  _episodePosVector.clear();
+  _episodeIdVector.clear();
+}
+
+void Agent::serializeExperienceReplayBinary()
+{
+  _k->_logger->logInfo("Detailed", "Serializing Agent's Training State (binary)...\n");
+  auto beginTime = std::chrono::steady_clock::now(); // Profiling
+
+  // Only one snapshot is written at a time
+  waitForExperienceReplaySerialization();
+
+  // If results directory doesn't exist, create it
+  if (!dirExists(_k->_fileOutputPath)) mkdir(_k->_fileOutputPath);
+  if (!dirExists(_k->_fileOutputPath))
+    KORALI_LOG_ERROR("Could not create directory %s to serialize the training state.\n", _k->_fileOutputPath.c_str());
+
+  const size_t size = _stateVector.size();
+
+  // Global index (since the start of training) of the experience following the newest one in memory
+  const size_t lastExperience = std::max(_experienceCount, size);
+
+  // Appending only what the log is missing, unless it lost track of the replay memory or holds too many evicted experiences
+  size_t newCount = lastExperience - std::min(_experienceReplaySnapshotCount, lastExperience);
+  const bool rewriteLog = _experienceReplaySnapshotCount == 0 || _experienceReplaySnapshotCount > lastExperience || newCount > size || _experienceReplaySnapshotLogSize + newCount > 2 * _experienceReplayMaximumSize;
+  if (rewriteLog) newCount = size;
+
+  const uint64_t strides[5] = {_problem->_stateVectorSize, _problem->_actionVectorSize, _policyParameterCount, _policyActionProbabilityCount, _policyUnboundedActionCount};
+
+  // Staging the columns (a copy, since the replay memory keeps changing while they are written)
+  replayLogHeader logHeader;
+  std::memcpy(logHeader.magic, _replayLogMagic, sizeof(logHeader.magic));
+  logHeader.firstExperience = lastExperience - newCount;
+  logHeader.count = newCount;
+  std::memcpy(logHeader.strides, strides, sizeof(strides));
+
+  const size_t first = size - newCount;
+  std::vector<std::vector<char>> logColumns;
+  stageColumn(logColumns, _episodeIdVector, first, newCount);
+  stageColumn(logColumns, _episodePosVector, first, newCount);
+  stageColumn(logColumns, _stateVector, first, newCount);
+  stageColumn(logColumns, _actionVector, first, newCount);
+  stageColumn(logColumns, _rewardVector, first, newCount);
+  stageColumn(logColumns, _environmentIdVector, first, newCount);
+  stageColumn(logColumns, _terminationVector, first, newCount);
+  stageColumn(logColumns, _truncatedStateVector, first, newCount);
+  stageColumn(logColumns, _expPolicyStateValueVector, first, newCount);
+  stageColumn(logColumns, _expPolicyParameterVector, first, newCount);
+  stageColumn(logColumns, _expPolicyActionProbabilityVector, first, newCount);
+  stageColumn(logColumns, _expPolicyActionIndexVector, first, newCount);
+  stageColumn(logColumns, _expPolicyUnboundedActionVector, first, newCount);
+
+  // Metadata changes for every experience during training, hence it is rewritten in full
+  replayMetaHeader metaHeader;
+  std::memcpy(metaHeader.magic, _replayMetaMagic, sizeof(metaHeader.magic));
+  metaHeader.lastExperience = lastExperience;
+  metaHeader.count = size;
+  std::memcpy(metaHeader.strides, strides, sizeof(strides));
+
+  std::vector<std::vector<char>> metaColumns;
+  stageColumn(metaColumns, _stateValueVector, 0, size);
+  stageColumn(metaColumns, _retraceValueVector, 0, size);
+  stageColumn(metaColumns, _importanceWeightVector, 0, size);
+  stageColumn(metaColumns, _truncatedImportanceWeightVector, 0, size);
+  stageColumn(metaColumns, _isOnPolicyVector, 0, size);
+  stageColumn(metaColumns, _truncatedStateValueVector, 0, size);
+  stageColumn(metaColumns, _curPolicyParameterVector, 0, size);
+  stageColumn(metaColumns, _curPolicyActionProbabilityVector, 0, size);
+  stageColumn(metaColumns, _curPolicyUnboundedActionVector, 0, size);
+
+  metaColumns.emplace_back(paddedColumnSize(size * sizeof(float)));
+  float *priorities = reinterpret_cast<float *>(metaColumns.back().data());
+  for (size_t i = 0; i < size; i++) priorities[i] = _priorityTree[i];
+
+  const std::string logPath = _k->_fileOutputPath + "/replay.bin";
+  const std::string metaPath = _k->_fileOutputPath + "/replay.meta.bin";
+
+  // Writing in the background. Full rewrites go through a temporary file, so that an interrupted
+  // write never leaves the metadata pointing to experiences that are missing from the log.
+  _experienceReplaySnapshotWriter = std::async(std::launch::async, [=, logColumns = std::move(logColumns), metaColumns = std::move(metaColumns)]() {
+    std::vector<std::pair<const void *, size_t>> blocks;
+    blocks.push_back({&logHeader, sizeof(logHeader)});
+    for (const auto &c : logColumns) blocks.push_back({c.data(), c.size()});
+
+    if (rewriteLog)
+    {
+      if (int err = writeBlocksToFile(logPath + ".tmp", blocks, false)) return err;
+      if (std::rename((logPath + ".tmp").c_str(), logPath.c_str()) != 0) return errno;
+    }
+    else if (int err = writeBlocksToFile(logPath, blocks, true))
+      return err;
+
+    blocks.clear();
+    blocks.push_back({&metaHeader, sizeof(metaHeader)});
+    for (const auto &c : metaColumns) blocks.push_back({c.data(), c.size()});
+
+    if (int err = writeBlocksToFile(metaPath + ".tmp", blocks, false)) return err;
+    if (std::rename((metaPath + ".tmp").c_str(), metaPath.c_str()) != 0) return errno;
+
+    return 0;
+  });
+
+  _experienceReplaySnapshotCount = lastExperience;
+  _experienceReplaySnapshotLogSize = rewriteLog ? newCount : _experienceReplaySnapshotLogSize + newCount;
+
+  auto endTime = std::chrono::steady_clock::now();                                                                   // Profiling
+  _sessionSerializationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count();    // Profiling
+  _generationSerializationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count(); // Profiling
+}
+
+void Agent::waitForExperienceReplaySerialization()
+{
+  if (_experienceReplaySnapshotWriter.valid() == false) return;
+
+  const int err = _experienceReplaySnapshotWriter.get();
+  if (err != 0)
+    KORALI_LOG_ERROR("Could not serialize training state into %s: %s\n", _k->_fileOutputPath.c_str(), std::strerror(err));
+}
+
+void Agent::deserializeExperienceReplayBinary()
+{
+  auto beginTime = std::chrono::steady_clock::now(); // Profiling
+
+  waitForExperienceReplaySerialization();
+
+  const std::string logPath = _k->_fileOutputPath + "/replay.bin";
+  const std::string metaPath = _k->_fileOutputPath + "/replay.meta.bin";
+
+  _k->_logger->logInfo("Detailed", "Loading previous run training state from files %s and %s...\n", logPath.c_str(), metaPath.c_str());
+
+  mappedFile meta(metaPath);
+  mappedFile log(logPath);
+  if (meta.isOpen() == false || log.isOpen() == false)
+    KORALI_LOG_ERROR("Trying to resume training or test policy but could not map the agent's state files %s and %s.\n", logPath.c_str(), metaPath.c_str());
+
+  const uint64_t strides[5] = {_problem->_stateVectorSize, _problem->_actionVectorSize, _policyParameterCount, _policyActionProbabilityCount, _policyUnboundedActionCount};
+
+  // Row sizes of the columns, in the order they are staged by serializeExperienceReplayBinary
+  const size_t stateRowBytes = strides[0] * sizeof(float);
+  const std::vector<size_t> logRowBytes = {sizeof(size_t), sizeof(size_t), stateRowBytes, strides[1] * sizeof(float), sizeof(float), sizeof(size_t), sizeof(termination_t), stateRowBytes, sizeof(float), strides[2] * sizeof(float), strides[3] * sizeof(float), sizeof(size_t), strides[4] * sizeof(float)};
+  const std::vector<size_t> metaRowBytes = {sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(bool), sizeof(float), strides[2] * sizeof(float), strides[3] * sizeof(float), strides[4] * sizeof(float), sizeof(float)};
+
+  replayMetaHeader metaHeader;
+  if (meta.size() < sizeof(metaHeader)) KORALI_LOG_ERROR("File %s is too short to be an experience replay metadata file.\n", metaPath.c_str());
+  std::memcpy(&metaHeader, meta.data(), sizeof(metaHeader));
+  if (std::memcmp(metaHeader.magic, _replayMetaMagic, sizeof(metaHeader.magic)) != 0) KORALI_LOG_ERROR("File %s is not an experience replay metadata file.\n", metaPath.c_str());
+  if (std::memcmp(metaHeader.strides, strides, sizeof(strides)) != 0) KORALI_LOG_ERROR("Experience replay in %s was produced for a problem with different state, action or policy sizes.\n", metaPath.c_str());
+
+  const size_t size = metaHeader.count;
+  const size_t lastExperience = metaHeader.lastExperience;
+  const size_t firstExperience = lastExperience - size;
+
+  clearExperienceReplay();
+
+  // Going through the chunks of the log, keeping the experiences that were in memory at the time of the snapshot
+  size_t loaded = 0;
+  size_t offset = 0;
+  while (offset + sizeof(replayLogHeader) <= log.size())
+  {
+    replayLogHeader h;
+    std::memcpy(&h, log.data() + offset, sizeof(h));
+    if (std::memcmp(h.magic, _replayLogMagic, sizeof(h.magic)) != 0) KORALI_LOG_ERROR("File %s is corrupted at offset %lu.\n", logPath.c_str(), offset);
+    if (std::memcmp(h.strides, strides, sizeof(strides)) != 0) KORALI_LOG_ERROR("Experience replay in %s was produced for a problem with different state, action or policy sizes.\n", logPath.c_str());
+
+    const size_t n = h.count;
+    const size_t chunkSize = sizeof(h) + columnBlockSize(n, logRowBytes);
+
+    // A chunk cut short by an interrupted append is not referenced by the metadata
+    if (offset + chunkSize > log.size()) break;
+
+    const size_t begin = std::max((size_t)h.firstExperience, firstExperience + loaded);
+    const size_t end = std::min((size_t)(h.firstExperience + n), lastExperience);
+    if (begin < end)
+    {
+      const size_t j = begin - h.firstExperience;
+      const size_t count = end - begin;
+      const char *p = log.data() + offset + sizeof(h);
+      p = loadColumn(p, j, count, n, _episodeIdVector);
+      p = loadColumn(p, j, count, n, _episodePosVector);
+      p = loadColumn(p, j, count, n, _stateVector);
+      p = loadColumn(p, j, count, n, _actionVector);
+      p = loadColumn(p, j, count, n, _rewardVector);
+      p = loadColumn(p, j, count, n, _environmentIdVector);
+      p = loadColumn(p, j, count, n, _terminationVector);
+      p = loadColumn(p, j, count, n, _truncatedStateVector);
+      p = loadColumn(p, j, count, n, _expPolicyStateValueVector);
+      p = loadColumn(p, j, count, n, _expPolicyParameterVector);
+      p = loadColumn(p, j, count, n, _expPolicyActionProbabilityVector);
+      p = loadColumn(p, j, count, n, _expPolicyActionIndexVector);
+      p = loadColumn(p, j, count, n, _expPolicyUnboundedActionVector);
+      loaded += count;
+    }
+
+    offset += chunkSize;
+  }
+
+  if (loaded != size)
+    KORALI_LOG_ERROR("Experience replay log %s holds %lu of the %lu experiences referenced by %s.\n", logPath.c_str(), loaded, size, metaPath.c_str());
+
+  if (meta.size() < sizeof(metaHeader) + columnBlockSize(size, metaRowBytes)) KORALI_LOG_ERROR("File %s is too short for the %lu experiences it describes.\n", metaPath.c_str(), size);
+
+  const char *p = meta.data() + sizeof(metaHeader);
+  p = loadColumn(p, 0, size, size, _stateValueVector);
+  p = loadColumn(p, 0, size, size, _retraceValueVector);
+  p = loadColumn(p, 0, size, size, _importanceWeightVector);
+  p = loadColumn(p, 0, size, size, _truncatedImportanceWeightVector);
+  p = loadColumn(p, 0, size, size, _isOnPolicyVector);
+  p = loadColumn(p, 0, size, size, _truncatedStateValueVector);
+  p = loadColumn(p, 0, size, size, _curPolicyParameterVector);
+  p = loadColumn(p, 0, size, size, _curPolicyActionProbabilityVector);
+  p = loadColumn(p, 0, size, size, _curPolicyUnboundedActionVector);
+
+  const float *priorities = reinterpret_cast<const float *>(p);
+  for (size_t i = 0; i < size; i++) _priorityTree.add(priorities[i]);
+
+  // The experience counters of the resumed run may not match the snapshot, so the next one rewrites the log
+  _experienceReplaySnapshotCount = 0;
+  _experienceReplaySnapshotLogSize = 0;
+
+  auto endTime = std::chrono::steady_clock::now();                                                                         // Profiling
+  double deserializationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count() / 1.0e+9; // Profiling
+  _k->_logger->logInfo("Detailed", "Took %fs to deserialize training state.\n", deserializationTime);
+}
+
 void Agent::printGenerationAfter()
 {
   if (_mode == "Training")
@@ -988,7 +2002,7 @@ void Agent::printGenerationAfter()
       for (size_t i = 0; i < _problem->_environmentCount; ++i)
         _k->_logger->logInfo("Normal", " + Experience Count Env %zu:      %lu\n", i, _experienceCountPerEnvironment[i]);
 
-    _k->_logger->logInfo("Normal", " + Experience Memory Size:      %lu/%lu\n", _stateVector.size(), _experienceReplayMaximumSize);
+    _k->_logger->logInfo("Normal", " + Experience Memory Size:      %lu/%lu\n", _rewardVector.size(), _experienceReplayMaximumSize);
     if (_maxEpisodes > 0)
       _k->_logger->logInfo("Normal", " + Total Episodes Count:        %lu/%lu\n", _currentEpisode, _maxEpisodes);
     else
@@ -1003,7 +2017,7 @@ void Agent::printGenerationAfter()
       _k->_logger->logInfo("Normal", " + Out of Bound Actions:        %lu (%.3f%%)\n", _rewardOutboundPenalizationCount, 100.0f * (float)_rewardOutboundPenalizationEnabled / (float)_experienceCount);
 
     _k->_logger->logInfo("Normal", "Off-Policy Statistics:\n");
-    _k->_logger->logInfo("Normal", " + Count (Ratio/Target):        %lu/%lu (%.3f/%.3f)\n", _experienceReplayOffPolicyCount, _stateVector.size(), _experienceReplayOffPolicyRatio, _experienceReplayOffPolicyTarget);
+    _k->_logger->logInfo("Normal", " + Count (Ratio/Target):        %lu/%lu (%.3f/%.3f)\n", _experienceReplayOffPolicyCount, _rewardVector.size(), _experienceReplayOffPolicyRatio, _experienceReplayOffPolicyTarget);
     _k->_logger->logInfo("Normal", " + Importance Weight Cutoff:    [%.3f, %.3f]\n", 1.0f / _experienceReplayOffPolicyCurrentCutoff, _experienceReplayOffPolicyCurrentCutoff);
     _k->_logger->logInfo("Normal", " + REFER Beta Factor:           %f\n", _experienceReplayOffPolicyREFERBeta);
 
@@ -1062,6 +2076,22 @@ void Agent::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Policy", "Parameter Count");
  }
 
+ if (isDefined(js, "Policy", "Action Probability Count"))
+ {
+ try { _policyActionProbabilityCount = js["Policy"]["Action Probability Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Policy']['Action Probability Count']\n%s", e.what()); } 
+   eraseValue(js, "Policy", "Action Probability Count");
+ }
+
+ if (isDefined(js, "Policy", "Unbounded Action Count"))
+ {
+ try { _policyUnboundedActionCount = js["Policy"]["Unbounded Action Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Policy']['Unbounded Action Count']\n%s", e.what()); } 
+   eraseValue(js, "Policy", "Unbounded Action Count");
+ }
+
  if (isDefined(js, "Action Lower Bounds"))
  {
  try { _actionLowerBounds = js["Action Lower Bounds"].get<std::vector<float>>();
@@ -1188,6 +2218,30 @@ void Agent::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Experience Replay", "Off Policy", "Current Cutoff");
  }
 
+ if (isDefined(js, "Experience Replay", "Snapshot Count"))
+ {
+ try { _experienceReplaySnapshotCount = js["Experience Replay"]["Snapshot Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Snapshot Count']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Snapshot Count");
+ }
+
+ if (isDefined(js, "Experience Replay", "Snapshot Log Size"))
+ {
+ try { _experienceReplaySnapshotLogSize = js["Experience Replay"]["Snapshot Log Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Snapshot Log Size']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Snapshot Log Size");
+ }
+
+ if (isDefined(js, "Experience Replay", "Priority", "Max"))
+ {
+ try { _experienceReplayPriorityMax = js["Experience Replay"]["Priority"]["Max"].get<float>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Priority']['Max']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Priority", "Max");
+ }
+
  if (isDefined(js, "Current Learning Rate"))
  {
  try { _currentLearningRate = js["Current Learning Rate"].get<float>();
@@ -1353,12 +2407,22 @@ void Agent::setConfiguration(knlohmann::json& js)
 {
  bool validOption = false; 
  if (_miniBatchStrategy == "Uniform") validOption = true; 
+ if (_miniBatchStrategy == "Prioritized") validOption = true; 
  if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Mini Batch']['Strategy'] required by agent.\n", _miniBatchStrategy.c_str()); 
 }
    eraseValue(js, "Mini Batch", "Strategy");
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Mini Batch']['Strategy'] required by agent.\n"); 
 
+ if (isDefined(js, "Mini Batch", "Data Parallel Learners"))
+ {
+ try { _miniBatchDataParallelLearners = js["Mini Batch"]["Data Parallel Learners"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Mini Batch']['Data Parallel Learners']\n%s", e.what()); } 
+   eraseValue(js, "Mini Batch", "Data Parallel Learners");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Mini Batch']['Data Parallel Learners'] required by agent.\n"); 
+
  if (isDefined(js, "Time Sequence Length"))
  {
  try { _timeSequenceLength = js["Time Sequence Length"].get<size_t>();
@@ -1448,6 +2512,21 @@ void Agent::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Serialize'] required by agent.\n"); 
 
+ if (isDefined(js, "Experience Replay", "Serialization Format"))
+ {
+ try { _experienceReplaySerializationFormat = js["Experience Replay"]["Serialization Format"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Serialization Format']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_experienceReplaySerializationFormat == "Binary") validOption = true; 
+ if (_experienceReplaySerializationFormat == "JSON") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Experience Replay']['Serialization Format'] required by agent.\n", _experienceReplaySerializationFormat.c_str()); 
+}
+   eraseValue(js, "Experience Replay", "Serialization Format");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Serialization Format'] required by agent.\n"); 
+
  if (isDefined(js, "Experience Replay", "Start Size"))
  {
  try { _experienceReplayStartSize = js["Experience Replay"]["Start Size"].get<size_t>();
@@ -1466,6 +2545,24 @@ void Agent::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Maximum Size'] required by agent.\n"); 
 
+ if (isDefined(js, "Experience Replay", "Sharding", "Enabled"))
+ {
+ try { _experienceReplayShardingEnabled = js["Experience Replay"]["Sharding"]["Enabled"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Sharding']['Enabled']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Sharding", "Enabled");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Sharding']['Enabled'] required by agent.\n"); 
+
+ if (isDefined(js, "Experience Replay", "Sharding", "Shard Size"))
+ {
+ try { _experienceReplayShardingShardSize = js["Experience Replay"]["Sharding"]["Shard Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Sharding']['Shard Size']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Sharding", "Shard Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Sharding']['Shard Size'] required by agent.\n"); 
+
  if (isDefined(js, "Experience Replay", "Off Policy", "Cutoff Scale"))
  {
  try { _experienceReplayOffPolicyCutoffScale = js["Experience Replay"]["Off Policy"]["Cutoff Scale"].get<float>();
@@ -1502,6 +2599,33 @@ void Agent::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Off Policy']['REFER Beta'] required by agent.\n"); 
 
+ if (isDefined(js, "Experience Replay", "Priority", "Exponent"))
+ {
+ try { _experienceReplayPriorityExponent = js["Experience Replay"]["Priority"]["Exponent"].get<float>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Priority']['Exponent']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Priority", "Exponent");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Priority']['Exponent'] required by agent.\n"); 
+
+ if (isDefined(js, "Experience Replay", "Priority", "Importance Weight Exponent"))
+ {
+ try { _experienceReplayPriorityImportanceWeightExponent = js["Experience Replay"]["Priority"]["Importance Weight Exponent"].get<float>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Priority']['Importance Weight Exponent']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Priority", "Importance Weight Exponent");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Priority']['Importance Weight Exponent'] required by agent.\n"); 
+
+ if (isDefined(js, "Experience Replay", "Priority", "Importance Weight Annealing Rate"))
+ {
+ try { _experienceReplayPriorityImportanceWeightAnnealingRate = js["Experience Replay"]["Priority"]["Importance Weight Annealing Rate"].get<float>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Experience Replay']['Priority']['Importance Weight Annealing Rate']\n%s", e.what()); } 
+   eraseValue(js, "Experience Replay", "Priority", "Importance Weight Annealing Rate");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experience Replay']['Priority']['Importance Weight Annealing Rate'] required by agent.\n"); 
+
  if (isDefined(js, "Experiences Between Policy Updates"))
  {
  try { _experiencesBetweenPolicyUpdates = js["Experiences Between Policy Updates"].get<float>();
@@ -1511,6 +2635,30 @@ void Agent::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Experiences Between Policy Updates'] required by agent.\n"); 
 
+ if (isDefined(js, "Asynchronous Policy Updates"))
+ {
+ try { _asynchronousPolicyUpdates = js["Asynchronous Policy Updates"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Asynchronous Policy Updates']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Policy Updates");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Asynchronous Policy Updates'] required by agent.\n"); 
+
+ if (isDefined(js, "Policy Broadcast", "Precision"))
+ {
+ try { _policyBroadcastPrecision = js["Policy Broadcast"]["Precision"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ agent ] \n + Key:    ['Policy Broadcast']['Precision']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_policyBroadcastPrecision == "Single") validOption = true; 
+ if (_policyBroadcastPrecision == "Half") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Policy Broadcast']['Precision'] required by agent.\n", _policyBroadcastPrecision.c_str()); 
+}
+   eraseValue(js, "Policy Broadcast", "Precision");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Policy Broadcast']['Precision'] required by agent.\n"); 
+
  if (isDefined(js, "State Rescaling", "Enabled"))
  {
  try { _stateRescalingEnabled = js["State Rescaling"]["Enabled"].get<int>();
@@ -1595,6 +2743,7 @@ void Agent::getConfiguration(knlohmann::json& js)
    js["Episodes Per Generation"] = _episodesPerGeneration;
    js["Mini Batch"]["Size"] = _miniBatchSize;
    js["Mini Batch"]["Strategy"] = _miniBatchStrategy;
+   js["Mini Batch"]["Data Parallel Learners"] = _miniBatchDataParallelLearners;
    js["Time Sequence Length"] = _timeSequenceLength;
    js["Learning Rate"] = _learningRate;
    js["L2 Regularization"]["Enabled"] = _l2RegularizationEnabled;
@@ -1605,13 +2754,21 @@ void Agent::getConfiguration(knlohmann::json& js)
    js["Discount Factor"] = _discountFactor;
    js["Importance Weight Truncation Level"] = _importanceWeightTruncationLevel;
    js["Experience Replay"]["Serialize"] = _experienceReplaySerialize;
+   js["Experience Replay"]["Serialization Format"] = _experienceReplaySerializationFormat;
    js["Experience Replay"]["Start Size"] = _experienceReplayStartSize;
    js["Experience Replay"]["Maximum Size"] = _experienceReplayMaximumSize;
+   js["Experience Replay"]["Sharding"]["Enabled"] = _experienceReplayShardingEnabled;
+   js["Experience Replay"]["Sharding"]["Shard Size"] = _experienceReplayShardingShardSize;
    js["Experience Replay"]["Off Policy"]["Cutoff Scale"] = _experienceReplayOffPolicyCutoffScale;
    js["Experience Replay"]["Off Policy"]["Target"] = _experienceReplayOffPolicyTarget;
    js["Experience Replay"]["Off Policy"]["Annealing Rate"] = _experienceReplayOffPolicyAnnealingRate;
    js["Experience Replay"]["Off Policy"]["REFER Beta"] = _experienceReplayOffPolicyREFERBeta;
+   js["Experience Replay"]["Priority"]["Exponent"] = _experienceReplayPriorityExponent;
+   js["Experience Replay"]["Priority"]["Importance Weight Exponent"] = _experienceReplayPriorityImportanceWeightExponent;
+   js["Experience Replay"]["Priority"]["Importance Weight Annealing Rate"] = _experienceReplayPriorityImportanceWeightAnnealingRate;
    js["Experiences Between Policy Updates"] = _experiencesBetweenPolicyUpdates;
+   js["Asynchronous Policy Updates"] = _asynchronousPolicyUpdates;
+   js["Policy Broadcast"]["Precision"] = _policyBroadcastPrecision;
    js["State Rescaling"]["Enabled"] = _stateRescalingEnabled;
    js["Reward"]["Rescaling"]["Enabled"] = _rewardRescalingEnabled;
    js["Reward"]["Outbound Penalization"]["Enabled"] = _rewardOutboundPenalizationEnabled;
@@ -1620,6 +2777,8 @@ void Agent::getConfiguration(knlohmann::json& js)
    js["Termination Criteria"]["Max Experiences"] = _maxExperiences;
    js["Termination Criteria"]["Max Policy Updates"] = _maxPolicyUpdates;
    js["Policy"]["Parameter Count"] = _policyParameterCount;
+   js["Policy"]["Action Probability Count"] = _policyActionProbabilityCount;
+   js["Policy"]["Unbounded Action Count"] = _policyUnboundedActionCount;
    js["Action Lower Bounds"] = _actionLowerBounds;
    js["Action Upper Bounds"] = _actionUpperBounds;
    js["Current Episode"] = _currentEpisode;
@@ -1636,6 +2795,9 @@ void Agent::getConfiguration(knlohmann::json& js)
    js["Experience Replay"]["Off Policy"]["Count"] = _experienceReplayOffPolicyCount;
    js["Experience Replay"]["Off Policy"]["Ratio"] = _experienceReplayOffPolicyRatio;
    js["Experience Replay"]["Off Policy"]["Current Cutoff"] = _experienceReplayOffPolicyCurrentCutoff;
+   js["Experience Replay"]["Snapshot Count"] = _experienceReplaySnapshotCount;
+   js["Experience Replay"]["Snapshot Log Size"] = _experienceReplaySnapshotLogSize;
+   js["Experience Replay"]["Priority"]["Max"] = _experienceReplayPriorityMax;
    js["Current Learning Rate"] = _currentLearningRate;
    js["Policy Update Count"] = _policyUpdateCount;
    js["Current Sample ID"] = _currentSampleID;
@@ -1655,7 +2817,7 @@ void Agent::getConfiguration(knlohmann::json& js)
 void Agent::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Episodes Per Generation\": 1, \"Concurrent Environments\": 1, \"Discount Factor\": 0.995, \"Time Sequence Length\": 1, \"Importance Weight Truncation Level\": 1.0, \"State Rescaling\": {\"Enabled\": false}, \"Reward\": {\"Rescaling\": {\"Enabled\": false}, \"Outbound Penalization\": {\"Enabled\": false, \"Factor\": 0.5}}, \"Mini Batch\": {\"Strategy\": \"Uniform\", \"Size\": 256}, \"L2 Regularization\": {\"Enabled\": false, \"Importance\": 0.0001}, \"Training\": {\"Average Depth\": 100, \"Current Policy\": {}, \"Best Policy\": {}}, \"Testing\": {\"Sample Ids\": [], \"Current Policy\": {}}, \"Termination Criteria\": {\"Max Episodes\": 0, \"Max Experiences\": 0, \"Max Policy Updates\": 0}, \"Experience Replay\": {\"Serialize\": true, \"Off Policy\": {\"Cutoff Scale\": 4.0, \"Target\": 0.1, \"REFER Beta\": 0.3, \"Annealing Rate\": 0.0}}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}}";
+ std::string defaultString = "{\"Episodes Per Generation\": 1, \"Concurrent Environments\": 1, \"Discount Factor\": 0.995, \"Time Sequence Length\": 1, \"Asynchronous Policy Updates\": false, \"Importance Weight Truncation Level\": 1.0, \"Policy Broadcast\": {\"Precision\": \"Single\"}, \"State Rescaling\": {\"Enabled\": false}, \"Reward\": {\"Rescaling\": {\"Enabled\": false}, \"Outbound Penalization\": {\"Enabled\": false, \"Factor\": 0.5}}, \"Mini Batch\": {\"Strategy\": \"Uniform\", \"Size\": 256, \"Data Parallel Learners\": 1}, \"L2 Regularization\": {\"Enabled\": false, \"Importance\": 0.0001}, \"Training\": {\"Average Depth\": 100, \"Current Policy\": {}, \"Best Policy\": {}}, \"Testing\": {\"Sample Ids\": [], \"Current Policy\": {}}, \"Termination Criteria\": {\"Max Episodes\": 0, \"Max Experiences\": 0, \"Max Policy Updates\": 0}, \"Experience Replay\": {\"Serialize\": true, \"Serialization Format\": \"Binary\", \"Sharding\": {\"Enabled\": false, \"Shard Size\": 0}, \"Off Policy\": {\"Cutoff Scale\": 4.0, \"Target\": 0.1, \"REFER Beta\": 0.3, \"Annealing Rate\": 0.0}, \"Priority\": {\"Exponent\": 0.6, \"Importance Weight Exponent\": 0.4, \"Importance Weight Annealing Rate\": 0.0}}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Solver::applyModuleDefaults(js);
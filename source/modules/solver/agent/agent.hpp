@@ -13,12 +13,21 @@
 #pragma once
 
 #include "auxiliar/cbuffer.hpp"
+#include "auxiliar/sumtree.hpp"
+#include "modules/conduit/distributed/distributed.hpp"
 #include "modules/problem/reinforcementLearning/reinforcementLearning.hpp"
 #include "modules/problem/supervisedLearning/supervisedLearning.hpp"
 #include "modules/solver/learner/deepSupervisor/deepSupervisor.hpp"
 #include "sample/sample.hpp"
 #include <algorithm> // std::shuffle
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <queue>
 #include <random>
+#include <thread>
 
 namespace korali
 {
@@ -81,6 +90,83 @@ struct policy_t
   std::vector<float> unboundedAction;
 };
 
+/**
+ * @brief Structure to stage the experiences of an episode in progress, received in chunks from its environment.
+ *        Every column is a flat array with one row per experience, so that chunks are appended without per-experience allocations.
+ */
+struct episode_t
+{
+  /**
+   * @brief Environment that produced the episode
+   */
+  size_t environmentId = 0;
+
+  /**
+   * @brief Number of experiences received so far
+   */
+  size_t experienceCount = 0;
+
+  /**
+   * @brief Termination status of the last experience received
+   */
+  termination_t termination = e_nonTerminal;
+
+  /**
+   * @brief States of the experiences (state vector size per row). With a sharded replay, only those sent along with the experiences.
+   */
+  std::vector<float> states;
+
+  /**
+   * @brief [Sharded replay] Shard that holds the state of every experience, or -1 if the state was sent along with the experience
+   */
+  std::vector<int> stateShardIds;
+
+  /**
+   * @brief [Sharded replay] Position of the state of every experience among all the states written to its shard
+   */
+  std::vector<size_t> stateShardIndexes;
+
+  /**
+   * @brief Actions of the experiences (action vector size per row)
+   */
+  std::vector<float> actions;
+
+  /**
+   * @brief Rewards of the experiences
+   */
+  std::vector<float> rewards;
+
+  /**
+   * @brief If the episode was truncated, the state that follows the last experience
+   */
+  std::vector<float> truncatedState;
+
+  /**
+   * @brief State values produced by the policy for every experience
+   */
+  std::vector<float> stateValues;
+
+  /**
+   * @brief Distribution parameters produced by the policy for every experience
+   */
+  std::vector<float> distributionParameters;
+
+  /**
+   * @brief [Discrete] Action probabilities produced by the policy for every experience
+   */
+  std::vector<float> actionProbabilities;
+
+  /**
+   * @brief [Discrete] Index of the selected action for every experience
+   */
+  std::vector<size_t> actionIndexes;
+
+  /**
+   * @brief [Continuous] Unbounded actions of the Squashed Normal policy for every experience
+   */
+  std::vector<float> unboundedActions;
+};
+
 /**
 * @brief Class declaration for module: Agent.
 */
@@ -120,6 +206,10 @@ class Agent : public Solver
   */
    std::string _miniBatchStrategy;
   /**
+  * @brief Number of learners (threads) that split every mini batch among them to compute the policy gradients. Each learner evaluates and back propagates its slice of the mini batch, and the gradients of the slices are summed in a fixed order before the optimizer step, so that results do not depend on thread scheduling.
+  */
+   size_t _miniBatchDataParallelLearners;
+  /**
   * @brief Indicates the number of contiguous experiences to pass to the NN for learning. This is only useful when using recurrent NNs.
   */
    size_t _timeSequenceLength;
@@ -160,6 +250,10 @@ class Agent : public Solver
   */
    int _experienceReplaySerialize;
   /**
+  * @brief Specifies the file format of the serialized experience replay.
+  */
+   std::string _experienceReplaySerializationFormat;
+  /**
   * @brief The minimum number of experiences before learning starts.
   */
    size_t _experienceReplayStartSize;
@@ -168,6 +262,14 @@ class Agent : public Solver
   */
    size_t _experienceReplayMaximumSize;
   /**
+  * @brief If true, the states of the experiences are kept in a shard on the node of the worker that ran the environment, instead of on the engine. The engine keeps the rest of the replay memory, and reads the states it needs for training with one-sided MPI communication. Requires the Distributed conduit, with the agent as the only experiment of the engine, and disabled experience replay serialization.
+  */
+   int _experienceReplayShardingEnabled;
+  /**
+  * @brief The number of states every worker can hold in its shard. If 0, twice the maximum size of the replay memory divided by the number of workers. States that do not fit in the shard of their worker are sent to the engine.
+  */
+   size_t _experienceReplayShardingShardSize;
+  /**
   * @brief Initial Cut-Off to classify experiences as on- or off-policy. (c_max in https://arxiv.org/abs/1807.05827)
   */
    float _experienceReplayOffPolicyCutoffScale;
@@ -184,10 +286,30 @@ class Agent : public Solver
   */
    float _experienceReplayOffPolicyREFERBeta;
   /**
+  * @brief Exponent applied to the absolute difference between the retrace and the state value of an experience to obtain its priority (alpha in https://arxiv.org/abs/1511.05952). Only relevant for the Prioritized mini batch strategy.
+  */
+   float _experienceReplayPriorityExponent;
+  /**
+  * @brief Initial exponent of the importance sampling correction of prioritized experiences (beta in https://arxiv.org/abs/1511.05952). Only relevant for the Prioritized mini batch strategy.
+  */
+   float _experienceReplayPriorityImportanceWeightExponent;
+  /**
+  * @brief Increase of the importance weight exponent per policy update, until it reaches 1.0. Only relevant for the Prioritized mini batch strategy.
+  */
+   float _experienceReplayPriorityImportanceWeightAnnealingRate;
+  /**
   * @brief The number of experiences to receive before training/updating (real number, may be less than < 1.0, for more than one update per experience).
   */
    float _experiencesBetweenPolicyUpdates;
   /**
+  * @brief If true, after the first policy update of every generation, the policy updates run in a separate learner thread. The engine keeps receiving experiences while the policy is trained, and sends the environments the latest policy published by the learner. Requires a concurrent or distributed conduit.
+  */
+   int _asynchronousPolicyUpdates;
+  /**
+  * @brief Specifies the floating point precision of the policy sent to the environments. The environments cache the policy and only receive it when it has changed.
+  */
+   std::string _policyBroadcastPrecision;
+  /**
   * @brief Determines whether to normalize the states, such that they have mean 0 and standard deviation 1 (done only once after the initial exploration phase).
   */
    int _stateRescalingEnabled;
@@ -208,6 +330,14 @@ class Agent : public Solver
   */
    size_t _policyParameterCount;
   /**
+  * @brief [Internal Use] Stores the number of action probabilities kept per experience in the replay memory (discrete agents only).
+  */
+   size_t _policyActionProbabilityCount;
+  /**
+  * @brief [Internal Use] Stores the number of unbounded actions kept per experience in the replay memory (continuous agents only).
+  */
+   size_t _policyUnboundedActionCount;
+  /**
   * @brief [Internal Use] Lower bounds for actions.
   */
    std::vector<float> _actionLowerBounds;
@@ -272,6 +402,18 @@ class Agent : public Solver
   */
    float _experienceReplayOffPolicyCurrentCutoff;
   /**
+  * @brief [Internal Use] Number of experiences (counted since the start of training) already written to the binary experience replay log.
+  */
+   size_t _experienceReplaySnapshotCount;
+  /**
+  * @brief [Internal Use] Number of experiences stored in the binary experience replay log, used to decide when to compact it.
+  */
+   size_t _experienceReplaySnapshotLogSize;
+  /**
+  * @brief [Internal Use] Largest priority observed so far, assigned to new experiences to guarantee they are sampled at least once.
+  */
+   float _experienceReplayPriorityMax;
+  /**
   * @brief [Internal Use] The current learning rate to use for the NN hyperparameter optimization.
   */
    float _currentLearningRate;
@@ -365,6 +507,11 @@ class Agent : public Solver
    */
   std::vector<bool> _isAgentRunning;
 
+  /**
+   * @brief Episodes in progress, received in chunks from every sub-agent of every running environment
+   */
+  std::vector<std::vector<episode_t>> _pendingEpisodes;
+
   /**
    * @brief Session-specific experience count. This is useful in case of restart: counters from the old session won't count
    */
@@ -391,19 +538,54 @@ class Agent : public Solver
   size_t _sessionExperiencesUntilStartSize;
 
   /**
-   * @brief Stores the state of the experience
+   * @brief Stores the state of the experience (one row of state vector size per experience). Unused with a sharded replay.
+   */
+  cStridedBuffer<float> _stateVector;
+
+  /**
+   * @brief [Sharded replay] Shard that holds the state of every experience, or -1 if the engine holds it
    */
-  cBuffer<std::vector<float>> _stateVector;
+  cBuffer<int> _stateShardIdVector;
 
   /**
-   * @brief Stores the action taken by the agent at the given state
+   * @brief [Sharded replay] Position of the state of every experience among all the states written to its shard, or among the states held by the engine
    */
-  cBuffer<std::vector<float>> _actionVector;
+  cBuffer<size_t> _stateShardIndexVector;
 
   /**
-   * @brief Stores the current sequence of states observed by the agent (limited to time sequence length defined by the user)
+   * @brief [Sharded replay] States held by the engine, because they did not fit in the shard of their worker, in the order of their experiences
    */
-  cBuffer<std::vector<float>> _stateTimeSequence;
+  std::deque<std::vector<float>> _stateShardLocalStates;
+
+  /**
+   * @brief [Sharded replay] Position of the first of the states held by the engine
+   */
+  size_t _stateShardLocalFirstIndex = 0;
+
+  /**
+   * @brief [Sharded replay] For every shard, the number of states written to it that are no longer in the replay memory and may be overwritten
+   */
+  std::vector<size_t> _stateShardReleasedCounts;
+
+  /**
+   * @brief [Sharded replay] For every shard, the positions of the evicted states that can not be released yet, because an earlier state is still in the replay memory
+   */
+  std::vector<std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>>> _stateShardEvictedIndexes;
+
+  /**
+   * @brief [Sharded replay] Conduit that holds the shards, once they are allocated
+   */
+  conduit::Distributed *_stateShardConduit = nullptr;
+
+  /**
+   * @brief Stores the action taken by the agent at the given state (one row of action vector size per experience)
+   */
+  cStridedBuffer<float> _actionVector;
+
+  /**
+   * @brief Stores the current sequence of states observed by every agent in the environment (limited to time sequence length defined by the user)
+   */
+  std::vector<cBuffer<std::vector<float>>> _stateTimeSequence;
 
   /**
    * @brief Episode that experience belongs to
@@ -426,24 +608,54 @@ class Agent : public Solver
   cBuffer<float> _truncatedImportanceWeightVector;
 
   /**
-   * @brief For prioritized experience replay, this stores the experience's priority
+   * @brief For prioritized experience replay, this stores the experience's priority (laid out like the replay memory)
+   */
+  sumTree _priorityTree;
+
+  /**
+   * @brief For prioritized experience replay, the importance sampling correction of each experience of the last (sorted) mini batch
+   */
+  std::vector<float> _miniBatchSamplingWeights;
+
+  /**
+   * @brief Contains the distribution parameters of the most current policy given the experience state. Its state value is kept in _stateValueVector.
+   */
+  cStridedBuffer<float> _curPolicyParameterVector;
+
+  /**
+   * @brief [Discrete] Contains the action probabilities of the most current policy given the experience state
+   */
+  cStridedBuffer<float> _curPolicyActionProbabilityVector;
+
+  /**
+   * @brief [Continuous] Contains the unbounded action of the most current policy given the experience state
+   */
+  cStridedBuffer<float> _curPolicyUnboundedActionVector;
+
+  /**
+   * @brief Contains the state value produced at the moment of the action was taken
    */
-  cBuffer<float> _priorityVector;
+  cBuffer<float> _expPolicyStateValueVector;
 
   /**
-   * @brief For prioritized experience replay, this stores the experience's probability
+   * @brief Contains the distribution parameters of the policy at the moment of the action was taken
    */
-  cBuffer<float> _probabilityVector;
+  cStridedBuffer<float> _expPolicyParameterVector;
 
   /**
-   * @brief Contains the most current policy information given the experience state
+   * @brief [Discrete] Contains the action probabilities of the policy at the moment of the action was taken
    */
-  cBuffer<policy_t> _curPolicyVector;
+  cStridedBuffer<float> _expPolicyActionProbabilityVector;
 
   /**
-   * @brief Contains the policy information produced at the moment of the action was taken
+   * @brief [Discrete] Contains the index of the action taken
    */
-  cBuffer<policy_t> _expPolicyVector;
+  cBuffer<size_t> _expPolicyActionIndexVector;
+
+  /**
+   * @brief [Continuous] Contains the unbounded action of the policy at the moment of the action was taken
+   */
+  cStridedBuffer<float> _expPolicyUnboundedActionVector;
 
   /**
    * @brief Indicates whether the experience is on policy, given the specified off-policiness criteria
@@ -468,7 +680,7 @@ class Agent : public Solver
   /**
    * @brief If this is a truncated terminal experience, the truncated state is also saved here
    */
-  cBuffer<std::vector<float>> _truncatedStateVector;
+  cStridedBuffer<float> _truncatedStateVector;
 
   /**
    * @brief Contains the environment id of every experience
@@ -486,14 +698,74 @@ class Agent : public Solver
   cBuffer<float> _stateValueVector;
 
   /**
-   * @brief Stores the priority annealing rate.
+   * @brief Background write of the last binary experience replay snapshot, returns zero or the errno of the failed operation
+   */
+  std::future<int> _experienceReplaySnapshotWriter;
+
+  /**
+   * @brief Thread running the policy updates, if they are asynchronous
+   */
+  std::thread _learnerThread;
+
+  /**
+   * @brief Guards the replay memory, the policy neural network, and the policy update counters while the learner thread runs
+   */
+  std::mutex _learnerMutex;
+
+  /**
+   * @brief Guards the learner thread's wait for new experiences or a stop request
+   */
+  std::mutex _learnerWakeMutex;
+
+  /**
+   * @brief Wakes the learner thread up when new experiences arrive or it has to stop
+   */
+  std::condition_variable _learnerCondition;
+
+  /**
+   * @brief Tells the learner thread to finish after its current policy update (guarded by the wake mutex)
+   */
+  bool _learnerStopRequested = false;
+
+  /**
+   * @brief Error raised by the learner thread, reported by the engine thread
+   */
+  std::exception_ptr _learnerException;
+
+  /**
+   * @brief Guards the policy published by the learner thread
+   */
+  std::mutex _learnerPolicyMutex;
+
+  /**
+   * @brief Latest policy hyperparameters published by the learner thread. The learner builds the next one aside and swaps it in.
+   */
+  knlohmann::json _learnerPublishedPolicy;
+
+  /**
+   * @brief Number of policies published by the learner thread
+   */
+  std::atomic<size_t> _learnerPublishedPolicyVersion{0};
+
+  /**
+   * @brief Version of the published policy last sent to the environments
    */
-  float _priorityAnnealingRate;
+  size_t _learnerFetchedPolicyVersion = 0;
 
   /**
-   * @brief Stores the importance weight annealing factor.
+   * @brief Version of the current training policy, increased whenever it changes. Environments that cached this version do not receive the policy again.
    */
-  float _importanceWeightAnnealingRate;
+  size_t _trainingCurrentPolicyVersion = 0;
+
+  /**
+   * @brief Current training policy, encoded as sent to the environments. It is only re-encoded when the policy version changes.
+   */
+  knlohmann::json _trainingCurrentPolicyMessage;
+
+  /**
+   * @brief Experiences received from the environments and not yet added to the session experience count
+   */
+  std::atomic<size_t> _receivedExperienceCount{0};
 
   /**
    * @brief Storage for the pointer to the learning problem
@@ -608,6 +880,19 @@ class Agent : public Solver
    */
   void normalizeStateNeuralNetwork(NeuralNetwork *neuralNetwork, size_t miniBatchSize, size_t normalizationSteps);
 
+  /**
+   * @brief Appends a chunk of experiences, received from an environment while its episode runs, to the staged episode.
+   * @param episode The staged episode
+   * @param chunk Flat arrays (one row per experience) with the experiences of the chunk
+   */
+  void appendExperienceChunk(episode_t &episode, const knlohmann::json &chunk);
+
+  /**
+   * @brief Adds the experiences of a finished episode into the replay memory.
+   * @param episode The staged episode
+   */
+  void processEpisode(episode_t &episode);
+
   /**
    * @brief Additional post-processing of episode after episode terminated.
    * @param episode A vector of experiences pertaining to the episode.
@@ -640,6 +925,13 @@ class Agent : public Solver
    */
   virtual std::vector<policy_t> runPolicy(const std::vector<std::vector<std::vector<float>>> &stateBatch) = 0;
 
+  /**
+   * @brief Runs the policy for inference on any number of state time series, evaluating them in batches of the inference batch size (one state per agent in the environment)
+   * @param stateBatch The batch of state time series (Format: BxTxS, B is batch size, T is the time series lenght, and S is the state size)
+   * @return The policies given the state series, one per entry of the batch
+   */
+  std::vector<policy_t> runInferencePolicy(const std::vector<std::vector<std::vector<float>>> &stateBatch);
+
   /**
    * @brief Calculates the starting experience index of the time sequence for the selected experience
    * @param expId The index of the latest experience in the sequence
@@ -662,6 +954,39 @@ class Agent : public Solver
    */
   std::vector<std::vector<float>> getTruncatedStateSequence(size_t expId);
 
+  /**
+   * @brief Assembles the policy that produced the action of an experience from the replay memory
+   * @param expId The index of the experience
+   * @return The experience policy
+   */
+  policy_t getExperiencePolicy(size_t expId);
+
+  /**
+   * @brief Assembles the most current policy of an experience from the replay memory
+   * @param expId The index of the experience
+   * @return The current policy
+   */
+  policy_t getCurrentPolicy(size_t expId);
+
+  /**
+   * @brief Stores the policy that produced the action of a new experience in the replay memory
+   * @param policy The experience policy
+   */
+  void addExperiencePolicy(const policy_t &policy);
+
+  /**
+   * @brief Adds the current policy of a new experience to the replay memory
+   * @param policy The current policy
+   */
+  void addCurrentPolicy(const policy_t &policy);
+
+  /**
+   * @brief Overwrites the most current policy of an experience in the replay memory
+   * @param expId The index of the experience
+   * @param policy The current policy
+   */
+  void setCurrentPolicy(size_t expId, const policy_t &policy);
+
   /**
    * @brief Calculates importance weight of current action from old and new policies
    * @param action The action taken
@@ -678,15 +1003,83 @@ class Agent : public Solver
   void attendAgent(const size_t agentId);
 
   /**
-   * @brief Serializes the experience replay into a JSON compatible format
+   * @brief Serializes the experience replay in the selected format
    */
   void serializeExperienceReplay();
 
   /**
-   * @brief Deserializes a JSON object into the experience replay
+   * @brief Deserializes the experience replay, from the binary snapshot if selected and present, or from JSON otherwise
    */
   void deserializeExperienceReplay();
 
+  /**
+   * @brief Appends the experiences added since the last snapshot to the binary replay log and rewrites the metadata file. The files are written in the background.
+   */
+  void serializeExperienceReplayBinary();
+
+  /**
+   * @brief Loads the experience replay from the memory-mapped binary replay log and metadata files
+   */
+  void deserializeExperienceReplayBinary();
+
+  /**
+   * @brief Waits for the background write of the last binary snapshot to finish, and reports its errors
+   */
+  void waitForExperienceReplaySerialization();
+
+  /**
+   * @brief Removes all experiences from the replay memory
+   */
+  void clearExperienceReplay();
+
+  /**
+   * @brief Adds the received experiences to the session count and checks whether a policy update is due
+   * @return True, if enough experiences have been received since the last policy update
+   */
+  bool isPolicyUpdateDue();
+
+  /**
+   * @brief Performs one policy update and updates the learning rate and REFER parameters
+   */
+  void runPolicyUpdate();
+
+  /**
+   * @brief Starts the learner thread, which performs the policy updates as they become due
+   */
+  void startLearnerThread();
+
+  /**
+   * @brief Stops the learner thread after its current policy update, and reports its errors
+   */
+  void stopLearnerThread();
+
+  /**
+   * @brief Main loop of the learner thread
+   */
+  void runLearnerThread();
+
+  /**
+   * @brief Wakes the learner thread up (if it is waiting) to check whether a policy update is due
+   */
+  void notifyLearner();
+
+  /**
+   * @brief Takes the latest policy published by the learner thread (if any) as the current training policy, and reports the learner's errors
+   */
+  void fetchLearnerPolicy();
+
+  /**
+   * @brief Returns the message that carries the current training policy to the environments, encoding it if it changed since the last call
+   * @return Message with the policy version, precision, and encoded hyperparameters
+   */
+  const knlohmann::json &getTrainingPolicyMessage();
+
+  /**
+   * @brief Sets the agent's policy from a message produced by getTrainingPolicyMessage
+   * @param message Message with the policy version, precision, and encoded hyperparameters
+   */
+  void setTrainingPolicyMessage(const knlohmann::json &message);
+
   /**
    * @brief Runs a generation when running in training mode
    */
@@ -702,6 +1095,33 @@ class Agent : public Solver
    */
   void rescaleStates();
 
+  /**
+   * @brief [Sharded replay] Allocates the shards on the workers, once the conduit is running
+   */
+  void allocateStateShards();
+
+  /**
+   * @brief [Sharded replay] Adds the state of an experience to the replay memory, releasing the state of the experience it replaces
+   * @param episode The episode that contains the experience
+   * @param expId The position of the experience in the episode
+   * @param localStateId The position of the experience's state among those sent along with the episode, increased if used
+   */
+  void addShardedState(const episode_t &episode, const size_t expId, size_t &localStateId);
+
+  /**
+   * @brief Copies the states of the given experiences, reading them from the shards if the replay is sharded
+   * @param expIds The indexes of the experiences
+   * @param dst Storage for the states, one after the other
+   */
+  void loadStates(const std::vector<size_t> &expIds, float *dst);
+
+  /**
+   * @brief Overwrites the states of the given experiences, writing them to the shards if the replay is sharded
+   * @param expIds The indexes of the experiences
+   * @param src The new states, one after the other
+   */
+  void storeStates(const std::vector<size_t> &expIds, const float *src);
+
   /**
    * @brief Rescales a given reward by the square root of the sum of squarred rewards
    * @param environmentId The id of the environment to which this reward belongs
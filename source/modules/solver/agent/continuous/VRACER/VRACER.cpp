@@ -30,7 +30,7 @@ void VRACER::initializeAgent()
   _criticPolicyExperiment["Problem"]["Type"] = "Supervised Learning";
   _criticPolicyExperiment["Problem"]["Max Timesteps"] = _timeSequenceLength;
   _criticPolicyExperiment["Problem"]["Training Batch Size"] = _miniBatchSize;
-  _criticPolicyExperiment["Problem"]["Inference Batch Size"] = 1;
+  _criticPolicyExperiment["Problem"]["Inference Batch Size"] = _problem->_agentsPerEnvironment;
   _criticPolicyExperiment["Problem"]["Input"]["Size"] = _problem->_stateVectorSize;
   _criticPolicyExperiment["Problem"]["Solution"]["Size"] = 1 + _policyParameterCount;
 
@@ -40,6 +40,7 @@ void VRACER::initializeAgent()
   _criticPolicyExperiment["Solver"]["Learning Rate"] = _currentLearningRate;
   _criticPolicyExperiment["Solver"]["Loss Function"] = "Direct Gradient";
   _criticPolicyExperiment["Solver"]["Steps Per Generation"] = 1;
+  _criticPolicyExperiment["Solver"]["Data Parallel Learners"] = _miniBatchDataParallelLearners;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Optimizer"] = _neuralNetworkOptimizer;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Engine"] = _neuralNetworkEngine;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Hidden Layers"] = _neuralNetworkHiddenLayers;
@@ -116,12 +117,12 @@ void VRACER::calculatePolicyGradients(const std::vector<size_t> &miniBatch)
     size_t expId = miniBatch[b];
 
     // Get state, action and policy for this experience
-    const auto &expPolicy = _expPolicyVector[expId];
-    const auto &expAction = _actionVector[expId];
+    const auto expPolicy = getExperiencePolicy(expId);
+    const auto expAction = _actionVector.getVector(expId);
 
     // Gathering metadata
     const float V = _stateValueVector[expId];
-    const auto &curPolicy = _curPolicyVector[expId];
+    const auto curPolicy = getCurrentPolicy(expId);
     const float expVtbc = _retraceValueVector[expId];
 
     // Storage for the update gradient
@@ -177,6 +178,9 @@ void VRACER::calculatePolicyGradients(const std::vector<size_t> &miniBatch)
       if (expPolicy.distributionParameters[_problem->_actionVectorSize + i] < _minMiniBatchPolicyStdDev[i]) _minMiniBatchPolicyStdDev[i] = expPolicy.distributionParameters[_problem->_actionVectorSize + i];
     }
 
+    // Correcting the bias of prioritized replay (the weight is one for uniform sampling)
+    for (size_t i = 0; i < gradientLoss.size(); i++) gradientLoss[i] *= _miniBatchSamplingWeights[b];
+
     // Set Gradient of Loss as Solution
     for (size_t i = 0; i < gradientLoss.size(); i++)
       if (std::isfinite(gradientLoss[i]) == false)
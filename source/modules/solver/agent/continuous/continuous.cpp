@@ -17,6 +17,10 @@ void Continuous::initializeAgent()
   // Getting continuous problem pointer
   _problem = dynamic_cast<problem::reinforcementLearning::Continuous *>(_k->_problem);
 
+  // Only the squashed normal policy needs the unbounded action to evaluate past actions
+  _policyActionProbabilityCount = 0;
+  _policyUnboundedActionCount = _policyDistribution == "Squashed Normal" ? _problem->_actionVectorSize : 0;
+
   // Obtaining action shift and scales for bounded distributions
   _actionShifts.resize(_problem->_actionVectorSize);
   _actionScales.resize(_problem->_actionVectorSize);
@@ -100,21 +104,31 @@ void Continuous::initializeAgent()
 
 void Continuous::getAction(korali::Sample &sample)
 {
-  // Get action for all the agents in the environment
-  for (size_t i = 0; i < sample["State"].size(); i++)
+  // Number of agents in the environment
+  const size_t agentCount = sample["State"].size();
+
+  // Storage for the state time sequences of all the agents
+  std::vector<std::vector<std::vector<float>>> stateSequenceBatch(agentCount);
+
+  for (size_t i = 0; i < agentCount; i++)
   {
-    // Getting current state
-    auto state = sample["State"][i];
+    // Adding current state to the agent's state time sequence
+    _stateTimeSequence[i].add(sample["State"][i].get<std::vector<float>>());
+    stateSequenceBatch[i] = _stateTimeSequence[i].getVector();
+  }
 
-    // Adding state to the state time sequence
-    _stateTimeSequence.add(state);
+  // Forward the state sequences of all agents at once to get the Gaussian means and sigmas from policy
+  auto policies = runInferencePolicy(stateSequenceBatch);
+
+  // Get action for all the agents in the environment
+  for (size_t i = 0; i < agentCount; i++)
+  {
+    // Policy for the agent's current state
+    auto &policy = policies[i];
 
     // Storage for the action to select
     std::vector<float> action(_problem->_actionVectorSize);
 
-    // Forward state sequence to get the Gaussian means and sigmas from policy
-    auto policy = runPolicy({_stateTimeSequence.getVector()})[0];
-
     /*****************************************************************************
      * During Training we select action according to policy's probability
      * distribution
@@ -25,7 +25,7 @@ void dVRACER::initializeAgent()
   _criticPolicyExperiment["Problem"]["Type"] = "Supervised Learning";
   _criticPolicyExperiment["Problem"]["Max Timesteps"] = _timeSequenceLength;
   _criticPolicyExperiment["Problem"]["Training Batch Size"] = _miniBatchSize;
-  _criticPolicyExperiment["Problem"]["Inference Batch Size"] = 1;
+  _criticPolicyExperiment["Problem"]["Inference Batch Size"] = _problem->_agentsPerEnvironment;
   _criticPolicyExperiment["Problem"]["Input"]["Size"] = _problem->_stateVectorSize;
   _criticPolicyExperiment["Problem"]["Solution"]["Size"] = 1 + _policyParameterCount; // The value function, action q values, and inverse temperature
 
@@ -35,6 +35,7 @@ void dVRACER::initializeAgent()
   _criticPolicyExperiment["Solver"]["Learning Rate"] = _currentLearningRate;
   _criticPolicyExperiment["Solver"]["Loss Function"] = "Direct Gradient";
   _criticPolicyExperiment["Solver"]["Steps Per Generation"] = 1;
+  _criticPolicyExperiment["Solver"]["Data Parallel Learners"] = _miniBatchDataParallelLearners;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Optimizer"] = _neuralNetworkOptimizer;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Engine"] = _neuralNetworkEngine;
   _criticPolicyExperiment["Solver"]["Neural Network"]["Hidden Layers"] = _neuralNetworkHiddenLayers;
@@ -99,10 +100,10 @@ void dVRACER::calculatePolicyGradients(const std::vector<size_t> &miniBatch)
     size_t expId = miniBatch[b];
 
     // Getting experience policy data
-    const auto &expPolicy = _expPolicyVector[expId];
+    const auto expPolicy = getExperiencePolicy(expId);
 
     // Getting current policy data
-    const auto &curPolicy = _curPolicyVector[expId];
+    const auto curPolicy = getCurrentPolicy(expId);
 
     // Getting value evaluation
     const float V = _stateValueVector[expId];
@@ -156,6 +157,9 @@ void dVRACER::calculatePolicyGradients(const std::vector<size_t> &miniBatch)
     for (size_t i = 0; i < _policyParameterCount; i++)
       gradientLoss[1 + i] += klGradMultiplier * klGrad[i];
 
+    // Correcting the bias of prioritized replay (the weight is one for uniform sampling)
+    for (size_t i = 0; i < gradientLoss.size(); i++) gradientLoss[i] *= _miniBatchSamplingWeights[b];
+
     // Set Gradient of Loss as Solution
     _criticPolicyProblem->_solutionData[b] = gradientLoss;
   }
@@ -16,21 +16,33 @@ void Discrete::initializeAgent()
   _problem = dynamic_cast<problem::reinforcementLearning::Discrete *>(_k->_problem);
 
   _policyParameterCount = _problem->_possibleActions.size() + 1; // q values and inverseTemperature
+  _policyActionProbabilityCount = _problem->_possibleActions.size();
+  _policyUnboundedActionCount = 0;
 }
 
 void Discrete::getAction(korali::Sample &sample)
 {
-  // Get action for all the agents in the environment
-  for (size_t i = 0; i < sample["State"].size(); i++)
+  // Number of agents in the environment
+  const size_t agentCount = sample["State"].size();
+
+  // Storage for the state time sequences of all the agents
+  std::vector<std::vector<std::vector<float>>> stateSequenceBatch(agentCount);
+
+  for (size_t i = 0; i < agentCount; i++)
   {
-    // Getting current state
-    auto state = sample["State"][i].get<std::vector<float>>();
+    // Adding current state to the agent's state time sequence
+    _stateTimeSequence[i].add(sample["State"][i].get<std::vector<float>>());
+    stateSequenceBatch[i] = _stateTimeSequence[i].getVector();
+  }
 
-    // Adding state to the state time sequence
-    _stateTimeSequence.add(state);
+  // Getting the probability of the actions given by the agent's policy, for all agents at once
+  const auto policies = runInferencePolicy(stateSequenceBatch);
 
-    // Getting the probability of the actions given by the agent's policy
-    auto policy = runPolicy({_stateTimeSequence.getVector()})[0];
+  // Get action for all the agents in the environment
+  for (size_t i = 0; i < agentCount; i++)
+  {
+    // Policy for the agent's current state
+    const auto &policy = policies[i];
     const auto &qValAndInvTemp = policy.distributionParameters;
     const auto &pActions = policy.actionProbabilities;
 
@@ -1,7 +1,10 @@
 #include "engine.hpp"
+#include "modules/problem/integration/integration.hpp"
 #include "modules/solver/integrator/integrator.hpp"
 #include "sample/sample.hpp"
 
+#include <gsl/gsl_qrng.h>
+
 namespace korali
 {
 namespace solver
@@ -11,8 +14,45 @@ namespace solver
 void Integrator::setInitialConfiguration()
 {
   _variableCount = _k->_variables.size();
+  _integrationMethod = dynamic_cast<problem::Integration *>(_k->_problem)->_integrationMethod;
 
   _integral = 0;
+  _errorEstimate = Inf;
+
+  if (_integrationMethod == "Sparse Grid")
+  {
+    if (_maxRefinementLevel < 1 || _maxRefinementLevel > 16) KORALI_LOG_ERROR("'Max Refinement Level' must be between 1 and 16 (is %zu).\n", _maxRefinementLevel);
+    _oldIndices.clear();
+    _activeIndices.clear();
+    _activeContributions.clear();
+    _evaluatedGridPoints.clear();
+    _evaluatedGridValues.clear();
+    _gridValues.clear();
+    _levelNodes.clear();
+    _sampleCount = _maxModelEvaluations;
+    return;
+  }
+
+  if (_integrationMethod == "Sobol" || _integrationMethod == "Halton")
+  {
+    if (_randomizationCount < 2) KORALI_LOG_ERROR("'Randomization Count' must be at least 2 to estimate the error (is %zu).\n", _randomizationCount);
+    if (_initialSequenceLength < 1) KORALI_LOG_ERROR("'Initial Sequence Length' must be a strictly positive integer.\n");
+    if (_integrationMethod == "Sobol" && _variableCount > 40) KORALI_LOG_ERROR("Sobol sequences support at most 40 variables (%zu given).\n", _variableCount);
+    if (_integrationMethod == "Halton" && _variableCount > 1229) KORALI_LOG_ERROR("Halton sequences support at most 1229 variables (%zu given).\n", _variableCount);
+
+    _sequenceLength = 0;
+    _randomizationSums.assign(_randomizationCount, 0.0);
+    _randomizationShifts.resize(_randomizationCount);
+    for (size_t r = 0; r < _randomizationCount; r++)
+    {
+      _randomizationShifts[r].resize(_variableCount);
+      for (size_t d = 0; d < _variableCount; d++)
+        _randomizationShifts[r][d] = _uniformGenerator->getRandomNumber();
+    }
+    _sampleCount = _maxModelEvaluations;
+    return;
+  }
+
   _sampleCount = 1;
   for (size_t i = 0; i < _variableCount; i++)
     _sampleCount *= _k->_variables[i]->_numberOfGridpoints;
@@ -34,6 +74,20 @@ void Integrator::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  _integrationMethod = dynamic_cast<problem::Integration *>(_k->_problem)->_integrationMethod;
+
+  if (_integrationMethod == "Sparse Grid" || _integrationMethod == "Sobol" || _integrationMethod == "Halton")
+  {
+    if (_integrationMethod == "Sparse Grid")
+      runSparseGridGeneration();
+    else
+      runQuasiMonteCarloGeneration();
+
+    (*_k)["Results"]["Integral"] = _integral;
+    (*_k)["Results"]["Error Estimate"] = _errorEstimate;
+    return;
+  }
+
   _executionsPerGeneration = std::min(_executionsPerGeneration, _maxModelEvaluations - _modelEvaluationCount);
 
   std::vector<Sample> samples(_executionsPerGeneration);
@@ -83,6 +137,344 @@ void Integrator::runGeneration()
     _integral += weight * f;
   }
   (*_k)["Results"]["Integral"] = _integral;
+  (*_k)["Results"]["Error Estimate"] = _errorEstimate;
+}
+
+void Integrator::evaluatePoints(const std::vector<std::vector<double>> &points, std::vector<double> &values)
+{
+  values.resize(points.size());
+  const size_t batchSize = std::max(_executionsPerGeneration, (size_t)1);
+
+  for (size_t start = 0; start < points.size(); start += batchSize)
+  {
+    const size_t end = std::min(start + batchSize, points.size());
+    std::vector<Sample> samples(end - start);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+      _k->_logger->logInfo("Detailed", "Running sample %zu with values:\n         ", _modelEvaluationCount + 1);
+      for (auto &x : points[start + i]) _k->_logger->logData("Detailed", " %le   ", x);
+      _k->_logger->logData("Detailed", "\n");
+
+      samples[i]["Sample Id"] = start + i;
+      samples[i]["Module"] = "Problem";
+      samples[i]["Operation"] = "Execute";
+      samples[i]["Parameters"] = points[start + i];
+      KORALI_START(samples[i]);
+      _modelEvaluationCount++;
+    }
+    KORALI_WAITALL(samples);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+      auto f = KORALI_GET(double, samples[i], "Evaluation");
+      values[start + i] = f;
+    }
+  }
+}
+
+void Integrator::initializeSparseGridRules()
+{
+  // Level rules are only built once an index first refines to them (see extendSparseGridRules)
+  _levelNodes.assign(1, std::vector<size_t>());
+  _levelDifferenceWeights.assign(1, std::vector<double>());
+
+  // Rebuilding the value lookup from the (checkpointed) evaluation record
+  _gridValues.clear();
+  for (size_t i = 0; i < _evaluatedGridPoints.size(); i++)
+    _gridValues[_evaluatedGridPoints[i]] = _evaluatedGridValues[i];
+}
+
+void Integrator::extendSparseGridRules(size_t level)
+{
+  // Node identifiers live on the finest level: node j of level l (2^(l-1) intervals) has id j * 2^(L-l)
+  const size_t finestIntervals = getFinestIntervalCount();
+
+  for (size_t l = _levelNodes.size(); l <= level; l++)
+  {
+    const auto weights = getClenshawCurtisWeights(l);
+    const auto previousWeights = getClenshawCurtisWeights(l - 1);
+    const size_t n = weights.size() - 1;
+
+    _levelNodes.push_back(std::vector<size_t>(weights.size()));
+    _levelDifferenceWeights.push_back(weights);
+
+    if (l == 1)
+    {
+      _levelNodes[l][0] = finestIntervals / 2;
+      continue;
+    }
+
+    // Level 2 contains the center node of level 1, deeper levels contain every other node of the previous level
+    for (size_t j = 0; j <= n; j++)
+    {
+      _levelNodes[l][j] = j * (finestIntervals / n);
+      if (l == 2 && j == 1) _levelDifferenceWeights[l][j] -= previousWeights[0];
+      if (l > 2 && j % 2 == 0) _levelDifferenceWeights[l][j] -= previousWeights[j / 2];
+    }
+  }
+}
+
+std::vector<double> Integrator::getClenshawCurtisWeights(size_t level) const
+{
+  if (level == 0) return std::vector<double>();
+  if (level == 1) return std::vector<double>({2.0});
+
+  // Clenshaw-Curtis weights on [-1,1] for the nodes cos(j*pi/n), which are symmetric in j
+  const size_t n = (size_t)1 << (level - 1);
+  std::vector<double> weights(n + 1);
+  for (size_t j = 0; j <= n / 2; j++)
+  {
+    // Summing b_k / (4k^2 - 1) * T_k(cos(2*pi*j/n)) over k = 1..n/2 with Clenshaw's recurrence
+    const double x = std::cos(2.0 * j * M_PI / n);
+    double b1 = 0.0;
+    double b2 = 0.0;
+    for (size_t k = n / 2; k >= 1; k--)
+    {
+      const double b = (2 * k == n) ? 1.0 : 2.0;
+      const double b0 = b / (4.0 * k * k - 1.0) + 2.0 * x * b1 - b2;
+      b2 = b1;
+      b1 = b0;
+    }
+    const double sum = x * b1 - b2;
+
+    const double c = (j == 0) ? 1.0 : 2.0;
+    weights[j] = c / n * (1.0 - sum);
+    weights[n - j] = weights[j];
+  }
+
+  return weights;
+}
+
+size_t Integrator::getFinestIntervalCount() const
+{
+  return (size_t)1 << std::max(_maxRefinementLevel - 1, (size_t)1);
+}
+
+double Integrator::getGridCoordinate(size_t variableIdx, size_t nodeId) const
+{
+  const double finestIntervals = (double)getFinestIntervalCount();
+  const double center = 0.5 * (_k->_variables[variableIdx]->_upperBound + _k->_variables[variableIdx]->_lowerBound);
+  const double halfWidth = 0.5 * (_k->_variables[variableIdx]->_upperBound - _k->_variables[variableIdx]->_lowerBound);
+  return center + halfWidth * std::cos(nodeId * M_PI / finestIntervals);
+}
+
+void Integrator::evaluateTensorGrids(const std::vector<std::vector<size_t>> &indices)
+{
+  std::vector<std::vector<size_t>> newNodes;
+  std::map<std::vector<size_t>, bool> scheduled;
+
+  for (const auto &index : indices)
+  {
+    std::vector<size_t> counter(_variableCount, 0);
+    std::vector<size_t> node(_variableCount);
+    bool done = false;
+    while (done == false)
+    {
+      for (size_t d = 0; d < _variableCount; d++) node[d] = _levelNodes[index[d]][counter[d]];
+      if (_gridValues.count(node) == 0 && scheduled.count(node) == 0)
+      {
+        scheduled[node] = true;
+        newNodes.push_back(node);
+      }
+
+      // Advancing the tensor product odometer
+      done = true;
+      for (size_t d = 0; d < _variableCount; d++)
+        if (++counter[d] < _levelNodes[index[d]].size())
+        {
+          done = false;
+          break;
+        }
+        else
+          counter[d] = 0;
+    }
+  }
+
+  std::vector<std::vector<double>> points(newNodes.size(), std::vector<double>(_variableCount));
+  for (size_t i = 0; i < newNodes.size(); i++)
+    for (size_t d = 0; d < _variableCount; d++)
+      points[i][d] = getGridCoordinate(d, newNodes[i][d]);
+
+  std::vector<double> values;
+  evaluatePoints(points, values);
+
+  for (size_t i = 0; i < newNodes.size(); i++)
+  {
+    _gridValues[newNodes[i]] = values[i];
+    _evaluatedGridPoints.push_back(newNodes[i]);
+    _evaluatedGridValues.push_back(values[i]);
+  }
+}
+
+double Integrator::getTensorDifference(const std::vector<size_t> &index) const
+{
+  double scale = 1.0;
+  for (size_t d = 0; d < _variableCount; d++)
+    scale *= 0.5 * (_k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound);
+
+  double difference = 0.0;
+  std::vector<size_t> counter(_variableCount, 0);
+  std::vector<size_t> node(_variableCount);
+  bool done = false;
+  while (done == false)
+  {
+    double weight = 1.0;
+    for (size_t d = 0; d < _variableCount; d++)
+    {
+      node[d] = _levelNodes[index[d]][counter[d]];
+      weight *= _levelDifferenceWeights[index[d]][counter[d]];
+    }
+    if (weight != 0.0) difference += weight * _gridValues.at(node);
+
+    done = true;
+    for (size_t d = 0; d < _variableCount; d++)
+      if (++counter[d] < _levelNodes[index[d]].size())
+      {
+        done = false;
+        break;
+      }
+      else
+        counter[d] = 0;
+  }
+
+  return scale * difference;
+}
+
+void Integrator::runSparseGridGeneration()
+{
+  if (_levelNodes.empty() || _gridValues.size() != _evaluatedGridValues.size()) initializeSparseGridRules();
+
+  std::vector<std::vector<size_t>> newIndices;
+
+  if (_oldIndices.empty() && _activeIndices.empty())
+  {
+    // Starting from the coarsest (single point) rule
+    newIndices.push_back(std::vector<size_t>(_variableCount, 1));
+  }
+  else
+  {
+    // Only reachable when the 'Grid Completed' criterion is disabled
+    if (_activeIndices.empty()) KORALI_LOG_ERROR("The sparse grid is complete up to the 'Max Refinement Level' (%zu), there is no index left to refine.\n", _maxRefinementLevel);
+
+    // Refining the active index with the largest hierarchical surplus
+    size_t selected = 0;
+    for (size_t i = 1; i < _activeIndices.size(); i++)
+      if (std::abs(_activeContributions[i]) > std::abs(_activeContributions[selected])) selected = i;
+
+    const auto refined = _activeIndices[selected];
+    _oldIndices.push_back(refined);
+    _activeIndices.erase(_activeIndices.begin() + selected);
+    _activeContributions.erase(_activeContributions.begin() + selected);
+
+    // Adding the forward neighbours whose backward neighbours are all old (admissibility)
+    for (size_t d = 0; d < _variableCount; d++)
+    {
+      auto forward = refined;
+      forward[d]++;
+      if (forward[d] > _maxRefinementLevel) continue;
+
+      bool isAdmissible = true;
+      for (size_t e = 0; e < _variableCount && isAdmissible; e++)
+      {
+        if (forward[e] == 1) continue;
+        auto backward = forward;
+        backward[e]--;
+        if (std::find(_oldIndices.begin(), _oldIndices.end(), backward) == _oldIndices.end()) isAdmissible = false;
+      }
+
+      if (isAdmissible) newIndices.push_back(forward);
+    }
+  }
+
+  for (const auto &index : newIndices) extendSparseGridRules(*std::max_element(index.begin(), index.end()));
+
+  evaluateTensorGrids(newIndices);
+
+  for (const auto &index : newIndices)
+  {
+    const double difference = getTensorDifference(index);
+    _activeIndices.push_back(index);
+    _activeContributions.push_back(difference);
+    _integral += difference;
+  }
+
+  // The surpluses of the not yet refined indices estimate the remaining error
+  _errorEstimate = 0.0;
+  for (const auto &c : _activeContributions) _errorEstimate += std::abs(c);
+}
+
+void Integrator::runQuasiMonteCarloGeneration()
+{
+  // Doubling the sequence on every generation keeps the points of a (0,m)-net balanced
+  const size_t newPointCount = _sequenceLength == 0 ? _initialSequenceLength : _sequenceLength;
+  const double twoPow32 = 4294967296.0;
+
+  gsl_qrng *generator = gsl_qrng_alloc(_integrationMethod == "Sobol" ? gsl_qrng_sobol : gsl_qrng_halton, _variableCount);
+  std::vector<double> u(_variableCount);
+
+  // Replaying the consumed prefix keeps the generator state out of the checkpoint
+  for (size_t i = 0; i < _sequenceLength; i++) gsl_qrng_get(generator, u.data());
+
+  std::vector<std::vector<double>> points(newPointCount * _randomizationCount, std::vector<double>(_variableCount));
+  for (size_t i = 0; i < newPointCount; i++)
+  {
+    gsl_qrng_get(generator, u.data());
+
+    for (size_t r = 0; r < _randomizationCount; r++)
+      for (size_t d = 0; d < _variableCount; d++)
+      {
+        double x;
+        if (_integrationMethod == "Sobol")
+        {
+          // Random digital shift: XOR of the 32-bit binary expansions
+          const uint32_t digits = (uint32_t)(u[d] * twoPow32);
+          const uint32_t shift = (uint32_t)(_randomizationShifts[r][d] * twoPow32);
+          x = (double)(digits ^ shift) / twoPow32;
+        }
+        else
+        {
+          // Cranley-Patterson rotation modulo one
+          x = u[d] + _randomizationShifts[r][d];
+          if (x >= 1.0) x -= 1.0;
+        }
+
+        points[i * _randomizationCount + r][d] = _k->_variables[d]->_lowerBound + x * (_k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound);
+      }
+  }
+
+  gsl_qrng_free(generator);
+
+  std::vector<double> values;
+  evaluatePoints(points, values);
+
+  for (size_t i = 0; i < newPointCount; i++)
+    for (size_t r = 0; r < _randomizationCount; r++)
+      _randomizationSums[r] += values[i * _randomizationCount + r];
+
+  _sequenceLength += newPointCount;
+
+  double volume = 1.0;
+  for (size_t d = 0; d < _variableCount; d++)
+    volume *= _k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound;
+
+  // The randomizations are independent unbiased estimates; their spread gives the error
+  std::vector<double> estimates(_randomizationCount);
+  double mean = 0.0;
+  for (size_t r = 0; r < _randomizationCount; r++)
+  {
+    estimates[r] = volume * _randomizationSums[r] / (double)_sequenceLength;
+    mean += estimates[r];
+  }
+  mean /= (double)_randomizationCount;
+
+  double variance = 0.0;
+  for (size_t r = 0; r < _randomizationCount; r++)
+    variance += (estimates[r] - mean) * (estimates[r] - mean);
+  variance /= (double)(_randomizationCount - 1);
+
+  _integral = mean;
+  _errorEstimate = std::sqrt(variance / (double)_randomizationCount);
 }
 
 void Integrator::printGenerationBefore()
@@ -91,12 +483,20 @@ void Integrator::printGenerationBefore()
 
 void Integrator::printGenerationAfter()
 {
+  if (_integrationMethod == "Sparse Grid" || _integrationMethod == "Sobol" || _integrationMethod == "Halton")
+  {
+    _k->_logger->logInfo("Minimal", "Model Evaluations: %lu - Integral: %e - Error Estimate: %e\n", _modelEvaluationCount, _integral, _errorEstimate);
+    if (_integrationMethod == "Sparse Grid") _k->_logger->logInfo("Normal", "Active Indices: %zu - Old Indices: %zu\n", _activeIndices.size(), _oldIndices.size());
+    return;
+  }
+
   _k->_logger->logInfo("Minimal", "Total Terms summed %lu/%lu.\n", _modelEvaluationCount, _sampleCount);
 }
 
 void Integrator::finalize()
 {
   _k->_logger->logInfo("Minimal", "Integral Calculated: %e\n", _integral);
+  if (_errorEstimate < Inf) _k->_logger->logInfo("Minimal", "Error Estimate: %e\n", _errorEstimate);
 }
 
 void Integrator::setConfiguration(knlohmann::json& js) 
@@ -127,6 +527,87 @@ void Integrator::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Indices Helper");
  }
 
+ if (isDefined(js, "Error Estimate"))
+ {
+ try { _errorEstimate = js["Error Estimate"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Error Estimate']\n%s", e.what()); } 
+   eraseValue(js, "Error Estimate");
+ }
+
+ if (isDefined(js, "Old Indices"))
+ {
+ try { _oldIndices = js["Old Indices"].get<std::vector<std::vector<size_t>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Old Indices']\n%s", e.what()); } 
+   eraseValue(js, "Old Indices");
+ }
+
+ if (isDefined(js, "Active Indices"))
+ {
+ try { _activeIndices = js["Active Indices"].get<std::vector<std::vector<size_t>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Active Indices']\n%s", e.what()); } 
+   eraseValue(js, "Active Indices");
+ }
+
+ if (isDefined(js, "Active Contributions"))
+ {
+ try { _activeContributions = js["Active Contributions"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Active Contributions']\n%s", e.what()); } 
+   eraseValue(js, "Active Contributions");
+ }
+
+ if (isDefined(js, "Evaluated Grid Points"))
+ {
+ try { _evaluatedGridPoints = js["Evaluated Grid Points"].get<std::vector<std::vector<size_t>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Evaluated Grid Points']\n%s", e.what()); } 
+   eraseValue(js, "Evaluated Grid Points");
+ }
+
+ if (isDefined(js, "Evaluated Grid Values"))
+ {
+ try { _evaluatedGridValues = js["Evaluated Grid Values"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Evaluated Grid Values']\n%s", e.what()); } 
+   eraseValue(js, "Evaluated Grid Values");
+ }
+
+ if (isDefined(js, "Sequence Length"))
+ {
+ try { _sequenceLength = js["Sequence Length"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Sequence Length']\n%s", e.what()); } 
+   eraseValue(js, "Sequence Length");
+ }
+
+ if (isDefined(js, "Randomization Sums"))
+ {
+ try { _randomizationSums = js["Randomization Sums"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Randomization Sums']\n%s", e.what()); } 
+   eraseValue(js, "Randomization Sums");
+ }
+
+ if (isDefined(js, "Randomization Shifts"))
+ {
+ try { _randomizationShifts = js["Randomization Shifts"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Randomization Shifts']\n%s", e.what()); } 
+   eraseValue(js, "Randomization Shifts");
+ }
+
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
  if (isDefined(js, "Executions Per Generation"))
  {
  try { _executionsPerGeneration = js["Executions Per Generation"].get<size_t>();
@@ -136,6 +617,51 @@ void Integrator::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Executions Per Generation'] required by integrator.\n"); 
 
+ if (isDefined(js, "Max Refinement Level"))
+ {
+ try { _maxRefinementLevel = js["Max Refinement Level"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Max Refinement Level']\n%s", e.what()); } 
+   eraseValue(js, "Max Refinement Level");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Max Refinement Level'] required by integrator.\n"); 
+
+ if (isDefined(js, "Randomization Count"))
+ {
+ try { _randomizationCount = js["Randomization Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Randomization Count']\n%s", e.what()); } 
+   eraseValue(js, "Randomization Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Randomization Count'] required by integrator.\n"); 
+
+ if (isDefined(js, "Initial Sequence Length"))
+ {
+ try { _initialSequenceLength = js["Initial Sequence Length"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Initial Sequence Length']\n%s", e.what()); } 
+   eraseValue(js, "Initial Sequence Length");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Initial Sequence Length'] required by integrator.\n"); 
+
+ if (isDefined(js, "Termination Criteria", "Error Tolerance"))
+ {
+ try { _errorTolerance = js["Termination Criteria"]["Error Tolerance"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Termination Criteria']['Error Tolerance']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Error Tolerance");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Error Tolerance'] required by integrator.\n"); 
+
+ if (isDefined(js, "Termination Criteria", "Grid Completed"))
+ {
+ try { _gridCompleted = js["Termination Criteria"]["Grid Completed"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ integrator ] \n + Key:    ['Termination Criteria']['Grid Completed']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Grid Completed");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Grid Completed'] required by integrator.\n"); 
+
  Solver::setConfiguration(js);
  _type = "integrator";
  if(isDefined(js, "Type")) eraseValue(js, "Type");
@@ -147,16 +673,31 @@ void Integrator::getConfiguration(knlohmann::json& js)
 
  js["Type"] = _type;
    js["Executions Per Generation"] = _executionsPerGeneration;
+   js["Max Refinement Level"] = _maxRefinementLevel;
+   js["Randomization Count"] = _randomizationCount;
+   js["Initial Sequence Length"] = _initialSequenceLength;
+   js["Termination Criteria"]["Error Tolerance"] = _errorTolerance;
+   js["Termination Criteria"]["Grid Completed"] = _gridCompleted;
    js["Sample Count"] = _sampleCount;
    js["Integral"] = _integral;
    js["Indices Helper"] = _indicesHelper;
+   js["Error Estimate"] = _errorEstimate;
+   js["Old Indices"] = _oldIndices;
+   js["Active Indices"] = _activeIndices;
+   js["Active Contributions"] = _activeContributions;
+   js["Evaluated Grid Points"] = _evaluatedGridPoints;
+   js["Evaluated Grid Values"] = _evaluatedGridValues;
+   js["Sequence Length"] = _sequenceLength;
+   js["Randomization Sums"] = _randomizationSums;
+   js["Randomization Shifts"] = _randomizationShifts;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
  Solver::getConfiguration(js);
 } 
 
 void Integrator::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Executions Per Generation\": 500000000}";
+ std::string defaultString = "{\"Executions Per Generation\": 500000000, \"Max Refinement Level\": 12, \"Randomization Count\": 8, \"Initial Sequence Length\": 64, \"Termination Criteria\": {\"Error Tolerance\": -Infinity, \"Grid Completed\": true}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Solver::applyModuleDefaults(js);
@@ -168,6 +709,26 @@ void Integrator::applyVariableDefaults()
  Solver::applyVariableDefaults();
 } 
 
+bool Integrator::checkTermination()
+{
+ bool hasFinished = false;
+
+ if (_errorEstimate <= _errorTolerance)
+ {
+  _terminationCriteria.push_back("integrator['Error Tolerance'] = " + std::to_string(_errorTolerance) + ".");
+  hasFinished = true;
+ }
+
+ if (_gridCompleted && (_integrationMethod == "Sparse Grid") && _activeIndices.empty() && (_oldIndices.empty() == false))
+ {
+  _terminationCriteria.push_back("integrator['Grid Completed'] = " + std::to_string(_gridCompleted) + ".");
+  hasFinished = true;
+ }
+
+ hasFinished = hasFinished || Solver::checkTermination();
+ return hasFinished;
+}
+
 ;
 
 } //solver
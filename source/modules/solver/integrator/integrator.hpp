@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include "modules/distribution/univariate/uniform/uniform.hpp"
 #include "modules/solver/solver.hpp"
+#include <map>
 
 namespace korali
 {
@@ -25,12 +27,107 @@ namespace solver
 */
 class Integrator : public Solver
 {
+  private:
+  /**
+   * @brief Integration method selected in the problem
+   */
+  std::string _integrationMethod;
+
+  /**
+   * @brief [Sparse Grid] Node identifiers of each Clenshaw-Curtis level (index 0 unused)
+   */
+  std::vector<std::vector<size_t>> _levelNodes;
+
+  /**
+   * @brief [Sparse Grid] Difference weights (level minus previous level) on [-1,1] matching _levelNodes
+   */
+  std::vector<std::vector<double>> _levelDifferenceWeights;
+
+  /**
+   * @brief [Sparse Grid] Integrand value per evaluated node tuple, rebuilt from the internal settings after a resume
+   */
+  std::map<std::vector<size_t>, double> _gridValues;
+
+  /**
+   * @brief [Sparse Grid] Resets the nested Clenshaw-Curtis node and difference weight tables and rebuilds the value lookup.
+   */
+  void initializeSparseGridRules();
+
+  /**
+   * @brief [Sparse Grid] Appends the node and difference weight tables of all levels up to the given one that are not built yet.
+   * @param level Highest level required
+   */
+  void extendSparseGridRules(size_t level);
+
+  /**
+   * @brief [Sparse Grid] Computes the Clenshaw-Curtis weights on [-1,1] of a level.
+   * @param level Level of the rule (empty for level 0)
+   * @return The weights, ordered like the nodes cos(j*pi/n)
+   */
+  std::vector<double> getClenshawCurtisWeights(size_t level) const;
+
+  /**
+   * @brief [Sparse Grid] Returns the number of intervals of the finest grid on which node identifiers are defined.
+   * @return The interval count, at least two so that the single node of level 1 lies at the center of the interval
+   */
+  size_t getFinestIntervalCount() const;
+
+  /**
+   * @brief [Sparse Grid] Maps a canonical node identifier to a coordinate within the bounds of a variable.
+   * @param variableIdx Index of the variable
+   * @param nodeId Canonical node identifier
+   * @return The coordinate
+   */
+  double getGridCoordinate(size_t variableIdx, size_t nodeId) const;
+
+  /**
+   * @brief [Sparse Grid] Evaluates all nodes of the given level multi-indices not evaluated yet.
+   * @param indices Level multi-indices
+   */
+  void evaluateTensorGrids(const std::vector<std::vector<size_t>> &indices);
+
+  /**
+   * @brief [Sparse Grid] Computes the tensor difference integral of a level multi-index from evaluated nodes.
+   * @param index Level multi-index
+   * @return The hierarchical surplus of the index
+   */
+  double getTensorDifference(const std::vector<size_t> &index) const;
+
+  /**
+   * @brief [Sparse Grid] Performs one dimension-adaptive refinement step.
+   */
+  void runSparseGridGeneration();
+
+  /**
+   * @brief [Sobol/Halton] Evaluates the next block of the randomized low-discrepancy sequence.
+   */
+  void runQuasiMonteCarloGeneration();
+
+  /**
+   * @brief Evaluates the integrand at the given points, launching at most 'Executions Per Generation' samples at a time.
+   * @param points Points to evaluate
+   * @param values Integrand values, in the same order as the points
+   */
+  void evaluatePoints(const std::vector<std::vector<double>> &points, std::vector<double> &values);
+
   public: 
   /**
-  * @brief Specifies the number of model executions per generation. By default this setting is 0, meaning that all executions will be performed in the first generation. For values greater 0, executions will be split into batches and split int generations for intermediate output.
+  * @brief Specifies the number of model executions per generation. By default this setting is 0, meaning that all executions will be performed in the first generation. For values greater 0, executions will be split into batches and split int generations for intermediate output. For the 'Sparse Grid', 'Sobol' and 'Halton' methods, a generation is one refinement step and this setting bounds the number of concurrently launched executions.
   */
    size_t _executionsPerGeneration;
   /**
+  * @brief [Sparse Grid] Maximum Clenshaw-Curtis level per dimension. Level l uses 2^(l-1)+1 points (one point for level 1), and at most 16 levels are supported.
+  */
+   size_t _maxRefinementLevel;
+  /**
+  * @brief [Sobol/Halton] Number of independent randomizations of the low-discrepancy sequence. The spread of their estimates gives the error estimate.
+  */
+   size_t _randomizationCount;
+  /**
+  * @brief [Sobol/Halton] Number of sequence points per randomization in the first generation. The sequence length doubles on every following generation.
+  */
+   size_t _initialSequenceLength;
+  /**
   * @brief [Internal Use] Number of samples to execute.
   */
    size_t _sampleCount;
@@ -42,8 +139,61 @@ class Integrator : public Solver
   * @brief [Internal Use] Holds helper to calculate cartesian indices from linear index.
   */
    std::vector<size_t> _indicesHelper;
+  /**
+  * @brief [Internal Use] Current estimate of the absolute integration error.
+  */
+   double _errorEstimate;
+  /**
+  * @brief [Internal Use] [Sparse Grid] Level multi-indices whose forward neighbours have already been added.
+  */
+   std::vector<std::vector<size_t>> _oldIndices;
+  /**
+  * @brief [Internal Use] [Sparse Grid] Level multi-indices that are candidates for refinement.
+  */
+   std::vector<std::vector<size_t>> _activeIndices;
+  /**
+  * @brief [Internal Use] [Sparse Grid] Hierarchical surplus (tensor difference integral) of each active multi-index.
+  */
+   std::vector<double> _activeContributions;
+  /**
+  * @brief [Internal Use] [Sparse Grid] Canonical node identifiers of all evaluated points.
+  */
+   std::vector<std::vector<size_t>> _evaluatedGridPoints;
+  /**
+  * @brief [Internal Use] [Sparse Grid] Integrand values at the evaluated points.
+  */
+   std::vector<double> _evaluatedGridValues;
+  /**
+  * @brief [Internal Use] [Sobol/Halton] Number of sequence points consumed so far per randomization.
+  */
+   size_t _sequenceLength;
+  /**
+  * @brief [Internal Use] [Sobol/Halton] Accumulated integrand values per randomization.
+  */
+   std::vector<double> _randomizationSums;
+  /**
+  * @brief [Internal Use] [Sobol/Halton] Random shift in [0,1)^D applied to the sequence for each randomization.
+  */
+   std::vector<std::vector<double>> _randomizationShifts;
+  /**
+  * @brief [Internal Use] Uniform random number generator for the sequence randomization.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Termination Criteria] [Sparse Grid/Sobol/Halton] Stops the integration once the estimated absolute error falls below this value.
+  */
+   double _errorTolerance;
+  /**
+  * @brief [Termination Criteria] [Sparse Grid] Stops the integration once every level multi-index up to the Max Refinement Level has been refined.
+  */
+   int _gridCompleted;
   
  
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
   /**
   * @brief Obtains the entire current state and configuration of the module.
   * @param js JSON object onto which to save the serialized state of the module.
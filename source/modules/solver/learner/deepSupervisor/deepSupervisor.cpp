@@ -2,6 +2,7 @@
 #include "modules/experiment/experiment.hpp"
 #include "modules/solver/learner/deepSupervisor/deepSupervisor.hpp"
 #include "sample/sample.hpp"
+#include <algorithm>
 #include <omp.h>
 
 namespace korali
@@ -64,9 +65,34 @@ void DeepSupervisor::initialize()
   neuralNetworkConfig["Layers"][curLayer] = _neuralNetworkOutputLayer;
   neuralNetworkConfig["Layers"][curLayer]["Type"] = "Layer/Output";
 
+  /*****************************************************************
+   * Splitting the training batch among data parallel learners
+   *****************************************************************/
+
+  const size_t N = _problem->_trainingBatchSize;
+  const size_t L = _dataParallelLearners;
+
+  if (L == 0) KORALI_LOG_ERROR("The number of data parallel learners must be at least one.\n");
+  if (L > N) KORALI_LOG_ERROR("The number of data parallel learners (%lu) is larger than the training batch size (%lu).\n", L, N);
+  if (L > (size_t)omp_get_max_threads()) KORALI_LOG_ERROR("The number of data parallel learners (%lu) is larger than the number of available threads (%d).\n", L, omp_get_max_threads());
+
+  // Slices differ in at most one input, and their boundaries only depend on the batch size and the number of learners
+  _dataParallelSliceOffsets.resize(L + 1);
+  for (size_t i = 0; i <= L; i++) _dataParallelSliceOffsets[i] = i * N / L;
+
+  std::vector<size_t> trainingBatchSizes({_problem->_trainingBatchSize, _problem->_inferenceBatchSize});
+  for (size_t i = 0; L > 1 && i < L; i++)
+  {
+    const size_t sliceSize = _dataParallelSliceOffsets[i + 1] - _dataParallelSliceOffsets[i];
+    if (std::find(trainingBatchSizes.begin(), trainingBatchSizes.end(), sliceSize) == trainingBatchSizes.end()) trainingBatchSizes.push_back(sliceSize);
+  }
+
+  _dataParallelOutputValues.resize(L > 1 ? N : 0);
+  _dataParallelGradients.resize(L > 1 ? L : 0);
+
   // Instancing training neural network
   auto trainingNeuralNetworkConfig = neuralNetworkConfig;
-  trainingNeuralNetworkConfig["Batch Sizes"] = {_problem->_trainingBatchSize, _problem->_inferenceBatchSize};
+  trainingNeuralNetworkConfig["Batch Sizes"] = trainingBatchSizes;
   trainingNeuralNetworkConfig["Mode"] = "Training";
   _neuralNetwork = dynamic_cast<NeuralNetwork *>(getModule(trainingNeuralNetworkConfig, _k));
   _neuralNetwork->applyModuleDefaults(trainingNeuralNetworkConfig);
@@ -111,44 +137,53 @@ void DeepSupervisor::runGeneration()
 
   for (size_t step = 0; step < _stepsPerGeneration; step++)
   {
-    // If we use an MSE loss function, we need to update the gradient vector with its difference with each of batch's last timestep of the NN output
-    if (_lossFunction == "Mean Squared Error")
-    {
-      // Checking that incoming data has a correct format
-      _problem->verifyData();
-
-      // Creating gradient vector
-      auto gradientVector = _problem->_solutionData;
-
-      // Forward propagating the input values through the training neural network
-      _neuralNetwork->forward(_problem->_inputData);
+    // Storage for the hyperparameter gradients of the whole batch
+    std::vector<float> nnHyperparameterGradients;
 
-      // Getting a reference to the neural network output
-      const auto &results = _neuralNetwork->getOutputValues(N);
-
-      // Calculating gradients via the loss function
-      for (size_t b = 0; b < N; b++)
-        for (size_t i = 0; i < OC; i++)
-          gradientVector[b][i] = gradientVector[b][i] - results[b][i];
-
-      // Backward propagating the gradients through the training neural network
-      _neuralNetwork->backward(gradientVector);
-
-      // Calculating loss across the batch size
-      _currentLoss = 0.0;
-      for (size_t b = 0; b < N; b++)
-        for (size_t i = 0; i < OC; i++)
-          _currentLoss += gradientVector[b][i] * gradientVector[b][i];
-      _currentLoss = _currentLoss / ((float)N * 2.0f);
+    // With several learners, each one processes a slice of the batch
+    if (_dataParallelLearners > 1)
+      nnHyperparameterGradients = getDataParallelGradients();
+    else
+    {
+      // If we use an MSE loss function, we need to update the gradient vector with its difference with each of batch's last timestep of the NN output
+      if (_lossFunction == "Mean Squared Error")
+      {
+        // Checking that incoming data has a correct format
+        _problem->verifyData();
+
+        // Creating gradient vector
+        auto gradientVector = _problem->_solutionData;
+
+        // Forward propagating the input values through the training neural network
+        _neuralNetwork->forward(_problem->_inputData);
+
+        // Getting a reference to the neural network output
+        const auto &results = _neuralNetwork->getOutputValues(N);
+
+        // Calculating gradients via the loss function
+        for (size_t b = 0; b < N; b++)
+          for (size_t i = 0; i < OC; i++)
+            gradientVector[b][i] = gradientVector[b][i] - results[b][i];
+
+        // Backward propagating the gradients through the training neural network
+        _neuralNetwork->backward(gradientVector);
+
+        // Calculating loss across the batch size
+        _currentLoss = 0.0;
+        for (size_t b = 0; b < N; b++)
+          for (size_t i = 0; i < OC; i++)
+            _currentLoss += gradientVector[b][i] * gradientVector[b][i];
+        _currentLoss = _currentLoss / ((float)N * 2.0f);
+      }
+
+      // If using direct gradient, backward propagating the gradients directly through the training neural network
+      if (_lossFunction == "Direct Gradient")
+        _neuralNetwork->backward(_problem->_solutionData);
+
+      // Getting hyperparameter gradients
+      nnHyperparameterGradients = _neuralNetwork->getHyperparameterGradients(N);
     }
 
-    // If using direct gradient, backward propagating the gradients directly through the training neural network
-    if (_lossFunction == "Direct Gradient")
-      _neuralNetwork->backward(_problem->_solutionData);
-
-    // Getting hyperparameter gradients
-    auto nnHyperparameterGradients = _neuralNetwork->getHyperparameterGradients(N);
-
     // Apply gradient of L2 regularizer
     if (_l2RegularizationEnabled)
     {
@@ -166,6 +201,76 @@ void DeepSupervisor::runGeneration()
   }
 }
 
+void DeepSupervisor::runDataParallel(const std::function<void(const size_t, const size_t, const size_t)> &function)
+{
+  const size_t L = _dataParallelLearners;
+  size_t learnerCount = 0;
+
+  // Every thread uses its own layer pipeline, so the learners only share the hyperparameters of the network
+#pragma omp parallel num_threads(L)
+  {
+    const size_t learnerId = omp_get_thread_num();
+    if (learnerId == 0) learnerCount = omp_get_num_threads();
+    if (learnerId < L) function(learnerId, _dataParallelSliceOffsets[learnerId], _dataParallelSliceOffsets[learnerId + 1]);
+  }
+
+  if (learnerCount != L) KORALI_LOG_ERROR("Only %lu threads were available to run %lu data parallel learners.\n", learnerCount, L);
+}
+
+std::vector<float> DeepSupervisor::getDataParallelGradients()
+{
+  // Grabbing constants
+  const size_t N = _problem->_trainingBatchSize;
+  const size_t OC = _problem->_solutionSize;
+  const size_t L = _dataParallelLearners;
+
+  // Checking that incoming data has a correct format
+  if (_lossFunction == "Mean Squared Error") _problem->verifyData();
+
+  // Storage for the loss of every slice
+  std::vector<float> sliceLosses(L, 0.0f);
+
+  runDataParallel([&](const size_t learnerId, const size_t start, const size_t end) {
+    const size_t sliceSize = end - start;
+    std::vector<std::vector<float>> gradientVector(_problem->_solutionData.begin() + start, _problem->_solutionData.begin() + end);
+
+    if (_lossFunction == "Mean Squared Error")
+    {
+      // Forward propagating the slice, its activations are kept by this learner's pipeline for the backward propagation
+      const std::vector<std::vector<std::vector<float>>> inputSlice(_problem->_inputData.begin() + start, _problem->_inputData.begin() + end);
+      _neuralNetwork->forward(inputSlice);
+      const auto &results = _neuralNetwork->getOutputValues(sliceSize);
+
+      for (size_t b = 0; b < sliceSize; b++)
+        for (size_t i = 0; i < OC; i++)
+        {
+          gradientVector[b][i] = gradientVector[b][i] - results[b][i];
+          sliceLosses[learnerId] += gradientVector[b][i] * gradientVector[b][i];
+        }
+    }
+
+    // With direct gradients, the slice was forward propagated by this learner in getEvaluation
+    _neuralNetwork->backward(gradientVector);
+    _dataParallelGradients[learnerId] = _neuralNetwork->getHyperparameterGradients(sliceSize);
+  });
+
+  // Summing the gradients of the slices always in learner order, so that the result does not depend on the thread scheduling
+  std::vector<float> hyperparameterGradients = _dataParallelGradients[0];
+#pragma omp parallel for
+  for (size_t i = 0; i < hyperparameterGradients.size(); i++)
+    for (size_t l = 1; l < L; l++)
+      hyperparameterGradients[i] += _dataParallelGradients[l][i];
+
+  if (_lossFunction == "Mean Squared Error")
+  {
+    _currentLoss = 0.0;
+    for (size_t l = 0; l < L; l++) _currentLoss += sliceLosses[l];
+    _currentLoss = _currentLoss / ((float)N * 2.0f);
+  }
+
+  return hyperparameterGradients;
+}
+
 std::vector<float> DeepSupervisor::getHyperparameters()
 {
   return _neuralNetwork->getHyperparameters();
@@ -185,6 +290,19 @@ std::vector<std::vector<float>> &DeepSupervisor::getEvaluation(const std::vector
   // Grabbing constants
   const size_t N = input.size();
 
+  // Splitting training batches among the data parallel learners
+  if (_dataParallelLearners > 1 && N == _problem->_trainingBatchSize)
+  {
+    runDataParallel([&](const size_t learnerId, const size_t start, const size_t end) {
+      const std::vector<std::vector<std::vector<float>>> inputSlice(input.begin() + start, input.begin() + end);
+      _neuralNetwork->forward(inputSlice);
+      const auto &results = _neuralNetwork->getOutputValues(end - start);
+      for (size_t b = start; b < end; b++) _dataParallelOutputValues[b] = results[b - start];
+    });
+
+    return _dataParallelOutputValues;
+  }
+
   // Running the input values through the neural network
   _neuralNetwork->forward(input);
 
@@ -350,6 +468,15 @@ void DeepSupervisor::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['L2 Regularization']['Importance'] required by deepSupervisor.\n"); 
 
+ if (isDefined(js, "Data Parallel Learners"))
+ {
+ try { _dataParallelLearners = js["Data Parallel Learners"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ deepSupervisor ] \n + Key:    ['Data Parallel Learners']\n%s", e.what()); } 
+   eraseValue(js, "Data Parallel Learners");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Data Parallel Learners'] required by deepSupervisor.\n"); 
+
  if (isDefined(js, "Output Weights Scaling"))
  {
  try { _outputWeightsScaling = js["Output Weights Scaling"].get<float>();
@@ -392,6 +519,7 @@ void DeepSupervisor::getConfiguration(knlohmann::json& js)
    js["Learning Rate"] = _learningRate;
    js["L2 Regularization"]["Enabled"] = _l2RegularizationEnabled;
    js["L2 Regularization"]["Importance"] = _l2RegularizationImportance;
+   js["Data Parallel Learners"] = _dataParallelLearners;
    js["Output Weights Scaling"] = _outputWeightsScaling;
    js["Termination Criteria"]["Target Loss"] = _targetLoss;
    js["Current Loss"] = _currentLoss;
@@ -405,7 +533,7 @@ void DeepSupervisor::getConfiguration(knlohmann::json& js)
 void DeepSupervisor::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Steps Per Generation\": 1, \"L2 Regularization\": {\"Enabled\": false, \"Importance\": 0.0001}, \"Neural Network\": {\"Output Activation\": \"Identity\", \"Output Layer\": {}}, \"Termination Criteria\": {\"Target Loss\": -1.0}, \"Hyperparameters\": [], \"Output Weights Scaling\": 1.0}";
+ std::string defaultString = "{\"Steps Per Generation\": 1, \"Data Parallel Learners\": 1, \"L2 Regularization\": {\"Enabled\": false, \"Importance\": 0.0001}, \"Neural Network\": {\"Output Activation\": \"Identity\", \"Output Layer\": {}}, \"Termination Criteria\": {\"Target Loss\": -1.0}, \"Hyperparameters\": [], \"Output Weights Scaling\": 1.0}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Learner::applyModuleDefaults(js);
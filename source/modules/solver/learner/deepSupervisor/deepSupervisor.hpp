@@ -22,6 +22,7 @@
 #include "modules/solver/learner/deepSupervisor/optimizers/fMadGrad.hpp"
 #include "modules/solver/learner/deepSupervisor/optimizers/fRMSProp.hpp"
 #include "modules/solver/learner/learner.hpp"
+#include <functional>
 
 namespace korali
 {
@@ -82,6 +83,10 @@ class DeepSupervisor : public Learner
   */
    int _l2RegularizationImportance;
   /**
+  * @brief Number of learners (threads) that split every training batch among them. Each learner propagates its slice of the batch through its own copy of the neural network's activations, and their hyperparameter gradients are summed in a fixed order before the optimizer step. With the direct gradient loss, the batch must have been evaluated before (with a batch of the training batch size).
+  */
+   size_t _dataParallelLearners;
+  /**
   * @brief Specified by how much will the weights of the last linear transformation of the NN be scaled. A value of < 1.0 is useful for a more deterministic start.
   */
    float _outputWeightsScaling;
@@ -158,6 +163,33 @@ class DeepSupervisor : public Learner
   //
   //  std::vector<std::vector<float>> &getDataGradients(const std::vector<std::vector<std::vector<float>>> &input, const std::vector<std::vector<float>> &outputGradients);
 
+  /**
+   * @brief Offsets of the training batch slices of each data parallel learner, followed by the training batch size
+   */
+  std::vector<size_t> _dataParallelSliceOffsets;
+
+  /**
+   * @brief Output values of the whole training batch, gathered from the data parallel learners
+   */
+  std::vector<std::vector<float>> _dataParallelOutputValues;
+
+  /**
+   * @brief Hyperparameter gradients of the slice of each data parallel learner
+   */
+  std::vector<std::vector<float>> _dataParallelGradients;
+
+  /**
+   * @brief Runs a function once per data parallel learner, each on its own thread (and therefore on its own layer pipeline of the neural network)
+   * @param function Function receiving the learner id and the start and end of its slice of the training batch
+   */
+  void runDataParallel(const std::function<void(const size_t, const size_t, const size_t)> &function);
+
+  /**
+   * @brief Back propagates the training batch with the data parallel learners and sums their hyperparameter gradients
+   * @return The hyperparameter gradients of the whole training batch
+   */
+  std::vector<float> getDataParallelGradients();
+
   std::vector<std::vector<float>> &getEvaluation(const std::vector<std::vector<std::vector<float>>> &input) override;
   std::vector<float> getHyperparameters() override;
   void setHyperparameters(const std::vector<float> &hyperparameters) override;
@@ -0,0 +1,537 @@
+#include "engine.hpp"
+#include "modules/experiment/experiment.hpp"
+#include "modules/problem/problem.hpp"
+#include "modules/solver/optimizer/BayesianOptimization/BayesianOptimization.hpp"
+#include "sample/sample.hpp"
+
+#include "auxiliar/libgp/rprop.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <numeric>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+void BayesianOptimization::setInitialConfiguration()
+{
+  _variableCount = _k->_variables.size();
+
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    if (std::isfinite(_k->_variables[d]->_lowerBound) == false || std::isfinite(_k->_variables[d]->_upperBound) == false)
+      KORALI_LOG_ERROR("Bayesian Optimization requires finite Lower and Upper Bounds for variable \'%s\'.\n", _k->_variables[d]->_name.c_str());
+    if (_k->_variables[d]->_upperBound <= _k->_variables[d]->_lowerBound)
+      KORALI_LOG_ERROR("Lower Bound (%.4f) of variable \'%s\' is not smaller than its Upper Bound (%.4f).\n", _k->_variables[d]->_lowerBound, _k->_variables[d]->_name.c_str(), _k->_variables[d]->_upperBound);
+  }
+
+  if (_initialDesignSize == 0) KORALI_LOG_ERROR("Initial Design Size must be larger than 0.\n");
+  if (_acquisitionCandidateCount == 0) KORALI_LOG_ERROR("Acquisition Candidate Count must be larger than 0.\n");
+  if (_hyperparameterUpdateFrequency == 0) KORALI_LOG_ERROR("Hyperparameter Update Frequency must be larger than 0.\n");
+
+  _evaluatedParameters.clear();
+  _evaluatedValues.clear();
+  _hyperparameters.clear();
+  _valueMean = 0.0;
+  _valueScale = 1.0;
+  _observationsSinceUpdate = 0;
+  _gp.reset();
+
+  _bestEverVariables.resize(_variableCount);
+  _currentBestVariables.resize(_variableCount);
+
+  _previousBestValue = -Inf;
+  _currentBestValue = -Inf;
+  _bestEverValue = -Inf;
+}
+
+void BayesianOptimization::runGeneration()
+{
+  if (_k->_currentGeneration == 1) setInitialConfiguration();
+
+  // The surrogate is not part of the checkpoint, so it is rebuilt after resuming
+  if (_gp == nullptr && _evaluatedValues.empty() == false) rebuildSurrogate();
+
+  _previousBestValue = _currentBestValue;
+  _currentBestValue = -Inf;
+
+  // The first generation evaluates a Latin hypercube design
+  std::vector<std::vector<double>> design;
+  if (_gp == nullptr)
+  {
+    design.resize(_initialDesignSize, std::vector<double>(_variableCount));
+    std::vector<size_t> strata(_initialDesignSize);
+    for (size_t d = 0; d < _variableCount; d++)
+    {
+      std::iota(strata.begin(), strata.end(), 0);
+      for (size_t i = _initialDesignSize - 1; i > 0; i--) std::swap(strata[i], strata[(size_t)(_uniformGenerator->getRandomNumber() * (i + 1)) % (i + 1)]);
+      for (size_t i = 0; i < _initialDesignSize; i++) design[i][d] = (strata[i] + _uniformGenerator->getRandomNumber()) / (double)_initialDesignSize;
+    }
+    for (auto &u : design) u = unscaleParameters(u);
+  }
+
+  // Keeping as many points in flight as there are idle workers
+  const size_t idleWorkers = std::max((size_t)1, _k->_engine->_conduit->_workerQueue.size());
+  const size_t pointCount = design.empty() == false ? design.size() : (_batchSize > 0 ? _batchSize : idleWorkers);
+  const size_t slotCount = std::min(pointCount, idleWorkers);
+
+  _pendingPoints.clear();
+  std::vector<Sample> samples(slotCount);
+  std::vector<std::vector<double>> slotPoints(slotCount);
+  size_t launchedPoints = 0;
+  size_t finishedPoints = 0;
+
+  for (size_t s = 0; s < slotCount; s++)
+  {
+    slotPoints[s] = design.empty() ? proposePoint() : design[launchedPoints];
+    launchPoint(samples[s], slotPoints[s], launchedPoints++);
+  }
+
+  while (finishedPoints < pointCount)
+  {
+    size_t finishedId = KORALI_WAITANY(samples);
+    finishedPoints++;
+
+    double value = KORALI_GET(double, samples[finishedId], "F(x)");
+    removePending(slotPoints[finishedId]);
+    addObservation(slotPoints[finishedId], value);
+
+    if (_gp != nullptr && _observationsSinceUpdate >= _hyperparameterUpdateFrequency) updateHyperparameters();
+
+    if (launchedPoints < pointCount)
+    {
+      // The new point is proposed with the surrogate as updated so far, penalized around the points still in flight
+      slotPoints[finishedId] = design.empty() ? proposePoint() : design[launchedPoints];
+      launchPoint(samples[finishedId], slotPoints[finishedId], launchedPoints++);
+    }
+  }
+
+  if (_gp == nullptr) updateHyperparameters();
+}
+
+std::vector<double> BayesianOptimization::scaleParameters(const std::vector<double> &x) const
+{
+  std::vector<double> u(_variableCount);
+  for (size_t d = 0; d < _variableCount; d++)
+    u[d] = (x[d] - _k->_variables[d]->_lowerBound) / (_k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound);
+  return u;
+}
+
+std::vector<double> BayesianOptimization::unscaleParameters(const std::vector<double> &u) const
+{
+  std::vector<double> x(_variableCount);
+  for (size_t d = 0; d < _variableCount; d++)
+    x[d] = _k->_variables[d]->_lowerBound + u[d] * (_k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound);
+  return x;
+}
+
+void BayesianOptimization::rebuildSurrogate()
+{
+  _gp = std::make_unique<libgp::GaussianProcess>(_variableCount, _covarianceFunction);
+
+  const size_t parameterCount = _gp->covf().get_param_dim();
+  if (_hyperparameters.size() != parameterCount) _hyperparameters.assign(parameterCount, 0.0);
+
+  Eigen::VectorXd p(parameterCount);
+  for (size_t i = 0; i < parameterCount; i++) p[i] = _hyperparameters[i];
+  _gp->covf().set_loghyper(p);
+
+  for (size_t i = 0; i < _evaluatedValues.size(); i++)
+  {
+    auto u = scaleParameters(_evaluatedParameters[i]);
+    _gp->add_pattern(u.data(), (_evaluatedValues[i] - _valueMean) / _valueScale);
+  }
+}
+
+void BayesianOptimization::updateHyperparameters()
+{
+  // Standardizing the observed values
+  const double n = (double)_evaluatedValues.size();
+  _valueMean = std::accumulate(_evaluatedValues.begin(), _evaluatedValues.end(), 0.0) / n;
+  double variance = 0.0;
+  for (const auto &y : _evaluatedValues) variance += (y - _valueMean) * (y - _valueMean);
+  _valueScale = std::sqrt(variance / n);
+  if (_valueScale <= 0.0 || std::isfinite(_valueScale) == false) _valueScale = 1.0;
+
+  rebuildSurrogate();
+
+  // Maximizing the log marginal likelihood
+  libgp::RProp rprop;
+  rprop.init();
+  rprop.maximize(_gp.get(), 100, false);
+
+  // Noise-free objectives drive the noise (and sometimes the length scale) towards zero, which leaves the covariance
+  // matrix numerically singular. Flooring the log-hyperparameters keeps the factorization well conditioned.
+  auto p = _gp->covf().get_loghyper();
+  for (size_t i = 0; i < _hyperparameters.size(); i++) _hyperparameters[i] = std::max((double)p[i], -7.0);
+  rebuildSurrogate();
+
+  _observationsSinceUpdate = 0;
+}
+
+void BayesianOptimization::addObservation(const std::vector<double> &x, double value)
+{
+  _evaluatedParameters.push_back(x);
+  _evaluatedValues.push_back(value);
+
+  if (value > _currentBestValue)
+  {
+    _currentBestValue = value;
+    _currentBestVariables = x;
+  }
+
+  if (value > _bestEverValue)
+  {
+    _bestEverValue = value;
+    _bestEverVariables = x;
+  }
+
+  // libgp extends the Cholesky factor by one row/column (O(n^2)) while the hyperparameters are unchanged
+  if (_gp != nullptr)
+  {
+    auto u = scaleParameters(x);
+    _gp->add_pattern(u.data(), (value - _valueMean) / _valueScale);
+    _observationsSinceUpdate++;
+  }
+}
+
+double BayesianOptimization::getAcquisition(const std::vector<double> &u, double bestValue)
+{
+  const double mean = _gp->f(u.data());
+  const double stdDev = std::sqrt(std::max(_gp->var(u.data()), 1e-12));
+
+  // Expected Improvement
+  const double improvement = mean - bestValue - _explorationWeight;
+  const double z = improvement / stdDev;
+  double acquisition = improvement * 0.5 * std::erfc(-z * M_SQRT1_2) + stdDev * std::exp(-0.5 * z * z) / std::sqrt(2.0 * M_PI);
+  acquisition = std::max(acquisition, 0.0);
+
+  // Local penalization: probability that u lies outside the ball that cannot contain the maximum, given the pending point
+  for (size_t j = 0; j < _pendingPoints.size(); j++)
+  {
+    double distance = 0.0;
+    for (size_t d = 0; d < _variableCount; d++) distance += (u[d] - _pendingPoints[j][d]) * (u[d] - _pendingPoints[j][d]);
+    distance = std::sqrt(distance);
+
+    const double zj = (_lipschitzConstant * distance - bestValue + _pendingMeans[j]) / _pendingStdDevs[j];
+    acquisition *= 0.5 * std::erfc(-zj * M_SQRT1_2);
+  }
+
+  return acquisition;
+}
+
+void BayesianOptimization::updateLipschitzConstant(const std::vector<std::vector<double>> &points)
+{
+  const double h = 1e-4;
+  _lipschitzConstant = 1e-7;
+
+  for (auto u : points)
+  {
+    double gradientNorm = 0.0;
+    for (size_t d = 0; d < _variableCount; d++)
+    {
+      const double ud = u[d];
+      u[d] = ud + h;
+      const double fPlus = _gp->f(u.data());
+      u[d] = ud - h;
+      const double fMinus = _gp->f(u.data());
+      u[d] = ud;
+      gradientNorm += (fPlus - fMinus) * (fPlus - fMinus) / (4.0 * h * h);
+    }
+    _lipschitzConstant = std::max(_lipschitzConstant, std::sqrt(gradientNorm));
+  }
+}
+
+std::vector<double> BayesianOptimization::proposePoint()
+{
+  const double bestValue = (_bestEverValue - _valueMean) / _valueScale;
+
+  // Surrogate prediction at the pending points
+  _pendingMeans.resize(_pendingPoints.size());
+  _pendingStdDevs.resize(_pendingPoints.size());
+  for (size_t j = 0; j < _pendingPoints.size(); j++)
+  {
+    _pendingMeans[j] = _gp->f(_pendingPoints[j].data());
+    _pendingStdDevs[j] = std::sqrt(std::max(_gp->var(_pendingPoints[j].data()), 1e-12));
+  }
+
+  // Local candidates are drawn around the best observed points
+  std::vector<size_t> ranking(_evaluatedValues.size());
+  std::iota(ranking.begin(), ranking.end(), 0);
+  const size_t topCount = std::min((size_t)5, ranking.size());
+  std::partial_sort(ranking.begin(), ranking.begin() + topCount, ranking.end(), [&](size_t a, size_t b) { return _evaluatedValues[a] > _evaluatedValues[b]; });
+
+  std::vector<std::vector<double>> candidates(_acquisitionCandidateCount, std::vector<double>(_variableCount));
+  for (size_t c = 0; c < _acquisitionCandidateCount; c++)
+  {
+    if (c % 2 == 0 || topCount == 0)
+      for (size_t d = 0; d < _variableCount; d++) candidates[c][d] = _uniformGenerator->getRandomNumber();
+    else
+    {
+      auto center = scaleParameters(_evaluatedParameters[ranking[(c / 2) % topCount]]);
+      for (size_t d = 0; d < _variableCount; d++) candidates[c][d] = std::min(1.0, std::max(0.0, center[d] + 0.05 * _normalGenerator->getRandomNumber()));
+    }
+  }
+
+  if (_pendingPoints.empty() == false)
+  {
+    std::vector<std::vector<double>> lipschitzPoints(candidates.begin(), candidates.begin() + std::min((size_t)50, candidates.size()));
+    updateLipschitzConstant(lipschitzPoints);
+  }
+
+  size_t bestCandidate = 0;
+  double bestAcquisition = -Inf;
+  for (size_t c = 0; c < _acquisitionCandidateCount; c++)
+  {
+    const double acquisition = getAcquisition(candidates[c], bestValue);
+    if (acquisition > bestAcquisition)
+    {
+      bestAcquisition = acquisition;
+      bestCandidate = c;
+    }
+  }
+
+  return unscaleParameters(candidates[bestCandidate]);
+}
+
+void BayesianOptimization::launchPoint(Sample &sample, const std::vector<double> &x, size_t sampleId)
+{
+  _pendingPoints.push_back(scaleParameters(x));
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Evaluate";
+  sample["Parameters"] = x;
+  sample["Sample Id"] = sampleId;
+  _modelEvaluationCount++;
+  KORALI_START(sample);
+}
+
+void BayesianOptimization::removePending(const std::vector<double> &x)
+{
+  auto u = scaleParameters(x);
+  auto it = std::find(_pendingPoints.begin(), _pendingPoints.end(), u);
+  if (it != _pendingPoints.end()) _pendingPoints.erase(it);
+}
+
+void BayesianOptimization::printGenerationBefore() { return; }
+
+void BayesianOptimization::printGenerationAfter()
+{
+  _k->_logger->logInfo("Normal", "Current Function Value: Max = %+6.3e - Best = %+6.3e\n", _currentBestValue, _bestEverValue);
+  _k->_logger->logInfo("Normal", "Observations: %zu\n", _evaluatedValues.size());
+  _k->_logger->logInfo("Detailed", "Best Variables:\n");
+  for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _bestEverVariables[d]);
+  _k->_logger->logInfo("Detailed", "Log-Hyperparameters:\n");
+  for (size_t i = 0; i < _hyperparameters.size(); i++) _k->_logger->logData("Detailed", "         %+6.3e\n", _hyperparameters[i]);
+}
+
+void BayesianOptimization::finalize()
+{
+  // Updating Results
+  (*_k)["Results"]["Best Sample"]["F(x)"] = _bestEverValue;
+  (*_k)["Results"]["Best Sample"]["Parameters"] = _bestEverVariables;
+
+  _k->_logger->logInfo("Minimal", "Optimum found: %e\n", _bestEverValue);
+  _k->_logger->logInfo("Minimal", "Optimum found at:\n");
+  for (size_t d = 0; d < _variableCount; ++d) _k->_logger->logData("Minimal", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _bestEverVariables[d]);
+}
+
+void BayesianOptimization::setConfiguration(knlohmann::json& js) 
+{
+ if (isDefined(js, "Results"))  eraseValue(js, "Results");
+
+ if (isDefined(js, "Evaluated Parameters"))
+ {
+ try { _evaluatedParameters = js["Evaluated Parameters"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Evaluated Parameters']\n%s", e.what()); } 
+   eraseValue(js, "Evaluated Parameters");
+ }
+
+ if (isDefined(js, "Evaluated Values"))
+ {
+ try { _evaluatedValues = js["Evaluated Values"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Evaluated Values']\n%s", e.what()); } 
+   eraseValue(js, "Evaluated Values");
+ }
+
+ if (isDefined(js, "Hyperparameters"))
+ {
+ try { _hyperparameters = js["Hyperparameters"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Hyperparameters']\n%s", e.what()); } 
+   eraseValue(js, "Hyperparameters");
+ }
+
+ if (isDefined(js, "Value Mean"))
+ {
+ try { _valueMean = js["Value Mean"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Value Mean']\n%s", e.what()); } 
+   eraseValue(js, "Value Mean");
+ }
+
+ if (isDefined(js, "Value Scale"))
+ {
+ try { _valueScale = js["Value Scale"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Value Scale']\n%s", e.what()); } 
+   eraseValue(js, "Value Scale");
+ }
+
+ if (isDefined(js, "Observations Since Update"))
+ {
+ try { _observationsSinceUpdate = js["Observations Since Update"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Observations Since Update']\n%s", e.what()); } 
+   eraseValue(js, "Observations Since Update");
+ }
+
+ if (isDefined(js, "Current Best Variables"))
+ {
+ try { _currentBestVariables = js["Current Best Variables"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Current Best Variables']\n%s", e.what()); } 
+   eraseValue(js, "Current Best Variables");
+ }
+
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
+ if (isDefined(js, "Normal Generator"))
+ {
+ _normalGenerator = dynamic_cast<korali::distribution::univariate::Normal*>(korali::Module::getModule(js["Normal Generator"], _k));
+ _normalGenerator->applyVariableDefaults();
+ _normalGenerator->applyModuleDefaults(js["Normal Generator"]);
+ _normalGenerator->setConfiguration(js["Normal Generator"]);
+   eraseValue(js, "Normal Generator");
+ }
+
+ if (isDefined(js, "Initial Design Size"))
+ {
+ try { _initialDesignSize = js["Initial Design Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Initial Design Size']\n%s", e.what()); } 
+   eraseValue(js, "Initial Design Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Initial Design Size'] required by BayesianOptimization.\n"); 
+
+ if (isDefined(js, "Batch Size"))
+ {
+ try { _batchSize = js["Batch Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Batch Size']\n%s", e.what()); } 
+   eraseValue(js, "Batch Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Batch Size'] required by BayesianOptimization.\n"); 
+
+ if (isDefined(js, "Covariance Function"))
+ {
+ try { _covarianceFunction = js["Covariance Function"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Covariance Function']\n%s", e.what()); } 
+   eraseValue(js, "Covariance Function");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Covariance Function'] required by BayesianOptimization.\n"); 
+
+ if (isDefined(js, "Exploration Weight"))
+ {
+ try { _explorationWeight = js["Exploration Weight"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Exploration Weight']\n%s", e.what()); } 
+   eraseValue(js, "Exploration Weight");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Exploration Weight'] required by BayesianOptimization.\n"); 
+
+ if (isDefined(js, "Acquisition Candidate Count"))
+ {
+ try { _acquisitionCandidateCount = js["Acquisition Candidate Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Acquisition Candidate Count']\n%s", e.what()); } 
+   eraseValue(js, "Acquisition Candidate Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Acquisition Candidate Count'] required by BayesianOptimization.\n"); 
+
+ if (isDefined(js, "Hyperparameter Update Frequency"))
+ {
+ try { _hyperparameterUpdateFrequency = js["Hyperparameter Update Frequency"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ BayesianOptimization ] \n + Key:    ['Hyperparameter Update Frequency']\n%s", e.what()); } 
+   eraseValue(js, "Hyperparameter Update Frequency");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Hyperparameter Update Frequency'] required by BayesianOptimization.\n"); 
+
+ Optimizer::setConfiguration(js);
+ _type = "optimizer/BayesianOptimization";
+ if(isDefined(js, "Type")) eraseValue(js, "Type");
+ if(isEmpty(js) == false) KORALI_LOG_ERROR(" + Unrecognized settings for Korali module: BayesianOptimization: \n%s\n", js.dump(2).c_str());
+} 
+
+void BayesianOptimization::getConfiguration(knlohmann::json& js) 
+{
+
+ js["Type"] = _type;
+   js["Initial Design Size"] = _initialDesignSize;
+   js["Batch Size"] = _batchSize;
+   js["Covariance Function"] = _covarianceFunction;
+   js["Exploration Weight"] = _explorationWeight;
+   js["Acquisition Candidate Count"] = _acquisitionCandidateCount;
+   js["Hyperparameter Update Frequency"] = _hyperparameterUpdateFrequency;
+   js["Evaluated Parameters"] = _evaluatedParameters;
+   js["Evaluated Values"] = _evaluatedValues;
+   js["Hyperparameters"] = _hyperparameters;
+   js["Value Mean"] = _valueMean;
+   js["Value Scale"] = _valueScale;
+   js["Observations Since Update"] = _observationsSinceUpdate;
+   js["Current Best Variables"] = _currentBestVariables;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+ if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
+ Optimizer::getConfiguration(js);
+} 
+
+void BayesianOptimization::applyModuleDefaults(knlohmann::json& js) 
+{
+
+ std::string defaultString = "{\"Initial Design Size\": 10, \"Batch Size\": 0, \"Covariance Function\": \"CovSum ( CovMatern5iso, CovNoise)\", \"Exploration Weight\": 0.01, \"Acquisition Candidate Count\": 2000, \"Hyperparameter Update Frequency\": 5, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Evaluated Parameters\": [], \"Evaluated Values\": [], \"Hyperparameters\": [], \"Value Mean\": 0.0, \"Value Scale\": 1.0, \"Observations Since Update\": 0, \"Current Best Variables\": []}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ mergeJson(js, defaultJs); 
+ Optimizer::applyModuleDefaults(js);
+} 
+
+void BayesianOptimization::applyVariableDefaults() 
+{
+
+ std::string defaultString = "{}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ if (isDefined(_k->_js.getJson(), "Variables"))
+  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) 
+   mergeJson(_k->_js["Variables"][i], defaultJs); 
+ Optimizer::applyVariableDefaults();
+} 
+
+bool BayesianOptimization::checkTermination()
+{
+ bool hasFinished = false;
+
+ hasFinished = hasFinished || Optimizer::checkTermination();
+ return hasFinished;
+}
+
+;
+
+} //optimizer
+} //solver
+} //korali
+;
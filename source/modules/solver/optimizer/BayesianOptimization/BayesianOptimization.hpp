@@ -0,0 +1,225 @@
+/** \namespace optimizer
+* @brief Namespace declaration for modules of type: optimizer.
+*/
+
+/** \file
+* @brief Header file for module: BayesianOptimization.
+*/
+
+/** \dir solver/optimizer/BayesianOptimization
+* @brief Contains code, documentation, and scripts for module: BayesianOptimization.
+*/
+
+#pragma once
+
+#include "auxiliar/libgp/gp.h"
+#include "modules/distribution/univariate/normal/normal.hpp"
+#include "modules/distribution/univariate/uniform/uniform.hpp"
+#include "modules/solver/optimizer/optimizer.hpp"
+#include <memory>
+#include <vector>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+/**
+* @brief Class declaration for module: BayesianOptimization.
+*/
+class BayesianOptimization : public Optimizer
+{
+  private:
+  /**
+   * @brief Gaussian process surrogate, on parameters scaled to the unit hypercube and standardized values
+   */
+  std::unique_ptr<libgp::GaussianProcess> _gp;
+
+  /**
+   * @brief Scaled locations of the points under evaluation, used to penalize the acquisition around them
+   */
+  std::vector<std::vector<double>> _pendingPoints;
+
+  /**
+   * @brief Surrogate mean at each pending point
+   */
+  std::vector<double> _pendingMeans;
+
+  /**
+   * @brief Surrogate standard deviation at each pending point
+   */
+  std::vector<double> _pendingStdDevs;
+
+  /**
+   * @brief Estimate of the Lipschitz constant of the (scaled) objective, used by the local penalization
+   */
+  double _lipschitzConstant;
+
+  /**
+   * @brief Maps parameters to the unit hypercube.
+   * @param x Parameters
+   * @return Scaled parameters
+   */
+  std::vector<double> scaleParameters(const std::vector<double> &x) const;
+
+  /**
+   * @brief Maps scaled parameters back to the variable domain.
+   * @param u Scaled parameters
+   * @return Parameters
+   */
+  std::vector<double> unscaleParameters(const std::vector<double> &u) const;
+
+  /**
+   * @brief Re-creates the surrogate from all evaluated points with the current hyperparameters (full factorization).
+   */
+  void rebuildSurrogate();
+
+  /**
+   * @brief Re-standardizes the values and re-fits the hyperparameters by maximizing the marginal likelihood.
+   */
+  void updateHyperparameters();
+
+  /**
+   * @brief Records an evaluated point and adds it to the surrogate with a rank-one update of the Cholesky factor.
+   * @param x Parameters of the point
+   * @param value Objective value
+   */
+  void addObservation(const std::vector<double> &x, double value);
+
+  /**
+   * @brief Evaluates the locally penalized Expected Improvement.
+   * @param u Scaled candidate
+   * @param bestValue Best standardized value observed so far
+   * @return The acquisition value
+   */
+  double getAcquisition(const std::vector<double> &u, double bestValue);
+
+  /**
+   * @brief Estimates the Lipschitz constant from the surrogate mean gradient on a set of scaled points.
+   * @param points Scaled points
+   */
+  void updateLipschitzConstant(const std::vector<std::vector<double>> &points);
+
+  /**
+   * @brief Proposes the next point by maximizing the acquisition over random candidates, penalized around the pending points.
+   * @return Parameters of the proposed point
+   */
+  std::vector<double> proposePoint();
+
+  /**
+   * @brief Registers a point as pending and starts its evaluation.
+   * @param sample Sample to use
+   * @param x Parameters of the point
+   * @param sampleId Identifier of the sample
+   */
+  void launchPoint(Sample &sample, const std::vector<double> &x, size_t sampleId);
+
+  /**
+   * @brief Removes a point from the pending list.
+   * @param x Parameters of the point
+   */
+  void removePending(const std::vector<double> &x);
+
+  public: 
+  /**
+  * @brief Number of points of the Latin hypercube design evaluated in the first generation, before the surrogate is used.
+  */
+   size_t _initialDesignSize;
+  /**
+  * @brief Number of evaluations per generation, kept concurrently in flight. If 0, it is set to the number of idle workers.
+  */
+   size_t _batchSize;
+  /**
+  * @brief Covariance function of the Gaussian process surrogate, in libgp notation. Parameters are scaled to the unit hypercube before fitting.
+  */
+   std::string _covarianceFunction;
+  /**
+  * @brief Improvement margin (in units of the standard deviation of the observed values) required by the Expected Improvement acquisition.
+  */
+   double _explorationWeight;
+  /**
+  * @brief Number of candidate points on which the acquisition function is evaluated to propose a new point. Half are drawn uniformly, half around the best observed points.
+  */
+   size_t _acquisitionCandidateCount;
+  /**
+  * @brief Number of new observations after which the hyperparameters of the Gaussian process are re-fitted. In between, observations are added to the Cholesky factor with rank-one updates.
+  */
+   size_t _hyperparameterUpdateFrequency;
+  /**
+  * @brief [Internal Use] Parameters of all evaluated points.
+  */
+   std::vector<std::vector<double>> _evaluatedParameters;
+  /**
+  * @brief [Internal Use] Objective values of all evaluated points.
+  */
+   std::vector<double> _evaluatedValues;
+  /**
+  * @brief [Internal Use] Logarithm of the hyperparameters of the covariance function.
+  */
+   std::vector<double> _hyperparameters;
+  /**
+  * @brief [Internal Use] Mean of the observed values used to standardize the surrogate output.
+  */
+   double _valueMean;
+  /**
+  * @brief [Internal Use] Standard deviation of the observed values used to standardize the surrogate output.
+  */
+   double _valueScale;
+  /**
+  * @brief [Internal Use] Number of observations added since the last hyperparameter fit.
+  */
+   size_t _observationsSinceUpdate;
+  /**
+  * @brief [Internal Use] Best variables of current generation.
+  */
+   std::vector<double> _currentBestVariables;
+  /**
+  * @brief [Internal Use] Uniform random number generator.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Internal Use] Normal random number generator.
+  */
+   korali::distribution::univariate::Normal* _normalGenerator;
+  
+ 
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
+  /**
+  * @brief Obtains the entire current state and configuration of the module.
+  * @param js JSON object onto which to save the serialized state of the module.
+  */
+  void getConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Sets the entire state and configuration of the module, given a JSON object.
+  * @param js JSON object from which to deserialize the state of the module.
+  */
+  void setConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default configuration upon its creation.
+  * @param js JSON object containing user configuration. The defaults will not override any currently defined settings.
+  */
+  void applyModuleDefaults(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default variable configuration to each variable in the Experiment upon creation.
+  */
+  void applyVariableDefaults() override;
+  
+
+  void setInitialConfiguration() override;
+  void runGeneration() override;
+  void printGenerationBefore() override;
+  void printGenerationAfter() override;
+  void finalize() override;
+};
+
+} //optimizer
+} //solver
+} //korali
+;
@@ -26,12 +26,13 @@ void DEA::setInitialConfiguration()
     if (_k->_variables[d]->_upperBound < _k->_variables[d]->_lowerBound)
       KORALI_LOG_ERROR("Lower Bound (%.4f) of variable \'%s\'  exceeds Upper Bound (%.4f).\n", _k->_variables[d]->_lowerBound, _k->_variables[d]->_name.c_str(), _k->_variables[d]->_upperBound);
 
-  // Allocating Memory
-  _samplePopulation.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _samplePopulation[i].resize(_variableCount);
+  // The other accept rules select among a fully evaluated population, which the asynchronous version never waits for
+  if (_version == "Asynchronous" && _acceptRule != "Greedy")
+    KORALI_LOG_ERROR("The Asynchronous version only supports the Greedy accept rule (%s given).\n", _acceptRule.c_str());
 
-  _candidatePopulation.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _candidatePopulation[i].resize(_variableCount);
+  // Allocating Memory
+  _samplePopulation.resize(_populationSize * _variableCount);
+  _candidatePopulation.resize(_populationSize * _variableCount);
 
   _previousMean.resize(_variableCount);
   _currentMean.resize(_variableCount);
@@ -63,26 +64,24 @@ void DEA::setInitialConfiguration()
 
   for (size_t i = 0; i < _populationSize; ++i)
     for (size_t d = 0; d < _variableCount; ++d)
-      _currentMean[d] += _samplePopulation[i][d] / ((double)_populationSize);
+      _currentMean[d] += _samplePopulation[i * _variableCount + d] / ((double)_populationSize);
 }
 
 void DEA::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  if (_version == "Asynchronous")
+  {
+    runAsynchronousGeneration();
+    return;
+  }
+
   prepareGeneration();
 
   // Initializing Sample Evaluation
   std::vector<Sample> samples(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++)
-  {
-    samples[i]["Module"] = "Problem";
-    samples[i]["Operation"] = "Evaluate";
-    samples[i]["Parameters"] = _candidatePopulation[i];
-    samples[i]["Sample Id"] = i;
-    _modelEvaluationCount++;
-    KORALI_START(samples[i]);
-  }
+  for (size_t i = 0; i < _populationSize; i++) launchCandidate(samples[i], i);
 
   // Waiting for samples to finish
   KORALI_WAITALL(samples);
@@ -90,6 +89,62 @@ void DEA::runGeneration()
   updateSolver(samples);
 }
 
+void DEA::runAsynchronousGeneration()
+{
+  _previousBestValue = _currentBestValue;
+  _previousBestEverValue = _bestEverValue;
+  _currentBestValue = -Inf;
+  _previousValueVector = _valueVector;
+
+  // Keeping as many candidates in flight as there are idle workers
+  size_t slotCount = std::min(_populationSize, std::max((size_t)1, _k->_engine->_conduit->_workerQueue.size()));
+
+  // At the first generation, the initial population is evaluated as is
+  if (_k->_currentGeneration > 1) prepareCandidates(0, slotCount);
+
+  std::vector<Sample> samples(slotCount);
+  std::vector<size_t> slotCandidates(slotCount);
+  size_t nextCandidate = 0;
+  size_t finishedCandidates = 0;
+
+  for (size_t s = 0; s < slotCount; s++)
+  {
+    slotCandidates[s] = nextCandidate++;
+    launchCandidate(samples[s], slotCandidates[s]);
+  }
+
+  while (finishedCandidates < _populationSize)
+  {
+    size_t finishedId = KORALI_WAITANY(samples);
+    finishedCandidates++;
+
+    double value = KORALI_GET(double, samples[finishedId], "F(x)");
+    acceptCandidate(slotCandidates[finishedId], value);
+
+    if (nextCandidate < _populationSize)
+    {
+      // The new candidate is mutated from the population as updated so far
+      if (_k->_currentGeneration > 1) prepareCandidates(nextCandidate, nextCandidate + 1);
+      slotCandidates[finishedId] = nextCandidate++;
+      launchCandidate(samples[finishedId], slotCandidates[finishedId]);
+    }
+  }
+
+  updatePopulationStatistics();
+}
+
+void DEA::launchCandidate(Sample &sample, size_t candidateIdx)
+{
+  auto candidate = _candidatePopulation.begin() + candidateIdx * _variableCount;
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Evaluate";
+  sample["Parameters"] = std::vector<double>(candidate, candidate + _variableCount);
+  sample["Sample Id"] = candidateIdx;
+  _modelEvaluationCount++;
+  KORALI_START(sample);
+}
+
 void DEA::initSamples()
 {
   /* skip sampling in gen 1 */
@@ -97,101 +152,209 @@ void DEA::initSamples()
     for (size_t d = 0; d < _variableCount; ++d)
     {
       double width = _k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound;
-      _candidatePopulation[i][d] = _k->_variables[d]->_lowerBound + width * _uniformGenerator->getRandomNumber();
-      _samplePopulation[i][d] = _candidatePopulation[i][d];
+      _candidatePopulation[i * _variableCount + d] = _k->_variables[d]->_lowerBound + width * _uniformGenerator->getRandomNumber();
+      _samplePopulation[i * _variableCount + d] = _candidatePopulation[i * _variableCount + d];
     }
 }
 
 void DEA::prepareGeneration()
 {
   /* at gen 1 candidates initialized in initialize() */
-  if (_k->_currentGeneration > 1)
-    for (size_t i = 0; i < _populationSize; ++i)
-    {
-      bool isFeasible = true;
-      do
-      {
-        mutateSingle(i);
-        if (_fixInfeasible && isFeasible == false) fixInfeasible(i);
-
-        isFeasible = isSampleFeasible(_candidatePopulation[i]);
-        if (isFeasible == false) _infeasibleSampleCount++;
-      } while (isFeasible == false);
-    }
+  if (_k->_currentGeneration > 1) prepareCandidates(0, _populationSize);
   _previousValueVector = _valueVector;
 }
 
-void DEA::mutateSingle(size_t sampleIdx)
+void DEA::prepareCandidates(size_t begin, size_t end)
 {
-  size_t a, b;
-  do
-  {
-    a = _uniformGenerator->getRandomNumber() * _populationSize;
-  } while (a == sampleIdx);
-  do
+  // Scratch storage is not part of the checkpoint, so it is (re)sized here
+  _lowerBounds.resize(_variableCount);
+  _upperBounds.resize(_variableCount);
+  for (size_t d = 0; d < _variableCount; ++d)
   {
-    b = _uniformGenerator->getRandomNumber() * _populationSize;
-  } while (b == sampleIdx || b == a);
+    _lowerBounds[d] = _k->_variables[d]->_lowerBound;
+    _upperBounds[d] = _k->_variables[d]->_upperBound;
+  }
+
+  std::vector<size_t> pendingIds(end - begin);
+  std::iota(pendingIds.begin(), pendingIds.end(), begin);
+
+  mutateCandidates(pendingIds);
 
-  if (_mutationRule == "Self Adaptive")
+  while (true)
   {
-    // Brest [2006]
-    double tau1 = 0.1;
-    double tau2 = 0.1;
-    double Fl = 0.1;
-    double Fu = 0.9;
+    std::vector<size_t> infeasibleIds;
+    for (size_t i : pendingIds)
+      if (isCandidateFeasible(i) == false) infeasibleIds.push_back(i);
+
+    if (infeasibleIds.empty()) break;
+    _infeasibleSampleCount += infeasibleIds.size();
+
+    mutateCandidates(infeasibleIds);
+    if (_fixInfeasible) fixInfeasible(infeasibleIds);
+
+    pendingIds = std::move(infeasibleIds);
+  }
+}
+
+void DEA::mutateCandidates(const std::vector<size_t> &candidateIds)
+{
+  const size_t N = candidateIds.size();
 
-    double rd2 = _uniformGenerator->getRandomNumber();
-    double rd3 = _uniformGenerator->getRandomNumber();
+  _firstDifferenceIndexes.resize(N);
+  _secondDifferenceIndexes.resize(N);
+  _parentIndexes.resize(N);
+  _candidateMutationRates.resize(N);
+  _crossoverMask.resize(N * _variableCount);
 
-    if (rd2 < tau1)
+  // Drawing all random numbers first, since the generator is sequential
+  for (size_t j = 0; j < N; ++j)
+  {
+    const size_t sampleIdx = candidateIds[j];
+
+    size_t a, b;
+    do
     {
-      double rd1 = _uniformGenerator->getRandomNumber();
-      _mutationRate = Fl + rd1 * Fu;
-    }
-    if (rd3 < tau2)
+      a = _uniformGenerator->getRandomNumber() * _populationSize;
+    } while (a == sampleIdx);
+    do
+    {
+      b = _uniformGenerator->getRandomNumber() * _populationSize;
+    } while (b == sampleIdx || b == a);
+
+    if (_mutationRule == "Self Adaptive")
     {
-      double rd4 = _uniformGenerator->getRandomNumber();
-      _crossoverRate = rd4;
+      // Brest [2006]
+      double tau1 = 0.1;
+      double tau2 = 0.1;
+      double Fl = 0.1;
+      double Fu = 0.9;
+
+      double rd2 = _uniformGenerator->getRandomNumber();
+      double rd3 = _uniformGenerator->getRandomNumber();
+
+      if (rd2 < tau1)
+      {
+        double rd1 = _uniformGenerator->getRandomNumber();
+        _mutationRate = Fl + rd1 * Fu;
+      }
+      if (rd3 < tau2)
+      {
+        double rd4 = _uniformGenerator->getRandomNumber();
+        _crossoverRate = rd4;
+      }
     }
-  }
 
-  double *parent;
-  if (_parentSelectionRule == "Random")
-  {
     size_t c;
-    do
+    if (_parentSelectionRule == "Random")
+    {
+      do
+      {
+        c = _uniformGenerator->getRandomNumber() * _populationSize;
+      } while (c == sampleIdx || c == a || c == b);
+    }
+    else /* _parentSelectionRule == "Best" */
     {
-      c = _uniformGenerator->getRandomNumber() * _populationSize;
-    } while (c == sampleIdx || c == a || c == b);
-    parent = &_samplePopulation[c][0];
+      c = _bestSampleIndex;
+    }
+
+    _firstDifferenceIndexes[j] = a;
+    _secondDifferenceIndexes[j] = b;
+    _parentIndexes[j] = c;
+    _candidateMutationRates[j] = _mutationRate;
+
+    size_t rn = _uniformGenerator->getRandomNumber() * _variableCount;
+    double *mask = &_crossoverMask[j * _variableCount];
+    for (size_t d = 0; d < _variableCount; ++d)
+      mask[d] = ((_uniformGenerator->getRandomNumber() < _crossoverRate) || (d == rn)) ? 1.0 : 0.0;
   }
-  else /* _parentSelectionRule == "Best" */
+
+  // Building trial vectors with branch-free, vectorizable row operations
+  for (size_t j = 0; j < N; ++j)
   {
-    parent = &_samplePopulation[_bestSampleIndex][0];
+    const double F = _candidateMutationRates[j];
+    const double *mask = &_crossoverMask[j * _variableCount];
+    const double *parent = &_samplePopulation[_parentIndexes[j] * _variableCount];
+    const double *xa = &_samplePopulation[_firstDifferenceIndexes[j] * _variableCount];
+    const double *xb = &_samplePopulation[_secondDifferenceIndexes[j] * _variableCount];
+    const double *x = &_samplePopulation[candidateIds[j] * _variableCount];
+    double *trial = &_candidatePopulation[candidateIds[j] * _variableCount];
+
+#pragma omp simd
+    for (size_t d = 0; d < _variableCount; ++d)
+      trial[d] = x[d] + mask[d] * (parent[d] + F * (xa[d] - xb[d]) - x[d]);
   }
+}
 
-  size_t rn = _uniformGenerator->getRandomNumber() * _variableCount;
-  for (size_t d = 0; d < _variableCount; ++d)
+void DEA::fixInfeasible(const std::vector<size_t> &candidateIds)
+{
+  const size_t N = candidateIds.size();
+
+  _infeasibleShrinkFactors.resize(N * _variableCount);
+  for (size_t i = 0; i < N * _variableCount; ++i) _infeasibleShrinkFactors[i] = _uniformGenerator->getRandomNumber();
+
+  const double *lb = _lowerBounds.data();
+  const double *ub = _upperBounds.data();
+
+  for (size_t j = 0; j < N; ++j)
   {
-    if ((_uniformGenerator->getRandomNumber() < _crossoverRate) || (d == rn))
-      _candidatePopulation[sampleIdx][d] = parent[d] + _mutationRate * (_samplePopulation[a][d] - _samplePopulation[b][d]);
-    else
-      _candidatePopulation[sampleIdx][d] = _samplePopulation[sampleIdx][d];
+    const double *u = &_infeasibleShrinkFactors[j * _variableCount];
+    const double *x = &_samplePopulation[candidateIds[j] * _variableCount];
+    double *trial = &_candidatePopulation[candidateIds[j] * _variableCount];
+
+#pragma omp simd
+    for (size_t d = 0; d < _variableCount; ++d)
+    {
+      double len = 0.0;
+      if (trial[d] < lb[d]) len = trial[d] - lb[d];
+      if (trial[d] > ub[d]) len = trial[d] - ub[d];
+      trial[d] = x[d] - len * u[d];
+    }
   }
 }
 
-void DEA::fixInfeasible(size_t sampleIdx)
+bool DEA::isCandidateFeasible(size_t candidateIdx)
 {
+  const double *trial = &_candidatePopulation[candidateIdx * _variableCount];
+
+  bool isFeasible = true;
   for (size_t d = 0; d < _variableCount; ++d)
+    isFeasible &= std::isfinite(trial[d]) && (trial[d] >= _lowerBounds[d]) && (trial[d] <= _upperBounds[d]);
+
+  return isFeasible;
+}
+
+void DEA::acceptCandidate(size_t candidateIdx, double value)
+{
+  auto candidate = _candidatePopulation.begin() + candidateIdx * _variableCount;
+
+  if (value > _currentBestValue)
+  {
+    _currentBestValue = value;
+    std::copy(candidate, candidate + _variableCount, _currentBestVariables.begin());
+  }
+
+  bool isAccepted = false;
+
+  // The initial population is always taken as is
+  if (_k->_currentGeneration == 1) isAccepted = true;
+
+  // Accept all mutations better than parent
+  if (_acceptRule == "Greedy" && value > _previousValueVector[candidateIdx]) isAccepted = true;
+
+  if (_acceptRule != "Greedy")
+    KORALI_LOG_ERROR("Accept Rule (%s) not supported by the Asynchronous version.\n", _acceptRule.c_str());
+
+  if (isAccepted)
   {
-    double len = 0.0;
-    if (_candidatePopulation[sampleIdx][d] < _k->_variables[d]->_lowerBound)
-      len = _candidatePopulation[sampleIdx][d] - _k->_variables[d]->_lowerBound;
-    if (_candidatePopulation[sampleIdx][d] > _k->_variables[d]->_upperBound)
-      len = _candidatePopulation[sampleIdx][d] - _k->_variables[d]->_upperBound;
+    std::copy(candidate, candidate + _variableCount, _samplePopulation.begin() + candidateIdx * _variableCount);
+    _valueVector[candidateIdx] = value;
+  }
 
-    _candidatePopulation[sampleIdx][d] = _samplePopulation[sampleIdx][d] - len * _uniformGenerator->getRandomNumber();
+  if (value > _bestEverValue)
+  {
+    _bestEverValue = value;
+    _bestSampleIndex = candidateIdx;
+    std::copy(candidate, candidate + _variableCount, _bestEverVariables.begin());
   }
 }
 
@@ -206,10 +369,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   _previousBestValue = _currentBestValue;
   _currentBestValue = _valueVector[_bestSampleIndex];
 
-  for (size_t d = 0; d < _variableCount; ++d) _currentBestVariables[d] = _candidatePopulation[_bestSampleIndex][d];
-
-  _previousMean = _currentMean;
-  std::fill(std::begin(_currentMean), std::end(_currentMean), 0.0);
+  for (size_t d = 0; d < _variableCount; ++d) _currentBestVariables[d] = _candidatePopulation[_bestSampleIndex * _variableCount + d];
 
   if (_currentBestValue > _bestEverValue) _bestEverVariables = _currentBestVariables;
 
@@ -219,7 +379,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     if (_currentBestValue > _bestEverValue)
     {
-      for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[_bestSampleIndex][d] = _candidatePopulation[_bestSampleIndex][d];
+      for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[_bestSampleIndex * _variableCount + d] = _candidatePopulation[_bestSampleIndex * _variableCount + d];
       _bestEverValue = _currentBestValue;
     }
     acceptRuleRecognized = true;
@@ -229,7 +389,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     for (size_t i = 0; i < _populationSize; ++i)
       if (_valueVector[i] > _previousValueVector[i])
-        _samplePopulation[i] = _candidatePopulation[i];
+        for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[i * _variableCount + d] = _candidatePopulation[i * _variableCount + d];
     if (_currentBestValue > _bestEverValue)
     {
       _bestEverValue = _currentBestValue;
@@ -241,7 +401,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     for (size_t i = 0; i < _populationSize; ++i)
       if (_valueVector[i] > _bestEverValue)
-        for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[i][d] = _candidatePopulation[i][d];
+        for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[i * _variableCount + d] = _candidatePopulation[i * _variableCount + d];
     if (_currentBestValue > _bestEverValue)
     {
       _bestEverValue = _currentBestValue;
@@ -255,7 +415,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
       if (_valueVector[i] > _bestEverValue)
         for (size_t d = 0; d < _variableCount; ++d)
         {
-          _samplePopulation[i][d] = _candidatePopulation[i][d];
+          _samplePopulation[i * _variableCount + d] = _candidatePopulation[i * _variableCount + d];
           _bestEverValue = _valueVector[i];
         }
     acceptRuleRecognized = true;
@@ -263,21 +423,27 @@ void DEA::updateSolver(std::vector<Sample> &samples)
 
   if (acceptRuleRecognized == false) KORALI_LOG_ERROR("Accept Rule (%s) not recognized.\n", _acceptRule.c_str());
 
+  updatePopulationStatistics();
+}
+
+void DEA::updatePopulationStatistics()
+{
+  _previousMean = _currentMean;
+  std::fill(std::begin(_currentMean), std::end(_currentMean), 0.0);
+
   for (size_t i = 0; i < _populationSize; ++i)
     for (size_t d = 0; d < _variableCount; ++d)
-      _currentMean[d] += _samplePopulation[i][d] / ((double)_populationSize);
+      _currentMean[d] += _samplePopulation[i * _variableCount + d] / ((double)_populationSize);
 
-  for (size_t d = 0; d < _variableCount; ++d)
-  {
-    double max = -Inf;
-    double min = +Inf;
-    for (size_t i = 0; i < _populationSize; ++i)
+  std::vector<double> max(_variableCount, -Inf);
+  std::vector<double> min(_variableCount, +Inf);
+  for (size_t i = 0; i < _populationSize; ++i)
+    for (size_t d = 0; d < _variableCount; ++d)
     {
-      if (_samplePopulation[i][d] > max) max = _samplePopulation[i][d];
-      if (_samplePopulation[i][d] < min) min = _samplePopulation[i][d];
+      if (_samplePopulation[i * _variableCount + d] > max[d]) max[d] = _samplePopulation[i * _variableCount + d];
+      if (_samplePopulation[i * _variableCount + d] < min[d]) min[d] = _samplePopulation[i * _variableCount + d];
     }
-    _maxDistances[d] = max - min;
-  }
+  for (size_t d = 0; d < _variableCount; ++d) _maxDistances[d] = max[d] - min[d];
 
   _currentMinimumStepSize = +Inf;
   for (size_t d = 0; d < _variableCount; ++d) std::min(_currentMinimumStepSize, fabs(_currentMean[d] - _previousMean[d]));
@@ -351,7 +517,7 @@ void DEA::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Population"))
  {
- try { _samplePopulation = js["Sample Population"].get<std::vector<std::vector<double>>>();
+ try { _samplePopulation = js["Sample Population"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Sample Population']\n%s", e.what()); } 
    eraseValue(js, "Sample Population");
@@ -359,7 +525,7 @@ void DEA::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Candidate Population"))
  {
- try { _candidatePopulation = js["Candidate Population"].get<std::vector<std::vector<double>>>();
+ try { _candidatePopulation = js["Candidate Population"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Candidate Population']\n%s", e.what()); } 
    eraseValue(js, "Candidate Population");
@@ -429,6 +595,21 @@ void DEA::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Current Minimum Step Size");
  }
 
+ if (isDefined(js, "Version"))
+ {
+ try { _version = js["Version"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Version']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_version == "Synchronous") validOption = true; 
+ if (_version == "Asynchronous") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Version'] required by DEA.\n", _version.c_str()); 
+}
+   eraseValue(js, "Version");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Version'] required by DEA.\n"); 
+
  if (isDefined(js, "Population Size"))
  {
  try { _populationSize = js["Population Size"].get<size_t>();
@@ -552,6 +733,7 @@ void DEA::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Version"] = _version;
    js["Population Size"] = _populationSize;
    js["Crossover Rate"] = _crossoverRate;
    js["Mutation Rate"] = _mutationRate;
@@ -584,7 +766,7 @@ void DEA::getConfiguration(knlohmann::json& js)
 void DEA::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Population Size\": 200, \"Crossover Rate\": 0.9, \"Mutation Rate\": 0.5, \"Mutation Rule\": \"Fixed\", \"Parent Selection Rule\": \"Random\", \"Accept Rule\": \"Greedy\", \"Fix Infeasible\": true, \"Termination Criteria\": {\"Max Infeasible Resamplings\": 10000000, \"Min Value\": -Infinity, \"Max Value\": Infinity, \"Min Step Size\": -Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Value Vector\": [], \"Previous Value Vector\": [], \"Sample Population\": [[]], \"Candidate Population\": [[]], \"Best Sample Index\": 0, \"Best Ever Value\": -Infinity, \"Previous Best Ever Value\": -Infinity, \"Current Mean\": [], \"Previous Mean\": [], \"Current Best Variables\": [], \"Max Distances\": [], \"Infeasible Sample Count\": 0, \"Current Minimum Step Size\": 0.0}";
+ std::string defaultString = "{\"Version\": \"Synchronous\", \"Population Size\": 200, \"Crossover Rate\": 0.9, \"Mutation Rate\": 0.5, \"Mutation Rule\": \"Fixed\", \"Parent Selection Rule\": \"Random\", \"Accept Rule\": \"Greedy\", \"Fix Infeasible\": true, \"Termination Criteria\": {\"Max Infeasible Resamplings\": 10000000, \"Min Value\": -Infinity, \"Max Value\": Infinity, \"Min Step Size\": -Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Value Vector\": [], \"Previous Value Vector\": [], \"Sample Population\": [], \"Candidate Population\": [], \"Best Sample Index\": 0, \"Best Ever Value\": -Infinity, \"Previous Best Ever Value\": -Infinity, \"Current Mean\": [], \"Previous Mean\": [], \"Current Best Variables\": [], \"Max Distances\": [], \"Infeasible Sample Count\": 0, \"Current Minimum Step Size\": 0.0}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
@@ -32,16 +32,84 @@ class DEA : public Optimizer
 {
   private:
   /**
-   * @brief Mutate a sample.
-   * @param sampleIdx Index of sample to be mutated.
+   * @brief Indexes of the first vector of the differential, per candidate.
    */
-  void mutateSingle(size_t sampleIdx);
+  std::vector<size_t> _firstDifferenceIndexes;
 
   /**
-   * @brief Fix sample params that are outside of domain.
-   * @param sampleIdx Index of sample that is outside of domain.
+   * @brief Indexes of the second vector of the differential, per candidate.
    */
-  void fixInfeasible(size_t sampleIdx);
+  std::vector<size_t> _secondDifferenceIndexes;
+
+  /**
+   * @brief Indexes of the parent (base) vector, per candidate.
+   */
+  std::vector<size_t> _parentIndexes;
+
+  /**
+   * @brief Mutation rate used for each candidate (differs per candidate under the self adaptive rule).
+   */
+  std::vector<double> _candidateMutationRates;
+
+  /**
+   * @brief Crossover mask (1.0 takes the mutant, 0.0 keeps the sample), stored contiguously per candidate.
+   */
+  std::vector<double> _crossoverMask;
+
+  /**
+   * @brief Uniform random numbers used to pull infeasible candidates back into the domain, stored contiguously per candidate.
+   */
+  std::vector<double> _infeasibleShrinkFactors;
+
+  /**
+   * @brief Lower bounds of the variables, cached for the vectorized kernels.
+   */
+  std::vector<double> _lowerBounds;
+
+  /**
+   * @brief Upper bounds of the variables, cached for the vectorized kernels.
+   */
+  std::vector<double> _upperBounds;
+
+  /**
+   * @brief Mutates and crosses over a set of candidates. Random numbers are drawn first, then trial vectors are built in a single pass over the contiguous population.
+   * @param candidateIds Indexes of the candidates to be mutated.
+   */
+  void mutateCandidates(const std::vector<size_t> &candidateIds);
+
+  /**
+   * @brief Fix candidate params that are outside of domain.
+   * @param candidateIds Indexes of the candidates that are outside of domain.
+   */
+  void fixInfeasible(const std::vector<size_t> &candidateIds);
+
+  /**
+   * @brief Checks whether a candidate lies within the variable bounds.
+   * @param candidateIdx Index of the candidate to check.
+   * @return True, if feasible; false, otherwise.
+   */
+  bool isCandidateFeasible(size_t candidateIdx);
+
+  /**
+   * @brief Produces feasible candidates for a contiguous range of the population.
+   * @param begin Index of the first candidate.
+   * @param end Index past the last candidate.
+   */
+  void prepareCandidates(size_t begin, size_t end);
+
+  /**
+   * @brief Dispatches the evaluation of a candidate.
+   * @param sample Sample to use for the evaluation.
+   * @param candidateIdx Index of the candidate to evaluate.
+   */
+  void launchCandidate(Sample &sample, size_t candidateIdx);
+
+  /**
+   * @brief Applies the accept rule to a single evaluated candidate (asynchronous version).
+   * @param candidateIdx Index of the evaluated candidate.
+   * @param value Objective function value of the candidate.
+   */
+  void acceptCandidate(size_t candidateIdx, double value);
 
   /**
    * @brief Update the state of Differential Evolution
@@ -49,6 +117,11 @@ class DEA : public Optimizer
    */
   void updateSolver(std::vector<Sample> &samples);
 
+  /**
+   * @brief Updates population mean, widths and step size after selection.
+   */
+  void updatePopulationStatistics();
+
   /**
    * @brief Create new set of candidates.
    */
@@ -59,8 +132,17 @@ class DEA : public Optimizer
    */
   void prepareGeneration();
 
+  /**
+   * @brief Runs a generation in which candidates are selected and replaced as soon as their evaluation finishes.
+   */
+  void runAsynchronousGeneration();
+
   public: 
   /**
+  * @brief Indicates which variant of the Differential Evolution algorithm to use.
+  */
+   std::string _version;
+  /**
   * @brief Specifies the number of samples to evaluate per generation (preferably 5-10x the number of variables).
   */
    size_t _populationSize;
@@ -81,7 +163,7 @@ class DEA : public Optimizer
   */
    std::string _parentSelectionRule;
   /**
-  * @brief Sets the accept rule after sample mutation and evaluation.
+  * @brief Sets the accept rule after sample mutation and evaluation. The Asynchronous version only supports the Greedy rule.
   */
    std::string _acceptRule;
   /**
@@ -105,13 +187,13 @@ class DEA : public Optimizer
   */
    std::vector<double> _previousValueVector;
   /**
-  * @brief [Internal Use] Sample variable information.
+  * @brief [Internal Use] Sample variable information, stored contiguously (one row of Variable Count entries per sample).
   */
-   std::vector<std::vector<double>> _samplePopulation;
+   std::vector<double> _samplePopulation;
   /**
-  * @brief [Internal Use] Sample candidates variable information.
+  * @brief [Internal Use] Sample candidates variable information, stored contiguously (one row of Variable Count entries per candidate).
   */
-   std::vector<std::vector<double>> _candidatePopulation;
+   std::vector<double> _candidatePopulation;
   /**
   * @brief [Internal Use] Index of the best sample in current generation.
   */
@@ -2,6 +2,9 @@
 #include "modules/solver/optimizer/gridSearch/gridSearch.hpp"
 #include "sample/sample.hpp"
 
+#include <algorithm>
+#include <functional>
+
 namespace korali
 {
 namespace solver
@@ -29,8 +32,17 @@ void GridSearch::setInitialConfiguration()
 
   _maxModelEvaluations = _numberOfValues;
 
-  _objective.resize(_numberOfValues);
+  if (_executionsPerGeneration == 0) KORALI_LOG_ERROR("Executions Per Generation must be larger than 0.\n");
+  if (_concurrentEvaluations == 0) KORALI_LOG_ERROR("Concurrent Evaluations must be larger than 0.\n");
+
   _bestEverVariables.resize(_variableCount);
+  _bestEverValue = -Inf;
+  _currentBestValue = -Inf;
+  _previousBestValue = -Inf;
+
+  _gridCursor = 0;
+  _topValues.clear();
+  _topParameters.clear();
 
   // We assume i = _index[0] + _index[1]*_sample[0].size() + _index[1]*_sample[0].size()*_sample[1].size() + .....
   _indexHelper.resize(_variableCount);
@@ -47,48 +59,94 @@ void GridSearch::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
-  // Example: Evaluating a sample
-  std::vector<Sample> samples(_numberOfValues);
-  std::vector<double> sampleData(_variableCount);
+  _previousBestValue = _currentBestValue;
+  _currentBestValue = -Inf;
 
-  size_t rest, index;
-  for (size_t i = 0; i < _numberOfValues; i++)
+  // Streaming this generation's share of the grid through a bounded window of samples
+  size_t generationEnd = std::min(_numberOfValues, _gridCursor + _executionsPerGeneration);
+  size_t windowSize = std::min(_concurrentEvaluations, generationEnd - _gridCursor);
+
+  std::vector<Sample> samples(windowSize);
+  for (size_t i = 0; i < windowSize; i++) launchGridPoint(samples[i]);
+
+  size_t pendingSamples = windowSize;
+  while (pendingSamples > 0)
   {
-    rest = i;
-    for (int d = _variableCount - 1; d >= 0; d--)
-    {
-      // We assume i = _index[0] + _index[1]*_sample[0].size() + _index[1]*_sample[0].size()*_sample[1].size() + .....
-      if (d == 0)
-        index = rest % _indexHelper[d];
-      else
-        index = rest / _indexHelper[d];
+    size_t finishedId = KORALI_WAITANY(samples);
+    pendingSamples--;
 
-      rest -= index * _indexHelper[d];
+    auto parameters = KORALI_GET(std::vector<double>, samples[finishedId], "Parameters");
+    auto value = KORALI_GET(double, samples[finishedId], "F(x)");
+    updateBest(parameters, value);
 
-      sampleData[d] = _k->_variables[d]->_values[index];
+    // Reusing the finished sample for the next grid point
+    if (_gridCursor < generationEnd)
+    {
+      launchGridPoint(samples[finishedId]);
+      pendingSamples++;
     }
-    _k->_logger->logInfo("Detailed", "Running sample %zu/%zu with values:\n         ", i + 1, _numberOfValues);
-    for (auto &x : sampleData) _k->_logger->logData("Detailed", " %f   ", x);
-    _k->_logger->logData("Detailed", "\n");
-
-    samples[i]["Module"] = "Problem";
-    samples[i]["Operation"] = "Evaluate";
-    samples[i]["Parameters"] = sampleData;
-    samples[i]["Sample Id"] = i;
-    KORALI_START(samples[i]);
-    _modelEvaluationCount++;
   }
-  KORALI_WAITALL(samples);
-  for (size_t i = 0; i < _numberOfValues; i++)
+}
+
+void GridSearch::getGridPoint(size_t index, std::vector<double> &point)
+{
+  size_t rest = index;
+  for (int d = _variableCount - 1; d >= 0; d--)
+  {
+    // We assume i = _index[0] + _index[1]*_sample[0].size() + _index[1]*_sample[0].size()*_sample[1].size() + .....
+    size_t valueIndex;
+    if (d == 0)
+      valueIndex = rest % _indexHelper[d];
+    else
+      valueIndex = rest / _indexHelper[d];
+
+    rest -= valueIndex * _indexHelper[d];
+
+    point[d] = _k->_variables[d]->_values[valueIndex];
+  }
+}
+
+void GridSearch::launchGridPoint(Sample &sample)
+{
+  std::vector<double> sampleData(_variableCount);
+  getGridPoint(_gridCursor, sampleData);
+
+  _k->_logger->logInfo("Detailed", "Running sample %zu/%zu with values:\n         ", _gridCursor + 1, _numberOfValues);
+  for (auto &x : sampleData) _k->_logger->logData("Detailed", " %f   ", x);
+  _k->_logger->logData("Detailed", "\n");
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Evaluate";
+  sample["Parameters"] = sampleData;
+  sample["Sample Id"] = _gridCursor;
+  KORALI_START(sample);
+  _modelEvaluationCount++;
+  _gridCursor++;
+}
+
+void GridSearch::updateBest(const std::vector<double> &parameters, const double value)
+{
+  if (value > _currentBestValue) _currentBestValue = value;
+
+  if (value > _bestEverValue)
   {
-    _objective[i] = KORALI_GET(double, samples[i], "F(x)");
+    _bestEverValue = value;
+    _bestEverVariables = parameters;
   }
 
-  std::vector<double>::iterator maximum = std::max_element(_objective.begin(), _objective.end());
-  size_t maxIndex = std::distance(_objective.begin(), maximum);
+  if (_topSampleCount == 0) return;
+  if (_topValues.size() == _topSampleCount && (value > _topValues.back()) == false) return;
+
+  // Inserting while keeping the values in descending order
+  size_t position = std::distance(_topValues.begin(), std::upper_bound(_topValues.begin(), _topValues.end(), value, std::greater<double>()));
+  _topValues.insert(_topValues.begin() + position, value);
+  _topParameters.insert(_topParameters.begin() + position, parameters);
 
-  _bestEverVariables = KORALI_GET(std::vector<double>, samples[maxIndex], "Parameters");
-  _bestEverValue = KORALI_GET(double, samples[maxIndex], "F(x)");
+  if (_topValues.size() > _topSampleCount)
+  {
+    _topValues.pop_back();
+    _topParameters.pop_back();
+  }
 }
 
 void GridSearch::printGenerationBefore()
@@ -108,6 +166,12 @@ void GridSearch::finalize()
   // Updating Results
   (*_k)["Results"]["Best Sample"]["Parameters"] = _bestEverVariables;
   (*_k)["Results"]["Best Sample"]["F(x)"] = _bestEverValue;
+
+  for (size_t i = 0; i < _topValues.size(); i++)
+  {
+    (*_k)["Results"]["Top Samples"][i]["Parameters"] = _topParameters[i];
+    (*_k)["Results"]["Top Samples"][i]["F(x)"] = _topValues[i];
+  }
 }
 
 void GridSearch::setConfiguration(knlohmann::json& js) 
@@ -122,12 +186,28 @@ void GridSearch::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Number Of Values");
  }
 
- if (isDefined(js, "Objective"))
+ if (isDefined(js, "Grid Cursor"))
  {
- try { _objective = js["Objective"].get<std::vector<double>>();
+ try { _gridCursor = js["Grid Cursor"].get<size_t>();
 } catch (const std::exception& e)
- { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Objective']\n%s", e.what()); } 
-   eraseValue(js, "Objective");
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Grid Cursor']\n%s", e.what()); } 
+   eraseValue(js, "Grid Cursor");
+ }
+
+ if (isDefined(js, "Top Values"))
+ {
+ try { _topValues = js["Top Values"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Values']\n%s", e.what()); } 
+   eraseValue(js, "Top Values");
+ }
+
+ if (isDefined(js, "Top Parameters"))
+ {
+ try { _topParameters = js["Top Parameters"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Parameters']\n%s", e.what()); } 
+   eraseValue(js, "Top Parameters");
  }
 
  if (isDefined(js, "Index Helper"))
@@ -138,6 +218,33 @@ void GridSearch::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Index Helper");
  }
 
+ if (isDefined(js, "Executions Per Generation"))
+ {
+ try { _executionsPerGeneration = js["Executions Per Generation"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Executions Per Generation']\n%s", e.what()); } 
+   eraseValue(js, "Executions Per Generation");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Executions Per Generation'] required by gridSearch.\n"); 
+
+ if (isDefined(js, "Concurrent Evaluations"))
+ {
+ try { _concurrentEvaluations = js["Concurrent Evaluations"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Concurrent Evaluations']\n%s", e.what()); } 
+   eraseValue(js, "Concurrent Evaluations");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Concurrent Evaluations'] required by gridSearch.\n"); 
+
+ if (isDefined(js, "Top Sample Count"))
+ {
+ try { _topSampleCount = js["Top Sample Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Sample Count']\n%s", e.what()); } 
+   eraseValue(js, "Top Sample Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Top Sample Count'] required by gridSearch.\n"); 
+
  if (isDefined(_k->_js.getJson(), "Variables"))
  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
  } 
@@ -151,8 +258,13 @@ void GridSearch::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Executions Per Generation"] = _executionsPerGeneration;
+   js["Concurrent Evaluations"] = _concurrentEvaluations;
+   js["Top Sample Count"] = _topSampleCount;
    js["Number Of Values"] = _numberOfValues;
-   js["Objective"] = _objective;
+   js["Grid Cursor"] = _gridCursor;
+   js["Top Values"] = _topValues;
+   js["Top Parameters"] = _topParameters;
    js["Index Helper"] = _indexHelper;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
  } 
@@ -162,7 +274,7 @@ void GridSearch::getConfiguration(knlohmann::json& js)
 void GridSearch::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{}";
+ std::string defaultString = "{\"Executions Per Generation\": 500000000, \"Concurrent Evaluations\": 1000, \"Top Sample Count\": 0, \"Grid Cursor\": 0, \"Top Values\": [], \"Top Parameters\": []}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
@@ -27,15 +27,56 @@ namespace optimizer
 */
 class GridSearch : public Optimizer
 {
+  private:
+  /**
+   * @brief Computes the parameters of a grid point from its linear index.
+   * @param index Linear index of the grid point.
+   * @param point Vector to store the parameters of the grid point.
+   */
+  void getGridPoint(size_t index, std::vector<double> &point);
+
+  /**
+   * @brief Dispatches the evaluation of the grid point under the cursor and advances the cursor.
+   * @param sample Sample to use for the evaluation.
+   */
+  void launchGridPoint(Sample &sample);
+
+  /**
+   * @brief Updates the running best and the list of top grid points with an evaluated grid point.
+   * @param parameters Parameters of the grid point.
+   * @param value Objective function value of the grid point.
+   */
+  void updateBest(const std::vector<double> &parameters, const double value);
+
   public: 
   /**
+  * @brief Specifies the number of grid points evaluated per generation. The grid cursor is stored between generations, so a run resumed from a checkpoint continues with the first grid point not yet evaluated.
+  */
+   size_t _executionsPerGeneration;
+  /**
+  * @brief Specifies the maximum number of grid points under evaluation at the same time. A new grid point is dispatched as soon as any evaluation finishes, so memory usage does not depend on the size of the grid.
+  */
+   size_t _concurrentEvaluations;
+  /**
+  * @brief Specifies how many of the best grid points (and their objective values) to keep and report in the results. If set to 0, only the best grid point is kept.
+  */
+   size_t _topSampleCount;
+  /**
   * @brief [Internal Use] Total number of parameter to evaluate (samples per generation).
   */
    size_t _numberOfValues;
   /**
-  * @brief [Internal Use] Vector containing values of the objective function.
+  * @brief [Internal Use] Linear index of the next grid point to evaluate.
+  */
+   size_t _gridCursor;
+  /**
+  * @brief [Internal Use] Objective values of the best grid points found so far, in descending order.
+  */
+   std::vector<double> _topValues;
+  /**
+  * @brief [Internal Use] Parameters of the best grid points found so far, in the same order as Top Values.
   */
-   std::vector<double> _objective;
+   std::vector<std::vector<double>> _topParameters;
   /**
   * @brief [Internal Use] Holds helper to calculate cartesian indices from linear index.
   */
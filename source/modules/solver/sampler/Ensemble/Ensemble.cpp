@@ -0,0 +1,208 @@
+#include "engine.hpp"
+#include "modules/experiment/experiment.hpp"
+#include "modules/problem/problem.hpp"
+#include "modules/solver/sampler/Ensemble/Ensemble.hpp"
+#include "sample/sample.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace korali
+{
+namespace solver
+{
+namespace sampler
+{
+;
+
+void Ensemble::setInitialConfiguration()
+{
+  _variableCount = _k->_variables.size();
+
+  if (_walkerCount % 2 != 0) KORALI_LOG_ERROR("Walker Count must be even (is %zu).\n", _walkerCount);
+  if (_walkerCount < 2 * _variableCount) KORALI_LOG_ERROR("Walker Count must be at least twice the number of variables (is %zu, required %zu).\n", _walkerCount, 2 * _variableCount);
+  if (_walkerCount < 4) KORALI_LOG_ERROR("Walker Count must be at least 4 (is %zu).\n", _walkerCount);
+  if (_leap < 1) KORALI_LOG_ERROR("Leap must be larger 0 (is %zu).\n", _leap);
+  if (_stretchScale <= 1.0) KORALI_LOG_ERROR("Stretch Scale must be larger 1.0 (is %lf).\n", _stretchScale);
+  if (_differentialEvolutionProbability < 0.0 || _differentialEvolutionProbability > 1.0) KORALI_LOG_ERROR("Differential Evolution Probability must be in [0.0, 1.0] (is %lf).\n", _differentialEvolutionProbability);
+  if (_differentialEvolutionScale < 0.0) KORALI_LOG_ERROR("Differential Evolution Scale must be larger equal 0.0 (is %lf).\n", _differentialEvolutionScale);
+  if (_differentialEvolutionNoise < 0.0) KORALI_LOG_ERROR("Differential Evolution Noise must be larger equal 0.0 (is %lf).\n", _differentialEvolutionNoise);
+
+  for (size_t d = 0; d < _variableCount; d++)
+    if (_k->_variables[d]->_initialStandardDeviation <= 0.0) KORALI_LOG_ERROR("Initial Standard Deviation of variable '%s' must be larger 0.0 (is %lf).\n", _k->_variables[d]->_name.c_str(), _k->_variables[d]->_initialStandardDeviation);
+
+  if (_differentialEvolutionScale == 0.0) _differentialEvolutionScale = 2.38 / std::sqrt(2.0 * (double)_variableCount);
+
+  // Walker and proposal storage is contiguous, one row per walker
+  _walkers.resize(_walkerCount * _variableCount);
+  _walkerEvaluations.resize(_walkerCount);
+  _proposals.resize(_walkerCount / 2 * _variableCount);
+  _proposalLogJacobians.resize(_walkerCount / 2);
+
+  for (size_t k = 0; k < _walkerCount; k++)
+    for (size_t d = 0; d < _variableCount; d++)
+      _walkers[k * _variableCount + d] = _k->_variables[d]->_initialMean + _k->_variables[d]->_initialStandardDeviation * _normalGenerator->getRandomNumber();
+
+  _acceptanceCount = 0;
+  _proposedSampleCount = 0;
+  _acceptanceRate = 1.0;
+  _chainLength = 0;
+}
+
+void Ensemble::evaluatePositions(const std::vector<double> &positions, std::vector<double> &evaluations)
+{
+  const size_t positionCount = positions.size() / _variableCount;
+  std::vector<Sample> samples(positionCount);
+
+  for (size_t k = 0; k < positionCount; k++)
+  {
+    samples[k]["Parameters"] = std::vector<double>(positions.begin() + k * _variableCount, positions.begin() + (k + 1) * _variableCount);
+    samples[k]["Sample Id"] = _modelEvaluationCount;
+    samples[k]["Module"] = "Problem";
+    samples[k]["Operation"] = "Evaluate";
+    _modelEvaluationCount++;
+    KORALI_START(samples[k]);
+  }
+
+  KORALI_WAITALL(samples);
+
+  evaluations.resize(positionCount);
+  for (size_t k = 0; k < positionCount; k++)
+  {
+    double evaluation = KORALI_GET(double, samples[k], "logP(x)");
+    evaluations[k] = evaluation;
+  }
+}
+
+void Ensemble::runGeneration()
+{
+  if (_k->_currentGeneration == 1)
+  {
+    setInitialConfiguration();
+
+    evaluatePositions(_walkers, _walkerEvaluations);
+
+    for (size_t k = 0; k < _walkerCount; k++)
+      if (std::isfinite(_walkerEvaluations[k]) == false) KORALI_LOG_ERROR("Initial position of walker %zu has a non-finite log-density (%lf). Consider reducing the Initial Standard Deviation.\n", k, _walkerEvaluations[k]);
+  }
+
+  // Each half is updated against the current positions of the other half, which keeps the chain in detailed balance
+  const size_t halfCount = _walkerCount / 2;
+  updateHalfEnsemble(0, halfCount);
+  updateHalfEnsemble(halfCount, 0);
+
+  _acceptanceRate = (double)_acceptanceCount / (double)_proposedSampleCount;
+
+  if ((_chainLength >= _burnIn) && (_chainLength % _leap == 0))
+  {
+    _sampleDatabase.insert(_sampleDatabase.end(), _walkers.begin(), _walkers.end());
+    _sampleEvaluationDatabase.insert(_sampleEvaluationDatabase.end(), _walkerEvaluations.begin(), _walkerEvaluations.end());
+  }
+
+  _chainLength++;
+}
+
+void Ensemble::proposeStretch(const size_t activeOffset, const size_t complementOffset)
+{
+  const size_t halfCount = _walkerCount / 2;
+
+  for (size_t k = 0; k < halfCount; k++)
+  {
+    // Drawing z from g(z) ~ 1/sqrt(z) on [1/a, a] by inversion
+    const double u = _uniformGenerator->getRandomNumber();
+    const double z = std::pow((_stretchScale - 1.0) * u + 1.0, 2.0) / _stretchScale;
+    const size_t j = complementOffset + std::min((size_t)(_uniformGenerator->getRandomNumber() * halfCount), halfCount - 1);
+
+    const double *xk = &_walkers[(activeOffset + k) * _variableCount];
+    const double *xj = &_walkers[j * _variableCount];
+    double *y = &_proposals[k * _variableCount];
+    for (size_t d = 0; d < _variableCount; d++) y[d] = xj[d] + z * (xk[d] - xj[d]);
+
+    _proposalLogJacobians[k] = ((double)_variableCount - 1.0) * std::log(z);
+  }
+}
+
+void Ensemble::proposeDifferentialEvolution(const size_t activeOffset, const size_t complementOffset)
+{
+  const size_t halfCount = _walkerCount / 2;
+
+  for (size_t k = 0; k < halfCount; k++)
+  {
+    // Drawing two distinct walkers of the complementary half
+    const size_t j1 = std::min((size_t)(_uniformGenerator->getRandomNumber() * halfCount), halfCount - 1);
+    size_t j2 = std::min((size_t)(_uniformGenerator->getRandomNumber() * (halfCount - 1)), halfCount - 2);
+    if (j2 >= j1) j2++;
+
+    const double *xk = &_walkers[(activeOffset + k) * _variableCount];
+    const double *xj1 = &_walkers[(complementOffset + j1) * _variableCount];
+    const double *xj2 = &_walkers[(complementOffset + j2) * _variableCount];
+    double *y = &_proposals[k * _variableCount];
+    for (size_t d = 0; d < _variableCount; d++) y[d] = xk[d] + _differentialEvolutionScale * (xj1[d] - xj2[d]) + _differentialEvolutionNoise * _normalGenerator->getRandomNumber();
+
+    _proposalLogJacobians[k] = 0.0;
+  }
+}
+
+void Ensemble::updateHalfEnsemble(const size_t activeOffset, const size_t complementOffset)
+{
+  const size_t halfCount = _walkerCount / 2;
+
+  if (_differentialEvolutionProbability > 0.0 && _uniformGenerator->getRandomNumber() < _differentialEvolutionProbability)
+    proposeDifferentialEvolution(activeOffset, complementOffset);
+  else
+    proposeStretch(activeOffset, complementOffset);
+
+  std::vector<double> proposalEvaluations;
+  evaluatePositions(_proposals, proposalEvaluations);
+  _proposedSampleCount += halfCount;
+
+  for (size_t k = 0; k < halfCount; k++)
+  {
+    const size_t walkerIdx = activeOffset + k;
+    if (std::isfinite(proposalEvaluations[k]) == false) continue;
+
+    const double logAlpha = _proposalLogJacobians[k] + proposalEvaluations[k] - _walkerEvaluations[walkerIdx];
+    if (logAlpha >= 0.0 || std::log(_uniformGenerator->getRandomNumber()) < logAlpha)
+    {
+      std::copy(_proposals.begin() + k * _variableCount, _proposals.begin() + (k + 1) * _variableCount, _walkers.begin() + walkerIdx * _variableCount);
+      _walkerEvaluations[walkerIdx] = proposalEvaluations[k];
+      _acceptanceCount++;
+    }
+  }
+}
+
+void Ensemble::printGenerationBefore() { return; }
+
+void Ensemble::printGenerationAfter()
+{
+  _k->_logger->logInfo("Minimal", "Database Entries %zu\n", _sampleEvaluationDatabase.size());
+  _k->_logger->logInfo("Normal", "Accepted Samples: %zu\n", _acceptanceCount);
+  _k->_logger->logInfo("Normal", "Acceptance Rate Proposals: %.2f%%\n", 100 * _acceptanceRate);
+
+  _k->_logger->logInfo("Detailed", "Current Ensemble Mean:\n");
+  for (size_t d = 0; d < _variableCount; d++)
+  {
+    double mean = 0.0;
+    for (size_t k = 0; k < _walkerCount; k++) mean += _walkers[k * _variableCount + d];
+    _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), mean / (double)_walkerCount);
+  }
+}
+
+void Ensemble::finalize()
+{
+  _k->_logger->logInfo("Minimal", "Number of Generated Samples: %zu\n", _proposedSampleCount);
+  _k->_logger->logInfo("Minimal", "Acceptance Rate: %.2f%%\n", 100 * _acceptanceRate);
+  if (_sampleEvaluationDatabase.size() >= _maxSamples) _k->_logger->logInfo("Minimal", "Max Samples Reached.\n");
+
+  // Results are reported with one entry per sample, as for the other samplers
+  const size_t sampleCount = _sampleEvaluationDatabase.size();
+  std::vector<std::vector<double>> sampleDatabase(sampleCount);
+  for (size_t i = 0; i < sampleCount; i++) sampleDatabase[i].assign(_sampleDatabase.begin() + i * _variableCount, _sampleDatabase.begin() + (i + 1) * _variableCount);
+  (*_k)["Results"]["Sample Database"] = sampleDatabase;
+}
+
+} //sampler
+} //solver
+} //korali
+;
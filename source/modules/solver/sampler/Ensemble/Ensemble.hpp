@@ -0,0 +1,181 @@
+/** \namespace sampler
+* @brief Namespace declaration for modules of type: sampler.
+*/
+
+/** \file
+* @brief Header file for module: Ensemble.
+*/
+
+/** \dir solver/sampler/Ensemble
+* @brief Contains code, documentation, and scripts for module: Ensemble.
+*/
+
+#pragma once
+
+#include "modules/distribution/univariate/normal/normal.hpp"
+#include "modules/distribution/univariate/uniform/uniform.hpp"
+#include "modules/solver/sampler/sampler.hpp"
+#include <vector>
+
+namespace korali
+{
+namespace solver
+{
+namespace sampler
+{
+;
+
+/**
+* @brief Class declaration for module: Ensemble.
+*/
+class Ensemble : public Sampler
+{
+  private:
+  /**
+   * @brief Evaluates a batch of positions concurrently.
+   * @param positions Positions to evaluate, stored contiguously
+   * @param evaluations Storage for the log-density of each position
+   */
+  void evaluatePositions(const std::vector<double> &positions, std::vector<double> &evaluations);
+
+  /**
+   * @brief Generates the stretch move proposals for the walkers of one half of the ensemble.
+   * @param activeOffset Index of the first walker being updated
+   * @param complementOffset Index of the first walker of the complementary half
+   */
+  void proposeStretch(const size_t activeOffset, const size_t complementOffset);
+
+  /**
+   * @brief Generates the differential evolution proposals for the walkers of one half of the ensemble.
+   * @param activeOffset Index of the first walker being updated
+   * @param complementOffset Index of the first walker of the complementary half
+   */
+  void proposeDifferentialEvolution(const size_t activeOffset, const size_t complementOffset);
+
+  /**
+   * @brief Updates one half of the ensemble: all its proposals are evaluated as a single batch before the acceptance step.
+   * @param activeOffset Index of the first walker being updated
+   * @param complementOffset Index of the first walker of the complementary half
+   */
+  void updateHalfEnsemble(const size_t activeOffset, const size_t complementOffset);
+
+  public: 
+  /**
+  * @brief Number of walkers in the ensemble. Must be even and larger than the number of variables. Each half of the ensemble is evaluated as one batch, hence up to half of this number of workers are kept busy.
+  */
+   size_t _walkerCount;
+  /**
+  * @brief Specifies the number of preliminary ensemble updates before samples are being stored.
+  */
+   size_t _burnIn;
+  /**
+  * @brief Stores the walkers only every 'Leap'-th ensemble update (thinning).
+  */
+   size_t _leap;
+  /**
+  * @brief Scale parameter (a > 1) of the stretch move distribution g(z) ~ 1/sqrt(z) on [1/a, a].
+  */
+   double _stretchScale;
+  /**
+  * @brief Probability to update a half of the ensemble with the differential evolution move instead of the stretch move.
+  */
+   double _differentialEvolutionProbability;
+  /**
+  * @brief Scale of the difference vector in the differential evolution move. If 0.0 (default) it is set to 2.38 / sqrt(2 * N), N being the number of variables.
+  */
+   double _differentialEvolutionScale;
+  /**
+  * @brief Standard deviation of the gaussian noise added to the differential evolution move.
+  */
+   double _differentialEvolutionNoise;
+  /**
+  * @brief [Internal Use] Normal random number generator.
+  */
+   korali::distribution::univariate::Normal* _normalGenerator;
+  /**
+  * @brief [Internal Use] Uniform random number generator.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Internal Use] Current position of all walkers, stored contiguously (walker k occupies entries k * N to (k + 1) * N - 1).
+  */
+   std::vector<double> _walkers;
+  /**
+  * @brief [Internal Use] Log-density of the current position of all walkers.
+  */
+   std::vector<double> _walkerEvaluations;
+  /**
+  * @brief [Internal Use] Proposed positions of the half of the ensemble being updated, stored contiguously.
+  */
+   std::vector<double> _proposals;
+  /**
+  * @brief [Internal Use] Log of the Jacobian factor of the proposals (zero for the differential evolution move).
+  */
+   std::vector<double> _proposalLogJacobians;
+  /**
+  * @brief [Internal Use] Number of accepted proposals (including Burn In period).
+  */
+   size_t _acceptanceCount;
+  /**
+  * @brief [Internal Use] Number of proposals.
+  */
+   size_t _proposedSampleCount;
+  /**
+  * @brief [Internal Use] Ratio of accepted to proposed samples (including Burn In period).
+  */
+   double _acceptanceRate;
+  /**
+  * @brief [Internal Use] Number of ensemble updates (including Burn In and Leaped updates).
+  */
+   size_t _chainLength;
+  /**
+  * @brief [Internal Use] Stored walker positions, stored contiguously (sample i occupies entries i * N to (i + 1) * N - 1).
+  */
+   std::vector<double> _sampleDatabase;
+  /**
+  * @brief [Internal Use] Log-density of the stored walker positions.
+  */
+   std::vector<double> _sampleEvaluationDatabase;
+  /**
+  * @brief [Termination Criteria] Number of Samples to Generate.
+  */
+   size_t _maxSamples;
+  
+ 
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
+  /**
+  * @brief Obtains the entire current state and configuration of the module.
+  * @param js JSON object onto which to save the serialized state of the module.
+  */
+  void getConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Sets the entire state and configuration of the module, given a JSON object.
+  * @param js JSON object from which to deserialize the state of the module.
+  */
+  void setConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default configuration upon its creation.
+  * @param js JSON object containing user configuration. The defaults will not override any currently defined settings.
+  */
+  void applyModuleDefaults(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default variable configuration to each variable in the Experiment upon creation.
+  */
+  void applyVariableDefaults() override;
+  
+
+  void setInitialConfiguration() override;
+  void runGeneration() override;
+  void printGenerationBefore() override;
+  void printGenerationAfter() override;
+  void finalize() override;
+};
+
+} //sampler
+} //solver
+} //korali
+;
@@ -75,16 +75,58 @@ void HMC::setInitialConfiguration()
       KORALI_LOG_ERROR("Burn In too short for adaptive step size, must be larger than %zu (is %zu).", minBurnInLength, _burnIn);
   }
 
+  if (_chainCount < 1) KORALI_LOG_ERROR("Chain Count must be larger 0 (is %zu).\n", _chainCount);
+  if (_diagnosticsFrequency < 1) KORALI_LOG_ERROR("Diagnostics Frequency must be larger 0 (is %zu).\n", _diagnosticsFrequency);
+
+  // The momentum generator of the dense metrics is shared, hence it cannot hold a metric per chain
+  if (_chainCount > 1 && _useDiagonalMetric == false && _metricType != Metric::Static) KORALI_LOG_ERROR("Chain Count larger 1 requires 'Use Diagonal Metric' to be true.\n");
+
+  // Prepare DBs
+  _sampleDatabase.resize(0);
+  _sampleEvaluationDatabase.resize(0);
+
+  // Initialize common variables
+  _proposedSampleCount = 0;
+  _chainLength = 0;
+
+  // Init Convergence Diagnostics
+  _potentialScaleReduction.clear();
+  _effectiveSampleSize.clear();
+  _currentMaxPotentialScaleReduction = std::numeric_limits<double>::infinity();
+  _currentMinEffectiveSampleSize = 0.0;
+
+  // Every chain starts with the configured step size
+  _chainStates.clear();
+  _chainStates.resize(_chainCount);
+  for (size_t c = 1; c < _chainCount; c++)
+  {
+    _chainStates[c].stepSize = _stepSize;
+    _chainStates[c].numIntegrationSteps = _numIntegrationSteps;
+  }
+
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+    initializeChain();
+
+    // The first chain starts at the initial mean, the others at a random draw around it
+    if (c > 0)
+      for (size_t i = 0; i < _variableCount; i++)
+        _positionLeader[i] += _k->_variables[i]->_initialStandardDeviation * _normalGenerator->getRandomNumber();
+
+    swapChainState(c);
+  }
+}
+
+void HMC::initializeChain()
+{
   // Resizing vectors of internal settings to correct dimensions
   _positionLeader.resize(_variableCount);
   _positionCandidate.resize(_variableCount);
   _momentumLeader.resize(_variableCount);
   _momentumCandidate.resize(_variableCount);
 
-  // Prepare DBs
-  _sampleDatabase.resize(0);
   _euclideanWarmupSampleDatabase.resize(0);
-  _sampleEvaluationDatabase.resize(0);
 
   // Initializing variable defaults
   for (size_t i = 0; i < _variableCount; i++)
@@ -135,10 +177,26 @@ void HMC::setInitialConfiguration()
   else
     _integrator = std::make_unique<LeapfrogExplicit>(_hamiltonian);
 
-  // Initialize common variables
+  // Preallocating the NUTS trajectory: one pending subtree per depth and the subtree under construction
+  _trajectory.treeHelpers.clear();
+  if (_useNUTS)
+  {
+    for (size_t d = 0; d <= _maxDepth; d++)
+    {
+      if (_metricType == Metric::Riemannian)
+        _trajectory.treeHelpers.push_back(std::make_unique<TreeHelperRiemannian>());
+      else
+        _trajectory.treeHelpers.push_back(std::make_unique<TreeHelperEuclidean>());
+      _trajectory.treeHelpers.back()->allocate(_variableCount);
+    }
+
+    _trajectory.rhoLeft.resize(_variableCount);
+    _trajectory.rhoRight.resize(_variableCount);
+    _trajectory.deltaRho.resize(_variableCount);
+  }
+
+  // Initialize chain variables
   _acceptanceCount = 0;
-  _proposedSampleCount = 0;
-  _chainLength = 0;
   _acceptanceRate = 1.;
   _acceptanceRateError = 0.;
   _runningAcceptanceRate = 1.;
@@ -156,252 +214,372 @@ void HMC::setInitialConfiguration()
 void HMC::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
-  _hamiltonian->updateHamiltonian(_positionLeader, _metric, _inverseMetric);
 
-  // Samples Momentum Candidate from N(0, metric)
-  _momentumCandidate = _hamiltonian->sampleMomentum(_metric);
-  _proposedSampleCount++;
+  std::vector<double> logUniSamples(_chainCount);
 
-  _positionCandidate = _positionLeader;
-  _momentumLeader = _momentumCandidate;
+  // Evaluating the leaders of all chains concurrently (unless the last evaluation of the chain already was at its leader)
+  std::vector<size_t> leaderChains;
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+    if (_hamiltonian->isEvaluated(_positionLeader) == false) leaderChains.push_back(c);
+    swapChainState(c);
+  }
 
-  if (_metricType == Metric::Riemannian_Const)
+  std::vector<Sample> samples(leaderChains.size());
+  for (size_t s = 0; s < leaderChains.size(); s++)
   {
-    int err = _hamiltonian->updateMetricMatricesRiemannian(_metric, _inverseMetric);
-    if (err > 0) _k->_logger->logWarning("Normal", "Error during metric update.");
+    swapChainState(leaderChains[s]);
+    _hamiltonian->startEvaluation(samples[s], _positionLeader);
+    swapChainState(leaderChains[s]);
   }
 
-  // New uniform sample for accept / reject
-  const double logUniSample = std::log(_uniformGenerator->getRandomNumber());
+  KORALI_WAITALL(samples);
+
+  for (size_t s = 0; s < leaderChains.size(); s++)
+  {
+    swapChainState(leaderChains[s]);
+    _hamiltonian->finishEvaluation(samples[s], _metric, _inverseMetric);
+    swapChainState(leaderChains[s]);
+  }
+
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+    logUniSamples[c] = initializeTrajectory();
+    swapChainState(c);
+  }
 
   // Execute version specific generation
   if (_useNUTS)
+    runGenerationNUTS(logUniSamples);
+  else
   {
-    if (_metricType == Metric::Riemannian)
-    {
-      runGenerationNUTSRiemannian(logUniSample);
-    }
-    else
-    {
-      runGenerationNUTS(logUniSample);
-    }
+    runGenerationHMC(logUniSamples);
   }
-  else
+
+  _modelEvaluationCount = 0;
+  for (size_t c = 0; c < _chainCount; c++)
   {
-    runGenerationHMC(logUniSample);
+    swapChainState(c);
+    saveSample();
+    updateState();
+    _modelEvaluationCount += _hamiltonian->_modelEvaluationCount;
+    swapChainState(c);
   }
 
-  saveSample();
+  _chainLength++;
 
-  updateState();
+  if ((_chainCount > 1 || _targetEffectiveSampleSize > 0.0) && (_k->_currentGeneration % _diagnosticsFrequency == 0)) updateDiagnostics();
 }
 
-void HMC::runGenerationHMC(const double logUniSample)
+double HMC::initializeTrajectory()
 {
-  // Track energies from leader
-  const double oldK = _hamiltonian->K(_momentumLeader, _inverseMetric);
-  const double oldU = _hamiltonian->U();
-
-  for (size_t i = 0; i < _numIntegrationSteps; ++i)
-    _integrator->step(_positionCandidate, _momentumCandidate, _metric, _inverseMetric, _stepSize);
-
-  // Negate proposed momentum to make proposal symmetric
-  std::transform(std::cbegin(_momentumCandidate), std::cend(_momentumCandidate), std::begin(_momentumCandidate), std::negate<double>());
+  // Samples Momentum Candidate from N(0, metric)
+  _momentumCandidate = _hamiltonian->sampleMomentum(_metric);
+  _proposedSampleCount++;
 
-  // Save energies from candidate
-  const double newK = _hamiltonian->K(_momentumCandidate, _inverseMetric);
-  const double newU = _hamiltonian->U();
-  const double logAlpha = std::min(0., -(newK - oldK + newU - oldU));
+  _positionCandidate = _positionLeader;
+  _momentumLeader = _momentumCandidate;
 
-  // Accept or reject sample
-  bool isNanPositionCandidate = isanynan(_positionCandidate);
-  _acceptanceProbability = isNanPositionCandidate ? 0. : std::exp(logAlpha);
-  _runningAcceptanceRate = _acceptanceRateLearningRate * _runningAcceptanceRate + (1. - _acceptanceRateLearningRate) * _acceptanceProbability;
-  if (logUniSample <= logAlpha && !isNanPositionCandidate)
+  if (_metricType == Metric::Riemannian_Const)
   {
-    _acceptanceCount++;
-    _positionLeader = _positionCandidate;
-    _leaderEvaluation = -newU;
+    int err = _hamiltonian->updateMetricMatricesRiemannian(_metric, _inverseMetric);
+    if (err > 0) _k->_logger->logWarning("Normal", "Error during metric update.");
   }
+
+  // New uniform sample for accept / reject
+  return std::log(_uniformGenerator->getRandomNumber());
 }
 
-void HMC::runGenerationNUTS(const double logUniSample)
+void HMC::runGenerationHMC(const std::vector<double> &logUniSamples)
 {
-  const double oldK = _hamiltonian->K(_momentumLeader, _inverseMetric);
-  const double oldU = _hamiltonian->U();
+  std::vector<double> oldK(_chainCount);
+  std::vector<double> oldU(_chainCount);
+  std::vector<size_t> integrationSteps(_chainCount);
 
-  auto qLeft = _positionLeader;
-  auto pLeft = _momentumLeader;
-  auto qRight = _positionLeader;
-  auto pRight = _momentumLeader;
+  // Track energies from leaders
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+    oldK[c] = _hamiltonian->K(_momentumLeader, _inverseMetric);
+    oldU[c] = _hamiltonian->U();
+    integrationSteps[c] = _numIntegrationSteps;
+    swapChainState(c);
+  }
 
-  _currentDepth = 0;
-  size_t numLeavesSubtree;
-  bool buildCriterion = true;
-  bool buildCriterionSubtree;
-  double numValidLeaves = 1.;
-  double numValidLeavesSubtree;
-  const double oldH = oldU + oldK;
-
-  auto helper = std::make_shared<TreeHelperEuclidean>();
-  helper->logUniSampleIn = logUniSample;
-  helper->rootHIn = oldH;
-  helper->buildCriterionOut = true;
-
-  do
+  const size_t maxIntegrationSteps = *std::max_element(std::cbegin(integrationSteps), std::cend(integrationSteps));
+
+  // Explicit leapfrog steps, split at the gradient evaluations such that all chains evaluate concurrently
+  for (size_t i = 0; i < maxIntegrationSteps; ++i)
   {
-    if (_uniformGenerator->getRandomNumber() < 0.5)
+    // Chains whose trajectory is shorter than the longest one stop stepping early
+    std::vector<size_t> steppingChains;
+    for (size_t c = 0; c < _chainCount; c++)
+      if (i < integrationSteps[c]) steppingChains.push_back(c);
+
+    // The position of a step usually is the last evaluated position of the previous step, whose evaluation is reused
+    std::vector<size_t> positionChains;
+    for (size_t c : steppingChains)
     {
-      helper->qIn = qLeft;
-      helper->pIn = pLeft;
-      helper->directionIn = -1;
+      swapChainState(c);
+      if (_hamiltonian->isEvaluated(_positionCandidate) == false) positionChains.push_back(c);
+      swapChainState(c);
+    }
+
+    std::vector<Sample> positionSamples(positionChains.size());
+    for (size_t s = 0; s < positionChains.size(); s++)
+    {
+      swapChainState(positionChains[s]);
+      _hamiltonian->startEvaluation(positionSamples[s], _positionCandidate);
+      swapChainState(positionChains[s]);
+    }
 
-      buildTree(helper, _currentDepth);
+    KORALI_WAITALL(positionSamples);
 
-      // qRight = --
-      // pRight = --
-      qLeft = helper->qLeftOut;
-      pLeft = helper->pLeftOut;
+    for (size_t s = 0; s < positionChains.size(); s++)
+    {
+      swapChainState(positionChains[s]);
+      _hamiltonian->finishEvaluation(positionSamples[s], _metric, _inverseMetric);
+      swapChainState(positionChains[s]);
+    }
 
-      // Setting for termination criterium
-      helper->qRightOut = qRight;
-      helper->pRightOut = pRight;
+    std::vector<Sample> driftSamples(steppingChains.size());
+    for (size_t s = 0; s < steppingChains.size(); s++)
+    {
+      swapChainState(steppingChains[s]);
+      _integrator->kickDrift(_positionCandidate, _momentumCandidate, _metric, _stepSize);
+      _hamiltonian->startEvaluation(driftSamples[s], _positionCandidate);
+      swapChainState(steppingChains[s]);
     }
-    else
+
+    KORALI_WAITALL(driftSamples);
+
+    for (size_t s = 0; s < steppingChains.size(); s++)
     {
-      helper->qIn = qRight;
-      helper->pIn = pRight;
-      helper->directionIn = +1;
+      swapChainState(steppingChains[s]);
+      _hamiltonian->finishEvaluation(driftSamples[s], _metric, _inverseMetric);
+      _integrator->kick(_momentumCandidate, _stepSize);
+      swapChainState(steppingChains[s]);
+    }
+  }
 
-      buildTree(helper, _currentDepth);
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+
+    // Negate proposed momentum to make proposal symmetric
+    std::transform(std::cbegin(_momentumCandidate), std::cend(_momentumCandidate), std::begin(_momentumCandidate), std::negate<double>());
 
-      // qLeft = --
-      // pLeft = --
-      qRight = helper->qRightOut;
-      pRight = helper->pRightOut;
+    // Save energies from candidate
+    const double newK = _hamiltonian->K(_momentumCandidate, _inverseMetric);
+    const double newU = _hamiltonian->U();
+    const double logAlpha = std::min(0., -(newK - oldK[c] + newU - oldU[c]));
 
-      // setting for termination criterium
-      helper->qLeftOut = qLeft;
-      helper->pLeftOut = pLeft;
+    // Accept or reject sample
+    bool isNanPositionCandidate = isanynan(_positionCandidate);
+    _acceptanceProbability = isNanPositionCandidate ? 0. : std::exp(logAlpha);
+    _runningAcceptanceRate = _acceptanceRateLearningRate * _runningAcceptanceRate + (1. - _acceptanceRateLearningRate) * _acceptanceProbability;
+    if (logUniSamples[c] <= logAlpha && !isNanPositionCandidate)
+    {
+      _acceptanceCount++;
+      _positionLeader = _positionCandidate;
+      _leaderEvaluation = -newU;
     }
-    _positionCandidate = helper->qProposedOut;
-    numValidLeavesSubtree = helper->numValidLeavesOut;
-    buildCriterionSubtree = helper->buildCriterionOut;
-    _acceptanceProbability = helper->alphaOut;
-    numLeavesSubtree = helper->numLeavesOut;
-
-    if (buildCriterionSubtree == true)
-      if (_uniformGenerator->getRandomNumber() < numValidLeavesSubtree / numValidLeaves && isanynan(_positionCandidate) == false)
-      {
-        _positionLeader = _positionCandidate;
-        _leaderEvaluation = -_hamiltonian->U();
-      }
 
-    numValidLeaves += numValidLeavesSubtree;
+    swapChainState(c);
+  }
+}
+
+void HMC::runGenerationNUTS(const std::vector<double> &logUniSamples)
+{
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    swapChainState(c);
+    startTrajectoryNUTS(logUniSamples[c]);
+    swapChainState(c);
+  }
 
-    buildCriterion = buildCriterionSubtree && helper->computeCriterion(*_hamiltonian);
+  // Advancing the trajectories of all chains in rounds, each unfinished trajectory evaluates one position per round
+  std::vector<bool> isTrajectoryActive(_chainCount, true);
+  size_t activeTrajectoryCount = _chainCount;
+  while (activeTrajectoryCount > 0)
+  {
+    // Only trajectories that stopped at an evaluation hold a started sample. The storage is reserved up front such that
+    // the samples are not moved while they run, and the slot of a trajectory that finished instead is released again.
+    std::vector<Sample> samples;
+    std::vector<size_t> sampleChains;
+    samples.reserve(activeTrajectoryCount);
+    for (size_t c = 0; c < _chainCount; c++)
+      if (isTrajectoryActive[c] == true)
+      {
+        swapChainState(c);
+        samples.emplace_back();
+        if (advanceTrajectoryNUTS(samples.back()) == true)
+          sampleChains.push_back(c);
+        else
+        {
+          samples.pop_back();
+          isTrajectoryActive[c] = false;
+          activeTrajectoryCount--;
+        }
+        swapChainState(c);
+      }
 
-    _currentDepth++;
-  } while (buildCriterion == true && _currentDepth <= _maxDepth);
+    KORALI_WAITALL(samples);
 
-  _currentDepth--;
-  _acceptanceProbability /= (double)numLeavesSubtree;
-  _acceptanceCountNUTS += _acceptanceProbability;
-  _runningAcceptanceRate = _acceptanceRateLearningRate * _runningAcceptanceRate + (1. - _acceptanceRateLearningRate) * _acceptanceProbability;
+    for (size_t s = 0; s < sampleChains.size(); s++)
+    {
+      swapChainState(sampleChains[s]);
+      _hamiltonian->finishEvaluation(samples[s], _metric, _inverseMetric);
+      swapChainState(sampleChains[s]);
+    }
+  }
 }
 
-void HMC::runGenerationNUTSRiemannian(const double logUniSample)
+void HMC::startTrajectoryNUTS(const double logUniSample)
 {
   const double oldK = _hamiltonian->K(_momentumLeader, _inverseMetric);
   const double oldU = _hamiltonian->U();
 
-  std::vector<double> qLeft = _positionLeader;
-  std::vector<double> pLeft = _momentumLeader;
-  std::vector<double> qRight = _positionLeader;
-  std::vector<double> pRight = _momentumLeader;
-
-  size_t depth = 0;
-  size_t numLeavesSubtree;
-  bool buildCriterion = true;
-  bool buildCriterionSubtree;
-  double numValidLeaves = 1.;
-  double numValidLeavesSubtree;
-  const double oldH = oldU + oldK;
-
-  auto helper = std::make_shared<TreeHelperRiemannian>();
-  helper->logUniSampleIn = logUniSample;
-  helper->rootHIn = oldH;
-  helper->buildCriterionOut = true;
-
-  std::vector<double> rhoInit = _momentumLeader;
-  std::vector<double> rhoLeft(_variableCount, 0.);
-  std::vector<double> rhoRight(_variableCount, 0.);
-  while (buildCriterion == true && depth <= _maxDepth)
+  _trajectory.qLeft = _positionLeader;
+  _trajectory.pLeft = _momentumLeader;
+  _trajectory.qRight = _positionLeader;
+  _trajectory.pRight = _momentumLeader;
+  std::fill(std::begin(_trajectory.rhoLeft), std::end(_trajectory.rhoLeft), 0.);
+  std::fill(std::begin(_trajectory.rhoRight), std::end(_trajectory.rhoRight), 0.);
+
+  _trajectory.logUniSample = logUniSample;
+  _trajectory.rootH = oldU + oldK;
+  _trajectory.numValidLeaves = 1.;
+  _currentDepth = 0;
+
+  startSubtreeNUTS();
+}
+
+void HMC::startSubtreeNUTS()
+{
+  _trajectory.direction = _uniformGenerator->getRandomNumber() < 0.5 ? -1 : +1;
+  _trajectory.leafId = 0;
+  _trajectory.stage = NUTSLeafStage::Start;
+}
+
+bool HMC::advanceTrajectoryNUTS(Sample &sample)
+{
+  auto &t = _trajectory;
+
+  while (true)
   {
-    if (_uniformGenerator->getRandomNumber() < 0.5)
+    // The outermost state in the direction of the subtree is advanced leaf by leaf
+    std::vector<double> &position = t.direction == -1 ? t.qLeft : t.qRight;
+    std::vector<double> &momentum = t.direction == -1 ? t.pLeft : t.pRight;
+    TreeHelper &leaf = *t.treeHelpers.back();
+
+    // Explicit leapfrog step, interrupted at every evaluation which is not already available
+    if (t.stage == NUTSLeafStage::Start)
     {
-      helper->qIn = qLeft;
-      helper->pIn = pLeft;
-      helper->directionIn = -1;
+      t.stage = NUTSLeafStage::PositionEvaluated;
+      if (_hamiltonian->isEvaluated(position) == false)
+      {
+        _hamiltonian->startEvaluation(sample, position);
+        return true;
+      }
+    }
 
-      buildTreeIntegration(helper, rhoLeft, depth);
+    if (t.stage == NUTSLeafStage::PositionEvaluated)
+    {
+      leaf.directionIn = t.direction;
+      leaf.logUniSampleIn = t.logUniSample;
+      leaf.rootHIn = t.rootH;
+      leaf.pIn = momentum;
 
-      // qRight = --
-      // pRight = --
-      qLeft = helper->qLeftOut;
-      pLeft = helper->pLeftOut;
+      _integrator->kickDrift(position, momentum, _metric, t.direction * _stepSize);
 
-      // Setting for termination criterium
-      helper->qRightOut = qRight;
-      helper->pRightOut = pRight;
+      t.stage = NUTSLeafStage::DriftEvaluated;
+      if (_hamiltonian->isEvaluated(position) == false)
+      {
+        _hamiltonian->startEvaluation(sample, position);
+        return true;
+      }
     }
-    else
-    {
-      helper->qIn = qRight;
-      helper->pIn = pRight;
-      helper->directionIn = +1;
 
-      buildTreeIntegration(helper, rhoRight, depth);
+    _integrator->kick(momentum, t.direction * _stepSize);
+    finishLeaf(leaf, position, momentum);
 
-      // qLeft = --
-      // pLeft = --
-      qRight = helper->qRightOut;
-      pRight = helper->pRightOut;
+    // After each leaf, the completed subtrees are merged bottom-up with their pending first halves (given by the set bits
+    // of the leaf index), which yields the same merge order (and random numbers) as the recursive formulation.
+    // If a subtree terminates, it is still merged with all pending first halves.
+    size_t level = 0;
+    for (; level < _currentDepth; level++)
+    {
+      if ((t.leafId >> level) & 1)
+        mergeSubtrees(*t.treeHelpers[level], *t.treeHelpers.back());
+      else if (t.treeHelpers.back()->buildCriterionOut == true)
+        break;
+    }
 
-      // Setting for termination criterium
-      helper->qLeftOut = qLeft;
-      helper->pLeftOut = pLeft;
+    if (level < _currentDepth)
+    {
+      // Keeping the completed first half of the next level until its second half is built
+      std::swap(t.treeHelpers[level], t.treeHelpers.back());
+      t.leafId++;
+      t.stage = NUTSLeafStage::Start;
+      continue;
     }
 
-    _positionCandidate = helper->qProposedOut;
-    _acceptanceProbability = helper->alphaOut;
-    numValidLeavesSubtree = helper->numValidLeavesOut;
-    buildCriterionSubtree = helper->buildCriterionOut;
-    numLeavesSubtree = helper->numLeavesOut;
+    // Either the subtree is complete or its construction terminated
+    if (finishSubtreeNUTS() == false) return false;
 
-    if (buildCriterionSubtree == true)
-      if (_uniformGenerator->getRandomNumber() < numValidLeavesSubtree / numValidLeaves && isanynan(_positionCandidate) == false)
-      {
-        _positionLeader = _positionCandidate;
-        _leaderEvaluation = -_hamiltonian->U();
-      }
+    startSubtreeNUTS();
+  }
+}
+
+bool HMC::finishSubtreeNUTS()
+{
+  auto &t = _trajectory;
+  const TreeHelper &subtree = *t.treeHelpers.back();
 
-    numValidLeaves += numValidLeavesSubtree;
+  if (_metricType == Metric::Riemannian)
+  {
+    std::vector<double> &rho = t.direction == -1 ? t.rhoLeft : t.rhoRight;
+    for (size_t d = 0; d < _variableCount; d++) rho[d] += subtree.rhoOut[d];
+  }
 
-    std::vector<double> deltaRho(_variableCount, 0.);
+  _positionCandidate = subtree.qProposedOut;
+  _acceptanceProbability = subtree.alphaOut;
+  const double numValidLeavesSubtree = subtree.numValidLeavesOut;
 
-    std::transform(std::cbegin(rhoLeft), std::cend(rhoLeft), std::cbegin(deltaRho), std::begin(deltaRho), std::plus<double>());
-    std::transform(cbegin(rhoInit), std::cend(rhoInit), std::cbegin(deltaRho), std::begin(deltaRho), std::plus<double>());
-    std::transform(std::cbegin(rhoRight), std::cend(rhoRight), std::cbegin(deltaRho), std::begin(deltaRho), std::plus<double>());
+  if (subtree.buildCriterionOut == true)
+    if (_uniformGenerator->getRandomNumber() < numValidLeavesSubtree / t.numValidLeaves && isanynan(_positionCandidate) == false)
+    {
+      _positionLeader = _positionCandidate;
+      _leaderEvaluation = -_hamiltonian->U();
+    }
 
-    buildCriterion = buildCriterionSubtree && helper->computeCriterion(*_hamiltonian, pLeft, pRight, _inverseMetric, deltaRho);
+  t.numValidLeaves += numValidLeavesSubtree;
 
-    depth++;
+  bool buildCriterion = subtree.buildCriterionOut;
+  if (buildCriterion == true)
+  {
+    if (_metricType == Metric::Riemannian)
+    {
+      for (size_t d = 0; d < _variableCount; d++) t.deltaRho[d] = t.rhoLeft[d] + _momentumLeader[d] + t.rhoRight[d];
+      buildCriterion = subtree.computeCriterion(*_hamiltonian, t.pLeft, t.pRight, _inverseMetric, t.deltaRho);
+    }
+    else
+      buildCriterion = _hamiltonian->computeStandardCriterion(t.qLeft, t.pLeft, t.qRight, t.pRight);
   }
 
-  _acceptanceProbability /= (double)numLeavesSubtree;
+  _currentDepth++;
+  if (buildCriterion == true && _currentDepth <= _maxDepth) return true;
+
+  // The trajectory is complete
+  _currentDepth--;
+  _acceptanceProbability /= (double)subtree.numLeavesOut;
   _acceptanceCountNUTS += _acceptanceProbability;
   _runningAcceptanceRate = _acceptanceRateLearningRate * _runningAcceptanceRate + (1. - _acceptanceRateLearningRate) * _acceptanceProbability;
+
+  return false;
 }
 
 void HMC::saveSample()
@@ -480,8 +658,6 @@ void HMC::updateStepSize()
 
 void HMC::updateState()
 {
-  _modelEvaluationCount = _hamiltonian->_modelEvaluationCount;
-
   // Update Acceptance Rate
   if (_useNUTS)
     _acceptanceRate = (double)_acceptanceCountNUTS / ((double)_chainLength + 1);
@@ -498,184 +674,98 @@ void HMC::updateState()
     if (err == GSL_EDOM) KORALI_LOG_ERROR("Inverse Metric negative definite (not updating Metric). Increase 'Initial Slow Adaption Interval' (is %zu).", _initialSlowAdaptionInterval);
     _euclideanWarmupSampleDatabase.clear();
   }
-
-  _chainLength++;
 }
 
-void HMC::buildTree(std::shared_ptr<TreeHelperEuclidean> helper, const size_t depth)
+void HMC::updateDiagnostics()
 {
-  helper->qLeftOut = helper->qIn;
-  helper->pLeftOut = helper->pIn;
-
-  if (depth == 0)
-  {
-    const double deltaMax = 100;
-    _integrator->step(helper->qLeftOut, helper->pLeftOut, _metric, _inverseMetric, helper->directionIn * _stepSize);
-
-    const double leafK = _hamiltonian->K(helper->pLeftOut, _metric);
-    const double leafU = _hamiltonian->U();
-    const double leafH = leafU + leafK;
-
-    helper->numValidLeavesOut = (helper->logUniSampleIn <= helper->rootHIn - leafH) ? 1. : 0.;
-
-    helper->buildCriterionOut = (helper->rootHIn - leafH + deltaMax > helper->logUniSampleIn);
+  computeConvergenceDiagnostics(_sampleDatabase, _chainCount, _potentialScaleReduction, _effectiveSampleSize);
 
-    helper->alphaOut = isanynan(helper->qLeftOut) ? 0.0 : std::min(1., std::exp(helper->rootHIn - leafH));
-    helper->numLeavesOut = 1;
-    helper->qRightOut = helper->qLeftOut;
-    helper->pRightOut = helper->pLeftOut;
-    helper->qProposedOut = helper->qLeftOut;
-  }
-  else
-  {
-    size_t numLeavesSubtree;
-    bool buildCriterionSubtree;
-    double numValidLeavesSubtree, alphaSubtree;
-
-    buildTree(helper, depth - 1);
-
-    if (helper->buildCriterionOut == true)
-    {
-      auto helperSubtree = std::make_shared<TreeHelperEuclidean>();
-      helperSubtree->logUniSampleIn = helper->logUniSampleIn;
-      helperSubtree->directionIn = helper->directionIn;
-      helperSubtree->rootHIn = helper->rootHIn;
-
-      if (helper->directionIn == -1)
-      {
-        helperSubtree->qIn = helper->qLeftOut;
-        helperSubtree->pIn = helper->pLeftOut;
-
-        buildTree(helperSubtree, depth - 1);
-
-        helper->qLeftOut = helperSubtree->qLeftOut;
-        helper->pLeftOut = helperSubtree->pLeftOut;
-        // helperSubtree->qRightOut = --
-        // helperSubtree->pRightOut = --
-      }
-      else
-      {
-        helperSubtree->qIn = helper->qRightOut;
-        helperSubtree->pIn = helper->pRightOut;
-
-        buildTree(helperSubtree, depth - 1);
-
-        // helperSubtree->qLeftOut = --
-        // helperSubtree->pLeftOut = --
-        helper->qRightOut = helperSubtree->qRightOut;
-        helper->pRightOut = helperSubtree->pRightOut;
-      }
-      numValidLeavesSubtree = helperSubtree->numValidLeavesOut;
-      buildCriterionSubtree = helperSubtree->buildCriterionOut;
-      alphaSubtree = helperSubtree->alphaOut;
-      numLeavesSubtree = helperSubtree->numLeavesOut;
-
-      // First check to avoid divising by zero
-      if (numValidLeavesSubtree != 0 && _uniformGenerator->getRandomNumber() < numValidLeavesSubtree / (helper->numValidLeavesOut + numValidLeavesSubtree))
-      {
-        helper->qProposedOut = helperSubtree->qProposedOut;
-      }
+  if (_potentialScaleReduction.empty()) return;
+  _currentMaxPotentialScaleReduction = *std::max_element(std::begin(_potentialScaleReduction), std::end(_potentialScaleReduction));
+  _currentMinEffectiveSampleSize = *std::min_element(std::begin(_effectiveSampleSize), std::end(_effectiveSampleSize));
+}
 
-      helper->numValidLeavesOut += numValidLeavesSubtree;
-      helper->alphaOut += alphaSubtree;
-      helper->numLeavesOut += numLeavesSubtree;
+void HMC::swapChainState(const size_t chainId)
+{
+  // The first chain lives in the solver state
+  if (chainId == 0) return;
+
+  auto &chain = _chainStates[chainId];
+  std::swap(_positionLeader, chain.positionLeader);
+  std::swap(_positionCandidate, chain.positionCandidate);
+  std::swap(_momentumLeader, chain.momentumLeader);
+  std::swap(_momentumCandidate, chain.momentumCandidate);
+  std::swap(_leaderEvaluation, chain.leaderEvaluation);
+  std::swap(_stepSize, chain.stepSize);
+  std::swap(_numIntegrationSteps, chain.numIntegrationSteps);
+  std::swap(_logDualStepSize, chain.logDualStepSize);
+  std::swap(_mu, chain.mu);
+  std::swap(_hBar, chain.hBar);
+  std::swap(_acceptanceRateError, chain.acceptanceRateError);
+  std::swap(_runningAcceptanceRate, chain.runningAcceptanceRate);
+  std::swap(_acceptanceProbability, chain.acceptanceProbability);
+  std::swap(_acceptanceRate, chain.acceptanceRate);
+  std::swap(_acceptanceCount, chain.acceptanceCount);
+  std::swap(_acceptanceCountNUTS, chain.acceptanceCountNUTS);
+  std::swap(_currentDepth, chain.currentDepth);
+  std::swap(_metric, chain.metric);
+  std::swap(_inverseMetric, chain.inverseMetric);
+  std::swap(_euclideanWarmupSampleDatabase, chain.euclideanWarmupSampleDatabase);
+  std::swap(_hamiltonian, chain.hamiltonian);
+  std::swap(_integrator, chain.integrator);
+  std::swap(_trajectory, chain.trajectory);
+}
 
-      helper->buildCriterionOut = buildCriterionSubtree && helper->computeCriterion(*_hamiltonian);
-    }
-  }
+void HMC::finishLeaf(TreeHelper &leaf, const std::vector<double> &position, const std::vector<double> &momentum)
+{
+  const double deltaMax = 100;
+  const double logUniSample = leaf.logUniSampleIn;
+  const double rootH = leaf.rootHIn;
+
+  const double leafK = _hamiltonian->K(momentum, _metric);
+  const double leafU = _hamiltonian->U();
+  const double leafH = leafU + leafK;
+
+  leaf.numValidLeavesOut = (logUniSample <= rootH - leafH) ? 1. : 0.;
+
+  leaf.buildCriterionOut = (rootH - leafH + deltaMax > logUniSample);
+
+  leaf.alphaOut = isanynan(position) ? 0.0 : std::min(1., std::exp(rootH - leafH));
+  leaf.numLeavesOut = 1;
+  leaf.qLeftOut = position;
+  leaf.pLeftOut = momentum;
+  leaf.qRightOut = position;
+  leaf.pRightOut = momentum;
+  leaf.qProposedOut = position;
+  leaf.rhoOut = momentum;
 }
 
-void HMC::buildTreeIntegration(std::shared_ptr<TreeHelperRiemannian> helper, std::vector<double> &rho, const size_t depth)
+void HMC::mergeSubtrees(TreeHelper &first, TreeHelper &second)
 {
-  helper->qLeftOut = helper->qIn;
-  helper->pLeftOut = helper->pIn;
+  // Keeping the proposal of the first subtree, unless the second one is chosen (first check to avoid divising by zero)
+  if (second.numValidLeavesOut == 0 || _uniformGenerator->getRandomNumber() >= second.numValidLeavesOut / (first.numValidLeavesOut + second.numValidLeavesOut))
+    std::swap(first.qProposedOut, second.qProposedOut);
 
-  if (depth == 0)
+  // The merged subtree starts where the first subtree started and ends where the second one ends
+  if (second.directionIn == -1)
   {
-    const double deltaMax = 100;
-    _integrator->step(helper->qLeftOut, helper->pLeftOut, _metric, _inverseMetric, helper->directionIn * _stepSize);
-
-    const double leafK = _hamiltonian->K(helper->pLeftOut, _metric);
-    const double leafU = _hamiltonian->U();
-    const double leafH = leafU + leafK;
-
-    helper->numValidLeavesOut = (helper->logUniSampleIn <= helper->rootHIn - leafH) ? 1. : 0.;
-
-    helper->buildCriterionOut = (helper->rootHIn - leafH + deltaMax > helper->logUniSampleIn);
-
-    helper->alphaOut = isanynan(helper->qLeftOut) ? 0.0 : std::min(1., std::exp(helper->rootHIn - leafH));
-    helper->numLeavesOut = 1;
-    helper->qRightOut = helper->qLeftOut;
-    helper->pRightOut = helper->pLeftOut;
-    helper->qProposedOut = helper->qLeftOut;
-
-    std::transform(std::cbegin(rho), std::cend(rho), std::cbegin(helper->pRightOut), std::begin(rho), std::plus<double>());
+    std::swap(first.qRightOut, second.qRightOut);
+    std::swap(first.pRightOut, second.pRightOut);
   }
   else
   {
-    size_t numLeavesSubtree;
-    bool buildCriterionSubtree;
-    double numValidLeavesSubtree, alphaSubtree;
-    auto pStart = helper->pIn;
-    std::vector<double> rhoFirstSubtree(_variableCount, 0.);
-
-    buildTreeIntegration(helper, rhoFirstSubtree, depth - 1);
-
-    if (helper->buildCriterionOut == true)
-    {
-      auto helperSubtree = std::make_shared<TreeHelperRiemannian>();
-      helperSubtree->logUniSampleIn = helper->logUniSampleIn;
-      helperSubtree->directionIn = helper->directionIn;
-      helperSubtree->rootHIn = helper->rootHIn;
-
-      std::vector<double> rhoSecondSubtree(_variableCount, 0.);
-      if (helper->directionIn == -1)
-      {
-        helperSubtree->qIn = helper->qLeftOut;
-        helperSubtree->pIn = helper->pLeftOut;
-        buildTreeIntegration(helperSubtree, rhoSecondSubtree, depth - 1);
-
-        helper->qLeftOut = helperSubtree->qLeftOut;
-        helper->pLeftOut = helperSubtree->pLeftOut;
-        // helperSubtree->qRightOut = --
-        // helperSubtree->pRightOut = --
-      }
-      else
-      {
-        helperSubtree->qIn = helper->qRightOut;
-        helperSubtree->pIn = helper->pRightOut;
-        buildTreeIntegration(helperSubtree, rhoSecondSubtree, depth - 1);
-
-        // helperSubtree->qLeftOut = --
-        // helperSubtree->pLeftOut = --
-        helper->qRightOut = helperSubtree->qRightOut;
-        helper->pRightOut = helperSubtree->pRightOut;
-      }
-
-      numValidLeavesSubtree = helperSubtree->numValidLeavesOut;
-      buildCriterionSubtree = helperSubtree->buildCriterionOut;
-      alphaSubtree = helperSubtree->alphaOut;
-      numLeavesSubtree = helperSubtree->numLeavesOut;
-
-      std::vector<double> rhoSubtree = rhoFirstSubtree;
-      std::transform(std::cbegin(rhoSubtree), std::cend(rhoSubtree), std::cbegin(rhoSecondSubtree), std::begin(rhoSubtree), std::plus<double>());
-
-      std::transform(std::cbegin(rho), std::cend(rho), std::cbegin(rhoSubtree), std::begin(rho), std::plus<double>());
+    std::swap(first.qLeftOut, second.qLeftOut);
+    std::swap(first.pLeftOut, second.pLeftOut);
+  }
+  std::swap(first.pIn, second.pIn);
 
-      // First check to avoid divising by zero
-      if (numValidLeavesSubtree != 0 && _uniformGenerator->getRandomNumber() < numValidLeavesSubtree / (helper->numValidLeavesOut + numValidLeavesSubtree))
-      {
-        helper->qProposedOut = helperSubtree->qProposedOut;
-      }
+  for (size_t d = 0; d < _variableCount; d++) second.rhoOut[d] += first.rhoOut[d];
 
-      helper->numValidLeavesOut += numValidLeavesSubtree;
-      helper->alphaOut += alphaSubtree;
-      helper->numLeavesOut += numLeavesSubtree;
+  second.numValidLeavesOut += first.numValidLeavesOut;
+  second.alphaOut += first.alphaOut;
+  second.numLeavesOut += first.numLeavesOut;
 
-      std::vector<double> pEnd = helper->directionIn == -1 ? helperSubtree->pLeftOut : helperSubtree->pRightOut;
-      helper->buildCriterionOut = buildCriterionSubtree && helper->computeCriterion(*_hamiltonian, pStart, pEnd, _inverseMetric, rhoSubtree);
-    }
-  }
+  second.buildCriterionOut = second.buildCriterionOut && second.computeSubtreeCriterion(*_hamiltonian, _inverseMetric);
 }
 
 void HMC::printGenerationBefore()
@@ -688,7 +778,24 @@ void HMC::printGenerationAfter()
   _k->_logger->logInfo("Minimal", "Database Entries %ld\n", _sampleDatabase.size());
   _k->_logger->logInfo("Normal", "Acceptance Rate Proposals: %.2f%%\n", 100. * _acceptanceRate);
   _k->_logger->logInfo("Normal", "Running Acceptance Rate: %.2f%%\n", 100. * _runningAcceptanceRate);
-  _k->_logger->logInfo("Detailed", "Num Model Evaluations: %zu\n", _hamiltonian->_modelEvaluationCount);
+  _k->_logger->logInfo("Detailed", "Num Model Evaluations: %zu\n", _modelEvaluationCount);
+
+  if (_chainCount > 1)
+  {
+    _k->_logger->logInfo("Normal", "Chain Acceptance Rates / Step Sizes:\n");
+    for (size_t c = 0; c < _chainCount; c++)
+    {
+      swapChainState(c);
+      _k->_logger->logData("Normal", "         Chain %zu: %.2f%% / %.3e\n", c, 100. * _acceptanceRate, _stepSize);
+      swapChainState(c);
+    }
+  }
+
+  if (_potentialScaleReduction.empty() == false)
+  {
+    _k->_logger->logInfo("Normal", "Convergence Diagnostics:\n");
+    for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Normal", "         %s: R-hat = %.4f, ESS = %.1f\n", _k->_variables[d]->_name.c_str(), _potentialScaleReduction[d], _effectiveSampleSize[d]);
+  }
 
   _k->_logger->logInfo("Detailed", "Current Leader:\n");
   for (size_t d = 0; d < _variableCount; ++d) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _positionLeader[d]);
@@ -758,6 +865,12 @@ void HMC::finalize()
   _k->_logger->logInfo("Normal", "Number of Generated Samples: %zu\n", _proposedSampleCount);
   _k->_logger->logInfo("Normal", "Acceptance Rate: %.2f%%\n", 100 * _acceptanceRate);
   _k->_logger->logInfo("Normal", "Num Model Evaluations: %zu\n", _modelEvaluationCount);
+  if (_chainCount > 1 || _targetEffectiveSampleSize > 0.0)
+  {
+    updateDiagnostics();
+    _k->_logger->logInfo("Minimal", "Max Potential Scale Reduction: %.4f\n", _currentMaxPotentialScaleReduction);
+    _k->_logger->logInfo("Minimal", "Min Effective Sample Size: %.1f\n", _currentMinEffectiveSampleSize);
+  }
   (*_k)["Results"]["Sample Database"] = _sampleDatabase;
 }
 
@@ -984,6 +1097,38 @@ void HMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Inverse Metric");
  }
 
+ if (isDefined(js, "Potential Scale Reduction"))
+ {
+ try { _potentialScaleReduction = js["Potential Scale Reduction"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Potential Scale Reduction");
+ }
+
+ if (isDefined(js, "Effective Sample Size"))
+ {
+ try { _effectiveSampleSize = js["Effective Sample Size"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Effective Sample Size");
+ }
+
+ if (isDefined(js, "Current Max Potential Scale Reduction"))
+ {
+ try { _currentMaxPotentialScaleReduction = js["Current Max Potential Scale Reduction"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Current Max Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Current Max Potential Scale Reduction");
+ }
+
+ if (isDefined(js, "Current Min Effective Sample Size"))
+ {
+ try { _currentMinEffectiveSampleSize = js["Current Min Effective Sample Size"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Current Min Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Current Min Effective Sample Size");
+ }
+
  if (isDefined(js, "Burn In"))
  {
  try { _burnIn = js["Burn In"].get<size_t>();
@@ -1173,6 +1318,24 @@ void HMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Initial Slow Adaption Interval'] required by HMC.\n"); 
 
+ if (isDefined(js, "Chain Count"))
+ {
+ try { _chainCount = js["Chain Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Chain Count']\n%s", e.what()); } 
+   eraseValue(js, "Chain Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Count'] required by HMC.\n"); 
+
+ if (isDefined(js, "Diagnostics Frequency"))
+ {
+ try { _diagnosticsFrequency = js["Diagnostics Frequency"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Diagnostics Frequency']\n%s", e.what()); } 
+   eraseValue(js, "Diagnostics Frequency");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Diagnostics Frequency'] required by HMC.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Samples"))
  {
  try { _maxSamples = js["Termination Criteria"]["Max Samples"].get<size_t>();
@@ -1182,6 +1345,24 @@ void HMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Max Samples'] required by HMC.\n"); 
 
+ if (isDefined(js, "Termination Criteria", "Target Potential Scale Reduction"))
+ {
+ try { _targetPotentialScaleReduction = js["Termination Criteria"]["Target Potential Scale Reduction"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Termination Criteria']['Target Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Target Potential Scale Reduction");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Target Potential Scale Reduction'] required by HMC.\n"); 
+
+ if (isDefined(js, "Termination Criteria", "Target Effective Sample Size"))
+ {
+ try { _targetEffectiveSampleSize = js["Termination Criteria"]["Target Effective Sample Size"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Termination Criteria']['Target Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Target Effective Sample Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Target Effective Sample Size'] required by HMC.\n"); 
+
  if (isDefined(_k->_js.getJson(), "Variables"))
  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
  if (isDefined(_k->_js["Variables"][i], "Initial Mean"))
@@ -1234,7 +1415,11 @@ void HMC::getConfiguration(knlohmann::json& js)
    js["Initial Fast Adaption Interval"] = _initialFastAdaptionInterval;
    js["Final Fast Adaption Interval"] = _finalFastAdaptionInterval;
    js["Initial Slow Adaption Interval"] = _initialSlowAdaptionInterval;
+   js["Chain Count"] = _chainCount;
+   js["Diagnostics Frequency"] = _diagnosticsFrequency;
    js["Termination Criteria"]["Max Samples"] = _maxSamples;
+   js["Termination Criteria"]["Target Potential Scale Reduction"] = _targetPotentialScaleReduction;
+   js["Termination Criteria"]["Target Effective Sample Size"] = _targetEffectiveSampleSize;
    js["Metric Type"] = _metricType;
  if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
  if(_multivariateGenerator != NULL) _multivariateGenerator->getConfiguration(js["Multivariate Generator"]);
@@ -1262,6 +1447,10 @@ void HMC::getConfiguration(knlohmann::json& js)
    js["Acceptance Rate Error"] = _acceptanceRateError;
    js["Metric"] = _metric;
    js["Inverse Metric"] = _inverseMetric;
+   js["Potential Scale Reduction"] = _potentialScaleReduction;
+   js["Effective Sample Size"] = _effectiveSampleSize;
+   js["Current Max Potential Scale Reduction"] = _currentMaxPotentialScaleReduction;
+   js["Current Min Effective Sample Size"] = _currentMinEffectiveSampleSize;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
    _k->_js["Variables"][i]["Initial Mean"] = _k->_variables[i]->_initialMean;
    _k->_js["Variables"][i]["Initial Standard Deviation"] = _k->_variables[i]->_initialStandardDeviation;
@@ -1272,7 +1461,7 @@ void HMC::getConfiguration(knlohmann::json& js)
 void HMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Burn In\": 300, \"Use Diagonal Metric\": true, \"Step Size\": 0.1, \"Num Integration Steps\": 4, \"Max Integration Steps\": 100, \"Use Adaptive Step Size\": true, \"Target Acceptance Rate\": 0.65, \"Acceptance Rate Learning Rate\": 0.85, \"Target Integration Time\": 1.0, \"Use NUTS\": true, \"Acceptance Count NUTS\": 0.0, \"Adaptive Step Size Speed Constant\": 0.05, \"Adaptive Step Size Stabilization Constant\": 10.0, \"Adaptive Step Size Schedule Constant\": 0.75, \"Max Depth\": 5, \"Version\": \"Euclidean\", \"Inverse Regularization Parameter\": 1.0, \"Max Fixed Point Iterations\": 8, \"Step Size Jitter\": 0.0, \"Initial Fast Adaption Interval\": 75, \"Final Fast Adaption Interval\": 50, \"Initial Slow Adaption Interval\": 25, \"Termination Criteria\": {\"Max Samples\": 500}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
+ std::string defaultString = "{\"Burn In\": 300, \"Use Diagonal Metric\": true, \"Step Size\": 0.1, \"Num Integration Steps\": 4, \"Max Integration Steps\": 100, \"Use Adaptive Step Size\": true, \"Target Acceptance Rate\": 0.65, \"Acceptance Rate Learning Rate\": 0.85, \"Target Integration Time\": 1.0, \"Use NUTS\": true, \"Acceptance Count NUTS\": 0.0, \"Adaptive Step Size Speed Constant\": 0.05, \"Adaptive Step Size Stabilization Constant\": 10.0, \"Adaptive Step Size Schedule Constant\": 0.75, \"Max Depth\": 5, \"Version\": \"Euclidean\", \"Inverse Regularization Parameter\": 1.0, \"Max Fixed Point Iterations\": 8, \"Step Size Jitter\": 0.0, \"Initial Fast Adaption Interval\": 75, \"Final Fast Adaption Interval\": 50, \"Initial Slow Adaption Interval\": 25, \"Chain Count\": 1, \"Diagnostics Frequency\": 100, \"Termination Criteria\": {\"Max Samples\": 500, \"Target Potential Scale Reduction\": 0.0, \"Target Effective Sample Size\": 0.0}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
@@ -1294,6 +1483,18 @@ bool HMC::checkTermination()
   hasFinished = true;
  }
 
+ if ((_chainCount > 1) && (_targetPotentialScaleReduction > 0.0) && (_currentMaxPotentialScaleReduction <= _targetPotentialScaleReduction))
+ {
+  _terminationCriteria.push_back("HMC['Target Potential Scale Reduction'] = " + std::to_string(_targetPotentialScaleReduction) + ".");
+  hasFinished = true;
+ }
+
+ if ((_targetEffectiveSampleSize > 0.0) && (_currentMinEffectiveSampleSize >= _targetEffectiveSampleSize))
+ {
+  _terminationCriteria.push_back("HMC['Target Effective Sample Size'] = " + std::to_string(_targetEffectiveSampleSize) + ".");
+  hasFinished = true;
+ }
+
  hasFinished = hasFinished || Sampler::checkTermination();
  return hasFinished;
 }
@@ -64,13 +64,261 @@ enum Metric
   Riemannian_Const = 3,
 };
 
+/**
+ * @brief Stage of the leaf of a NUTS trajectory under construction.
+ */
+enum /**
+* @brief Class declaration for module: HMC.
+*/
+class NUTSLeafStage
+{
+  /**
+   * @brief The leaf requires the evaluation at the outermost position of the trajectory.
+   */
+  Start = 0,
+
+  /**
+   * @brief The outermost position is evaluated, the first half of the leapfrog step can be taken.
+   */
+  PositionEvaluated = 1,
+
+  /**
+   * @brief The drifted position is evaluated, the leapfrog step and the leaf can be completed.
+   */
+  DriftEvaluated = 2,
+};
+
+/**
+ * @brief State of a NUTS trajectory under construction. It allows to interrupt the trajectory at every evaluation, such that the trajectories of all chains are integrated concurrently.
+ */
+struct NUTSTrajectory
+{
+  /**
+   * @brief Leftmost position of the trajectory.
+   */
+  std::vector<double> qLeft;
+
+  /**
+   * @brief Leftmost momentum of the trajectory.
+   */
+  std::vector<double> pLeft;
+
+  /**
+   * @brief Rightmost position of the trajectory.
+   */
+  std::vector<double> qRight;
+
+  /**
+   * @brief Rightmost momentum of the trajectory.
+   */
+  std::vector<double> pRight;
+
+  /**
+   * @brief Sum of the momenta left of the starting position (only relevant for the Riemannian metric).
+   */
+  std::vector<double> rhoLeft;
+
+  /**
+   * @brief Sum of the momenta right of the starting position (only relevant for the Riemannian metric).
+   */
+  std::vector<double> rhoRight;
+
+  /**
+   * @brief Sum of all momenta of the trajectory (only relevant for the Riemannian metric).
+   */
+  std::vector<double> deltaRho;
+
+  /**
+   * @brief Log of uniform sample needed for the slice sampling of the leaves.
+   */
+  double logUniSample = 0.;
+
+  /**
+   * @brief Energy of the root of the binary tree (i.e. starting position).
+   */
+  double rootH = 0.;
+
+  /**
+   * @brief Number of valid leaves of the trajectory.
+   */
+  double numValidLeaves = 0.;
+
+  /**
+   * @brief Direction of the subtree under construction (-1 or +1).
+   */
+  int direction = 1;
+
+  /**
+   * @brief Index of the leaf under construction within its subtree.
+   */
+  size_t leafId = 0;
+
+  /**
+   * @brief Stage of the leaf under construction.
+   */
+  NUTSLeafStage stage = NUTSLeafStage::Start;
+
+  /**
+   * @brief Preallocated tree helpers. Entry d holds the pending first half of depth d of the subtree under construction, the last entry holds the subtree under construction itself.
+   */
+  std::vector<std::unique_ptr<TreeHelper>> treeHelpers;
+};
+
+/**
+ * @brief State of a Markov chain that is adapted independently of the other chains.
+ */
+struct HMCChainState
+{
+  /**
+   * @brief Variables of the newest position/sample of the chain.
+   */
+  std::vector<double> positionLeader;
+
+  /**
+   * @brief Candidate position of the current trajectory.
+   */
+  std::vector<double> positionCandidate;
+
+  /**
+   * @brief Momentum of the newest position/sample of the chain.
+   */
+  std::vector<double> momentumLeader;
+
+  /**
+   * @brief Candidate momentum of the current trajectory.
+   */
+  std::vector<double> momentumCandidate;
+
+  /**
+   * @brief Evaluation of the leader.
+   */
+  double leaderEvaluation = 0.;
+
+  /**
+   * @brief Step size of the leapfrog integrator.
+   */
+  double stepSize = 0.;
+
+  /**
+   * @brief Number of leapfrog steps per trajectory (only relevant if NUTS is disabled).
+   */
+  size_t numIntegrationSteps = 0;
+
+  /**
+   * @brief Logarithm of the dual averaged step size.
+   */
+  double logDualStepSize = 0.;
+
+  /**
+   * @brief Shrinkage target of the dual averaging.
+   */
+  double mu = 0.;
+
+  /**
+   * @brief Running acceptance rate error of the dual averaging.
+   */
+  double hBar = 0.;
+
+  /**
+   * @brief Difference between target and running acceptance rate.
+   */
+  double acceptanceRateError = 0.;
+
+  /**
+   * @brief Running estimate of the acceptance rate.
+   */
+  double runningAcceptanceRate = 0.;
+
+  /**
+   * @brief Acceptance probability of the last trajectory.
+   */
+  double acceptanceProbability = 0.;
+
+  /**
+   * @brief Ratio of accepted to proposed samples.
+   */
+  double acceptanceRate = 0.;
+
+  /**
+   * @brief Number of accepted samples.
+   */
+  size_t acceptanceCount = 0;
+
+  /**
+   * @brief Sum of the acceptance probabilities of all NUTS trajectories.
+   */
+  double acceptanceCountNUTS = 0.;
+
+  /**
+   * @brief Depth of the last NUTS tree.
+   */
+  size_t currentDepth = 0;
+
+  /**
+   * @brief Metric of the chain.
+   */
+  std::vector<double> metric;
+
+  /**
+   * @brief Inverse metric of the chain.
+   */
+  std::vector<double> inverseMetric;
+
+  /**
+   * @brief Samples kept during the slow adaption interval for the metric estimation.
+   */
+  std::vector<std::vector<double>> euclideanWarmupSampleDatabase;
+
+  /**
+   * @brief Hamiltonian of the chain, holding the evaluation and gradient at its current position.
+   */
+  std::shared_ptr<Hamiltonian> hamiltonian;
+
+  /**
+   * @brief Leapfrog integrator of the chain.
+   */
+  std::unique_ptr<LeapfrogExplicit> integrator;
+
+  /**
+   * @brief NUTS trajectory of the chain.
+   */
+  NUTSTrajectory trajectory;
+};
+
 /**
 * @brief Class declaration for module: HMC.
 */
 class HMC : public Sampler
 {
   std::shared_ptr<Hamiltonian> _hamiltonian;
-  std::unique_ptr<Leapfrog> _integrator;
+  std::unique_ptr<LeapfrogExplicit> _integrator;
+
+  /**
+   * @brief State of each chain. The state of the first chain is kept in the solver itself, its entry is unused.
+   */
+  std::vector<HMCChainState> _chainStates;
+
+  /**
+   * @brief NUTS trajectory of the active chain.
+   */
+  NUTSTrajectory _trajectory;
+
+  /**
+   * @brief Exchanges the solver state with the state of a chain, making it the active chain. Calling it again restores the first chain.
+   * @param chainId Index of the chain
+   */
+  void swapChainState(const size_t chainId);
+
+  /**
+   * @brief Initializes position, metric, hamiltonian, integrator and step size of the active chain.
+   */
+  void initializeChain();
+
+  /**
+   * @brief Samples the momentum of the active chain and prepares its trajectory.
+   * @return Log of uniform sample needed for Metropolis accepance / rejection step.
+   */
+  double initializeTrajectory();
 
   /**
    * @brief Updates internal state such as mean, Metric and InverseMetric.
@@ -78,27 +326,26 @@ class HMC : public Sampler
   void updateState();
 
   /**
-   * @brief Process sample after evaluation.
+   * @brief Updates the convergence diagnostics (Potential Scale Reduction and Effective Sample Size) from the sample database.
    */
-  void finishSample(size_t sampleId);
+  void updateDiagnostics();
 
   /**
-   * @brief Runs generation of HMC sampler.
-   * @param logUniSample Log of uniform sample needed for Metropolis accepance / rejection step.
+   * @brief Process sample after evaluation.
    */
-  void runGenerationHMC(const double logUniSample);
+  void finishSample(size_t sampleId);
 
   /**
-   * @brief Runs NUTS algorithm with buildTree.
-   * @param logUniSample Log of uniform sample needed for Metropolis accepance / rejection step.
+   * @brief Runs generation of HMC sampler, integrating the trajectories of all chains in lockstep.
+   * @param logUniSamples Log of uniform sample needed for Metropolis accepance / rejection step of each chain.
    */
-  void runGenerationNUTS(const double logUniSample);
+  void runGenerationHMC(const std::vector<double> &logUniSamples);
 
   /**
-   * @brief Runs NUTS algorithm with buildTree.
-   * @param logUniSample Log of uniform sample needed for Metropolis accepance / rejection step.
+   * @brief Runs generation of NUTS sampler, building the trajectories of all chains concurrently.
+   * @param logUniSamples Log of uniform sample needed for the slice sampling of each chain.
    */
-  void runGenerationNUTSRiemannian(const double logUniSample);
+  void runGenerationNUTS(const std::vector<double> &logUniSamples);
 
   /**
    * @brief Saves sample.
@@ -111,19 +358,45 @@ class HMC : public Sampler
   void updateStepSize();
 
   /**
-   * @brief Recursive binary tree building algorithm. Applied if configuration 'Use NUTS' is set to True.
-   * @param helper Helper struct for large argument list.
-   * @param depth Current depth of binary tree.
+   * @brief Starts the NUTS trajectory of the active chain at its leader.
+   * @param logUniSample Log of uniform sample needed for the slice sampling.
+   */
+  void startTrajectoryNUTS(const double logUniSample);
+
+  /**
+   * @brief Starts a new subtree of the NUTS trajectory of the active chain in a random direction.
+   */
+  void startSubtreeNUTS();
+
+  /**
+   * @brief Iterative binary tree building algorithm. Applied if configuration 'Use NUTS' is set to True.
+   * Advances the trajectory of the active chain until it requires an evaluation or until it is complete.
+   * The leaves are integrated one after the other and merged bottom-up, the subtree is stored in the last tree helper.
+   * @param sample Sample used for the evaluation, if any.
+   * @return True if an evaluation was started, false if the trajectory is complete.
    */
-  void buildTree(std::shared_ptr<TreeHelperEuclidean> helper, const size_t depth);
+  bool advanceTrajectoryNUTS(Sample &sample);
 
   /**
-   * @brief Recursive binary tree building algorithm. Applied if configuration 'Use NUTS' is set to True.
-   * @param helper Helper struct for large argument list.
-   * @param rho Sum of momenta encountered along path.
-   * @param depth Current depth of binary tree.
+   * @brief Completes a subtree of the NUTS trajectory of the active chain, sampling its proposal and checking the U-turn criterion.
+   * @return True if the trajectory continues with a further subtree, false if it is complete.
    */
-  void buildTreeIntegration(std::shared_ptr<TreeHelperRiemannian> helper, std::vector<double> &rho, const size_t depth);
+  bool finishSubtreeNUTS();
+
+  /**
+   * @brief Stores the state at the end of the leapfrog step as a leaf of the binary tree.
+   * @param leaf Tree helper to store the leaf in.
+   * @param position Position of the leaf.
+   * @param momentum Momentum of the leaf.
+   */
+  void finishLeaf(TreeHelper &leaf, const std::vector<double> &position, const std::vector<double> &momentum);
+
+  /**
+   * @brief Merges two adjacent subtrees of equal depth. The storage of the subtrees is exchanged, not copied.
+   * @param first Subtree built first, its content is undefined on exit.
+   * @param second Subtree built second, holds the merged subtree on exit.
+   */
+  void mergeSubtrees(TreeHelper &first, TreeHelper &second);
 
   public: 
   /**
@@ -211,6 +484,14 @@ class HMC : public Sampler
   */
    size_t _initialSlowAdaptionInterval;
   /**
+  * @brief Number of independent Markov chains. Each chain adapts its own step size and metric. The leapfrog steps of all chains are evaluated concurrently (the NUTS trajectories of the chains are built one after another). The samples of all chains are stored in the Sample Database, interleaved by chain.
+  */
+   size_t _chainCount;
+  /**
+  * @brief Number of generations between updates of the convergence diagnostics (Potential Scale Reduction and Effective Sample Size).
+  */
+   size_t _diagnosticsFrequency;
+  /**
   * @brief [Internal Use] Metric Type can be set to 'Static', 'Euclidean' or 'Riemannian'.
   */
    Metric _metricType;
@@ -227,7 +508,7 @@ class HMC : public Sampler
   */
    korali::distribution::univariate::Uniform* _uniformGenerator;
   /**
-  * @brief [Internal Use] Ratio proposed to accepted samples (including Burn In period).
+  * @brief [Internal Use] Ratio proposed to accepted samples (including Burn In period). Refers to the first chain if Chain Count > 1.
   */
    double _acceptanceRate;
   /**
@@ -259,7 +540,7 @@ class HMC : public Sampler
   */
    size_t _chainLength;
   /**
-  * @brief [Internal Use] Evaluation of leader.
+  * @brief [Internal Use] Evaluation of leader. Refers to the first chain if Chain Count > 1.
   */
    double _leaderEvaluation;
   /**
@@ -267,7 +548,7 @@ class HMC : public Sampler
   */
    double _candidateEvaluation;
   /**
-  * @brief [Internal Use] Variables of the newest position/sample in the Markov chain.
+  * @brief [Internal Use] Variables of the newest position/sample in the Markov chain. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _positionLeader;
   /**
@@ -311,17 +592,41 @@ class HMC : public Sampler
   */
    double _acceptanceRateError;
   /**
-  * @brief [Internal Use] Metric for proposal distribution.
+  * @brief [Internal Use] Metric for proposal distribution. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _metric;
   /**
-  * @brief [Internal Use] Inverse Metric for proposal distribution.
+  * @brief [Internal Use] Inverse Metric for proposal distribution. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _inverseMetric;
   /**
+  * @brief [Internal Use] Gelman-Rubin Potential Scale Reduction (R-hat) of each variable across all chains.
+  */
+   std::vector<double> _potentialScaleReduction;
+  /**
+  * @brief [Internal Use] Effective Sample Size of each variable, pooled over all chains.
+  */
+   std::vector<double> _effectiveSampleSize;
+  /**
+  * @brief [Internal Use] Largest Potential Scale Reduction among all variables.
+  */
+   double _currentMaxPotentialScaleReduction;
+  /**
+  * @brief [Internal Use] Smallest Effective Sample Size among all variables.
+  */
+   double _currentMinEffectiveSampleSize;
+  /**
   * @brief [Termination Criteria] Number of Samples to Generate.
   */
    size_t _maxSamples;
+  /**
+  * @brief [Termination Criteria] Terminates once the Potential Scale Reduction (R-hat) across chains falls below this value for all variables (only relevant if Chain Count > 1, disabled if 0.0).
+  */
+   double _targetPotentialScaleReduction;
+  /**
+  * @brief [Termination Criteria] Terminates once the Effective Sample Size of all variables, pooled over all chains, exceeds this value (disabled if 0.0).
+  */
+   double _targetEffectiveSampleSize;
   
  
   /**
@@ -11,6 +11,8 @@
 #include "modules/problem/sampling/sampling.hpp"
 #include "sample/sample.hpp"
 
+#include <gsl/gsl_blas.h>
+
 namespace korali
 {
 namespace solver
@@ -34,7 +36,7 @@ class Hamiltonian
   * @param stateSpaceDim Dimension of State Space.
   * @param k Pointer to Korali object.
   */
-  Hamiltonian(const size_t stateSpaceDim, korali::Experiment *k) : _modelEvaluationCount(0), _stateSpaceDim{stateSpaceDim}
+  Hamiltonian(const size_t stateSpaceDim, korali::Experiment *k) : _modelEvaluationCount(0), _reuseEvaluations(true), _stateSpaceDim{stateSpaceDim}, _inverseMetricProduct(stateSpaceDim)
   {
     _k = k;
     samplingProblemPtr = dynamic_cast<korali::problem::Sampling *>(k->_problem);
@@ -142,22 +144,56 @@ class Hamiltonian
   virtual double innerProduct(const std::vector<double> &leftMomentum, const std::vector<double> &rightMomentum, const std::vector<double> &inverseMetric) const = 0;
 
   /**
-  * @brief Updates current position of hamiltonian.
+  * @brief Updates current position of hamiltonian. The evaluation is skipped if the hamiltonian is already evaluated at this position.
   * @param position Current position.
   * @param metric Current metric.
   * @param inverseMetric Inverse of current metric.
   */
-  virtual void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric)
+  void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric)
   {
+    if (isEvaluated(position)) return;
+
     auto sample = korali::Sample();
+    startEvaluation(sample, position);
+    KORALI_WAIT(sample);
+    finishEvaluation(sample, metric, inverseMetric);
+  }
+
+  /**
+  * @brief Starts the (non-blocking) evaluation of the objective at a given position.
+  * @param sample Sample used for the evaluation.
+  * @param position Position to evaluate.
+  */
+  void startEvaluation(korali::Sample &sample, const std::vector<double> &position)
+  {
     sample["Sample Id"] = _modelEvaluationCount;
     sample["Module"] = "Problem";
     sample["Operation"] = "Evaluate";
     sample["Parameters"] = position;
 
     KORALI_START(sample);
-    KORALI_WAIT(sample);
     _modelEvaluationCount++;
+    _evaluatedPosition = position;
+  }
+
+  /**
+  * @brief Checks whether the current state of the hamiltonian stems from an evaluation at the given position and can be reused.
+  * @param position Position to check.
+  * @return True if the evaluation at the position can be skipped.
+  */
+  bool isEvaluated(const std::vector<double> &position) const
+  {
+    return _reuseEvaluations && _evaluatedPosition == position;
+  }
+
+  /**
+  * @brief Updates the hamiltonian with a finished evaluation of the objective.
+  * @param sample Evaluated sample.
+  * @param metric Current metric.
+  * @param inverseMetric Inverse of current metric.
+  */
+  virtual void finishEvaluation(korali::Sample &sample, std::vector<double> &metric, std::vector<double> &inverseMetric)
+  {
     _currentEvaluation = KORALI_GET(double, sample, "logP(x)");
 
     if (samplingProblemPtr != nullptr)
@@ -185,15 +221,35 @@ class Hamiltonian
   */
   bool computeStandardCriterion(const std::vector<double> &positionLeft, const std::vector<double> &momentumLeft, const std::vector<double> &positionRight, const std::vector<double> &momentumRight) const
   {
-    std::vector<double> tmpVector(momentumLeft.size(), 0.0);
-
-    std::transform(std::begin(positionRight), std::cend(positionRight), std::cbegin(positionLeft), std::begin(tmpVector), std::minus<double>());
-    double dotProductLeft = std::inner_product(std::cbegin(tmpVector), std::cend(tmpVector), std::cbegin(momentumLeft), 0.0);
-    double dotProductRight = std::inner_product(std::cbegin(tmpVector), std::cend(tmpVector), std::cbegin(momentumRight), 0.0);
+    const size_t dim = momentumLeft.size();
+    double dotProductLeft = 0.0;
+    double dotProductRight = 0.0;
+
+#pragma omp simd reduction(+ : dotProductLeft, dotProductRight)
+    for (size_t i = 0; i < dim; ++i)
+    {
+      const double delta = positionRight[i] - positionLeft[i];
+      dotProductLeft += delta * momentumLeft[i];
+      dotProductRight += delta * momentumRight[i];
+    }
 
     return (dotProductLeft >= 0) && (dotProductRight >= 0);
   }
 
+  /**
+  * @brief Multiplies a vector with a dense (row-major) inverse metric.
+  * @param inverseMetric Inverse of current metric.
+  * @param vector Vector to multiply.
+  * @param result Storage for the product, must be of size of the state space.
+  */
+  void multiplyInverseMetric(const std::vector<double> &inverseMetric, const std::vector<double> &vector, std::vector<double> &result) const
+  {
+    gsl_matrix_const_view inverseMetricView = gsl_matrix_const_view_array(inverseMetric.data(), _stateSpaceDim, _stateSpaceDim);
+    gsl_vector_const_view vectorView = gsl_vector_const_view_array(vector.data(), _stateSpaceDim);
+    gsl_vector_view resultView = gsl_vector_view_array(result.data(), _stateSpaceDim);
+    gsl_blas_dgemv(CblasNoTrans, 1.0, &inverseMetricView.matrix, &vectorView.vector, 0.0, &resultView.vector);
+  }
+
   /**
   * @brief Updates Inverse Metric by approximating the covariance matrix with the Fisher information.
   * @param samples Vector of samples. 
@@ -247,10 +303,26 @@ class Hamiltonian
   */
   std::vector<double> _currentGradient;
 
+  /**
+  * @brief Position of the latest evaluation of the objective.
+  */
+  std::vector<double> _evaluatedPosition;
+
+  /**
+  * @brief Whether evaluations at an unchanged position are reused (false if the evaluation also updates a position dependent metric).
+  */
+  bool _reuseEvaluations;
+
   /**
   * @brief State Space Dimension needed for Leapfrog integrator.
   */
   size_t _stateSpaceDim;
+
+  protected:
+  /**
+  * @brief Preallocated storage for the product of the inverse metric with a momentum.
+  */
+  mutable std::vector<double> _inverseMetricProduct;
 };
 
 } // namespace sampler
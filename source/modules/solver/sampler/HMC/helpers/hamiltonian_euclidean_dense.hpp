@@ -4,6 +4,7 @@
 #include "hamiltonian_euclidean_base.hpp"
 #include "modules/distribution/multivariate/normal/normal.hpp"
 
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_multimin.h>
@@ -69,16 +70,7 @@ class HamiltonianEuclideanDense : public HamiltonianEuclidean
   */
   double K(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
-    double energy = 0.0;
-    for (size_t i = 0; i < _stateSpaceDim; ++i)
-    {
-      for (size_t j = 0; j < _stateSpaceDim; ++j)
-      {
-        energy += momentum[i] * inverseMetric[i * _stateSpaceDim + j] * momentum[j];
-      }
-    }
-
-    return 0.5 * energy;
+    return 0.5 * innerProduct(momentum, momentum, inverseMetric);
   }
 
   /**
@@ -90,17 +82,7 @@ class HamiltonianEuclideanDense : public HamiltonianEuclidean
   std::vector<double> dK(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
     std::vector<double> gradient(_stateSpaceDim, 0.0);
-    double gradi = 0.0;
-
-    for (size_t i = 0; i < _stateSpaceDim; ++i)
-    {
-      gradi = 0.0;
-      for (size_t j = 0; j < _stateSpaceDim; ++j)
-      {
-        gradi += inverseMetric[i * _stateSpaceDim + j] * momentum[j];
-      }
-      gradient[i] = gradi;
-    }
+    multiplyInverseMetric(inverseMetric, momentum, gradient);
 
     return gradient;
   }
@@ -126,15 +108,12 @@ class HamiltonianEuclideanDense : public HamiltonianEuclidean
   */
   double innerProduct(const std::vector<double> &leftMomentum, const std::vector<double> &rightMomentum, const std::vector<double> &inverseMetric) const override
   {
-    double result = 0.0;
+    multiplyInverseMetric(inverseMetric, rightMomentum, _inverseMetricProduct);
 
-    for (size_t i = 0; i < _stateSpaceDim; ++i)
-    {
-      for (size_t j = 0; j < _stateSpaceDim; ++j)
-      {
-        result += leftMomentum[i] * inverseMetric[i * _stateSpaceDim + j] * rightMomentum[j];
-      }
-    }
+    gsl_vector_const_view leftView = gsl_vector_const_view_array(leftMomentum.data(), _stateSpaceDim);
+    gsl_vector_const_view productView = gsl_vector_const_view_array(_inverseMetricProduct.data(), _stateSpaceDim);
+    double result = 0.0;
+    gsl_blas_ddot(&leftView.vector, &productView.vector, &result);
 
     return result;
   }
@@ -62,6 +62,7 @@ class HamiltonianEuclideanDiag : public HamiltonianEuclidean
   double K(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
     double energy = 0.0;
+#pragma omp simd reduction(+ : energy)
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       energy += momentum[i] * inverseMetric[i] * momentum[i];
@@ -79,6 +80,7 @@ class HamiltonianEuclideanDiag : public HamiltonianEuclidean
   std::vector<double> dK(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
     std::vector<double> gradient(_stateSpaceDim, 0.0);
+#pragma omp simd
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       gradient[i] = inverseMetric[i] * momentum[i];
@@ -114,6 +116,7 @@ class HamiltonianEuclideanDiag : public HamiltonianEuclidean
   {
     double result = 0.0;
 
+#pragma omp simd reduction(+ : result)
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       result += leftMomentum[i] * inverseMetric[i] * rightMomentum[i];
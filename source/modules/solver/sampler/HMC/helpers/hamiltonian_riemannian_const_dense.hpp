@@ -94,17 +94,7 @@ class HamiltonianRiemannianConstDense : public HamiltonianRiemannian
   std::vector<double> dK(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
     std::vector<double> gradient(_stateSpaceDim, 0.0);
-    double gradi = 0.0;
-
-    for (size_t i = 0; i < _stateSpaceDim; ++i)
-    {
-      gradi = 0.0;
-      for (size_t j = 0; j < _stateSpaceDim; ++j)
-      {
-        gradi += inverseMetric[i * _stateSpaceDim + j] * momentum[j];
-      }
-      gradient[i] = gradi;
-    }
+    multiplyInverseMetric(inverseMetric, momentum, gradient);
 
     return gradient;
   }
@@ -174,22 +164,13 @@ class HamiltonianRiemannianConstDense : public HamiltonianRiemannian
   }
 
   /**
-  * @brief Updates current position of hamiltonian.
-  * @param position Current position.
+  * @brief Updates the hamiltonian with a finished evaluation of the objective, including its hessian.
+  * @param sample Evaluated sample.
   * @param metric Current metric.
   * @param inverseMetric Inverse of current metric.
   */
-  void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric) override
+  void finishEvaluation(korali::Sample &sample, std::vector<double> &metric, std::vector<double> &inverseMetric) override
   {
-    auto sample = korali::Sample();
-    sample["Sample Id"] = _modelEvaluationCount;
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate";
-    sample["Parameters"] = position;
-
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
-    _modelEvaluationCount++;
     _currentEvaluation = KORALI_GET(double, sample, "logP(x)");
 
     if (samplingProblemPtr != nullptr)
@@ -228,15 +209,12 @@ class HamiltonianRiemannianConstDense : public HamiltonianRiemannian
   */
   double innerProduct(const std::vector<double> &momentumLeft, const std::vector<double> &momentumRight, const std::vector<double> &inverseMetric) const override
   {
-    double result = 0.0;
+    multiplyInverseMetric(inverseMetric, momentumRight, _inverseMetricProduct);
 
-    for (size_t i = 0; i < _stateSpaceDim; ++i)
-    {
-      for (size_t j = 0; j < _stateSpaceDim; ++j)
-      {
-        result += momentumLeft[i] * inverseMetric[i * _stateSpaceDim + j] * momentumRight[j];
-      }
-    }
+    gsl_vector_const_view leftView = gsl_vector_const_view_array(momentumLeft.data(), _stateSpaceDim);
+    gsl_vector_const_view productView = gsl_vector_const_view_array(_inverseMetricProduct.data(), _stateSpaceDim);
+    double result = 0.0;
+    gsl_blas_ddot(&leftView.vector, &productView.vector, &result);
 
     return result;
   }
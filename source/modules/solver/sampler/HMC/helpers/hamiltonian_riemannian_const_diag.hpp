@@ -68,6 +68,7 @@ class HamiltonianRiemannianConstDiag : public HamiltonianRiemannian
   std::vector<double> dK(const std::vector<double> &momentum, const std::vector<double> &inverseMetric) override
   {
     std::vector<double> gradient(_stateSpaceDim, 0.0);
+#pragma omp simd
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       gradient[i] = inverseMetric[i] * momentum[i];
@@ -86,6 +87,7 @@ class HamiltonianRiemannianConstDiag : public HamiltonianRiemannian
   {
     double energy = 0.0;
 
+#pragma omp simd reduction(+ : energy)
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       energy += momentum[i] * inverseMetric[i] * momentum[i];
@@ -137,22 +139,13 @@ class HamiltonianRiemannianConstDiag : public HamiltonianRiemannian
   }
 
   /**
-  * @brief Updates current position of hamiltonian.
-  * @param position Current position.
+  * @brief Updates the hamiltonian with a finished evaluation of the objective, including its hessian.
+  * @param sample Evaluated sample.
   * @param metric Current metric.
   * @param inverseMetric Inverse of current metric.
   */
-  void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric) override
+  void finishEvaluation(korali::Sample &sample, std::vector<double> &metric, std::vector<double> &inverseMetric) override
   {
-    auto sample = korali::Sample();
-    sample["Sample Id"] = _modelEvaluationCount;
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate";
-    sample["Parameters"] = position;
-
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
-    _modelEvaluationCount++;
     _currentEvaluation = KORALI_GET(double, sample, "logP(x)");
 
     if (samplingProblemPtr != nullptr)
@@ -198,6 +191,7 @@ class HamiltonianRiemannianConstDiag : public HamiltonianRiemannian
   {
     double result = 0.0;
 
+#pragma omp simd reduction(+ : result)
     for (size_t i = 0; i < _stateSpaceDim; ++i)
     {
       result += momentumLeft[i] * inverseMetric[i] * momentumRight[i];
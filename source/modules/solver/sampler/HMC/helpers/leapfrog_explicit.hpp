@@ -39,8 +39,22 @@ class LeapfrogExplicit : public Leapfrog
   void step(std::vector<double> &position, std::vector<double> &momentum, std::vector<double> &metric, std::vector<double> &inverseMetric, const double stepSize) override
   {
     _hamiltonian->updateHamiltonian(position, metric, inverseMetric);
-    std::vector<double> dU = _hamiltonian->dU();
+    kickDrift(position, momentum, metric, stepSize);
+
+    _hamiltonian->updateHamiltonian(position, metric, inverseMetric);
+    kick(momentum, stepSize);
+  }
 
+  /**
+  * @brief First part of the explicit Leapfrog step: half step of the momentum followed by a full step of the position. Requires the hamiltonian to be evaluated at the position.
+  * @param position Position which is evolved.
+  * @param momentum Momentum which is evolved.
+  * @param metric Current metric.
+  * @param stepSize Step Size used for Leap Frog Scheme.
+  */
+  void kickDrift(std::vector<double> &position, std::vector<double> &momentum, std::vector<double> &metric, const double stepSize)
+  {
+    std::vector<double> dU = _hamiltonian->dU();
     for (size_t i = 0; i < dU.size(); ++i)
     {
       momentum[i] -= 0.5 * stepSize * dU[i];
@@ -48,15 +62,20 @@ class LeapfrogExplicit : public Leapfrog
 
     // would need to update in Riemannian case
     std::vector<double> dK = _hamiltonian->dK(momentum, metric);
-
     for (size_t i = 0; i < dK.size(); ++i)
     {
       position[i] += stepSize * dK[i];
     }
+  }
 
-    _hamiltonian->updateHamiltonian(position, metric, inverseMetric);
-    dU = _hamiltonian->dU();
-
+  /**
+  * @brief Second part of the explicit Leapfrog step: half step of the momentum. Requires the hamiltonian to be evaluated at the evolved position.
+  * @param momentum Momentum which is evolved.
+  * @param stepSize Step Size used for Leap Frog Scheme.
+  */
+  void kick(std::vector<double> &momentum, const double stepSize)
+  {
+    std::vector<double> dU = _hamiltonian->dU();
     for (size_t i = 0; i < dU.size(); ++i)
     {
       momentum[i] -= 0.5 * stepSize * dU[i];
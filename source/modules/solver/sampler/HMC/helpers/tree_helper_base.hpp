@@ -71,6 +71,26 @@ struct TreeHelper
     * @brief Number of valid leaves encountererd (needed for adaptive time stepping).
     */
   size_t numLeavesOut;
+  /**
+    * @brief Sum of momenta of all leaves output (needed for the Riemannian criterion).
+    */
+  std::vector<double> rhoOut;
+
+  /**
+    * @brief Allocates the storage of the helper, such that it can be reused for any subtree without further allocations.
+    * @param stateSpaceDim Dimension of the state space.
+    */
+  void allocate(const size_t stateSpaceDim)
+  {
+    qIn.resize(stateSpaceDim);
+    pIn.resize(stateSpaceDim);
+    qLeftOut.resize(stateSpaceDim);
+    pLeftOut.resize(stateSpaceDim);
+    qRightOut.resize(stateSpaceDim);
+    pRightOut.resize(stateSpaceDim);
+    qProposedOut.resize(stateSpaceDim);
+    rhoOut.resize(stateSpaceDim);
+  }
 
   /**
     * @brief Computes No U-Turn Sampling (NUTS) criterion.
@@ -90,6 +110,14 @@ struct TreeHelper
     */
   virtual bool computeCriterion(const Hamiltonian &hamiltonian, const std::vector<double> &momentumStart, const std::vector<double> &momentumEnd, const std::vector<double> &inverseMetric, const std::vector<double> &rho) const = 0;
 
+  /**
+    * @brief Purely virtual function, computes No U-Turn Sampling (NUTS) criterion of the subtree described by the outputs of this helper.
+    * @param hamiltonian Hamiltonian object of system.
+    * @param inverseMetric Inverse of current metric.
+    * @return Returns of tree should be built further.
+    */
+  virtual bool computeSubtreeCriterion(const Hamiltonian &hamiltonian, const std::vector<double> &inverseMetric) const = 0;
+
   /**
    * @brief Default destructor
    */
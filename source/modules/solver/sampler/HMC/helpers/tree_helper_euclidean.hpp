@@ -38,6 +38,17 @@ struct TreeHelperEuclidean : public TreeHelper
     KORALI_LOG_ERROR("Wrong tree building criterion used in NUTS.");
     return false;
   }
+
+  /**
+  * @brief Computes No U-Turn Sampling (NUTS) criterion of the subtree, based on its leftmost and rightmost states.
+  * @param hamiltonian Hamiltonian object of system.
+  * @param inverseMetric Inverse of current metric.
+  * @return Returns of tree should be built further.
+  */
+  bool computeSubtreeCriterion(const Hamiltonian &hamiltonian, const std::vector<double> &inverseMetric) const override
+  {
+    return computeCriterion(hamiltonian);
+  }
 };
 
 } // namespace sampler
@@ -36,18 +36,22 @@ struct TreeHelperRiemannian : public TreeHelper
     */
   bool computeCriterion(const Hamiltonian &hamiltonian, const std::vector<double> &momentumStart, const std::vector<double> &momentumEnd, const std::vector<double> &inverseMetric, const std::vector<double> &rho) const override
   {
-    size_t dim = rho.size();
-    std::vector<double> tmpVectorOne(dim, 0.0);
-    std::transform(std::cbegin(rho), std::cend(rho), std::cbegin(momentumStart), std::begin(tmpVectorOne), std::minus<double>());
-
-    std::vector<double> tmpVectorTwo(dim, 0.0);
-    std::transform(std::cbegin(rho), std::cend(rho), std::cbegin(momentumStart), std::begin(tmpVectorTwo), std::minus<double>());
-
     double innerProductStart = hamiltonian.innerProduct(momentumStart, momentumStart, inverseMetric);
     double innerProductEnd = hamiltonian.innerProduct(momentumEnd, momentumEnd, inverseMetric);
 
     return innerProductStart > 0.0 && innerProductEnd > 0.0;
   }
+
+  /**
+    * @brief Computes No U-Turn Sampling (NUTS) criterion of the subtree, from the momentum it started with and its last momentum.
+    * @param hamiltonian Hamiltonian object of system.
+    * @param inverseMetric Inverse of current metric.
+    * @return Returns of tree should be built further.
+    */
+  bool computeSubtreeCriterion(const Hamiltonian &hamiltonian, const std::vector<double> &inverseMetric) const override
+  {
+    return computeCriterion(hamiltonian, pIn, directionIn == -1 ? pLeftOut : pRightOut, inverseMetric, rhoOut);
+  }
 };
 
 } // namespace sampler
@@ -4,6 +4,7 @@
 #include "modules/solver/sampler/MCMC/MCMC.hpp"
 #include "sample/sample.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <numeric>
@@ -31,14 +32,16 @@ void MCMC::setInitialConfiguration()
   if (_burnIn < 0) KORALI_LOG_ERROR("Burn In must be larger equal 0 (is %zu).\n", _burnIn);
   if (_rejectionLevels < 1) KORALI_LOG_ERROR("Rejection Levels must be larger 0 (is %zu).\n", _rejectionLevels);
   if (_nonAdaptionPeriod < 0) KORALI_LOG_ERROR("Non Adaption Period must be larger equal 0 (is %zu).\n", _nonAdaptionPeriod);
+  if (_chainCount < 1) KORALI_LOG_ERROR("Chain Count must be larger 0 (is %zu).\n", _chainCount);
+  if (_diagnosticsFrequency < 1) KORALI_LOG_ERROR("Diagnostics Frequency must be larger 0 (is %zu).\n", _diagnosticsFrequency);
 
   // Allocating MCMC memory
-  _chainCandidate.resize(_rejectionLevels);
-  for (size_t i = 0; i < _rejectionLevels; i++) _chainCandidate[i].resize(_variableCount);
+  _chainCandidate.resize(_chainCount * _rejectionLevels);
+  for (size_t i = 0; i < _chainCount * _rejectionLevels; i++) _chainCandidate[i].resize(_variableCount);
 
   _choleskyDecompositionCovariance.resize(_variableCount * _variableCount);
   _chainLeader.resize(_variableCount);
-  _chainCandidatesEvaluations.resize(_rejectionLevels);
+  _chainCandidatesEvaluations.resize(_chainCount * _rejectionLevels);
   _rejectionAlphas.resize(_rejectionLevels);
   _chainMean.resize(_variableCount);
   _chainCovariancePlaceholder.resize(_variableCount * _variableCount);
@@ -51,55 +54,94 @@ void MCMC::setInitialConfiguration()
   for (size_t i = 0; i < _variableCount; i++) _chainLeader[i] = _k->_variables[i]->_initialMean;
   for (size_t i = 0; i < _variableCount; i++) _choleskyDecompositionCovariance[i * _variableCount + i] = _k->_variables[i]->_initialStandardDeviation;
 
+  // The first chain starts at the initial mean, the others at a random draw from the initial proposal distribution around it
+  _chainLeaders.assign(_chainCount, _chainLeader);
+  for (size_t c = 1; c < _chainCount; c++) proposeCandidate(_chainLeader, _choleskyDecompositionCovariance, _chainLeaders[c]);
+
+  _chainMeans.assign(_chainCount, _chainMean);
+  _chainCovariances.assign(_chainCount, _chainCovariance);
+  _choleskyDecompositionChainCovariances.assign(_chainCount, _choleskyDecompositionChainCovariance);
+
   // Init Generation
   _acceptanceCount = 0;
   _proposedSampleCount = 0;
   _chainLength = 0;
   _chainLeaderEvaluation = -std::numeric_limits<double>::infinity();
+  _chainLeaderEvaluations.assign(_chainCount, _chainLeaderEvaluation);
+  _chainAcceptanceCounts.assign(_chainCount, 0);
   _acceptanceRate = 1.0;
+
+  // Init Convergence Diagnostics
+  _potentialScaleReduction.clear();
+  _effectiveSampleSize.clear();
+  _currentMaxPotentialScaleReduction = std::numeric_limits<double>::infinity();
+  _currentMinEffectiveSampleSize = 0.0;
 }
 
 void MCMC::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
-  bool _sampleAccepted = false;
+  std::vector<bool> isChainAccepted(_chainCount, false);
+  size_t acceptedChainCount = 0;
 
-  for (size_t i = 0; i < _rejectionLevels && _sampleAccepted == false; i++)
+  // All chains advance one rejection level at a time, evaluating their candidates concurrently
+  for (size_t i = 0; i < _rejectionLevels && acceptedChainCount < _chainCount; i++)
   {
-    generateCandidate(i);
+    // Only the chains that did not accept yet evaluate a candidate at this level
+    std::vector<size_t> pendingChains;
+    for (size_t c = 0; c < _chainCount; c++)
+      if (isChainAccepted[c] == false) pendingChains.push_back(c);
 
-    auto sample = Sample();
+    std::vector<Sample> samples(pendingChains.size());
 
-    _modelEvaluationCount++;
-    sample["Parameters"] = _chainCandidate[i];
-    sample["Sample Id"] = _sampleDatabase.size();
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate";
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
+    for (size_t s = 0; s < pendingChains.size(); s++)
+    {
+      const size_t c = pendingChains[s];
 
-    double evaluation = KORALI_GET(double, sample, "logP(x)");
+      generateCandidate(c, i);
 
-    _chainCandidatesEvaluations[i] = evaluation;
+      _modelEvaluationCount++;
+      samples[s]["Parameters"] = _chainCandidate[c * _rejectionLevels + i];
+      samples[s]["Sample Id"] = _sampleDatabase.size() + c;
+      samples[s]["Module"] = "Problem";
+      samples[s]["Operation"] = "Evaluate";
+      KORALI_START(samples[s]);
+    }
 
-    // Processing Result
-    double denom;
-    double _rejectionAlpha = recursiveAlpha(denom, _chainLeaderEvaluation, &_chainCandidatesEvaluations[0], i);
+    KORALI_WAITALL(samples);
 
-    if (_rejectionAlpha == 1.0 || _rejectionAlpha > _uniformGenerator->getRandomNumber())
+    for (size_t s = 0; s < pendingChains.size(); s++)
     {
-      _acceptanceCount++;
-      _sampleAccepted = true;
-      _chainLeaderEvaluation = _chainCandidatesEvaluations[i];
-      _chainLeader = _chainCandidate[i];
+      const size_t c = pendingChains[s];
+
+      double evaluation = KORALI_GET(double, samples[s], "logP(x)");
+
+      _chainCandidatesEvaluations[c * _rejectionLevels + i] = evaluation;
+
+      // Processing Result
+      double denom;
+      double _rejectionAlpha = recursiveAlpha(denom, _chainLeaderEvaluations[c], &_chainCandidatesEvaluations[c * _rejectionLevels], i);
+
+      if (_rejectionAlpha == 1.0 || _rejectionAlpha > _uniformGenerator->getRandomNumber())
+      {
+        _acceptanceCount++;
+        _chainAcceptanceCounts[c]++;
+        isChainAccepted[c] = true;
+        acceptedChainCount++;
+        _chainLeaderEvaluations[c] = _chainCandidatesEvaluations[c * _rejectionLevels + i];
+        _chainLeaders[c] = _chainCandidate[c * _rejectionLevels + i];
+      }
     }
   }
 
   if ((_chainLength >= _burnIn) && (_k->_currentGeneration % _leap == 0))
   {
-    _sampleDatabase.push_back(_chainLeader);
-    _sampleEvaluationDatabase.push_back(_chainLeaderEvaluation);
+    for (size_t c = 0; c < _chainCount; c++)
+    {
+      _sampleDatabase.push_back(_chainLeaders[c]);
+      _sampleEvaluationDatabase.push_back(_chainLeaderEvaluations[c]);
+    }
   }
 
   updateState();
@@ -173,55 +215,84 @@ double MCMC::recursiveAlpha(double &denominator, const double leaderLoglikelihoo
   }
 }
 
-void MCMC::generateCandidate(size_t sampleIdx)
+void MCMC::generateCandidate(size_t chainIdx, size_t sampleIdx)
 {
   _proposedSampleCount++;
 
-  if (sampleIdx == 0)
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidate[sampleIdx][d] = _chainLeader[d];
-  else
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidate[sampleIdx][d] = _chainCandidate[sampleIdx - 1][d];
+  const size_t candidateIdx = chainIdx * _rejectionLevels + sampleIdx;
+  const auto &origin = sampleIdx == 0 ? _chainLeaders[chainIdx] : _chainCandidate[candidateIdx - 1];
 
-  if ((_useAdaptiveSampling == false) || (_sampleDatabase.size() <= _nonAdaptionPeriod + _burnIn))
-    for (size_t d = 0; d < _variableCount; ++d)
-      for (size_t e = 0; e < _variableCount; ++e) _chainCandidate[sampleIdx][d] += _choleskyDecompositionCovariance[d * _variableCount + e] * _normalGenerator->getRandomNumber();
+  if ((_useAdaptiveSampling == false) || (_sampleDatabase.size() / _chainCount <= _nonAdaptionPeriod + _burnIn))
+    proposeCandidate(origin, _choleskyDecompositionCovariance, _chainCandidate[candidateIdx]);
   else
-    for (size_t d = 0; d < _variableCount; ++d)
-      for (size_t e = 0; e < _variableCount; ++e) _chainCandidate[sampleIdx][d] += _choleskyDecompositionChainCovariance[d * _variableCount + e] * _normalGenerator->getRandomNumber();
+    proposeCandidate(origin, _choleskyDecompositionChainCovariances[chainIdx], _chainCandidate[candidateIdx]);
+}
+
+void MCMC::proposeCandidate(const std::vector<double> &origin, const std::vector<double> &choleskyFactor, std::vector<double> &candidate)
+{
+  for (size_t d = 0; d < _variableCount; ++d) candidate[d] = origin[d];
+
+  for (size_t d = 0; d < _variableCount; ++d)
+    for (size_t e = 0; e < _variableCount; ++e) candidate[d] += choleskyFactor[d * _variableCount + e] * _normalGenerator->getRandomNumber();
 }
 
 void MCMC::updateState()
 {
-  _acceptanceRate = ((double)_acceptanceCount / (double)_chainLength);
+  _acceptanceRate = ((double)_acceptanceCount / (double)(_chainLength * _chainCount));
+
+  // Every chain adapts its own proposal from its own samples
+  for (size_t c = 0; c < _chainCount; c++)
+    updateChainStatistics(_chainLeaders[c], _sampleDatabase.size() / _chainCount, _chainMeans[c], _chainCovariances[c], _choleskyDecompositionChainCovariances[c]);
+
+  // The single chain fields refer to the first chain
+  _chainLeader = _chainLeaders[0];
+  _chainLeaderEvaluation = _chainLeaderEvaluations[0];
+  _chainMean = _chainMeans[0];
+  _chainCovariance = _chainCovariances[0];
+  _choleskyDecompositionChainCovariance = _choleskyDecompositionChainCovariances[0];
 
-  if (_sampleDatabase.size() == 0) return;
-  if (_sampleDatabase.size() == 1)
+  if ((_chainCount > 1 || _targetEffectiveSampleSize > 0.0) && (_k->_currentGeneration % _diagnosticsFrequency == 0)) updateDiagnostics();
+}
+
+void MCMC::updateDiagnostics()
+{
+  computeConvergenceDiagnostics(_sampleDatabase, _chainCount, _potentialScaleReduction, _effectiveSampleSize);
+
+  if (_potentialScaleReduction.empty()) return;
+  _currentMaxPotentialScaleReduction = *std::max_element(std::begin(_potentialScaleReduction), std::end(_potentialScaleReduction));
+  _currentMinEffectiveSampleSize = *std::min_element(std::begin(_effectiveSampleSize), std::end(_effectiveSampleSize));
+}
+
+void MCMC::updateChainStatistics(const std::vector<double> &leader, const size_t sampleCount, std::vector<double> &mean, std::vector<double> &covariance, std::vector<double> &choleskyFactor)
+{
+  if (sampleCount == 0) return;
+  if (sampleCount == 1)
   {
-    for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = _chainLeader[d];
+    for (size_t d = 0; d < _variableCount; d++) mean[d] = leader[d];
     return;
   }
 
   for (size_t d = 0; d < _variableCount; d++)
     for (size_t e = 0; e < d; e++)
     {
-      _chainCovariancePlaceholder[d * _variableCount + e] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[e] - _chainLeader[e]);
-      _chainCovariancePlaceholder[e * _variableCount + d] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[e] - _chainLeader[e]);
+      _chainCovariancePlaceholder[d * _variableCount + e] = (mean[d] - leader[d]) * (mean[e] - leader[e]);
+      _chainCovariancePlaceholder[e * _variableCount + d] = (mean[d] - leader[d]) * (mean[e] - leader[e]);
     }
-  for (size_t d = 0; d < _variableCount; d++) _chainCovariancePlaceholder[d * _variableCount + d] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[d] - _chainLeader[d]);
+  for (size_t d = 0; d < _variableCount; d++) _chainCovariancePlaceholder[d * _variableCount + d] = (mean[d] - leader[d]) * (mean[d] - leader[d]);
 
   // Chain Mean
-  for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = (_chainMean[d] * (_sampleDatabase.size() - 1) + _chainLeader[d]) / _sampleDatabase.size();
+  for (size_t d = 0; d < _variableCount; d++) mean[d] = (mean[d] * (sampleCount - 1) + leader[d]) / sampleCount;
 
   for (size_t d = 0; d < _variableCount; d++)
     for (size_t e = 0; e < d; e++)
     {
-      _chainCovariance[d * _variableCount + e] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + e] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + e];
-      _chainCovariance[e * _variableCount + d] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + e] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + e];
+      covariance[d * _variableCount + e] = (sampleCount - 2.0) / (sampleCount - 1.0) * covariance[d * _variableCount + e] + (_chainCovarianceScaling / sampleCount) * _chainCovariancePlaceholder[d * _variableCount + e];
+      covariance[e * _variableCount + d] = (sampleCount - 2.0) / (sampleCount - 1.0) * covariance[d * _variableCount + e] + (_chainCovarianceScaling / sampleCount) * _chainCovariancePlaceholder[d * _variableCount + e];
     }
   for (size_t d = 0; d < _variableCount; d++)
-    _chainCovariance[d * _variableCount + d] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + d] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + d];
+    covariance[d * _variableCount + d] = (sampleCount - 2.0) / (sampleCount - 1.0) * covariance[d * _variableCount + d] + (_chainCovarianceScaling / sampleCount) * _chainCovariancePlaceholder[d * _variableCount + d];
 
-  if ((_useAdaptiveSampling == true) && (_sampleDatabase.size() > _nonAdaptionPeriod)) choleskyDecomp(_chainCovariance, _choleskyDecompositionChainCovariance);
+  if ((_useAdaptiveSampling == true) && (sampleCount > _nonAdaptionPeriod)) choleskyDecomp(covariance, choleskyFactor);
 }
 
 void MCMC::printGenerationBefore() { return; }
@@ -233,6 +304,18 @@ void MCMC::printGenerationAfter()
   _k->_logger->logInfo("Normal", "Accepted Samples: %zu\n", _acceptanceCount);
   _k->_logger->logInfo("Normal", "Acceptance Rate Proposals: %.2f%%\n", 100 * _acceptanceRate);
 
+  if (_chainCount > 1)
+  {
+    _k->_logger->logInfo("Normal", "Chain Acceptance Rates:\n");
+    for (size_t c = 0; c < _chainCount; c++) _k->_logger->logData("Normal", "         Chain %zu: %.2f%%\n", c, 100.0 * (double)_chainAcceptanceCounts[c] / (double)_chainLength);
+  }
+
+  if (_potentialScaleReduction.empty() == false)
+  {
+    _k->_logger->logInfo("Normal", "Convergence Diagnostics:\n");
+    for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Normal", "         %s: R-hat = %.4f, ESS = %.1f\n", _k->_variables[d]->_name.c_str(), _potentialScaleReduction[d], _effectiveSampleSize[d]);
+  }
+
   _k->_logger->logInfo("Detailed", "Current Sample:\n");
   for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _chainLeader[d]);
 
@@ -251,6 +334,12 @@ void MCMC::finalize()
   _k->_logger->logInfo("Minimal", "Number of Generated Samples: %zu\n", _proposedSampleCount);
   _k->_logger->logInfo("Minimal", "Acceptance Rate: %.2f%%\n", 100 * _acceptanceRate);
   if (_sampleDatabase.size() == _maxSamples) _k->_logger->logInfo("Minimal", "Max Samples Reached.\n");
+  if (_chainCount > 1 || _targetEffectiveSampleSize > 0.0)
+  {
+    updateDiagnostics();
+    _k->_logger->logInfo("Minimal", "Max Potential Scale Reduction: %.4f\n", _currentMaxPotentialScaleReduction);
+    _k->_logger->logInfo("Minimal", "Min Effective Sample Size: %.1f\n", _currentMinEffectiveSampleSize);
+  }
   (*_k)["Results"]["Sample Database"] = _sampleDatabase;
 }
 
@@ -292,6 +381,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Cholesky Decomposition Chain Covariance");
  }
 
+ if (isDefined(js, "Cholesky Decomposition Chain Covariances"))
+ {
+ try { _choleskyDecompositionChainCovariances = js["Cholesky Decomposition Chain Covariances"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Cholesky Decomposition Chain Covariances']\n%s", e.what()); } 
+   eraseValue(js, "Cholesky Decomposition Chain Covariances");
+ }
+
  if (isDefined(js, "Chain Leader"))
  {
  try { _chainLeader = js["Chain Leader"].get<std::vector<double>>();
@@ -300,6 +397,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Leader");
  }
 
+ if (isDefined(js, "Chain Leaders"))
+ {
+ try { _chainLeaders = js["Chain Leaders"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leaders']\n%s", e.what()); } 
+   eraseValue(js, "Chain Leaders");
+ }
+
  if (isDefined(js, "Chain Leader Evaluation"))
  {
  try { _chainLeaderEvaluation = js["Chain Leader Evaluation"].get<double>();
@@ -308,6 +413,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Leader Evaluation");
  }
 
+ if (isDefined(js, "Chain Leader Evaluations"))
+ {
+ try { _chainLeaderEvaluations = js["Chain Leader Evaluations"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leader Evaluations']\n%s", e.what()); } 
+   eraseValue(js, "Chain Leader Evaluations");
+ }
+
  if (isDefined(js, "Chain Candidate"))
  {
  try { _chainCandidate = js["Chain Candidate"].get<std::vector<std::vector<double>>>();
@@ -348,6 +461,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Acceptance Count");
  }
 
+ if (isDefined(js, "Chain Acceptance Counts"))
+ {
+ try { _chainAcceptanceCounts = js["Chain Acceptance Counts"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Acceptance Counts']\n%s", e.what()); } 
+   eraseValue(js, "Chain Acceptance Counts");
+ }
+
  if (isDefined(js, "Proposed Sample Count"))
  {
  try { _proposedSampleCount = js["Proposed Sample Count"].get<size_t>();
@@ -380,6 +501,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Mean");
  }
 
+ if (isDefined(js, "Chain Means"))
+ {
+ try { _chainMeans = js["Chain Means"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Means']\n%s", e.what()); } 
+   eraseValue(js, "Chain Means");
+ }
+
  if (isDefined(js, "Chain Covariance Placeholder"))
  {
  try { _chainCovariancePlaceholder = js["Chain Covariance Placeholder"].get<std::vector<double>>();
@@ -396,6 +525,14 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Covariance");
  }
 
+ if (isDefined(js, "Chain Covariances"))
+ {
+ try { _chainCovariances = js["Chain Covariances"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Covariances']\n%s", e.what()); } 
+   eraseValue(js, "Chain Covariances");
+ }
+
  if (isDefined(js, "Chain Length"))
  {
  try { _chainLength = js["Chain Length"].get<size_t>();
@@ -404,6 +541,38 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Length");
  }
 
+ if (isDefined(js, "Potential Scale Reduction"))
+ {
+ try { _potentialScaleReduction = js["Potential Scale Reduction"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Potential Scale Reduction");
+ }
+
+ if (isDefined(js, "Effective Sample Size"))
+ {
+ try { _effectiveSampleSize = js["Effective Sample Size"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Effective Sample Size");
+ }
+
+ if (isDefined(js, "Current Max Potential Scale Reduction"))
+ {
+ try { _currentMaxPotentialScaleReduction = js["Current Max Potential Scale Reduction"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Current Max Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Current Max Potential Scale Reduction");
+ }
+
+ if (isDefined(js, "Current Min Effective Sample Size"))
+ {
+ try { _currentMinEffectiveSampleSize = js["Current Min Effective Sample Size"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Current Min Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Current Min Effective Sample Size");
+ }
+
  if (isDefined(js, "Burn In"))
  {
  try { _burnIn = js["Burn In"].get<size_t>();
@@ -458,6 +627,24 @@ void MCMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Covariance Scaling'] required by MCMC.\n"); 
 
+ if (isDefined(js, "Chain Count"))
+ {
+ try { _chainCount = js["Chain Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Count']\n%s", e.what()); } 
+   eraseValue(js, "Chain Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Count'] required by MCMC.\n"); 
+
+ if (isDefined(js, "Diagnostics Frequency"))
+ {
+ try { _diagnosticsFrequency = js["Diagnostics Frequency"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Diagnostics Frequency']\n%s", e.what()); } 
+   eraseValue(js, "Diagnostics Frequency");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Diagnostics Frequency'] required by MCMC.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Samples"))
  {
  try { _maxSamples = js["Termination Criteria"]["Max Samples"].get<size_t>();
@@ -467,6 +654,24 @@ void MCMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Max Samples'] required by MCMC.\n"); 
 
+ if (isDefined(js, "Termination Criteria", "Target Potential Scale Reduction"))
+ {
+ try { _targetPotentialScaleReduction = js["Termination Criteria"]["Target Potential Scale Reduction"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Termination Criteria']['Target Potential Scale Reduction']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Target Potential Scale Reduction");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Target Potential Scale Reduction'] required by MCMC.\n"); 
+
+ if (isDefined(js, "Termination Criteria", "Target Effective Sample Size"))
+ {
+ try { _targetEffectiveSampleSize = js["Termination Criteria"]["Target Effective Sample Size"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Termination Criteria']['Target Effective Sample Size']\n%s", e.what()); } 
+   eraseValue(js, "Termination Criteria", "Target Effective Sample Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Termination Criteria']['Target Effective Sample Size'] required by MCMC.\n"); 
+
  if (isDefined(_k->_js.getJson(), "Variables"))
  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
  if (isDefined(_k->_js["Variables"][i], "Initial Mean"))
@@ -504,25 +709,39 @@ void MCMC::getConfiguration(knlohmann::json& js)
    js["Use Adaptive Sampling"] = _useAdaptiveSampling;
    js["Non Adaption Period"] = _nonAdaptionPeriod;
    js["Chain Covariance Scaling"] = _chainCovarianceScaling;
+   js["Chain Count"] = _chainCount;
+   js["Diagnostics Frequency"] = _diagnosticsFrequency;
    js["Termination Criteria"]["Max Samples"] = _maxSamples;
+   js["Termination Criteria"]["Target Potential Scale Reduction"] = _targetPotentialScaleReduction;
+   js["Termination Criteria"]["Target Effective Sample Size"] = _targetEffectiveSampleSize;
  if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
  if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
    js["Cholesky Decomposition Covariance"] = _choleskyDecompositionCovariance;
    js["Cholesky Decomposition Chain Covariance"] = _choleskyDecompositionChainCovariance;
+   js["Cholesky Decomposition Chain Covariances"] = _choleskyDecompositionChainCovariances;
    js["Chain Leader"] = _chainLeader;
+   js["Chain Leaders"] = _chainLeaders;
    js["Chain Leader Evaluation"] = _chainLeaderEvaluation;
+   js["Chain Leader Evaluations"] = _chainLeaderEvaluations;
    js["Chain Candidate"] = _chainCandidate;
    js["Chain Candidates Evaluations"] = _chainCandidatesEvaluations;
    js["Rejection Alphas"] = _rejectionAlphas;
    js["Acceptance Rate"] = _acceptanceRate;
    js["Acceptance Count"] = _acceptanceCount;
+   js["Chain Acceptance Counts"] = _chainAcceptanceCounts;
    js["Proposed Sample Count"] = _proposedSampleCount;
    js["Sample Database"] = _sampleDatabase;
    js["Sample Evaluation Database"] = _sampleEvaluationDatabase;
    js["Chain Mean"] = _chainMean;
+   js["Chain Means"] = _chainMeans;
    js["Chain Covariance Placeholder"] = _chainCovariancePlaceholder;
    js["Chain Covariance"] = _chainCovariance;
+   js["Chain Covariances"] = _chainCovariances;
    js["Chain Length"] = _chainLength;
+   js["Potential Scale Reduction"] = _potentialScaleReduction;
+   js["Effective Sample Size"] = _effectiveSampleSize;
+   js["Current Max Potential Scale Reduction"] = _currentMaxPotentialScaleReduction;
+   js["Current Min Effective Sample Size"] = _currentMinEffectiveSampleSize;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
    _k->_js["Variables"][i]["Initial Mean"] = _k->_variables[i]->_initialMean;
    _k->_js["Variables"][i]["Initial Standard Deviation"] = _k->_variables[i]->_initialStandardDeviation;
@@ -533,7 +752,7 @@ void MCMC::getConfiguration(knlohmann::json& js)
 void MCMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Burn In\": 0, \"Leap\": 1, \"Rejection Levels\": 1, \"Use Adaptive Sampling\": false, \"Non Adaption Period\": 0, \"Chain Covariance Scaling\": 1.0, \"Termination Criteria\": {\"Max Samples\": 5000}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}}";
+ std::string defaultString = "{\"Burn In\": 0, \"Leap\": 1, \"Rejection Levels\": 1, \"Use Adaptive Sampling\": false, \"Non Adaption Period\": 0, \"Chain Covariance Scaling\": 1.0, \"Chain Count\": 1, \"Diagnostics Frequency\": 100, \"Termination Criteria\": {\"Max Samples\": 5000, \"Target Potential Scale Reduction\": 0.0, \"Target Effective Sample Size\": 0.0}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
@@ -555,6 +774,18 @@ bool MCMC::checkTermination()
   hasFinished = true;
  }
 
+ if ((_chainCount > 1) && (_targetPotentialScaleReduction > 0.0) && (_currentMaxPotentialScaleReduction <= _targetPotentialScaleReduction))
+ {
+  _terminationCriteria.push_back("MCMC['Target Potential Scale Reduction'] = " + std::to_string(_targetPotentialScaleReduction) + ".");
+  hasFinished = true;
+ }
+
+ if ((_targetEffectiveSampleSize > 0.0) && (_currentMinEffectiveSampleSize >= _targetEffectiveSampleSize))
+ {
+  _terminationCriteria.push_back("MCMC['Target Effective Sample Size'] = " + std::to_string(_targetEffectiveSampleSize) + ".");
+  hasFinished = true;
+ }
+
  hasFinished = hasFinished || Sampler::checkTermination();
  return hasFinished;
 }
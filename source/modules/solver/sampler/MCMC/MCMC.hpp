@@ -56,6 +56,14 @@ class MCMC : public Sampler
   */
    double _chainCovarianceScaling;
   /**
+  * @brief Number of independent Markov chains advanced in lockstep. The candidates of all chains are evaluated concurrently and each chain adapts its own proposal covariance. The samples of all chains are stored in the Sample Database, interleaved by chain.
+  */
+   size_t _chainCount;
+  /**
+  * @brief Number of generations between updates of the convergence diagnostics (Potential Scale Reduction and Effective Sample Size).
+  */
+   size_t _diagnosticsFrequency;
+  /**
   * @brief [Internal Use] Normal random number generator.
   */
    korali::distribution::univariate::Normal* _normalGenerator;
@@ -68,23 +76,35 @@ class MCMC : public Sampler
   */
    std::vector<double> _choleskyDecompositionCovariance;
   /**
-  * @brief [Internal Use] Chain Cholesky Decomposition of Covariance for sampling (using a lower triangular matrix, with rest zeros).
+  * @brief [Internal Use] Chain Cholesky Decomposition of Covariance for sampling (using a lower triangular matrix, with rest zeros). Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _choleskyDecompositionChainCovariance;
   /**
-  * @brief [Internal Use] Variables of the newest sample in the Markov chain.
+  * @brief [Internal Use] Cholesky Decomposition of the Chain Covariance of each chain.
+  */
+   std::vector<std::vector<double>> _choleskyDecompositionChainCovariances;
+  /**
+  * @brief [Internal Use] Variables of the newest sample in the Markov chain. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _chainLeader;
   /**
-  * @brief [Internal Use] The logLikelihood of the newest sample in the Markov chain.
+  * @brief [Internal Use] Variables of the newest sample of each Markov chain.
+  */
+   std::vector<std::vector<double>> _chainLeaders;
+  /**
+  * @brief [Internal Use] The logLikelihood of the newest sample in the Markov chain. Refers to the first chain if Chain Count > 1.
   */
    double _chainLeaderEvaluation;
   /**
-  * @brief [Internal Use] Candidate variables to be accepted or rejected after comparison with the Chain Leader.
+  * @brief [Internal Use] The logLikelihood of the newest sample of each Markov chain.
+  */
+   std::vector<double> _chainLeaderEvaluations;
+  /**
+  * @brief [Internal Use] Candidate variables to be accepted or rejected after comparison with the Chain Leader, stored per chain and rejection level (entry c * Rejection Levels + i).
   */
    std::vector<std::vector<double>> _chainCandidate;
   /**
-  * @brief [Internal Use] The loglikelihoods of the Chain Candidate Parameters.
+  * @brief [Internal Use] The loglikelihoods of the Chain Candidate Parameters, stored per chain and rejection level (entry c * Rejection Levels + i).
   */
    std::vector<double> _chainCandidatesEvaluations;
   /**
@@ -96,10 +116,14 @@ class MCMC : public Sampler
   */
    double _acceptanceRate;
   /**
-  * @brief [Internal Use] Number of accepted samples (including Burn In period).
+  * @brief [Internal Use] Number of accepted samples of all chains (including Burn In period).
   */
    size_t _acceptanceCount;
   /**
+  * @brief [Internal Use] Number of accepted samples of each chain (including Burn In period).
+  */
+   std::vector<size_t> _chainAcceptanceCounts;
+  /**
   * @brief [Internal Use] Number of proposed samples.
   */
    size_t _proposedSampleCount;
@@ -112,25 +136,57 @@ class MCMC : public Sampler
   */
    std::vector<double> _sampleEvaluationDatabase;
   /**
-  * @brief [Internal Use] Mean of Markov Chain calculated from samples in Database.
+  * @brief [Internal Use] Mean of Markov Chain calculated from samples in Database. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _chainMean;
   /**
+  * @brief [Internal Use] Mean of each Markov Chain calculated from its samples in Database.
+  */
+   std::vector<std::vector<double>> _chainMeans;
+  /**
   * @brief [Internal Use] Placeholder for chain covariance calculation.
   */
    std::vector<double> _chainCovariancePlaceholder;
   /**
-  * @brief [Internal Use] Chain Covariance calculated from samples in Database.
+  * @brief [Internal Use] Chain Covariance calculated from samples in Database. Refers to the first chain if Chain Count > 1.
   */
    std::vector<double> _chainCovariance;
   /**
+  * @brief [Internal Use] Covariance of each Markov Chain calculated from its samples in Database.
+  */
+   std::vector<std::vector<double>> _chainCovariances;
+  /**
   * @brief [Internal Use] Current Chain Length (including Burn In and Leaped Samples).
   */
    size_t _chainLength;
   /**
+  * @brief [Internal Use] Gelman-Rubin Potential Scale Reduction (R-hat) of each variable across all chains.
+  */
+   std::vector<double> _potentialScaleReduction;
+  /**
+  * @brief [Internal Use] Effective Sample Size of each variable, pooled over all chains.
+  */
+   std::vector<double> _effectiveSampleSize;
+  /**
+  * @brief [Internal Use] Largest Potential Scale Reduction among all variables.
+  */
+   double _currentMaxPotentialScaleReduction;
+  /**
+  * @brief [Internal Use] Smallest Effective Sample Size among all variables.
+  */
+   double _currentMinEffectiveSampleSize;
+  /**
   * @brief [Termination Criteria] Number of Samples to Generate.
   */
    size_t _maxSamples;
+  /**
+  * @brief [Termination Criteria] Terminates once the Potential Scale Reduction (R-hat) across chains falls below this value for all variables (only relevant if Chain Count > 1, disabled if 0.0).
+  */
+   double _targetPotentialScaleReduction;
+  /**
+  * @brief [Termination Criteria] Terminates once the Effective Sample Size of all variables, pooled over all chains, exceeds this value (disabled if 0.0).
+  */
+   double _targetEffectiveSampleSize;
   
  
   /**
@@ -174,11 +230,35 @@ class MCMC : public Sampler
    */
   void updateState();
 
+  /**
+   * @brief Updates the running mean and (adaptive) covariance of a chain with its newest sample.
+   * @param leader Newest sample of the chain
+   * @param sampleCount Number of samples of the chain, including the newest one
+   * @param mean Running mean of the chain
+   * @param covariance Running covariance of the chain
+   * @param choleskyFactor Cholesky decomposition of the covariance, updated if adaptive sampling is active
+   */
+  void updateChainStatistics(const std::vector<double> &leader, const size_t sampleCount, std::vector<double> &mean, std::vector<double> &covariance, std::vector<double> &choleskyFactor);
+
+  /**
+   * @brief Updates the convergence diagnostics (Potential Scale Reduction and Effective Sample Size) from the sample database.
+   */
+  void updateDiagnostics();
+
   /**
    * @brief Generate new sample.
-   * @param sampleIdx Id of the sample to generate a candidate for
+   * @param chainIdx Id of the chain to generate a candidate for
+   * @param sampleIdx Id of the sample (rejection level) to generate a candidate for
+   */
+  void generateCandidate(size_t chainIdx, size_t sampleIdx);
+
+  /**
+   * @brief Draws a Gaussian random walk proposal.
+   * @param origin Point to propose from
+   * @param choleskyFactor Lower triangular Cholesky decomposition of the proposal covariance
+   * @param candidate Storage for the proposed candidate
    */
-  void generateCandidate(size_t sampleIdx);
+  void proposeCandidate(const std::vector<double> &origin, const std::vector<double> &choleskyFactor, std::vector<double> &candidate);
 
   /**
    * @brief Cholesky decomposition of chain covariance matrix.
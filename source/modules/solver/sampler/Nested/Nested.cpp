@@ -4,6 +4,7 @@
 #include "modules/solver/sampler/Nested/Nested.hpp"
 #include "sample/sample.hpp"
 
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_eigen.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
@@ -31,7 +32,6 @@ void ellipse_t::initSphere()
   sampleIdx.clear();
   std::fill(mean.begin(), mean.end(), 0.);
   std::fill(cov.begin(), cov.end(), 0.);
-  std::fill(invCov.begin(), invCov.end(), 0.);
   std::fill(axes.begin(), axes.end(), 0.);
   std::fill(evals.begin(), evals.end(), 0.);
   std::fill(paxes.begin(), paxes.end(), 0.);
@@ -39,7 +39,6 @@ void ellipse_t::initSphere()
   for (size_t d = 0; d < dim; ++d)
   {
     cov[d * dim + d] = 1.;
-    invCov[d * dim + d] = 1.;
     axes[d * dim + d] = 1.;
     evals[d] = 1.;
     paxes[d * dim + d] = 1.;
@@ -56,8 +55,7 @@ void ellipse_t::scaleVolume(double factor)
   for (size_t d = 0; d < dim * dim; ++d)
   {
     cov[d] *= enlargementFactor;
-    invCov[d] *= 1. / enlargementFactor;
-    axes[d] *= enlargementFactor;
+    axes[d] *= std::sqrt(enlargementFactor);
   }
   for (size_t d = 0; d < dim; ++d) evals[d] *= enlargementFactor;
 }
@@ -69,10 +67,18 @@ void Nested::setInitialConfiguration()
 
   if (_minLogEvidenceDelta < 0.) KORALI_LOG_ERROR("Min Log Evidence Delta must be larger equal 0.0 (is %lf).\n", _minLogEvidenceDelta);
 
-  if ((_resamplingMethod != "Box") && (_resamplingMethod != "Ellipse") && (_resamplingMethod != "Multi Ellipse")) KORALI_LOG_ERROR("Only accepted Resampling Method are 'Box', 'Ellipse' and 'Multi Ellipse' (is %s).\n", _resamplingMethod.c_str());
+  if ((_resamplingMethod != "Box") && (_resamplingMethod != "Ellipse") && (_resamplingMethod != "Multi Ellipse") && (_resamplingMethod != "Slice") && (_resamplingMethod != "Random Walk")) KORALI_LOG_ERROR("Only accepted Resampling Method are 'Box', 'Ellipse', 'Multi Ellipse', 'Slice' and 'Random Walk' (is %s).\n", _resamplingMethod.c_str());
+
+  if ((_resamplingMethod == "Slice" || _resamplingMethod == "Random Walk") && (_proposalSteps == 0)) KORALI_LOG_ERROR("Proposal Steps must be larger 0 for Resampling Method '%s'.\n", _resamplingMethod.c_str());
 
   if (_proposalUpdateFrequency <= 0) KORALI_LOG_ERROR("Proposal Update Frequency must be larger 0");
 
+  if ((_dynamicPosteriorFraction < 0.) || (_dynamicPosteriorFraction > 1.)) KORALI_LOG_ERROR("Dynamic Posterior Fraction must be in [0.0, 1.0] (is %lf).\n", _dynamicPosteriorFraction);
+
+  if ((_dynamicImportanceThreshold <= 0.) || (_dynamicImportanceThreshold > 1.)) KORALI_LOG_ERROR("Dynamic Importance Threshold must be in (0.0, 1.0] (is %lf).\n", _dynamicImportanceThreshold);
+
+  if (_proposalUpdateShrinkage < 0.) KORALI_LOG_ERROR("Proposal Update Shrinkage must be larger equal 0.0 (is %lf).\n", _proposalUpdateShrinkage);
+
   _priorLowerBound.resize(_variableCount);
   _priorWidth.resize(_variableCount);
 
@@ -109,16 +115,24 @@ void Nested::setInitialConfiguration()
   _liveLogPriors.resize(_numberLivePoints);
   _liveLogPriorWeights.resize(_numberLivePoints);
   _liveSamplesRank.resize(_numberLivePoints);
-  _liveSamples.resize(_numberLivePoints);
-  for (size_t i = 0; i < _numberLivePoints; i++) _liveSamples[i].resize(_variableCount);
+  _liveBirthLStars.resize(_numberLivePoints);
+  _liveSamples.resize(_numberLivePoints * _variableCount);
 
   _numberDeadSamples = 0;
   _deadLogLikelihoods.resize(0);
   _deadLogPriors.resize(0);
   _deadLogWeights.resize(0);
   _deadLogPriorWeights.resize(0);
+  _deadBirthLStars.resize(0);
   _deadSamples.resize(0);
 
+  // Init dynamic nested sampling, starting with the baseline run
+  _dynamicBatch = 0;
+  _dynamicFillCount = _numberLivePoints;
+  _dynamicLowerBound = Lowest;
+  _dynamicUpperBound = Max;
+  _dynamicLowerLogVolume = 0.;
+
   // Init Generation
   _logEvidence = Lowest;
   _sumLogWeights = Lowest;
@@ -131,6 +145,7 @@ void Nested::setInitialConfiguration()
   _information = 0.;
   _lastAccepted = 0;
   _nextUpdate = 0;
+  _lastUpdateLogVolume = Max;
   _acceptedSamples = 0;
   _generatedSamples = 0;
   _lStarOld = Lowest;
@@ -146,10 +161,17 @@ void Nested::setInitialConfiguration()
   {
     initEllipseVector();
   }
-  else /* _resamplingMethod == "Multi Ellipse" */
+  else if (_resamplingMethod == "Multi Ellipse")
   {
     initEllipseVector();
   }
+  else /* _resamplingMethod == "Slice" || _resamplingMethod == "Random Walk" */
+  {
+    // The bounding ellipse defines the shape of the slices and random walk steps
+    initEllipseVector();
+    _chainVector.assign(_batchSize, chain_t(_variableCount));
+    _randomWalkScale = 1.;
+  }
 
   (*_k)["Results"]["Posterior Samples"] = {};
 }
@@ -173,6 +195,16 @@ void Nested::runGeneration()
   while (accepted == false)
   {
     updateBounds();
+
+    // Candidates generated by chains are already evaluated
+    if (_resamplingMethod == "Slice" || _resamplingMethod == "Random Walk")
+    {
+      generateCandidatesFromChains();
+      _lastAccepted++;
+      accepted = processGeneration();
+      continue;
+    }
+
     generateCandidates();
 
     for (size_t c = 0; c < _batchSize; c++)
@@ -213,7 +245,10 @@ void Nested::runFirstGeneration()
 {
   for (size_t i = 0; i < _numberLivePoints; i++)
     for (size_t d = 0; d < _variableCount; d++)
-      _liveSamples[i][d] = _uniformGenerator->getRandomNumber();
+      _liveSamples[i * _variableCount + d] = _uniformGenerator->getRandomNumber();
+
+  // Live samples drawn from the prior are unconstrained
+  std::fill(_liveBirthLStars.begin(), _liveBirthLStars.end(), Lowest);
 
   std::vector<double> sample;
   std::vector<Sample> samples(_numberLivePoints);
@@ -223,7 +258,7 @@ void Nested::runFirstGeneration()
   {
     samples[c]["Module"] = "Problem";
     samples[c]["Operation"] = "Evaluate";
-    sample = _liveSamples[c];
+    sample.assign(_liveSamples.begin() + c * _variableCount, _liveSamples.begin() + (c + 1) * _variableCount);
     priorTransform(sample);
     samples[c]["Parameters"] = sample;
     samples[c]["Sample Id"] = c;
@@ -260,21 +295,25 @@ void Nested::updateBounds()
 {
   if (_generatedSamples < _nextUpdate && _ellipseVector.empty() == false) return; // no update
 
+  // Keep the bounds until the live samples shrank sufficiently
+  if (_lastUpdateLogVolume - _logVolume < _proposalUpdateShrinkage) return; // no update
+
   // Set next update of bounding hypervolume
   _nextUpdate += _proposalUpdateFrequency;
+  _lastUpdateLogVolume = _logVolume;
 
   // Update bounding hypervolume
   if (_resamplingMethod == "Box")
   {
     updateBox();
   }
-  else if (_resamplingMethod == "Ellipse")
+  else if (_resamplingMethod == "Multi Ellipse")
   {
-    updateEllipse(_ellipseVector.front());
+    updateMultiEllipse();
   }
-  else /* _resamplingMethod == "Multi Ellipse" */
+  else /* _resamplingMethod == "Ellipse" || _resamplingMethod == "Slice" || _resamplingMethod == "Random Walk" */
   {
-    updateMultiEllipse();
+    updateEllipse(_ellipseVector.front());
   }
 }
 
@@ -302,6 +341,8 @@ void Nested::generateCandidates()
 
 bool Nested::processGeneration()
 {
+  if (_dynamicFillCount < _numberLivePoints) return fillDynamicBatch();
+
   size_t sampleIdx = _liveSamplesRank[0];
   size_t acceptedBefore = _acceptedSamples;
 
@@ -320,16 +361,20 @@ bool Nested::processGeneration()
 
     _logVolume -= _expectedLogShrinkage;
 
-    double dLogVol = std::log(0.5 * std::exp(logVolumeOld) - 0.5 * std::exp(_logVolume));
-    _logWeight = safeLogPlus(_lStar, _lStarOld) + dLogVol;
-    _logEvidence = safeLogPlus(_logEvidence, _logWeight);
+    // The evidence of dynamic batches is updated by merging all runs at the end of the batch
+    if (_dynamicBatch == 0)
+    {
+      double dLogVol = std::log(0.5 * std::exp(logVolumeOld) - 0.5 * std::exp(_logVolume));
+      _logWeight = safeLogPlus(_lStar, _lStarOld) + dLogVol;
+      _logEvidence = safeLogPlus(_logEvidence, _logWeight);
 
-    double evidenceTerm = std::exp(_lStarOld - _logEvidence) * _lStarOld + std::exp(_lStar - _logEvidence) * _lStar;
+      double evidenceTerm = std::exp(_lStarOld - _logEvidence) * _lStarOld + std::exp(_lStar - _logEvidence) * _lStar;
 
-    if (isfinite(evidenceTerm))
-    {
-      _information = std::exp(dLogVol) * evidenceTerm + std::exp(logEvidenceOld - _logEvidence) * (informationOld + logEvidenceOld) - _logEvidence;
-      _logEvidenceVar += 2. * (_information - informationOld) * _expectedLogShrinkage;
+      if (isfinite(evidenceTerm))
+      {
+        _information = std::exp(dLogVol) * evidenceTerm + std::exp(logEvidenceOld - _logEvidence) * (informationOld + logEvidenceOld) - _logEvidence;
+        _logEvidenceVar += 2. * (_information - informationOld) * _expectedLogShrinkage;
+      }
     }
 
     // Add candidate to dead samples
@@ -339,10 +384,11 @@ bool Nested::processGeneration()
     }
 
     // Replace worst sample from live samples by candidate
-    _liveSamples[sampleIdx] = _candidates[c];
+    std::copy(_candidates[c].begin(), _candidates[c].end(), _liveSamples.begin() + sampleIdx * _variableCount);
     _liveLogPriors[sampleIdx] = _candidateLogPriors[c];
     _liveLogPriorWeights[sampleIdx] = _candidateLogPriorWeights[c];
     _liveLogLikelihoods[sampleIdx] = _candidateLogLikelihoods[c];
+    _liveBirthLStars[sampleIdx] = _lStar;
 
     // Sort rank vector
     sortLiveSamplesAscending();
@@ -362,9 +408,22 @@ bool Nested::processGeneration()
   const size_t maxRank = _liveSamplesRank[_numberLivePoints - 1];
   _maxEvaluation = _liveLogPriorWeights[maxRank] + _liveLogLikelihoods[maxRank];
   _remainingLogEvidence = _maxEvaluation + _logVolume;
-  _logEvidenceDifference = safeLogPlus(_logEvidence, _remainingLogEvidence) - _logEvidence;
+  const double logEvidenceDifference = safeLogPlus(_logEvidence, _remainingLogEvidence) - _logEvidence;
   setBoundsVolume();
 
+  if (_dynamicBatch == 0)
+  {
+    _logEvidenceDifference = logEvidenceDifference;
+
+    // The baseline run is complete, continue with the dynamic batches
+    if ((_dynamicBatchCount > 0) && (_logEvidenceDifference <= _minLogEvidenceDelta)) finishDynamicBatch();
+  }
+  else
+  {
+    // The batch is complete once it reached its upper bound or its remaining evidence is negligible
+    if ((_lStar >= _dynamicUpperBound) || (logEvidenceDifference <= _minLogEvidenceDelta)) finishDynamicBatch();
+  }
+
   _lastAccepted++;
   return (acceptedBefore != _acceptedSamples);
 }
@@ -390,19 +449,19 @@ void Nested::setBoundsVolume()
     for (size_t d = 0; d < _variableCount; ++d)
       _boundLogVolume = safeLogPlus(_boundLogVolume, std::log(_boxUpperBound[d] - _boxLowerBound[d]));
   }
-  else if (_resamplingMethod == "Ellipse")
-  {
-    // Calculate volume of ellipsoid
-    auto &ellipse = _ellipseVector.front();
-    _boundLogVolume = std::log(ellipse.volume);
-  }
-  else /* _resamplingMethod == "Multi Ellipse" */
+  else if (_resamplingMethod == "Multi Ellipse")
   {
     // Calculate volume of (overlapping) ellipsoids
     _boundLogVolume = Lowest;
     for (auto &ellipse : _ellipseVector)
       _boundLogVolume = safeLogPlus(_boundLogVolume, std::log(ellipse.volume));
   }
+  else /* _resamplingMethod == "Ellipse" || _resamplingMethod == "Slice" || _resamplingMethod == "Random Walk" */
+  {
+    // Calculate volume of ellipsoid
+    auto &ellipse = _ellipseVector.front();
+    _boundLogVolume = std::log(ellipse.volume);
+  }
 }
 
 void Nested::generateCandidatesFromBox()
@@ -496,6 +555,229 @@ void Nested::generateCandidatesFromMultiEllipse()
   }
 }
 
+void Nested::generateCandidatesFromChains()
+{
+  for (auto &chain : _chainVector) initChain(chain);
+
+  // Evolving all chains in lockstep, each active chain evaluates one proposal per round
+  std::vector<bool> isActive(_batchSize, true);
+  size_t activeChains = _batchSize;
+  std::vector<double> sample;
+
+  while (activeChains > 0)
+  {
+    // Chains that run out of steps without a proposal inside the domain finish without evaluating
+    std::vector<size_t> proposingChains;
+    for (size_t c = 0; c < _batchSize; c++)
+    {
+      if (isActive[c] == false) continue;
+
+      if (proposeFromChain(_chainVector[c]) == false)
+      {
+        isActive[c] = false;
+        activeChains--;
+        continue;
+      }
+
+      proposingChains.push_back(c);
+    }
+
+    std::vector<Sample> samples(proposingChains.size());
+    for (size_t s = 0; s < proposingChains.size(); s++)
+    {
+      const size_t c = proposingChains[s];
+
+      samples[s]["Module"] = "Problem";
+      samples[s]["Operation"] = "Evaluate";
+      sample = _chainVector[c].proposal;
+      priorTransform(sample);
+      samples[s]["Parameters"] = sample;
+      samples[s]["Sample Id"] = c;
+      KORALI_START(samples[s]);
+      _modelEvaluationCount++;
+      _generatedSamples++;
+    }
+
+    KORALI_WAITALL(samples);
+
+    for (size_t s = 0; s < proposingChains.size(); s++)
+    {
+      auto &chain = _chainVector[proposingChains[s]];
+      auto parameters = KORALI_GET(std::vector<double>, samples[s], "Parameters");
+      chain.proposalLogPrior = KORALI_GET(double, samples[s], "logPrior");
+      chain.proposalLogPriorWeight = logPriorWeight(parameters);
+      chain.proposalLogLikelihood = KORALI_GET(double, samples[s], "logLikelihood");
+
+      updateChain(chain, chain.proposalLogLikelihood >= _lStar);
+    }
+  }
+
+  // The final positions of the chains are the candidates
+  size_t acceptedSteps = 0;
+  size_t rejectedSteps = 0;
+  for (size_t c = 0; c < _batchSize; c++)
+  {
+    const auto &chain = _chainVector[c];
+    _candidates[c] = chain.position;
+    _candidateLogLikelihoods[c] = chain.logLikelihood;
+    _candidateLogPriors[c] = chain.logPrior;
+    _candidateLogPriorWeights[c] = chain.logPriorWeight;
+
+    acceptedSteps += chain.acceptedSteps;
+    rejectedSteps += chain.rejectedSteps;
+  }
+
+  // Adapt the random walk steps to balance accepted and rejected proposals
+  if (_resamplingMethod == "Random Walk")
+  {
+    if (acceptedSteps > rejectedSteps) _randomWalkScale *= std::exp(1. / (double)acceptedSteps);
+    if (acceptedSteps < rejectedSteps) _randomWalkScale /= std::exp(1. / (double)rejectedSteps);
+  }
+}
+
+void Nested::initChain(chain_t &chain)
+{
+  // Start at a random live sample, which fulfills the likelihood constraint
+  const size_t sampleIdx = std::min((size_t)(_uniformGenerator->getRandomNumber() * _numberLivePoints), _numberLivePoints - 1);
+
+  std::copy(_liveSamples.begin() + sampleIdx * _variableCount, _liveSamples.begin() + (sampleIdx + 1) * _variableCount, chain.position.begin());
+  chain.logLikelihood = _liveLogLikelihoods[sampleIdx];
+  chain.logPrior = _liveLogPriors[sampleIdx];
+  chain.logPriorWeight = _liveLogPriorWeights[sampleIdx];
+
+  chain.remainingSteps = _proposalSteps;
+  chain.acceptedSteps = 0;
+  chain.rejectedSteps = 0;
+
+  if (_resamplingMethod == "Slice") initSlice(chain);
+}
+
+void Nested::initSlice(chain_t &chain)
+{
+  const auto &ellipse = _ellipseVector.front();
+
+  // Random direction, scaled to the bounding ellipse
+  double len = 0.;
+  std::vector<double> vec(_variableCount);
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    vec[d] = _normalGenerator->getRandomNumber();
+    len += vec[d] * vec[d];
+  }
+  len = std::sqrt(len);
+
+  for (size_t k = 0; k < _variableCount; ++k)
+  {
+    chain.direction[k] = 0.;
+    for (size_t l = 0; l < k + 1; ++l) chain.direction[k] += ellipse.axes[k * _variableCount + l] * vec[l] / len;
+  }
+
+  // Unit interval randomly placed around the position
+  chain.left = -_uniformGenerator->getRandomNumber();
+  chain.right = chain.left + 1.;
+  chain.stage = slice_stage_t::stepOutLeft;
+}
+
+bool Nested::proposeFromChain(chain_t &chain)
+{
+  while (chain.remainingSteps > 0)
+  {
+    if (_resamplingMethod == "Random Walk")
+    {
+      // Step uniformly inside the scaled bounding ellipse centered at the position
+      std::vector<double> step(_variableCount);
+      generateSampleFromEllipse(_ellipseVector.front(), step);
+      for (size_t d = 0; d < _variableCount; ++d)
+        chain.proposal[d] = chain.position[d] + _randomWalkScale * (step[d] - _ellipseVector.front().mean[d]);
+    }
+    else /* _resamplingMethod == "Slice" */
+    {
+      if (chain.stage == slice_stage_t::stepOutLeft)
+        chain.step = chain.left;
+      else if (chain.stage == slice_stage_t::stepOutRight)
+        chain.step = chain.right;
+      else /* chain.stage == slice_stage_t::shrink */
+        chain.step = chain.left + _uniformGenerator->getRandomNumber() * (chain.right - chain.left);
+
+      for (size_t d = 0; d < _variableCount; ++d)
+        chain.proposal[d] = chain.position[d] + chain.step * chain.direction[d];
+    }
+
+    if (insideUnitCube(chain.proposal)) return true;
+
+    // Proposals outside of the domain violate the constraint
+    updateChain(chain, false);
+  }
+
+  return false;
+}
+
+void Nested::updateChain(chain_t &chain, bool accepted)
+{
+  if (_resamplingMethod == "Random Walk")
+  {
+    if (accepted)
+    {
+      chain.position = chain.proposal;
+      chain.logLikelihood = chain.proposalLogLikelihood;
+      chain.logPrior = chain.proposalLogPrior;
+      chain.logPriorWeight = chain.proposalLogPriorWeight;
+      chain.acceptedSteps++;
+    }
+    else
+      chain.rejectedSteps++;
+
+    chain.remainingSteps--;
+    return;
+  }
+
+  /* _resamplingMethod == "Slice" */
+  if (chain.stage == slice_stage_t::stepOutLeft)
+  {
+    if (accepted)
+      chain.left -= 1.;
+    else
+      chain.stage = slice_stage_t::stepOutRight;
+  }
+  else if (chain.stage == slice_stage_t::stepOutRight)
+  {
+    if (accepted)
+      chain.right += 1.;
+    else
+      chain.stage = slice_stage_t::shrink;
+  }
+  else /* chain.stage == slice_stage_t::shrink */
+  {
+    if (accepted)
+    {
+      chain.position = chain.proposal;
+      chain.logLikelihood = chain.proposalLogLikelihood;
+      chain.logPrior = chain.proposalLogPrior;
+      chain.logPriorWeight = chain.proposalLogPriorWeight;
+      chain.acceptedSteps++;
+
+      // Continue with the next move
+      chain.remainingSteps--;
+      if (chain.remainingSteps > 0) initSlice(chain);
+    }
+    else
+    {
+      chain.rejectedSteps++;
+      if (chain.step < 0.)
+        chain.left = chain.step;
+      else
+        chain.right = chain.step;
+
+      // The interval collapsed onto the position, the move ends without moving
+      if (chain.right - chain.left < 1e-12)
+      {
+        chain.remainingSteps--;
+        if (chain.remainingSteps > 0) initSlice(chain);
+      }
+    }
+  }
+}
+
 void Nested::updateBox()
 {
   for (size_t d = 0; d < _variableCount; d++) _boxLowerBound[d] = Max;
@@ -504,8 +786,8 @@ void Nested::updateBox()
   for (size_t i = 0; i < _numberLivePoints; i++)
     for (size_t d = 0; d < _variableCount; d++)
     {
-      _boxLowerBound[d] = std::min(_boxLowerBound[d], _liveSamples[i][d]);
-      _boxUpperBound[d] = std::max(_boxUpperBound[d], _liveSamples[i][d]);
+      _boxLowerBound[d] = std::min(_boxLowerBound[d], _liveSamples[i * _variableCount + d]);
+      _boxUpperBound[d] = std::max(_boxUpperBound[d], _liveSamples[i * _variableCount + d]);
     }
 }
 
@@ -524,15 +806,17 @@ void Nested::sortLiveSamplesAscending()
 void Nested::updateDeadSamples(size_t sampleIdx)
 {
   _numberDeadSamples++;
-  _deadSamples.push_back(_liveSamples[sampleIdx]);
+  _deadSamples.emplace_back(_liveSamples.begin() + sampleIdx * _variableCount, _liveSamples.begin() + (sampleIdx + 1) * _variableCount);
   priorTransform(_deadSamples.back());
 
   _deadLogPriors.push_back(_liveLogPriors[sampleIdx]);
   _deadLogPriorWeights.push_back(_liveLogPriorWeights[sampleIdx]);
   _deadLogLikelihoods.push_back(_liveLogLikelihoods[sampleIdx]);
   _deadLogWeights.push_back(_logWeight);
+  _deadBirthLStars.push_back(_liveBirthLStars[sampleIdx]);
 
-  updateEffectiveSamples();
+  // The weights of dynamic batches are only known after merging all runs
+  if (_dynamicBatch == 0) updateEffectiveSamples();
 }
 
 void Nested::consumeLiveSamples()
@@ -583,6 +867,234 @@ void Nested::consumeLiveSamples()
   }
 }
 
+bool Nested::fillDynamicBatch()
+{
+  size_t acceptedBefore = _acceptedSamples;
+
+  // Fill the live samples of the batch with candidates above the lower bound
+  for (size_t c = 0; c < _batchSize; ++c)
+  {
+    if (_dynamicFillCount == _numberLivePoints) break;
+    if (_candidateLogLikelihoods[c] < _lStar) continue; // Ignore candidate
+
+    _acceptedSamples++;
+
+    const size_t sampleIdx = _dynamicFillCount++;
+    std::copy(_candidates[c].begin(), _candidates[c].end(), _liveSamples.begin() + sampleIdx * _variableCount);
+    _liveLogPriors[sampleIdx] = _candidateLogPriors[c];
+    _liveLogPriorWeights[sampleIdx] = _candidateLogPriorWeights[c];
+    _liveLogLikelihoods[sampleIdx] = _candidateLogLikelihoods[c];
+    _liveBirthLStars[sampleIdx] = _dynamicLowerBound;
+  }
+
+  // Batch filled, continue with regular nested sampling
+  if (_dynamicFillCount == _numberLivePoints)
+  {
+    sortLiveSamplesAscending();
+
+    const size_t minRank = _liveSamplesRank[0];
+    _lStarOld = _lStar;
+    if (isfinite(_liveLogPriorWeights[minRank] + _liveLogLikelihoods[minRank])) _lStar = _liveLogPriorWeights[minRank] + _liveLogLikelihoods[minRank];
+    const size_t maxRank = _liveSamplesRank[_numberLivePoints - 1];
+    _maxEvaluation = _liveLogPriorWeights[maxRank] + _liveLogLikelihoods[maxRank];
+    setBoundsVolume();
+  }
+
+  return (acceptedBefore != _acceptedSamples);
+}
+
+void Nested::startDynamicBatch()
+{
+  // Enforce an update of the bounds for the new live samples
+  _nextUpdate = _generatedSamples;
+  _lastUpdateLogVolume = Max;
+  _logEvidenceDifference = Max;
+
+  if (_dynamicLowerBound == Lowest)
+  {
+    // Batch starts from the prior
+    _lStarOld = Lowest;
+    _lStar = Lowest;
+    _logVolume = 0.;
+    runFirstGeneration();
+    _dynamicFillCount = _numberLivePoints;
+    return;
+  }
+
+  // Seed the live samples with the dead samples closest above the lower bound
+  std::vector<size_t> seeds;
+  for (size_t i = 0; i < _numberDeadSamples; ++i)
+    if (_deadLogPriorWeights[i] + _deadLogLikelihoods[i] > _dynamicLowerBound) seeds.push_back(i);
+
+  if (seeds.empty()) KORALI_LOG_ERROR("No dead samples above lower bound %lf of dynamic batch %zu.\n", _dynamicLowerBound, _dynamicBatch);
+
+  const size_t seedCount = std::min(seeds.size(), _numberLivePoints);
+  std::partial_sort(seeds.begin(), seeds.begin() + seedCount, seeds.end(), [this](const size_t &idx1, const size_t &idx2) -> bool
+                    {
+                      return this->_deadLogPriorWeights[idx1] + this->_deadLogLikelihoods[idx1] < this->_deadLogPriorWeights[idx2] + this->_deadLogLikelihoods[idx2];
+                    });
+
+  for (size_t i = 0; i < _numberLivePoints; ++i)
+  {
+    const size_t deadIdx = seeds[i % seedCount];
+
+    // Transformation from bounded domain to unit hypercube
+    for (size_t d = 0; d < _variableCount; ++d) _liveSamples[i * _variableCount + d] = (_deadSamples[deadIdx][d] - _priorLowerBound[d]) / _priorWidth[d];
+    _liveLogPriors[i] = _deadLogPriors[deadIdx];
+    _liveLogPriorWeights[i] = _deadLogPriorWeights[deadIdx];
+    _liveLogLikelihoods[i] = _deadLogLikelihoods[deadIdx];
+    _liveBirthLStars[i] = _dynamicLowerBound;
+  }
+
+  sortLiveSamplesAscending();
+
+  _lStarOld = _dynamicLowerBound;
+  _lStar = _dynamicLowerBound;
+  _logVolume = _dynamicLowerLogVolume;
+  _dynamicFillCount = 0;
+}
+
+void Nested::finishDynamicBatch()
+{
+  consumeDynamicLiveSamples();
+  updateDynamicEvidence();
+
+  _dynamicBatch++;
+  _k->_logger->logInfo("Normal", "Dynamic batch %zu/%zu: log likelihood bounds [%.2f, %.2f]\n", _dynamicBatch, _dynamicBatchCount, _dynamicLowerBound, _dynamicUpperBound);
+
+  if (_dynamicBatch <= _dynamicBatchCount)
+    startDynamicBatch();
+  else
+    _logEvidenceDifference = 0.;
+}
+
+void Nested::consumeDynamicLiveSamples()
+{
+  // Add remaining live samples to dead samples in ascending order, weights are assigned when merging the runs
+  for (size_t i = 0; i < _dynamicFillCount; ++i)
+  {
+    const size_t sampleIdx = (_dynamicFillCount == _numberLivePoints) ? _liveSamplesRank[i] : i;
+    if (isfinite(_liveLogPriorWeights[sampleIdx] + _liveLogLikelihoods[sampleIdx]))
+    {
+      _lStarOld = _lStar;
+      _lStar = _liveLogPriorWeights[sampleIdx] + _liveLogLikelihoods[sampleIdx];
+      updateDeadSamples(sampleIdx);
+    }
+  }
+  _dynamicFillCount = _numberLivePoints;
+}
+
+void Nested::updateDynamicEvidence()
+{
+  const size_t numSamples = _numberDeadSamples;
+
+  // Sort dead samples of all runs ascending
+  std::vector<double> keys(numSamples);
+  for (size_t i = 0; i < numSamples; ++i) keys[i] = _deadLogPriorWeights[i] + _deadLogLikelihoods[i];
+
+  std::vector<size_t> rank(numSamples);
+  std::iota(rank.begin(), rank.end(), 0);
+  std::sort(rank.begin(), rank.end(), [&keys](const size_t &idx1, const size_t &idx2) -> bool { return keys[idx1] < keys[idx2]; });
+
+  std::vector<double> sortedKeys(numSamples);
+  for (size_t i = 0; i < numSamples; ++i) sortedKeys[i] = keys[rank[i]];
+  std::vector<double> sortedBirths(_deadBirthLStars);
+  std::sort(sortedBirths.begin(), sortedBirths.end());
+
+  // Recompute evidence, volumes and weights with the number of live samples at each death
+  std::vector<double> logVolumes(numSamples);
+  std::vector<double> logEvidences(numSamples);
+  std::vector<double> liveCounts(numSamples);
+
+  _logEvidence = Lowest;
+  _information = 0.;
+  _logEvidenceVar = 0.;
+
+  double logVolume = 0.;
+  double lStarOld = Lowest;
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    const double lStar = sortedKeys[i];
+    const size_t born = std::lower_bound(sortedBirths.begin(), sortedBirths.end(), lStar) - sortedBirths.begin();
+    const size_t died = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), lStar) - sortedKeys.begin();
+    const double n = (born > died) ? (double)(born - died) : 1.;
+
+    const double logEvidenceOld = _logEvidence;
+    const double informationOld = _information;
+
+    const double dLogVol = logVolume + std::log(0.5 / (n + 1.));
+    logVolume += std::log(n / (n + 1.));
+
+    const double logWeight = safeLogPlus(lStar, lStarOld) + dLogVol;
+    _logEvidence = safeLogPlus(_logEvidence, logWeight);
+
+    const double evidenceTerm = std::exp(lStarOld - _logEvidence) * lStarOld + std::exp(lStar - _logEvidence) * lStar;
+
+    if (isfinite(evidenceTerm))
+    {
+      _information = std::exp(dLogVol) * evidenceTerm + std::exp(logEvidenceOld - _logEvidence) * (informationOld + logEvidenceOld) - _logEvidence;
+      _logEvidenceVar += 2. * (_information - informationOld) * std::log((n + 1.) / n);
+    }
+
+    _deadLogWeights[rank[i]] = logWeight;
+    logVolumes[i] = logVolume;
+    logEvidences[i] = logEvidenceOld;
+    liveCounts[i] = n;
+    lStarOld = lStar;
+  }
+  _logVolume = logVolume;
+
+  // Recompute effective sample size
+  _sumLogWeights = Lowest;
+  _sumSquareLogWeights = Lowest;
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    _sumLogWeights = safeLogPlus(_sumLogWeights, _deadLogWeights[i]);
+    _sumSquareLogWeights = safeLogPlus(_sumSquareLogWeights, 2. * _deadLogWeights[i]);
+  }
+  _effectiveSampleSize = std::exp(2. * _sumLogWeights - _sumSquareLogWeights);
+
+  // Importance of each dead sample for the posterior and the evidence
+  std::vector<double> posteriorImportance(numSamples);
+  std::vector<double> evidenceImportance(numSamples);
+  double sumPosteriorImportance = 0.;
+  double sumEvidenceImportance = 0.;
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    posteriorImportance[i] = std::exp(_deadLogWeights[rank[i]] - _logEvidence);
+    evidenceImportance[i] = (1. - std::exp(logEvidences[i] - _logEvidence)) / liveCounts[i];
+    sumPosteriorImportance += posteriorImportance[i];
+    sumEvidenceImportance += evidenceImportance[i];
+  }
+
+  std::vector<double> importance(numSamples);
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    importance[i] = 0.;
+    if (sumPosteriorImportance > 0.) importance[i] += _dynamicPosteriorFraction * posteriorImportance[i] / sumPosteriorImportance;
+    if (sumEvidenceImportance > 0.) importance[i] += (1. - _dynamicPosteriorFraction) * evidenceImportance[i] / sumEvidenceImportance;
+  }
+
+  // Next batch covers the region of highest importance, padded by one sample on each side
+  const double maxImportance = *std::max_element(importance.begin(), importance.end());
+  size_t first = numSamples - 1;
+  size_t last = 0;
+  for (size_t i = 0; i < numSamples; ++i)
+    if (importance[i] >= _dynamicImportanceThreshold * maxImportance)
+    {
+      first = std::min(first, i);
+      last = std::max(last, i);
+    }
+
+  // Leave enough dead samples above the lower bound to seed the batch
+  if (numSamples > _numberLivePoints) first = std::min(first, numSamples - _numberLivePoints);
+  else first = 0;
+
+  _dynamicLowerBound = (first > 0) ? sortedKeys[first - 1] : Lowest;
+  _dynamicLowerLogVolume = (first > 0) ? logVolumes[first - 1] : 0.;
+  _dynamicUpperBound = (last + 1 < numSamples) ? sortedKeys[last + 1] : Max;
+}
+
 void Nested::generatePosterior()
 {
   double maxLogWtDb = *max_element(std::begin(_deadLogWeights), std::end(_deadLogWeights));
@@ -617,15 +1129,6 @@ void Nested::generatePosterior()
   (*_k)["Results"]["Posterior Samples LogLikelihood Database"] = posteriorSamplesLogLikelihoodDatabase;
 }
 
-double Nested::l2distance(const std::vector<double> &sampleOne, const std::vector<double> &sampleTwo) const
-{
-  double dist = 0.;
-  // Calculate L2 distance
-  for (size_t d = 0; d < _variableCount; ++d) dist += (sampleOne[d] - sampleTwo[d]) * (sampleOne[d] - sampleTwo[d]);
-  dist = std::sqrt(dist);
-  return dist;
-}
-
 bool Nested::updateEllipse(ellipse_t &ellipse) const
 {
   if (ellipse.num == 0) return false;
@@ -693,11 +1196,10 @@ void Nested::updateEllipseMean(ellipse_t &ellipse) const
   std::fill(ellipse.mean.begin(), ellipse.mean.end(), 0.);
 
   for (size_t i = 0; i < ellipse.num; ++i)
-    for (size_t d = 0; d < _variableCount; ++d)
-    {
-      size_t sidx = ellipse.sampleIdx[i];
-      ellipse.mean[d] += _liveSamples[sidx][d];
-    }
+  {
+    const double *sample = &_liveSamples[ellipse.sampleIdx[i] * _variableCount];
+    for (size_t d = 0; d < _variableCount; ++d) ellipse.mean[d] += sample[d];
+  }
 
   if (ellipse.num > 0)
     for (size_t d = 0; d < _variableCount; ++d)
@@ -708,64 +1210,44 @@ bool Nested::updateEllipseCov(ellipse_t &ellipse) const
 {
   double weight = 1. / (ellipse.num - 1.);
 
+  // Gather the centered samples of the ellipse contiguously
+  std::vector<double> centered(ellipse.num * _variableCount);
+  for (size_t k = 0; k < ellipse.num; ++k)
+  {
+    const double *sample = &_liveSamples[ellipse.sampleIdx[k] * _variableCount];
+    for (size_t d = 0; d < _variableCount; ++d) centered[k * _variableCount + d] = sample[d] - ellipse.mean[d];
+  }
+
+  std::fill(ellipse.cov.begin(), ellipse.cov.end(), 0.);
   if (ellipse.num <= ellipse.dim)
   {
     // update variance
-    std::fill(ellipse.cov.begin(), ellipse.cov.end(), 0.);
-    std::fill(ellipse.invCov.begin(), ellipse.invCov.end(), 0.);
     for (size_t d = 0; d < _variableCount; ++d)
     {
       double c = 0.;
-      for (size_t k = 0; k < ellipse.num; ++k)
-      {
-        size_t sidx = ellipse.sampleIdx[k];
-        c += (_liveSamples[sidx][d] - ellipse.mean[d]) * (_liveSamples[sidx][d] - ellipse.mean[d]);
-        ellipse.cov[d * _variableCount + d] = (ellipse.num == 1) ? 1. : weight * c;
-        ellipse.invCov[d * _variableCount + d] = (ellipse.num == 1) ? 1. : 1. / (weight * c);
-      }
+      for (size_t k = 0; k < ellipse.num; ++k) c += centered[k * _variableCount + d] * centered[k * _variableCount + d];
+      ellipse.cov[d * _variableCount + d] = (ellipse.num == 1) ? 1. : weight * c;
     }
   }
   else
   {
-    // update covariance
-    for (size_t i = 0; i < _variableCount; ++i)
-    {
-      for (size_t j = i; j < _variableCount; ++j)
-      {
-        double c = 0.;
-        for (size_t k = 0; k < ellipse.num; ++k)
-        {
-          size_t sidx = ellipse.sampleIdx[k];
-          c += (_liveSamples[sidx][i] - ellipse.mean[i]) * (_liveSamples[sidx][j] - ellipse.mean[j]);
-        }
-        ellipse.cov[j * _variableCount + i] = ellipse.cov[i * _variableCount + j] = weight * c;
-      }
-    }
-
-    // update inverse covariance
+    // update covariance (lower triangle) and mirror it
+    gsl_matrix_view samples = gsl_matrix_view_array(centered.data(), ellipse.num, _variableCount);
     gsl_matrix_view cov = gsl_matrix_view_array(ellipse.cov.data(), _variableCount, _variableCount);
+    gsl_blas_dsyrk(CblasLower, CblasTrans, weight, &samples.matrix, 0., &cov.matrix);
 
-    gsl_matrix *matLU = gsl_matrix_alloc(_variableCount, _variableCount);
-    gsl_matrix_memcpy(matLU, &cov.matrix);
-
-    int signal;
-    gsl_permutation *perm = gsl_permutation_alloc(_variableCount);
-    gsl_linalg_LU_decomp(matLU, perm, &signal);
-
-    std::fill(ellipse.invCov.begin(), ellipse.invCov.end(), 0.);
-    gsl_matrix_view invCov = gsl_matrix_view_array(ellipse.invCov.data(), _variableCount, _variableCount);
+    for (size_t i = 0; i < _variableCount; ++i)
+      for (size_t j = i + 1; j < _variableCount; ++j)
+        ellipse.cov[i * _variableCount + j] = ellipse.cov[j * _variableCount + i];
+  }
 
-    gsl_linalg_LU_invert(matLU, perm, &invCov.matrix);
-    gsl_permutation_free(perm);
-    gsl_matrix_free(matLU);
+  // The cholesky factor is kept as axes of the ellipse, it provides the determinant, the samples and the Mahalanobis distances
+  std::copy(ellipse.cov.begin(), ellipse.cov.end(), ellipse.axes.begin());
+  gsl_matrix_view axes = gsl_matrix_view_array(ellipse.axes.data(), _variableCount, _variableCount);
+  if (gsl_linalg_cholesky_decomp1(&axes.matrix) != GSL_SUCCESS) return false; // LL^T = A
 
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (status != 0)
-    //    {
-    //      _k->_logger->logWarning("Normal", "Covariance inversion failed during ellipsoid covariance update.\n");
-    //      return false;
-    //    }
-  }
+  ellipse.det = 1.;
+  for (size_t d = 0; d < _variableCount; ++d) ellipse.det *= ellipse.axes[d * _variableCount + d] * ellipse.axes[d * _variableCount + d];
 
   return true;
 }
@@ -775,94 +1257,27 @@ bool Nested::updateEllipseVolume(ellipse_t &ellipse) const
   if (ellipse.num == 0) return false;
 
   gsl_matrix_view cov = gsl_matrix_view_array(ellipse.cov.data(), _variableCount, _variableCount);
-
-  gsl_matrix *matLU = gsl_matrix_alloc(_variableCount, _variableCount);
-  gsl_matrix_memcpy(matLU, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    gsl_matrix_free(matLU);
-  //    return false;
-  //  }
-
-  int signal;
-  gsl_permutation *perm = gsl_permutation_alloc(_variableCount);
-  gsl_linalg_LU_decomp(matLU, perm, &signal);
-  gsl_permutation_free(perm);
-
-  ellipse.det = gsl_linalg_LU_det(matLU, signal);
-  gsl_matrix_free(matLU);
-
   gsl_vector_view evals = gsl_vector_view_array(ellipse.evals.data(), _variableCount);
   gsl_matrix_view paxes = gsl_matrix_view_array(ellipse.paxes.data(), _variableCount, _variableCount);
 
-  gsl_matrix *matEigen = gsl_matrix_alloc(_variableCount, _variableCount);
-  gsl_matrix_memcpy(matEigen, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    gsl_matrix_free(matEigen);
-  //    return false;
-  //  }
-
-  gsl_eigen_symmv_workspace *workEigen = gsl_eigen_symmv_alloc(_variableCount);
-  gsl_eigen_symmv(matEigen, &evals.vector, &paxes.matrix, workEigen);
-  gsl_matrix_free(matEigen);
-  gsl_eigen_symmv_free(workEigen);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Eigenvalue Decomposition failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
-
-  gsl_eigen_symmv_sort(&evals.vector, &paxes.matrix, GSL_EIGEN_SORT_ABS_DESC);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Eigenvalue sorting failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
-
-  // Calculate axes from cholesky decomposition
-  gsl_matrix_view axes = gsl_matrix_view_array(ellipse.axes.data(), _variableCount, _variableCount);
-
-  /* On output the diagonal and lower triangular part of the
-   * input matrix A contain the matrix L, while the upper triangular part
-   * contains the original matrix. */
-
-  gsl_matrix_memcpy(&axes.matrix, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
+  // The principal axes are only needed to initialize the clustering of Multi Ellipse
+  if (_resamplingMethod == "Multi Ellipse")
+  {
+    gsl_matrix *matEigen = gsl_matrix_alloc(_variableCount, _variableCount);
+    gsl_matrix_memcpy(matEigen, &cov.matrix);
 
-  gsl_linalg_cholesky_decomp1(&axes.matrix); // LL^T = A
+    gsl_eigen_symmv_workspace *workEigen = gsl_eigen_symmv_alloc(_variableCount);
+    gsl_eigen_symmv(matEigen, &evals.vector, &paxes.matrix, workEigen);
+    gsl_matrix_free(matEigen);
+    gsl_eigen_symmv_free(workEigen);
 
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Cholesky Decomposition failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
+    gsl_eigen_symmv_sort(&evals.vector, &paxes.matrix, GSL_EIGEN_SORT_ABS_DESC);
+  }
 
   // Find scaling s.t. all samples are bounded by ellipse
-  double res, max = Lowest;
-  for (size_t i = 0; i < ellipse.num; ++i)
-  {
-    size_t six = ellipse.sampleIdx[i];
-    res = mahalanobisDistance(_liveSamples[six], ellipse);
-    if (res > max) max = res;
-  }
+  std::vector<double> distances(ellipse.num);
+  mahalanobisDistances(ellipse, distances);
+  double max = *std::max_element(distances.begin(), distances.end());
 
   ellipse.pointVolume = std::exp(_logVolume) * (double)ellipse.num / ((double)_numberLivePoints);
 
@@ -872,11 +1287,10 @@ bool Nested::updateEllipseVolume(ellipse_t &ellipse) const
   double enlargementFactor = vol > ellipse.pointVolume ? _ellipsoidalScaling * max : std::pow((ellipse.pointVolume * ellipse.pointVolume) / (K * K * ellipse.det), 1. / ((double)_variableCount));
   ellipse.volume = std::pow(enlargementFactor, _variableCount / 2.) * sqrt(ellipse.det) * K;
 
-  gsl_matrix_view invCov = gsl_matrix_view_array(ellipse.invCov.data(), _variableCount, _variableCount);
+  gsl_matrix_view axes = gsl_matrix_view_array(ellipse.axes.data(), _variableCount, _variableCount);
 
   // resize volume
   gsl_matrix_scale(&cov.matrix, enlargementFactor);
-  gsl_matrix_scale(&invCov.matrix, 1. / enlargementFactor);
   gsl_vector_scale(&evals.vector, enlargementFactor);
   gsl_matrix_scale(&axes.matrix, sqrt(enlargementFactor));
 
@@ -888,18 +1302,37 @@ double Nested::mahalanobisDistance(const std::vector<double> &sample, const elli
   std::vector<double> dif(_variableCount);
   for (size_t d = 0; d < _variableCount; ++d) dif[d] = sample[d] - ellipse.mean[d];
 
-  double tmp;
+  // Calculate Mahalanobis distance between sample and ellipsoid, |L^-1 (x - mean)|^2 with the cholesky factor L
+  gsl_matrix_const_view axes = gsl_matrix_const_view_array(ellipse.axes.data(), _variableCount, _variableCount);
+  gsl_vector_view difView = gsl_vector_view_array(dif.data(), _variableCount);
+  gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, &axes.matrix, &difView.vector);
+
   double dist = 0.;
-  // Calculate Mahalanobis distance between sample and ellipsoid
-  for (size_t i = 0; i < _variableCount; ++i)
+  for (size_t d = 0; d < _variableCount; ++d) dist += dif[d] * dif[d];
+  return dist;
+}
+
+void Nested::mahalanobisDistances(const ellipse_t &ellipse, std::vector<double> &distances) const
+{
+  std::vector<double> dif(ellipse.num * _variableCount);
+  for (size_t i = 0; i < ellipse.num; ++i)
   {
-    tmp = 0.;
-    for (size_t j = 0; j < _variableCount; ++j)
-      tmp += dif[j] * ellipse.invCov[i + _variableCount * j];
-    tmp *= dif[i];
-    dist += tmp;
+    const double *sample = &_liveSamples[ellipse.sampleIdx[i] * _variableCount];
+    for (size_t d = 0; d < _variableCount; ++d) dif[i * _variableCount + d] = sample[d] - ellipse.mean[d];
+  }
+
+  // Solving for all samples at once, rows of (X - mean) L^-T
+  gsl_matrix_const_view axes = gsl_matrix_const_view_array(ellipse.axes.data(), _variableCount, _variableCount);
+  gsl_matrix_view difView = gsl_matrix_view_array(dif.data(), ellipse.num, _variableCount);
+  gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1., &axes.matrix, &difView.matrix);
+
+  distances.resize(ellipse.num);
+  for (size_t i = 0; i < ellipse.num; ++i)
+  {
+    double dist = 0.;
+    for (size_t d = 0; d < _variableCount; ++d) dist += dif[i * _variableCount + d] * dif[i * _variableCount + d];
+    distances[i] = dist;
   }
-  return dist;
 }
 
 bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t &childOne, ellipse_t &childTwo) const
@@ -918,7 +1351,6 @@ bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t
   size_t nOne, nTwo, idxOne, idxTwo;
   std::vector<int8_t> clusterFlag(parent.num, 0);
 
-  bool ok = true;
   size_t iter = 0;
   size_t diffs = 1;
 
@@ -934,9 +1366,15 @@ bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t
     {
       size_t six = parent.sampleIdx[i];
 
-      // measure distances to cluster means
-      double d1 = l2distance(_liveSamples[six], childOne.mean);
-      double d2 = l2distance(_liveSamples[six], childTwo.mean);
+      // measure (squared) distances to cluster means
+      const double *sample = &_liveSamples[six * _variableCount];
+      double d1 = 0.;
+      double d2 = 0.;
+      for (size_t d = 0; d < _variableCount; ++d)
+      {
+        d1 += (sample[d] - childOne.mean[d]) * (sample[d] - childOne.mean[d]);
+        d2 += (sample[d] - childTwo.mean[d]) * (sample[d] - childTwo.mean[d]);
+      }
 
       int8_t flag = (d1 < d2) ? 1 : 2;
 
@@ -968,20 +1406,15 @@ bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t
         childTwo.sampleIdx[idxTwo++] = parent.sampleIdx[i];
     }
 
-    // update means of ellipsoids
+    // update means of ellipsoids (covariances are updated by the caller after convergence)
     updateEllipseMean(childOne);
     updateEllipseMean(childTwo);
-
-    ok = ok & updateEllipseCov(childOne);
-    ok = ok & updateEllipseCov(childTwo);
-
-    if (ok == false) break;
   }
 
   // SM - Only add a check if you can create a unit test to trigger it
   //  if (iter >= maxIter) _k->_logger->logWarning("Normal", "K-Means Clustering did not terminate in %zu steps.\n", maxIter);
 
-  return ok;
+  return (childOne.num > 0) && (childTwo.num > 0);
 }
 
 void Nested::updateEffectiveSamples()
@@ -1018,12 +1451,28 @@ void Nested::printGenerationAfter()
   {
     _k->_logger->logInfo("Detailed", "Num Ellipsoids: %zu\n", _ellipseVector.size());
   }
+  if (_resamplingMethod == "Random Walk")
+  {
+    _k->_logger->logInfo("Detailed", "Random Walk Scale: %.3f\n", _randomWalkScale);
+  }
 }
 
 void Nested::finalize()
 {
   if (_k->_currentGeneration <= 1) return;
-  if (_addLivePoints == true) consumeLiveSamples();
+
+  if (_dynamicBatch > _dynamicBatchCount)
+  {
+    // All dynamic batches are complete and merged
+  }
+  else if (_dynamicBatch > 0)
+  {
+    // Terminated during a dynamic batch
+    consumeDynamicLiveSamples();
+    updateDynamicEvidence();
+  }
+  else if (_addLivePoints == true)
+    consumeLiveSamples();
 
   generatePosterior();
 
@@ -1127,6 +1576,14 @@ void Nested::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Next Update");
  }
 
+ if (isDefined(js, "Last Update LogVolume"))
+ {
+ try { _lastUpdateLogVolume = js["Last Update LogVolume"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Last Update LogVolume']\n%s", e.what()); } 
+   eraseValue(js, "Last Update LogVolume");
+ }
+
  if (isDefined(js, "Information"))
  {
  try { _information = js["Information"].get<double>();
@@ -1263,14 +1720,30 @@ void Nested::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Candidate LogPrior Weights");
  }
 
+ if (isDefined(js, "Random Walk Scale"))
+ {
+ try { _randomWalkScale = js["Random Walk Scale"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Random Walk Scale']\n%s", e.what()); } 
+   eraseValue(js, "Random Walk Scale");
+ }
+
  if (isDefined(js, "Live Samples"))
  {
- try { _liveSamples = js["Live Samples"].get<std::vector<std::vector<double>>>();
+ try { _liveSamples = js["Live Samples"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Live Samples']\n%s", e.what()); } 
    eraseValue(js, "Live Samples");
  }
 
+ if (isDefined(js, "Live Birth LStars"))
+ {
+ try { _liveBirthLStars = js["Live Birth LStars"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Live Birth LStars']\n%s", e.what()); } 
+   eraseValue(js, "Live Birth LStars");
+ }
+
  if (isDefined(js, "Live LogLikelihoods"))
  {
  try { _liveLogLikelihoods = js["Live LogLikelihoods"].get<std::vector<double>>();
@@ -1343,6 +1816,14 @@ void Nested::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Dead LogPrior Weights");
  }
 
+ if (isDefined(js, "Dead Birth LStars"))
+ {
+ try { _deadBirthLStars = js["Dead Birth LStars"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dead Birth LStars']\n%s", e.what()); } 
+   eraseValue(js, "Dead Birth LStars");
+ }
+
  if (isDefined(js, "Dead LogWeights"))
  {
  try { _deadLogWeights = js["Dead LogWeights"].get<std::vector<double>>();
@@ -1351,6 +1832,46 @@ void Nested::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Dead LogWeights");
  }
 
+ if (isDefined(js, "Dynamic Batch"))
+ {
+ try { _dynamicBatch = js["Dynamic Batch"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Batch']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Batch");
+ }
+
+ if (isDefined(js, "Dynamic Fill Count"))
+ {
+ try { _dynamicFillCount = js["Dynamic Fill Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Fill Count']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Fill Count");
+ }
+
+ if (isDefined(js, "Dynamic Lower Bound"))
+ {
+ try { _dynamicLowerBound = js["Dynamic Lower Bound"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Lower Bound']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Lower Bound");
+ }
+
+ if (isDefined(js, "Dynamic Upper Bound"))
+ {
+ try { _dynamicUpperBound = js["Dynamic Upper Bound"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Upper Bound']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Upper Bound");
+ }
+
+ if (isDefined(js, "Dynamic Lower LogVolume"))
+ {
+ try { _dynamicLowerLogVolume = js["Dynamic Lower LogVolume"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Lower LogVolume']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Lower LogVolume");
+ }
+
  if (isDefined(js, "Covariance Matrix"))
  {
  try { _covarianceMatrix = js["Covariance Matrix"].get<std::vector<double>>();
@@ -1444,6 +1965,51 @@ void Nested::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Proposal Update Frequency'] required by Nested.\n"); 
 
+ if (isDefined(js, "Proposal Update Shrinkage"))
+ {
+ try { _proposalUpdateShrinkage = js["Proposal Update Shrinkage"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Proposal Update Shrinkage']\n%s", e.what()); } 
+   eraseValue(js, "Proposal Update Shrinkage");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Proposal Update Shrinkage'] required by Nested.\n"); 
+
+ if (isDefined(js, "Proposal Steps"))
+ {
+ try { _proposalSteps = js["Proposal Steps"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Proposal Steps']\n%s", e.what()); } 
+   eraseValue(js, "Proposal Steps");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Proposal Steps'] required by Nested.\n"); 
+
+ if (isDefined(js, "Dynamic Batch Count"))
+ {
+ try { _dynamicBatchCount = js["Dynamic Batch Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Batch Count']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Batch Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Dynamic Batch Count'] required by Nested.\n"); 
+
+ if (isDefined(js, "Dynamic Posterior Fraction"))
+ {
+ try { _dynamicPosteriorFraction = js["Dynamic Posterior Fraction"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Posterior Fraction']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Posterior Fraction");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Dynamic Posterior Fraction'] required by Nested.\n"); 
+
+ if (isDefined(js, "Dynamic Importance Threshold"))
+ {
+ try { _dynamicImportanceThreshold = js["Dynamic Importance Threshold"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Dynamic Importance Threshold']\n%s", e.what()); } 
+   eraseValue(js, "Dynamic Importance Threshold");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Dynamic Importance Threshold'] required by Nested.\n"); 
+
  if (isDefined(js, "Ellipsoidal Scaling"))
  {
  try { _ellipsoidalScaling = js["Ellipsoidal Scaling"].get<double>();
@@ -1498,6 +2064,11 @@ void Nested::getConfiguration(knlohmann::json& js)
    js["Add Live Points"] = _addLivePoints;
    js["Resampling Method"] = _resamplingMethod;
    js["Proposal Update Frequency"] = _proposalUpdateFrequency;
+   js["Proposal Update Shrinkage"] = _proposalUpdateShrinkage;
+   js["Proposal Steps"] = _proposalSteps;
+   js["Dynamic Batch Count"] = _dynamicBatchCount;
+   js["Dynamic Posterior Fraction"] = _dynamicPosteriorFraction;
+   js["Dynamic Importance Threshold"] = _dynamicImportanceThreshold;
    js["Ellipsoidal Scaling"] = _ellipsoidalScaling;
    js["Termination Criteria"]["Min Log Evidence Delta"] = _minLogEvidenceDelta;
    js["Termination Criteria"]["Max Effective Sample Size"] = _maxEffectiveSampleSize;
@@ -1513,6 +2084,7 @@ void Nested::getConfiguration(knlohmann::json& js)
    js["Bound LogVolume"] = _boundLogVolume;
    js["Last Accepted"] = _lastAccepted;
    js["Next Update"] = _nextUpdate;
+   js["Last Update LogVolume"] = _lastUpdateLogVolume;
    js["Information"] = _information;
    js["LStar"] = _lStar;
    js["LStarOld"] = _lStarOld;
@@ -1530,7 +2102,9 @@ void Nested::getConfiguration(knlohmann::json& js)
    js["Candidate LogLikelihoods"] = _candidateLogLikelihoods;
    js["Candidate LogPriors"] = _candidateLogPriors;
    js["Candidate LogPrior Weights"] = _candidateLogPriorWeights;
+   js["Random Walk Scale"] = _randomWalkScale;
    js["Live Samples"] = _liveSamples;
+   js["Live Birth LStars"] = _liveBirthLStars;
    js["Live LogLikelihoods"] = _liveLogLikelihoods;
    js["Live LogPriors"] = _liveLogPriors;
    js["Live LogPrior Weights"] = _liveLogPriorWeights;
@@ -1540,7 +2114,13 @@ void Nested::getConfiguration(knlohmann::json& js)
    js["Dead LogLikelihoods"] = _deadLogLikelihoods;
    js["Dead LogPriors"] = _deadLogPriors;
    js["Dead LogPrior Weights"] = _deadLogPriorWeights;
+   js["Dead Birth LStars"] = _deadBirthLStars;
    js["Dead LogWeights"] = _deadLogWeights;
+   js["Dynamic Batch"] = _dynamicBatch;
+   js["Dynamic Fill Count"] = _dynamicFillCount;
+   js["Dynamic Lower Bound"] = _dynamicLowerBound;
+   js["Dynamic Upper Bound"] = _dynamicUpperBound;
+   js["Dynamic Lower LogVolume"] = _dynamicLowerLogVolume;
    js["Covariance Matrix"] = _covarianceMatrix;
    js["Log Domain Size"] = _logDomainSize;
    js["Domain Mean"] = _domainMean;
@@ -1555,7 +2135,7 @@ void Nested::getConfiguration(knlohmann::json& js)
 void Nested::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Number Live Points\": 1500, \"Batch Size\": 1, \"Add Live Points\": true, \"Resampling Method\": \"Ellipse\", \"Proposal Update Frequency\": 1500, \"Ellipsoidal Scaling\": 1.0, \"Termination Criteria\": {\"Min Log Evidence Delta\": 0.01, \"Max Effective Sample Size\": 10000000.0, \"Max Log Likelihood\": 10000000.0}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
+ std::string defaultString = "{\"Number Live Points\": 1500, \"Batch Size\": 1, \"Add Live Points\": true, \"Resampling Method\": \"Ellipse\", \"Proposal Update Frequency\": 1500, \"Proposal Update Shrinkage\": 0.0, \"Proposal Steps\": 25, \"Dynamic Batch Count\": 0, \"Dynamic Posterior Fraction\": 1.0, \"Dynamic Importance Threshold\": 0.9, \"Ellipsoidal Scaling\": 1.0, \"Termination Criteria\": {\"Min Log Evidence Delta\": 0.01, \"Max Effective Sample Size\": 10000000.0, \"Max Log Likelihood\": 10000000.0}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
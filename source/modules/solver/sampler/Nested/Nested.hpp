@@ -40,7 +40,7 @@ struct ellipse_t
    * @brief Init d-dimensional ellipse without covariance.
    * @param dim Dimension of ellipsoid.
    */
-  ellipse_t(size_t dim) : dim(dim), num(0), det(0.0), sampleIdx(0), mean(dim, 0.0), cov(dim * dim, 0.0), invCov(dim * dim, 0.0), axes(dim * dim, 0.0), evals(dim, 0.0), paxes(dim * dim, 0.0), volume(0.0), pointVolume(0.0){};
+  ellipse_t(size_t dim) : dim(dim), num(0), det(0.0), sampleIdx(0), mean(dim, 0.0), cov(dim * dim, 0.0), axes(dim * dim, 0.0), evals(dim, 0.0), paxes(dim * dim, 0.0), volume(0.0), pointVolume(0.0){};
 
   /**
    * @brief Init d-dimensional unit sphere.
@@ -84,12 +84,7 @@ struct ellipse_t
   std::vector<double> cov;
 
   /**
-   * @brief Inverse of Covariance Matrix.
-   */
-  std::vector<double> invCov;
-
-  /**
-   * @brief Axes of the ellipse.
+   * @brief Axes of the ellipse, given by the lower Cholesky factor of the covariance (the upper triangle is unused).
    */
   std::vector<double> axes;
 
@@ -114,6 +109,127 @@ struct ellipse_t
   double pointVolume;
 };
 
+/**
+ * @brief Stage of a slice sampling move.
+ */
+enum /**
+* @brief Class declaration for module: Nested.
+*/
+class slice_stage_t
+{
+  /**
+   * @brief Stepping out the lower end of the slice interval.
+   */
+  stepOutLeft = 0,
+
+  /**
+   * @brief Stepping out the upper end of the slice interval.
+   */
+  stepOutRight = 1,
+
+  /**
+   * @brief Shrinking the slice interval until a sample inside the likelihood constraint is found.
+   */
+  shrink = 2,
+};
+
+/**
+ * @brief Markov chain evolved within the likelihood constraint to generate a candidate (only relevant for Slice and Random Walk sampling).
+ */
+struct chain_t
+{
+  /**
+   * @brief Default c-tor (avoid empty initialization).
+   */
+  chain_t() = delete;
+
+  /**
+   * @brief Init chain in d-dimensional unit domain.
+   * @param dim Dimension of domain.
+   */
+  chain_t(size_t dim) : position(dim, 0.0), logLikelihood(0.0), logPrior(0.0), logPriorWeight(0.0), proposal(dim, 0.0), proposalLogLikelihood(0.0), proposalLogPrior(0.0), proposalLogPriorWeight(0.0), direction(dim, 0.0), left(0.0), right(0.0), step(0.0), stage(slice_stage_t::stepOutLeft), remainingSteps(0), acceptedSteps(0), rejectedSteps(0){};
+
+  /**
+   * @brief Current position of the chain.
+   */
+  std::vector<double> position;
+
+  /**
+   * @brief Loglikelihood evaluation of the current position.
+   */
+  double logLikelihood;
+
+  /**
+   * @brief Log prior evaluation of the current position.
+   */
+  double logPrior;
+
+  /**
+   * @brief Log prior weight of the current position.
+   */
+  double logPriorWeight;
+
+  /**
+   * @brief Proposed position to be evaluated.
+   */
+  std::vector<double> proposal;
+
+  /**
+   * @brief Loglikelihood evaluation of the proposal.
+   */
+  double proposalLogLikelihood;
+
+  /**
+   * @brief Log prior evaluation of the proposal.
+   */
+  double proposalLogPrior;
+
+  /**
+   * @brief Log prior weight of the proposal.
+   */
+  double proposalLogPriorWeight;
+
+  /**
+   * @brief Direction of the slice.
+   */
+  std::vector<double> direction;
+
+  /**
+   * @brief Lower end of the slice interval along the direction.
+   */
+  double left;
+
+  /**
+   * @brief Upper end of the slice interval along the direction.
+   */
+  double right;
+
+  /**
+   * @brief Location of the proposal along the direction.
+   */
+  double step;
+
+  /**
+   * @brief Stage of the current slice sampling move.
+   */
+  slice_stage_t stage;
+
+  /**
+   * @brief Number of remaining moves or steps.
+   */
+  size_t remainingSteps;
+
+  /**
+   * @brief Number of accepted proposals.
+   */
+  size_t acceptedSteps;
+
+  /**
+   * @brief Number of rejected proposals.
+   */
+  size_t rejectedSteps;
+};
+
 /**
 * @brief Class declaration for module: Nested.
 */
@@ -130,6 +246,11 @@ class Nested : public Sampler
    */
   std::vector<ellipse_t> _ellipseVector;
 
+  /*
+   * @brief Storing chains (only relevant for Slice and Random Walk sampling).
+   */
+  std::vector<chain_t> _chainVector;
+
   /*
    * @brief Init and run first Generation.
    */
@@ -173,11 +294,67 @@ class Nested : public Sampler
    */
   void generateCandidatesFromMultiEllipse();
 
+  /**
+   * @brief Generate and evaluate new candidates by evolving one chain per candidate concurrently (Slice and Random Walk).
+   */
+  void generateCandidatesFromChains();
+
+  /**
+   * @brief Starts a chain at a randomly selected live sample.
+   * @param chain Chain to be initialized.
+   */
+  void initChain(chain_t &chain);
+
+  /**
+   * @brief Starts a slice sampling move of a chain in a random direction.
+   * @param chain Chain to be moved.
+   */
+  void initSlice(chain_t &chain);
+
+  /**
+   * @brief Generates the next proposal of a chain that needs to be evaluated. Proposals outside of the unit domain are rejected without evaluation.
+   * @param chain Chain to be evolved.
+   * @return False if the chain completed all its moves or steps.
+   */
+  bool proposeFromChain(chain_t &chain);
+
+  /**
+   * @brief Updates a chain with the outcome of its proposal.
+   * @param chain Chain to be updated.
+   * @param accepted True if the proposal fulfills the likelihood constraint.
+   */
+  void updateChain(chain_t &chain, bool accepted);
+
   /*
    * @brief Process Generation after receiving all results.
    */
   bool processGeneration();
 
+  /*
+   * @brief Process Generation while the live samples of a dynamic batch are generated above its lower likelihood bound.
+   */
+  bool fillDynamicBatch();
+
+  /*
+   * @brief Starts a dynamic batch of live samples in the likelihood range of the largest importance.
+   */
+  void startDynamicBatch();
+
+  /*
+   * @brief Ends the current run (baseline or dynamic batch), merges its samples and starts the next dynamic batch if any.
+   */
+  void finishDynamicBatch();
+
+  /*
+   * @brief Add all live samples to sample data base, without updating the evidence (updated by merging all runs).
+   */
+  void consumeDynamicLiveSamples();
+
+  /*
+   * @brief Recalculates evidence, information and weights of the dead samples of all runs, from the number of live samples at the likelihood of each dead sample. Determines the likelihood range of the next dynamic batch.
+   */
+  void updateDynamicEvidence();
+
   /*
    * @brief Calculates the log prior weight.
    */
@@ -214,13 +391,6 @@ class Nested : public Sampler
    */
   void generatePosterior();
 
-  /*
-   * @brief Calculate L2 distance between two vectors.
-   * @param sampleOne Vector one
-   * @param sampleTwo Vector two
-   */
-  double l2distance(const std::vector<double> &sampleOne, const std::vector<double> &sampleTwo) const;
-
   /*
    * @brief Updates bounding Ellipse (mean, cov and volume).
    * @param ellipse Ellipse to be updated.
@@ -270,6 +440,13 @@ class Nested : public Sampler
    */
   double mahalanobisDistance(const std::vector<double> &sample, const ellipse_t &ellipse) const;
 
+  /*
+   * @brief Calculates the Mahalanobis metric of all live samples of the ellipse at once.
+   * @param ellipse Ellipse.
+   * @param distances Mahalanobis metric of each sample of the ellipse (in the order of its sample indices).
+   */
+  void mahalanobisDistances(const ellipse_t &ellipse, std::vector<double> &distances) const;
+
   /*
    * @brief Calculate effective number of samples.
    * @return the number of effective samples
@@ -296,7 +473,7 @@ class Nested : public Sampler
   */
    int _addLivePoints;
   /**
-  * @brief Method to generate new candidates (can be set to either 'Box' or 'Ellipse', 'Multi Ellipse').
+  * @brief Method to generate new candidates (can be set to either 'Box' or 'Ellipse', 'Multi Ellipse', 'Slice', 'Random Walk'). 'Slice' and 'Random Walk' evolve Markov chains from live samples within the likelihood constraint, whose acceptance does not degrade with the dimension.
   */
    std::string _resamplingMethod;
   /**
@@ -304,6 +481,26 @@ class Nested : public Sampler
   */
    size_t _proposalUpdateFrequency;
   /**
+  * @brief Minimal decrease of the log volume of the live samples since the last update of the resampling distribution, before it is updated again (in addition to the Proposal Update Frequency). Zero updates it at every Proposal Update Frequency.
+  */
+   double _proposalUpdateShrinkage;
+  /**
+  * @brief Number of slice sampling moves, respectively random walk steps, used to generate a candidate from a live sample (only relevant for 'Slice' and 'Random Walk' proposal).
+  */
+   size_t _proposalSteps;
+  /**
+  * @brief Number of batches of live samples added adaptively after the baseline run (dynamic nested sampling). Each batch samples the likelihood range that dominates the uncertainty of the posterior and evidence with Number Live Points additional live samples. Zero runs static nested sampling.
+  */
+   size_t _dynamicBatchCount;
+  /**
+  * @brief Fraction of the importance assigned to the accuracy of the posterior, the remainder is assigned to the accuracy of the evidence (only relevant for dynamic nested sampling).
+  */
+   double _dynamicPosteriorFraction;
+  /**
+  * @brief A batch samples the likelihood range of the dead samples whose importance exceeds this fraction of the maximal importance (only relevant for dynamic nested sampling).
+  */
+   double _dynamicImportanceThreshold;
+  /**
   * @brief Scaling factor of ellipsoidal (only relevant for 'Ellipse' and 'Multi Ellipse' proposal).
   */
    double _ellipsoidalScaling;
@@ -352,6 +549,10 @@ class Nested : public Sampler
   */
    size_t _nextUpdate;
   /**
+  * @brief [Internal Use] Log volume of the live samples at the last update of the bounds.
+  */
+   double _lastUpdateLogVolume;
+  /**
   * @brief [Internal Use] Accumulated information.
   */
    double _information;
@@ -420,9 +621,17 @@ class Nested : public Sampler
   */
    std::vector<double> _candidateLogPriorWeights;
   /**
-  * @brief [Internal Use] Samples to be processed and replaced in ascending order.
+  * @brief [Internal Use] Scaling of the random walk steps relative to the bounding ellipse, adapted to the acceptance of the steps (only relevant for 'Random Walk' proposal).
   */
-   std::vector<std::vector<double>> _liveSamples;
+   double _randomWalkScale;
+  /**
+  * @brief [Internal Use] Samples to be processed and replaced in ascending order (contiguous, one row of Variable Count entries per live sample).
+  */
+   std::vector<double> _liveSamples;
+  /**
+  * @brief [Internal Use] Likelihood constraint (lStar) under which each live sample was generated.
+  */
+   std::vector<double> _liveBirthLStars;
   /**
   * @brief [Internal Use] Loglikelihood evaluations of live samples.
   */
@@ -460,10 +669,34 @@ class Nested : public Sampler
   */
    std::vector<double> _deadLogPriorWeights;
   /**
+  * @brief [Internal Use] Likelihood constraint (lStar) under which each dead sample was generated.
+  */
+   std::vector<double> _deadBirthLStars;
+  /**
   * @brief [Internal Use] Log weight (Priormass x Likelihood) of dead samples.
   */
    std::vector<double> _deadLogWeights;
   /**
+  * @brief [Internal Use] Index of the current batch of live samples (zero for the baseline run).
+  */
+   size_t _dynamicBatch;
+  /**
+  * @brief [Internal Use] Number of live samples of the current batch that have been generated above its lower likelihood bound.
+  */
+   size_t _dynamicFillCount;
+  /**
+  * @brief [Internal Use] Likelihood constraint (lStar) at which the current batch starts.
+  */
+   double _dynamicLowerBound;
+  /**
+  * @brief [Internal Use] Likelihood constraint (lStar) at which the current batch terminates.
+  */
+   double _dynamicUpperBound;
+  /**
+  * @brief [Internal Use] Estimated log prior volume enclosed by the lower likelihood bound of the current batch.
+  */
+   double _dynamicLowerLogVolume;
+  /**
   * @brief [Internal Use] Sample covariance of the live samples.
   */
    std::vector<double> _covarianceMatrix;
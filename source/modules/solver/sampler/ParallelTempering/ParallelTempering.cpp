@@ -0,0 +1,450 @@
+#include "engine.hpp"
+#include "modules/experiment/experiment.hpp"
+#include "modules/problem/problem.hpp"
+#include "modules/solver/sampler/ParallelTempering/ParallelTempering.hpp"
+#include "sample/sample.hpp"
+
+#include <limits>
+#include <numeric>
+
+namespace korali
+{
+namespace solver
+{
+namespace sampler
+{
+;
+
+void ParallelTempering::setInitialConfiguration()
+{
+  // Validating and allocating the state of the untempered chain
+  MCMC::setInitialConfiguration();
+
+  if (_chainCount != 1) KORALI_LOG_ERROR("Chain Count must be 1 for Parallel Tempering, use Replica Count instead (is %zu).\n", _chainCount);
+  if (_replicaCount < 2) KORALI_LOG_ERROR("Replica Count must be larger than 1 (is %zu).\n", _replicaCount);
+  if (_maxTemperature <= 1.0) KORALI_LOG_ERROR("Max Temperature must be larger than 1.0 (is %lf).\n", _maxTemperature);
+  if (_temperatureAdaptionRate < 0.0) KORALI_LOG_ERROR("Temperature Adaption Rate must be larger equal 0.0 (is %lf).\n", _temperatureAdaptionRate);
+  if (_temperatureAdaptionLag <= 0.0) KORALI_LOG_ERROR("Temperature Adaption Lag must be larger 0.0 (is %lf).\n", _temperatureAdaptionLag);
+
+  // Geometric temperature ladder
+  _temperatures.resize(_replicaCount);
+  for (size_t r = 0; r < _replicaCount; r++) _temperatures[r] = std::pow(_maxTemperature, (double)r / (double)(_replicaCount - 1));
+
+  _replicaLeaders.assign(_replicaCount, _chainLeader);
+  _replicaLeaderLogPriors.assign(_replicaCount, 0.0);
+  _replicaLeaderLogLikelihoods.assign(_replicaCount, -Inf);
+  _replicaSampleCounts.assign(_replicaCount, 0);
+  _replicaAcceptanceCounts.assign(_replicaCount, 0);
+  _replicaChainMeans.assign(_replicaCount, std::vector<double>(_variableCount, 0.0));
+  _replicaChainCovariances.assign(_replicaCount, std::vector<double>(_variableCount * _variableCount, 0.0));
+  _replicaCholeskyDecompositions.assign(_replicaCount, std::vector<double>(_variableCount * _variableCount, 0.0));
+
+  _swapProposalCounts.assign(_replicaCount - 1, 0);
+  _swapAcceptanceCounts.assign(_replicaCount - 1, 0);
+}
+
+void ParallelTempering::runGeneration()
+{
+  if (_k->_currentGeneration == 1) setInitialConfiguration();
+
+  // Per-step storage is not part of the checkpoint, so it is (re)allocated here
+  if (_replicaCandidates.size() != _replicaCount)
+  {
+    _replicaCandidates.assign(_replicaCount, std::vector<std::vector<double>>(_rejectionLevels, std::vector<double>(_variableCount)));
+    _replicaCandidatesLogPriors.assign(_replicaCount, std::vector<double>(_rejectionLevels));
+    _replicaCandidatesLogLikelihoods.assign(_replicaCount, std::vector<double>(_rejectionLevels));
+    _replicaRejectionLevels.assign(_replicaCount, 0);
+    _replicaProposalFactors.assign(_replicaCount, std::vector<double>(_variableCount * _variableCount));
+  }
+
+  // Every replica advances one step, with all replicas in flight at once
+  std::vector<Sample> samples(_replicaCount);
+
+  for (size_t r = 0; r < _replicaCount; r++)
+  {
+    // Before adaption, hotter replicas use proportionally wider proposals
+    if ((_useAdaptiveSampling == false) || (_replicaSampleCounts[r] <= _nonAdaptionPeriod + _burnIn))
+      for (size_t i = 0; i < _variableCount * _variableCount; i++) _replicaProposalFactors[r][i] = std::sqrt(_temperatures[r]) * _choleskyDecompositionCovariance[i];
+    else
+      _replicaProposalFactors[r] = _replicaCholeskyDecompositions[r];
+
+    _replicaRejectionLevels[r] = 0;
+    launchCandidate(samples[r], r);
+  }
+
+  size_t finishedReplicas = 0;
+  while (finishedReplicas < _replicaCount)
+  {
+    size_t r = KORALI_WAITANY(samples);
+
+    if (processCandidate(samples[r], r))
+      finishedReplicas++;
+    else
+    {
+      // Delayed rejection: the next level is proposed from the rejected candidate
+      _replicaRejectionLevels[r]++;
+      launchCandidate(samples[r], r);
+    }
+  }
+
+  std::vector<double> swapAccepted(_replicaCount - 1, 0.0);
+  std::vector<bool> swapProposed(_replicaCount - 1, false);
+  swapReplicas(swapAccepted, swapProposed);
+
+  // Only the untempered replica samples the target distribution
+  if ((_chainLength >= _burnIn) && (_k->_currentGeneration % _leap == 0))
+  {
+    _sampleDatabase.push_back(_replicaLeaders[0]);
+    _sampleEvaluationDatabase.push_back(_replicaLeaderLogPriors[0] + _replicaLeaderLogLikelihoods[0]);
+  }
+
+  if (_chainLength >= _burnIn)
+    for (size_t r = 0; r < _replicaCount; r++)
+    {
+      _replicaSampleCounts[r]++;
+      updateChainStatistics(_replicaLeaders[r], _replicaSampleCounts[r], _replicaChainMeans[r], _replicaChainCovariances[r], _replicaCholeskyDecompositions[r]);
+    }
+
+  adaptTemperatures(swapAccepted, swapProposed);
+
+  // Exposing the untempered replica through the MCMC state
+  _chainLength++;
+  _chainLeader = _replicaLeaders[0];
+  _chainLeaderEvaluation = _replicaLeaderLogPriors[0] + _replicaLeaderLogLikelihoods[0];
+  _chainMean = _replicaChainMeans[0];
+  _chainCovariance = _replicaChainCovariances[0];
+  _choleskyDecompositionChainCovariance = _replicaCholeskyDecompositions[0];
+  _acceptanceCount = _replicaAcceptanceCounts[0];
+  _acceptanceRate = (double)_acceptanceCount / (double)_chainLength;
+
+  if ((_targetEffectiveSampleSize > 0.0) && (_k->_currentGeneration % _diagnosticsFrequency == 0)) updateDiagnostics();
+}
+
+double ParallelTempering::getTemperedLogDensity(const double logPrior, const double logLikelihood, const double temperature) const
+{
+  return logPrior + logLikelihood / temperature;
+}
+
+void ParallelTempering::launchCandidate(Sample &sample, const size_t replicaId)
+{
+  const size_t level = _replicaRejectionLevels[replicaId];
+  const auto &origin = level == 0 ? _replicaLeaders[replicaId] : _replicaCandidates[replicaId][level - 1];
+
+  proposeCandidate(origin, _replicaProposalFactors[replicaId], _replicaCandidates[replicaId][level]);
+  _proposedSampleCount++;
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Evaluate";
+  sample["Parameters"] = _replicaCandidates[replicaId][level];
+  sample["Sample Id"] = _modelEvaluationCount;
+  _modelEvaluationCount++;
+  KORALI_START(sample);
+}
+
+bool ParallelTempering::processCandidate(Sample &sample, const size_t replicaId)
+{
+  const size_t level = _replicaRejectionLevels[replicaId];
+  const double temperature = _temperatures[replicaId];
+
+  // For Bayesian problems only the likelihood is tempered, otherwise the whole density
+  double logPrior = 0.0;
+  double logLikelihood;
+  if (sample.contains("logLikelihood"))
+  {
+    logPrior = KORALI_GET(double, sample, "logPrior");
+    logLikelihood = KORALI_GET(double, sample, "logLikelihood");
+  }
+  else
+    logLikelihood = KORALI_GET(double, sample, "logP(x)");
+
+  _replicaCandidatesLogPriors[replicaId][level] = logPrior;
+  _replicaCandidatesLogLikelihoods[replicaId][level] = logLikelihood;
+
+  std::vector<double> temperedEvaluations(level + 1);
+  for (size_t i = 0; i <= level; i++) temperedEvaluations[i] = getTemperedLogDensity(_replicaCandidatesLogPriors[replicaId][i], _replicaCandidatesLogLikelihoods[replicaId][i], temperature);
+  const double leaderEvaluation = getTemperedLogDensity(_replicaLeaderLogPriors[replicaId], _replicaLeaderLogLikelihoods[replicaId], temperature);
+
+  double denominator;
+  const double rejectionAlpha = recursiveAlpha(denominator, leaderEvaluation, temperedEvaluations.data(), level);
+
+  if (rejectionAlpha == 1.0 || rejectionAlpha > _uniformGenerator->getRandomNumber())
+  {
+    _replicaAcceptanceCounts[replicaId]++;
+    _replicaLeaders[replicaId] = _replicaCandidates[replicaId][level];
+    _replicaLeaderLogPriors[replicaId] = logPrior;
+    _replicaLeaderLogLikelihoods[replicaId] = logLikelihood;
+    return true;
+  }
+
+  return level + 1 == _rejectionLevels;
+}
+
+void ParallelTempering::swapReplicas(std::vector<double> &swapAccepted, std::vector<bool> &swapProposed)
+{
+  // Alternating between even and odd pairs, so that no replica takes part in two swaps at once
+  for (size_t i = _k->_currentGeneration % 2; i + 1 < _replicaCount; i += 2)
+  {
+    swapProposed[i] = true;
+    _swapProposalCounts[i]++;
+
+    // The untempered parts of the log-densities cancel out
+    const double logRatio = (1.0 / _temperatures[i] - 1.0 / _temperatures[i + 1]) * (_replicaLeaderLogLikelihoods[i + 1] - _replicaLeaderLogLikelihoods[i]);
+    swapAccepted[i] = std::isnan(logRatio) ? 0.0 : std::min(1.0, std::exp(logRatio));
+
+    if (swapAccepted[i] == 1.0 || swapAccepted[i] > _uniformGenerator->getRandomNumber())
+    {
+      _swapAcceptanceCounts[i]++;
+      std::swap(_replicaLeaders[i], _replicaLeaders[i + 1]);
+      std::swap(_replicaLeaderLogPriors[i], _replicaLeaderLogPriors[i + 1]);
+      std::swap(_replicaLeaderLogLikelihoods[i], _replicaLeaderLogLikelihoods[i + 1]);
+    }
+  }
+}
+
+void ParallelTempering::adaptTemperatures(const std::vector<double> &swapAccepted, const std::vector<bool> &swapProposed)
+{
+  // The first and last temperatures are fixed, so there is nothing to adapt with two replicas
+  if (_adaptTemperatures == false || _replicaCount < 3) return;
+
+  double meanAcceptance = 0.0;
+  size_t proposedCount = 0;
+  for (size_t i = 0; i + 1 < _replicaCount; i++)
+    if (swapProposed[i])
+    {
+      meanAcceptance += swapAccepted[i];
+      proposedCount++;
+    }
+  meanAcceptance /= (double)proposedCount;
+
+  // Widening the gaps whose swaps are accepted more often than average (Vousden2016), with a decaying rate
+  const double rate = _temperatureAdaptionRate * _temperatureAdaptionLag / (_temperatureAdaptionLag + (double)_k->_currentGeneration);
+
+  std::vector<double> gaps(_replicaCount - 1);
+  for (size_t i = 0; i + 1 < _replicaCount; i++)
+  {
+    gaps[i] = _temperatures[i + 1] - _temperatures[i];
+    if (swapProposed[i]) gaps[i] *= std::exp(rate * (swapAccepted[i] - meanAcceptance));
+  }
+
+  // Rescaling to keep the hottest temperature fixed
+  const double gapScaling = (_maxTemperature - 1.0) / std::accumulate(gaps.begin(), gaps.end(), 0.0);
+  for (size_t i = 0; i + 1 < _replicaCount; i++) _temperatures[i + 1] = _temperatures[i] + gaps[i] * gapScaling;
+  _temperatures[_replicaCount - 1] = _maxTemperature;
+}
+
+void ParallelTempering::printGenerationAfter()
+{
+  MCMC::printGenerationAfter();
+
+  _k->_logger->logInfo("Normal", "Temperatures (Acceptance Rate):\n");
+  for (size_t r = 0; r < _replicaCount; r++) _k->_logger->logData("Normal", "         T[%zu] = %+6.3e (%.2f%%)\n", r, _temperatures[r], 100.0 * (double)_replicaAcceptanceCounts[r] / (double)_chainLength);
+
+  _k->_logger->logInfo("Detailed", "Swap Acceptance Rates:\n");
+  for (size_t i = 0; i + 1 < _replicaCount; i++)
+    if (_swapProposalCounts[i] > 0) _k->_logger->logData("Detailed", "         T[%zu] <-> T[%zu]: %.2f%%\n", i, i + 1, 100.0 * (double)_swapAcceptanceCounts[i] / (double)_swapProposalCounts[i]);
+}
+
+void ParallelTempering::finalize()
+{
+  MCMC::finalize();
+
+  size_t swapProposals = std::accumulate(_swapProposalCounts.begin(), _swapProposalCounts.end(), (size_t)0);
+  size_t swapAcceptances = std::accumulate(_swapAcceptanceCounts.begin(), _swapAcceptanceCounts.end(), (size_t)0);
+  _k->_logger->logInfo("Minimal", "Swap Acceptance Rate: %.2f%%\n", swapProposals > 0 ? 100.0 * (double)swapAcceptances / (double)swapProposals : 0.0);
+}
+
+void ParallelTempering::setConfiguration(knlohmann::json& js) 
+{
+ if (isDefined(js, "Results"))  eraseValue(js, "Results");
+
+ if (isDefined(js, "Temperatures"))
+ {
+ try { _temperatures = js["Temperatures"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Temperatures']\n%s", e.what()); } 
+   eraseValue(js, "Temperatures");
+ }
+
+ if (isDefined(js, "Replica Leaders"))
+ {
+ try { _replicaLeaders = js["Replica Leaders"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Leaders']\n%s", e.what()); } 
+   eraseValue(js, "Replica Leaders");
+ }
+
+ if (isDefined(js, "Replica Leader LogPriors"))
+ {
+ try { _replicaLeaderLogPriors = js["Replica Leader LogPriors"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Leader LogPriors']\n%s", e.what()); } 
+   eraseValue(js, "Replica Leader LogPriors");
+ }
+
+ if (isDefined(js, "Replica Leader LogLikelihoods"))
+ {
+ try { _replicaLeaderLogLikelihoods = js["Replica Leader LogLikelihoods"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Leader LogLikelihoods']\n%s", e.what()); } 
+   eraseValue(js, "Replica Leader LogLikelihoods");
+ }
+
+ if (isDefined(js, "Replica Sample Counts"))
+ {
+ try { _replicaSampleCounts = js["Replica Sample Counts"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Sample Counts']\n%s", e.what()); } 
+   eraseValue(js, "Replica Sample Counts");
+ }
+
+ if (isDefined(js, "Replica Acceptance Counts"))
+ {
+ try { _replicaAcceptanceCounts = js["Replica Acceptance Counts"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Acceptance Counts']\n%s", e.what()); } 
+   eraseValue(js, "Replica Acceptance Counts");
+ }
+
+ if (isDefined(js, "Replica Chain Means"))
+ {
+ try { _replicaChainMeans = js["Replica Chain Means"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Chain Means']\n%s", e.what()); } 
+   eraseValue(js, "Replica Chain Means");
+ }
+
+ if (isDefined(js, "Replica Chain Covariances"))
+ {
+ try { _replicaChainCovariances = js["Replica Chain Covariances"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Chain Covariances']\n%s", e.what()); } 
+   eraseValue(js, "Replica Chain Covariances");
+ }
+
+ if (isDefined(js, "Replica Cholesky Decompositions"))
+ {
+ try { _replicaCholeskyDecompositions = js["Replica Cholesky Decompositions"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Cholesky Decompositions']\n%s", e.what()); } 
+   eraseValue(js, "Replica Cholesky Decompositions");
+ }
+
+ if (isDefined(js, "Swap Proposal Counts"))
+ {
+ try { _swapProposalCounts = js["Swap Proposal Counts"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Swap Proposal Counts']\n%s", e.what()); } 
+   eraseValue(js, "Swap Proposal Counts");
+ }
+
+ if (isDefined(js, "Swap Acceptance Counts"))
+ {
+ try { _swapAcceptanceCounts = js["Swap Acceptance Counts"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Swap Acceptance Counts']\n%s", e.what()); } 
+   eraseValue(js, "Swap Acceptance Counts");
+ }
+
+ if (isDefined(js, "Replica Count"))
+ {
+ try { _replicaCount = js["Replica Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Replica Count']\n%s", e.what()); } 
+   eraseValue(js, "Replica Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Replica Count'] required by ParallelTempering.\n"); 
+
+ if (isDefined(js, "Max Temperature"))
+ {
+ try { _maxTemperature = js["Max Temperature"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Max Temperature']\n%s", e.what()); } 
+   eraseValue(js, "Max Temperature");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Max Temperature'] required by ParallelTempering.\n"); 
+
+ if (isDefined(js, "Adapt Temperatures"))
+ {
+ try { _adaptTemperatures = js["Adapt Temperatures"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Adapt Temperatures']\n%s", e.what()); } 
+   eraseValue(js, "Adapt Temperatures");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Adapt Temperatures'] required by ParallelTempering.\n"); 
+
+ if (isDefined(js, "Temperature Adaption Rate"))
+ {
+ try { _temperatureAdaptionRate = js["Temperature Adaption Rate"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Temperature Adaption Rate']\n%s", e.what()); } 
+   eraseValue(js, "Temperature Adaption Rate");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Temperature Adaption Rate'] required by ParallelTempering.\n"); 
+
+ if (isDefined(js, "Temperature Adaption Lag"))
+ {
+ try { _temperatureAdaptionLag = js["Temperature Adaption Lag"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ ParallelTempering ] \n + Key:    ['Temperature Adaption Lag']\n%s", e.what()); } 
+   eraseValue(js, "Temperature Adaption Lag");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Temperature Adaption Lag'] required by ParallelTempering.\n"); 
+
+ MCMC::setConfiguration(js);
+ _type = "sampler/ParallelTempering";
+ if(isDefined(js, "Type")) eraseValue(js, "Type");
+ if(isEmpty(js) == false) KORALI_LOG_ERROR(" + Unrecognized settings for Korali module: ParallelTempering: \n%s\n", js.dump(2).c_str());
+} 
+
+void ParallelTempering::getConfiguration(knlohmann::json& js) 
+{
+
+ js["Type"] = _type;
+   js["Replica Count"] = _replicaCount;
+   js["Max Temperature"] = _maxTemperature;
+   js["Adapt Temperatures"] = _adaptTemperatures;
+   js["Temperature Adaption Rate"] = _temperatureAdaptionRate;
+   js["Temperature Adaption Lag"] = _temperatureAdaptionLag;
+   js["Temperatures"] = _temperatures;
+   js["Replica Leaders"] = _replicaLeaders;
+   js["Replica Leader LogPriors"] = _replicaLeaderLogPriors;
+   js["Replica Leader LogLikelihoods"] = _replicaLeaderLogLikelihoods;
+   js["Replica Sample Counts"] = _replicaSampleCounts;
+   js["Replica Acceptance Counts"] = _replicaAcceptanceCounts;
+   js["Replica Chain Means"] = _replicaChainMeans;
+   js["Replica Chain Covariances"] = _replicaChainCovariances;
+   js["Replica Cholesky Decompositions"] = _replicaCholeskyDecompositions;
+   js["Swap Proposal Counts"] = _swapProposalCounts;
+   js["Swap Acceptance Counts"] = _swapAcceptanceCounts;
+ MCMC::getConfiguration(js);
+} 
+
+void ParallelTempering::applyModuleDefaults(knlohmann::json& js) 
+{
+
+ std::string defaultString = "{\"Replica Count\": 8, \"Max Temperature\": 100.0, \"Adapt Temperatures\": true, \"Temperature Adaption Rate\": 0.01, \"Temperature Adaption Lag\": 1000.0}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ mergeJson(js, defaultJs); 
+ MCMC::applyModuleDefaults(js);
+} 
+
+void ParallelTempering::applyVariableDefaults() 
+{
+
+ MCMC::applyVariableDefaults();
+} 
+
+bool ParallelTempering::checkTermination()
+{
+ bool hasFinished = false;
+
+ hasFinished = hasFinished || MCMC::checkTermination();
+ return hasFinished;
+}
+
+;
+
+} //sampler
+} //solver
+} //korali
+;
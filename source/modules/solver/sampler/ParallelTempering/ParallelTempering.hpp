@@ -0,0 +1,197 @@
+/** \namespace sampler
+* @brief Namespace declaration for modules of type: sampler.
+*/
+
+/** \file
+* @brief Header file for module: ParallelTempering.
+*/
+
+/** \dir solver/sampler/ParallelTempering
+* @brief Contains code, documentation, and scripts for module: ParallelTempering.
+*/
+
+#pragma once
+
+#include "modules/solver/sampler/MCMC/MCMC.hpp"
+#include <vector>
+
+namespace korali
+{
+namespace solver
+{
+namespace sampler
+{
+;
+
+/**
+* @brief Class declaration for module: ParallelTempering.
+*/
+class ParallelTempering : public MCMC
+{
+  private:
+  /**
+   * @brief Candidates of the current step of each replica, one per rejection level
+   */
+  std::vector<std::vector<std::vector<double>>> _replicaCandidates;
+
+  /**
+   * @brief Untempered log-density part of the candidates of each replica
+   */
+  std::vector<std::vector<double>> _replicaCandidatesLogPriors;
+
+  /**
+   * @brief Tempered log-density part of the candidates of each replica
+   */
+  std::vector<std::vector<double>> _replicaCandidatesLogLikelihoods;
+
+  /**
+   * @brief Rejection level of the candidate under evaluation for each replica
+   */
+  std::vector<size_t> _replicaRejectionLevels;
+
+  /**
+   * @brief Cholesky decomposition of the proposal covariance of the current step of each replica
+   */
+  std::vector<std::vector<double>> _replicaProposalFactors;
+
+  /**
+   * @brief Evaluates the log-density of a replica target.
+   * @param logPrior Untempered part of the log-density
+   * @param logLikelihood Tempered part of the log-density
+   * @param temperature Temperature of the replica
+   * @return The tempered log-density
+   */
+  double getTemperedLogDensity(const double logPrior, const double logLikelihood, const double temperature) const;
+
+  /**
+   * @brief Generates the candidate of a replica at its current rejection level and starts its evaluation.
+   * @param sample Sample to use
+   * @param replicaId Index of the replica
+   */
+  void launchCandidate(Sample &sample, const size_t replicaId);
+
+  /**
+   * @brief Applies the (delayed rejection) acceptance step to an evaluated candidate.
+   * @param sample The evaluated sample
+   * @param replicaId Index of the replica
+   * @return Whether the step of the replica is complete (accepted, or rejected at the last level)
+   */
+  bool processCandidate(Sample &sample, const size_t replicaId);
+
+  /**
+   * @brief Proposes state swaps between adjacent replicas, alternating between even and odd pairs every generation.
+   * @param swapAccepted Storage for whether the swap between each pair was accepted (pairs not proposed are left unchanged)
+   * @param swapProposed Storage for whether a swap between each pair was proposed
+   */
+  void swapReplicas(std::vector<double> &swapAccepted, std::vector<bool> &swapProposed);
+
+  /**
+   * @brief Adapts the intermediate temperatures to equalize the swap acceptance between adjacent replicas.
+   * @param swapAccepted Whether the swap between each pair was accepted in this generation
+   * @param swapProposed Whether a swap between each pair was proposed in this generation
+   */
+  void adaptTemperatures(const std::vector<double> &swapAccepted, const std::vector<bool> &swapProposed);
+
+  public: 
+  /**
+  * @brief Number of tempered chains (replicas). All replicas are evaluated concurrently; only the samples of the untempered replica are stored in the database.
+  */
+   size_t _replicaCount;
+  /**
+  * @brief Temperature of the hottest replica. The initial temperature ladder is geometric between 1.0 and this value.
+  */
+   double _maxTemperature;
+  /**
+  * @brief Specifies whether the intermediate temperatures are adapted to equalize the swap acceptance rates between adjacent replicas.
+  */
+   int _adaptTemperatures;
+  /**
+  * @brief Initial rate at which the logarithm of the temperature gaps is adapted (only relevant if Adapt Temperatures is enabled).
+  */
+   double _temperatureAdaptionRate;
+  /**
+  * @brief Number of generations after which the adaption rate has decayed by half (only relevant if Adapt Temperatures is enabled).
+  */
+   double _temperatureAdaptionLag;
+  /**
+  * @brief [Internal Use] Current temperature of each replica, in increasing order (the first replica is untempered).
+  */
+   std::vector<double> _temperatures;
+  /**
+  * @brief [Internal Use] Variables of the newest sample of each replica.
+  */
+   std::vector<std::vector<double>> _replicaLeaders;
+  /**
+  * @brief [Internal Use] Untempered part of the log-density of each replica leader (the log prior for Bayesian problems, zero otherwise).
+  */
+   std::vector<double> _replicaLeaderLogPriors;
+  /**
+  * @brief [Internal Use] Tempered part of the log-density of each replica leader (the log likelihood for Bayesian problems, logP(x) otherwise).
+  */
+   std::vector<double> _replicaLeaderLogLikelihoods;
+  /**
+  * @brief [Internal Use] Number of samples (after Burn In) that contributed to the chain statistics of each replica.
+  */
+   std::vector<size_t> _replicaSampleCounts;
+  /**
+  * @brief [Internal Use] Number of accepted proposals of each replica.
+  */
+   std::vector<size_t> _replicaAcceptanceCounts;
+  /**
+  * @brief [Internal Use] Mean of each replica chain, used by the adaptive covariance.
+  */
+   std::vector<std::vector<double>> _replicaChainMeans;
+  /**
+  * @brief [Internal Use] Covariance of each replica chain (only relevant for Adaptive Sampling).
+  */
+   std::vector<std::vector<double>> _replicaChainCovariances;
+  /**
+  * @brief [Internal Use] Cholesky decomposition of the covariance of each replica chain (only relevant for Adaptive Sampling).
+  */
+   std::vector<std::vector<double>> _replicaCholeskyDecompositions;
+  /**
+  * @brief [Internal Use] Number of proposed swaps between each pair of adjacent replicas.
+  */
+   std::vector<size_t> _swapProposalCounts;
+  /**
+  * @brief [Internal Use] Number of accepted swaps between each pair of adjacent replicas.
+  */
+   std::vector<size_t> _swapAcceptanceCounts;
+  
+ 
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
+  /**
+  * @brief Obtains the entire current state and configuration of the module.
+  * @param js JSON object onto which to save the serialized state of the module.
+  */
+  void getConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Sets the entire state and configuration of the module, given a JSON object.
+  * @param js JSON object from which to deserialize the state of the module.
+  */
+  void setConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default configuration upon its creation.
+  * @param js JSON object containing user configuration. The defaults will not override any currently defined settings.
+  */
+  void applyModuleDefaults(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default variable configuration to each variable in the Experiment upon creation.
+  */
+  void applyVariableDefaults() override;
+  
+
+  void setInitialConfiguration() override;
+  void runGeneration() override;
+  void printGenerationAfter() override;
+  void finalize() override;
+};
+
+} //sampler
+} //solver
+} //korali
+;
@@ -6,6 +6,7 @@
 #include <limits>
 #include <numeric>
 
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_eigen.h>
 #include <gsl/gsl_linalg.h>
@@ -32,19 +33,28 @@ void TMCMC::setInitialConfiguration()
   if (_maxChainLength == 0) KORALI_LOG_ERROR("Max Chain Length must be greater 0.");
   if (_covarianceScaling <= 0.0) KORALI_LOG_ERROR("Covariance Scaling must be larger 0.0 (is %lf).\n", _covarianceScaling);
 
-  // Allocating TMCMC memory
+  if (_version == "SMC")
+  {
+    if ((_targetUnmovedProbability <= 0.0) || (_targetUnmovedProbability >= 1.0)) KORALI_LOG_ERROR("Target Unmoved Probability must be in (0.0, 1.0) (is %lf).\n", _targetUnmovedProbability);
+    if (_maxMovesPerParticle == 0) KORALI_LOG_ERROR("Max Moves Per Particle must be greater 0.");
+  }
+
+  // Allocating TMCMC memory (per-chain and per-sample rows are stored contiguously, row-major)
   _chainLeadersLogPriors.resize(_populationSize);
   _chainLeadersLogLikelihoods.resize(_populationSize);
-  _chainLeaders.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _chainLeaders[i].resize(_variableCount);
+  _chainLeaders.resize(_populationSize * _variableCount);
 
   _meanTheta.resize(_variableCount);
   _covarianceMatrix.resize(_variableCount * _variableCount);
 
   _chainCandidatesLogPriors.resize(_populationSize);
   _chainCandidatesLogLikelihoods.resize(_populationSize);
-  _chainCandidates.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _chainCandidates[i].resize(_variableCount);
+  _chainCandidates.resize(_populationSize * _variableCount);
+
+  _sampleDatabase.resize(_populationSize * _variableCount);
+  _sampleLogLikelihoodDatabase.resize(_populationSize);
+  _sampleLogPriorDatabase.resize(_populationSize);
+  _databaseEntries = 0;
 
   _chainLengths.resize(_populationSize);
   _currentChainStep.resize(_populationSize);
@@ -63,18 +73,12 @@ void TMCMC::setInitialConfiguration()
     _chainCandidatesErrors.resize(_populationSize, -1);
     _chainLeadersErrors.resize(_populationSize, -1);
     _sampleErrorDatabase.resize(_populationSize, -1);
-    _chainCandidatesGradients.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainCandidatesGradients[i].resize(_variableCount);
-    _chainLeadersGradients.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainLeadersGradients[i].resize(_variableCount);
-    _sampleGradientDatabase.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _sampleGradientDatabase[i].resize(_variableCount);
-    _chainCandidatesCovariance.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainCandidatesCovariance[i].resize(_variableCount * _variableCount);
-    _chainLeadersCovariance.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainLeadersCovariance[i].resize(_variableCount * _variableCount);
-    _sampleCovariancesDatabase.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _sampleCovariancesDatabase[i].resize(_variableCount);
+    _chainCandidatesGradients.resize(_populationSize * _variableCount);
+    _chainLeadersGradients.resize(_populationSize * _variableCount);
+    _sampleGradientDatabase.resize(_populationSize * _variableCount);
+    _chainCandidatesCovariance.resize(_populationSize * _variableCount * _variableCount);
+    _chainLeadersCovariance.resize(_populationSize * _variableCount * _variableCount);
+    _sampleCovariancesDatabase.resize(_populationSize * _variableCount * _variableCount);
 
     _upperExtendedBoundaries.resize(_variableCount);
     _lowerExtendedBoundaries.resize(_variableCount);
@@ -94,6 +98,7 @@ void TMCMC::setInitialConfiguration()
   _coefficientOfVariation = 0.0;
   _maxLoglikelihood = -Inf;
   _chainCount = _populationSize;
+  _movesPerParticle = _maxMovesPerParticle;
 
   _numCovarianceCorrections = 0;
 
@@ -127,7 +132,7 @@ void TMCMC::runGeneration()
           _chainPendingEvaluation[c] = true;
           samples[c]["Module"] = "Problem";
           samples[c]["Operation"] = "Evaluate";
-          samples[c]["Parameters"] = _chainCandidates[c];
+          samples[c]["Parameters"] = std::vector<double>(&_chainCandidates[c * _variableCount], &_chainCandidates[c * _variableCount] + _variableCount);
           samples[c]["Sample Id"] = c;
           _currentChainStep[c]++;
           _modelEvaluationCount++;
@@ -145,7 +150,7 @@ void TMCMC::runGeneration()
     if (isfinite(_chainCandidatesLogPriors[finishedId])) _numFinitePriorEvaluations++;
     if (isfinite(_chainCandidatesLogLikelihoods[finishedId])) _numFiniteLikelihoodEvaluations++;
 
-    if (_version == "TMCMC") processCandidate(finishedId);
+    if (_version != "mTMCMC") processCandidate(finishedId);
     if (_currentChainStep[finishedId] == _chainLengths[finishedId] + _currentBurnIn) _finishedChainsCount++;
   }
 
@@ -170,9 +175,8 @@ void TMCMC::prepareGeneration()
   _finishedChainsCount = 0;
   _maxLoglikelihood = -std::numeric_limits<double>::infinity();
 
-  _sampleLogLikelihoodDatabase.clear();
-  _sampleLogPriorDatabase.clear();
-  _sampleDatabase.clear();
+  // The database is preallocated to the population size and refilled in place
+  _databaseEntries = 0;
 
   _numFinitePriorEvaluations = 0;
   _numFiniteLikelihoodEvaluations = 0;
@@ -185,10 +189,6 @@ void TMCMC::prepareGeneration()
     _numEigenDecompositionFailuresProposal = 0;
     _numInversionFailuresProposal = 0;
     _numCholeskyDecompositionFailuresProposal = 0;
-
-    _sampleErrorDatabase.clear();
-    _sampleGradientDatabase.clear();
-    _sampleCovariancesDatabase.clear();
     if (_k->_currentGeneration > 1)
       std::fill(_chainCandidatesErrors.begin(), _chainCandidatesErrors.end(), 0);
     else
@@ -197,10 +197,10 @@ void TMCMC::prepareGeneration()
     // annealing
     for (size_t i = 0; i < _populationSize; ++i)
     {
-      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i][0], _variableCount, _variableCount);
+      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i * _variableCount * _variableCount], _variableCount, _variableCount);
       gsl_matrix_scale(&covLeader.matrix, _previousAnnealingExponent / _annealingExponent);
 
-      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i][0], _variableCount);
+      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i * _variableCount], _variableCount);
       gsl_vector_scale(&gradLeader.vector, _annealingExponent / _previousAnnealingExponent);
     }
   }
@@ -223,7 +223,7 @@ void TMCMC::prepareGeneration()
     if (_k->_currentGeneration == 1)
     {
       for (size_t d = 0; d < _variableCount; d++)
-        _chainCandidates[i][d] = _k->_distributions[_k->_variables[d]->_distributionIndex]->getRandomNumber();
+        _chainCandidates[i * _variableCount + d] = _k->_distributions[_k->_variables[d]->_distributionIndex]->getRandomNumber();
     }
     else
     {
@@ -239,17 +239,18 @@ void TMCMC::processCandidate(const size_t sampleId)
 
   if (P > U || _k->_currentGeneration == 1)
   {
-    _chainLeaders[sampleId] = _chainCandidates[sampleId];
+    std::copy_n(&_chainCandidates[sampleId * _variableCount], _variableCount, &_chainLeaders[sampleId * _variableCount]);
     _chainLeadersLogPriors[sampleId] = _chainCandidatesLogPriors[sampleId];
     _chainLeadersLogLikelihoods[sampleId] = _chainCandidatesLogLikelihoods[sampleId];
     if (_version == "mTMCMC")
     {
       _chainLeadersErrors[sampleId] = _chainCandidatesErrors[sampleId];
-      _chainLeadersGradients[sampleId] = _chainCandidatesGradients[sampleId];
-      _chainLeadersCovariance[sampleId] = _chainCandidatesCovariance[sampleId];
+      std::copy_n(&_chainCandidatesGradients[sampleId * _variableCount], _variableCount, &_chainLeadersGradients[sampleId * _variableCount]);
+      std::copy_n(&_chainCandidatesCovariance[sampleId * _variableCount * _variableCount], _variableCount * _variableCount, &_chainLeadersCovariance[sampleId * _variableCount * _variableCount]);
     }
 
-    if (_currentChainStep[sampleId] > _currentBurnIn) _acceptedSamplesCount++;
+    // In SMC every move counts towards the acceptance rate
+    if ((_currentChainStep[sampleId] > _currentBurnIn) || (_version == "SMC")) _acceptedSamplesCount++;
   }
 
   if (_currentChainStep[sampleId] < _currentBurnIn + _chainLengths[sampleId]) generateCandidate(sampleId);
@@ -298,7 +299,7 @@ void TMCMC::processGeneration()
 
   /* Sample candidate selections based on database entries */
   std::vector<unsigned int> numselections(_populationSize);
-  _multinomialGenerator->getSelections(weight, numselections, _populationSize);
+  resample(weight, numselections);
 
   /* scale weights with number repeated samples */
   for (size_t i = 0; i < _populationSize; i++) weight[i] = weight[i] * numselections[i];
@@ -311,25 +312,28 @@ void TMCMC::processGeneration()
   for (size_t i = 0; i < _populationSize; i++) sum_weight2 += weight[i] * weight[i];
 
   /* Update mean and covariance */
-  for (size_t i = 0; i < _variableCount; i++)
+  gsl_matrix_const_view database = gsl_matrix_const_view_array(_sampleDatabase.data(), _populationSize, _variableCount);
+  gsl_vector_const_view weightView = gsl_vector_const_view_array(weight.data(), _populationSize);
+  gsl_vector_view mean = gsl_vector_view_array(_meanTheta.data(), _variableCount);
+  gsl_blas_dgemv(CblasTrans, 1.0, &database.matrix, &weightView.vector, 0.0, &mean.vector);
+
+  // Centering the samples and scaling them by the square root of their weights turns the weighted covariance into a single rank-k update
+  _weightedCenteredSamples.resize(_populationSize * _variableCount);
+  for (size_t k = 0; k < _populationSize; k++)
   {
-    _meanTheta[i] = 0;
-    for (size_t j = 0; j < _populationSize; j++) _meanTheta[i] += _sampleDatabase[j][i] * weight[j];
+    const double sqrtWeight = sqrt(weight[k]);
+    for (size_t i = 0; i < _variableCount; i++) _weightedCenteredSamples[k * _variableCount + i] = sqrtWeight * (_sampleDatabase[k * _variableCount + i] - _meanTheta[i]);
   }
 
+  gsl_matrix_const_view centered = gsl_matrix_const_view_array(_weightedCenteredSamples.data(), _populationSize, _variableCount);
+  gsl_matrix_view covariance = gsl_matrix_view_array(_covarianceMatrix.data(), _variableCount, _variableCount);
+  gsl_blas_dsyrk(CblasUpper, CblasTrans, _covarianceScaling / (1.0 - sum_weight2), &centered.matrix, 0.0, &covariance.matrix);
   for (size_t i = 0; i < _variableCount; i++)
-  {
-    for (size_t j = i; j < _variableCount; ++j)
-    {
-      double s = 0.0;
-      for (size_t k = 0; k < _populationSize; ++k)
-        s += weight[k] * (_sampleDatabase[k][i] - _meanTheta[i]) * (_sampleDatabase[k][j] - _meanTheta[j]);
-      _covarianceMatrix[i * _variableCount + j] = _covarianceMatrix[j * _variableCount + i] = _covarianceScaling * s / (1.0 - sum_weight2);
-    }
-  }
+    for (size_t j = 0; j < i; j++) _covarianceMatrix[i * _variableCount + j] = _covarianceMatrix[j * _variableCount + i];
 
-  /* Resampling - Init new chains */
+  /* Resampling - Init new chains, in SMC every selection starts its own chain */
   std::fill(std::begin(_chainLengths), std::end(_chainLengths), 0);
+  const size_t maxChainLength = (_version == "SMC") ? 1 : _maxChainLength;
 
   size_t leaderChainLen;
   size_t zeroCount = 0;
@@ -339,21 +343,21 @@ void TMCMC::processGeneration()
     if (numselections[i] == 0) zeroCount++;
     while (numselections[i] > 0)
     {
-      _chainLeaders[leaderId] = _sampleDatabase[i];
+      std::copy_n(&_sampleDatabase[i * _variableCount], _variableCount, &_chainLeaders[leaderId * _variableCount]);
       _chainLeadersLogPriors[leaderId] = _sampleLogPriorDatabase[i];
       _chainLeadersLogLikelihoods[leaderId] = _sampleLogLikelihoodDatabase[i];
       if (_version == "mTMCMC")
       {
         _chainLeadersErrors[leaderId] = _sampleErrorDatabase[i];
-        _chainLeadersGradients[leaderId] = _sampleGradientDatabase[i];
-        _chainLeadersCovariance[leaderId] = _sampleCovariancesDatabase[i];
+        std::copy_n(&_sampleGradientDatabase[i * _variableCount], _variableCount, &_chainLeadersGradients[leaderId * _variableCount]);
+        std::copy_n(&_sampleCovariancesDatabase[i * _variableCount * _variableCount], _variableCount * _variableCount, &_chainLeadersCovariance[leaderId * _variableCount * _variableCount]);
       }
 
-      if (numselections[i] > _maxChainLength)
+      if (numselections[i] > maxChainLength)
       {
         /* uniform splitting of chains */
-        size_t rest = (numselections[i] % _maxChainLength != 0);
-        leaderChainLen = _maxChainLength - rest;
+        size_t rest = (numselections[i] % maxChainLength != 0);
+        leaderChainLen = maxChainLength - rest;
       }
       else
       {
@@ -370,22 +374,88 @@ void TMCMC::processGeneration()
     for (size_t i = 0; i < _populationSize; ++i)
     {
       if (_chainLeadersErrors[i] != 0) continue;
-      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i][0], _variableCount);
+      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i * _variableCount], _variableCount);
       gsl_vector_scale(&gradLeader.vector, _annealingExponent / _previousAnnealingExponent);
 
-      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i][0], _variableCount, _variableCount);
+      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i * _variableCount * _variableCount], _variableCount, _variableCount);
       gsl_matrix_scale(&covLeader.matrix, _annealingExponent / _previousAnnealingExponent);
     }
 
   /* Update acceptance statistics */
   size_t uniqueSelections = _populationSize - zeroCount;
   _proposalsAcceptanceRate = (1.0 * _acceptedSamplesCount) / _populationSize;
+  if (_version == "SMC") _proposalsAcceptanceRate /= (double)(_currentBurnIn + 1);
   _selectionAcceptanceRate = (1.0 * uniqueSelections) / _populationSize;
 
+  if (_version == "SMC") updateMovesPerParticle();
+
   _maxLoglikelihood = *std::max_element(_sampleLogLikelihoodDatabase.begin(), _sampleLogLikelihoodDatabase.end());
   _chainCount = leaderId;
 }
 
+void TMCMC::resample(const std::vector<double> &weight, std::vector<unsigned int> &numselections)
+{
+  if (_resamplingMethod == "Multinomial")
+  {
+    std::vector<double> p(weight);
+    _multinomialGenerator->getSelections(p, numselections, _populationSize);
+  }
+  else if (_resamplingMethod == "Systematic")
+  {
+    // One uniform offset on an evenly spaced grid over the cumulative weights
+    std::fill(numselections.begin(), numselections.end(), 0);
+    const double u = _uniformGenerator->getRandomNumber();
+    double cumWeight = 0.0;
+    size_t j = 0;
+    for (size_t i = 0; i < _populationSize; i++)
+    {
+      cumWeight += weight[i] * _populationSize;
+      while ((j < _populationSize) && (j + u < cumWeight))
+      {
+        numselections[i]++;
+        j++;
+      }
+    }
+    // Guard against round-off in the cumulative weights
+    numselections[_populationSize - 1] += _populationSize - j;
+  }
+  else /* _resamplingMethod == "Residual" */
+  {
+    // Deterministic selections from the integer part, remainder drawn from the residual weights
+    std::vector<double> residual(_populationSize);
+    size_t numDeterministic = 0;
+    for (size_t i = 0; i < _populationSize; i++)
+    {
+      const double expected = weight[i] * _populationSize;
+      numselections[i] = (unsigned int)std::floor(expected);
+      residual[i] = expected - numselections[i];
+      numDeterministic += numselections[i];
+    }
+
+    if (numDeterministic < _populationSize)
+    {
+      std::vector<unsigned int> residualSelections(_populationSize);
+      _multinomialGenerator->getSelections(residual, residualSelections, _populationSize - numDeterministic);
+      for (size_t i = 0; i < _populationSize; i++) numselections[i] += residualSelections[i];
+    }
+  }
+}
+
+void TMCMC::updateMovesPerParticle()
+{
+  // Number of moves such that a particle remains unmoved with Target Unmoved Probability: (1 - acceptance rate)^moves = p
+  if (_k->_currentGeneration == 1) return;
+
+  if (_proposalsAcceptanceRate <= 0.0)
+    _movesPerParticle = _maxMovesPerParticle;
+  else if (_proposalsAcceptanceRate >= 1.0)
+    _movesPerParticle = 1;
+  else
+    _movesPerParticle = (size_t)std::ceil(std::log(_targetUnmovedProbability) / std::log(1.0 - _proposalsAcceptanceRate));
+
+  _movesPerParticle = std::min(std::max(_movesPerParticle, (size_t)1), _maxMovesPerParticle);
+}
+
 void TMCMC::calculateGradients(std::vector<Sample> &samples)
 {
   size_t numGradientCalculations = 0.0;
@@ -403,8 +473,8 @@ void TMCMC::calculateGradients(std::vector<Sample> &samples)
   {
     size_t finishedId = KORALI_WAITANY(samples);
 
-    _chainCandidatesGradients[finishedId] = KORALI_GET(std::vector<double>, samples[finishedId], "logLikelihood Gradient");
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidatesGradients[finishedId][d] *= _annealingExponent;
+    std::vector<double> gradient = KORALI_GET(std::vector<double>, samples[finishedId], "logLikelihood Gradient");
+    for (size_t d = 0; d < _variableCount; ++d) _chainCandidatesGradients[finishedId * _variableCount + d] = _annealingExponent * gradient[d];
   }
 }
 
@@ -431,7 +501,7 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
     // printf("%s\n", samples[finishedId]._js.getJson().dump(2).c_str());
 
     // reset
-    std::fill(_chainCandidatesCovariance[finishedId].begin(), _chainCandidatesCovariance[finishedId].end(), 0.0);
+    std::fill_n(&_chainCandidatesCovariance[finishedId * Nth * Nth], Nth * Nth, 0.0);
 
     std::vector<double> FIM = samples[finishedId]["Fisher Information"];
     gsl_matrix_view FIMview = gsl_matrix_view_array(&FIM[0], Nth, Nth);
@@ -504,7 +574,7 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
     double distToUpper, distToLower;
     double len, chi2inv = gsl_cdf_chisq_Pinv(0.68, Nth);
 
-    gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[finishedId][0], Nth);
+    gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[finishedId * Nth], Nth);
 
     for (size_t d = 0; d < Nth; ++d)
     {
@@ -521,8 +591,8 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
       // measure overshoot & undershoot in all dims
       for (size_t e = 0; e < Nth; ++e)
       {
-        distToUpper = _upperExtendedBoundaries[e] - _chainCandidates[finishedId][e];
-        distToLower = _chainCandidates[finishedId][e] - _lowerExtendedBoundaries[e];
+        distToUpper = _upperExtendedBoundaries[e] - _chainCandidates[finishedId * Nth + e];
+        distToLower = _chainCandidates[finishedId * Nth + e] - _lowerExtendedBoundaries[e];
 
         len = gsl_vector_get(ccpy0, e) - _upperExtendedBoundaries[e];
         if (len > 0.) scale = std::min(scale, std::abs(1.0 / gsl_vector_get(&evec.vector, e) * distToUpper));
@@ -551,7 +621,7 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
       gsl_vector_scale(&evec.vector, sqrt(gsl_vector_get(Evals, d)));
     }
 
-    gsl_matrix_view candidatecov = gsl_matrix_view_array(&_chainCandidatesCovariance[finishedId][0], Nth, Nth);
+    gsl_matrix_view candidatecov = gsl_matrix_view_array(&_chainCandidatesCovariance[finishedId * Nth * Nth], Nth, Nth);
     gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, Evecs, Evecs, 0.0, &candidatecov.matrix);
 
     gsl_matrix_free(Evecs);
@@ -565,18 +635,18 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
 
 void TMCMC::generateCandidate(const size_t sampleId)
 {
-  if (_version == "TMCMC")
+  if (_version != "mTMCMC")
   {
-    _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
-    for (size_t d = 0; d < _variableCount; d++) _chainCandidates[sampleId][d] += _chainLeaders[sampleId][d];
+    _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId * _variableCount], _variableCount);
+    for (size_t d = 0; d < _variableCount; d++) _chainCandidates[sampleId * _variableCount + d] += _chainLeaders[sampleId * _variableCount + d];
   }
   else /* "mTMCMC" */
   {
     // TODO: refine error treatment granularity
     if (_chainLeadersErrors[sampleId] == 0)
     {
-      _multivariateGenerator->_meanVector = _chainLeaders[sampleId];
-      for (size_t i = 0; i < _variableCount * _variableCount; ++i) _multivariateGenerator->_sigma[i] = _chainLeadersCovariance[sampleId][i] * _stepSize;
+      _multivariateGenerator->_meanVector.assign(&_chainLeaders[sampleId * _variableCount], &_chainLeaders[sampleId * _variableCount] + _variableCount);
+      for (size_t i = 0; i < _variableCount * _variableCount; ++i) _multivariateGenerator->_sigma[i] = _chainLeadersCovariance[sampleId * _variableCount * _variableCount + i] * _stepSize;
 
       /* Cholesky Decomp */
       gsl_matrix_view sigma = gsl_matrix_view_array(&_multivariateGenerator->_sigma[0], _variableCount, _variableCount);
@@ -584,11 +654,11 @@ void TMCMC::generateCandidate(const size_t sampleId)
       if (status == GSL_SUCCESS)
       {
         _multivariateGenerator->updateDistribution();
-        _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
+        _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId * _variableCount], _variableCount);
 
-        gsl_vector_view candidate = gsl_vector_view_array(&_chainCandidates[sampleId][0], _variableCount);
-        gsl_vector_const_view leaderGrad = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId][0], _variableCount);
-        gsl_matrix_const_view leaderCov = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId][0], _variableCount, _variableCount);
+        gsl_vector_view candidate = gsl_vector_view_array(&_chainCandidates[sampleId * _variableCount], _variableCount);
+        gsl_vector_const_view leaderGrad = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId * _variableCount], _variableCount);
+        gsl_matrix_const_view leaderCov = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId * _variableCount * _variableCount], _variableCount, _variableCount);
         gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &leaderCov.matrix, &leaderGrad.vector, 1.0, &candidate.vector);
       }
 
@@ -601,7 +671,7 @@ void TMCMC::generateCandidate(const size_t sampleId)
     }
     if (_chainLeadersErrors[sampleId] != 0) /* error */
     {
-      _multivariateGenerator->_meanVector = _chainLeaders[sampleId];
+      _multivariateGenerator->_meanVector.assign(&_chainLeaders[sampleId * _variableCount], &_chainLeaders[sampleId * _variableCount] + _variableCount);
       _multivariateGenerator->_sigma = _covarianceMatrix;
 
       /* Cholesky Decomp */
@@ -609,22 +679,25 @@ void TMCMC::generateCandidate(const size_t sampleId)
       gsl_linalg_cholesky_decomp(&sigma.matrix);
 
       _multivariateGenerator->updateDistribution();
-      _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
+      _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId * _variableCount], _variableCount);
     }
   }
 }
 
 void TMCMC::updateDatabase(const size_t sampleId)
 {
-  _sampleDatabase.push_back(_chainLeaders[sampleId]);
-  _sampleLogPriorDatabase.push_back(_chainLeadersLogPriors[sampleId]);
-  _sampleLogLikelihoodDatabase.push_back(_chainLeadersLogLikelihoods[sampleId]);
+  if (_databaseEntries >= _populationSize) KORALI_LOG_ERROR("Sample database overflow: more than %zu entries in generation %zu.\n", _populationSize, _k->_currentGeneration);
+  const size_t entryId = _databaseEntries++;
+
+  std::copy_n(&_chainLeaders[sampleId * _variableCount], _variableCount, &_sampleDatabase[entryId * _variableCount]);
+  _sampleLogPriorDatabase[entryId] = _chainLeadersLogPriors[sampleId];
+  _sampleLogLikelihoodDatabase[entryId] = _chainLeadersLogLikelihoods[sampleId];
 
   if (_version == "mTMCMC")
   {
-    _sampleErrorDatabase.push_back(_chainLeadersErrors[sampleId]);
-    _sampleGradientDatabase.push_back(_chainLeadersGradients[sampleId]);
-    _sampleCovariancesDatabase.push_back(_chainLeadersCovariance[sampleId]);
+    _sampleErrorDatabase[entryId] = _chainLeadersErrors[sampleId];
+    std::copy_n(&_chainLeadersGradients[sampleId * _variableCount], _variableCount, &_sampleGradientDatabase[entryId * _variableCount]);
+    std::copy_n(&_chainLeadersCovariance[sampleId * _variableCount * _variableCount], _variableCount * _variableCount, &_sampleCovariancesDatabase[entryId * _variableCount * _variableCount]);
   }
 }
 
@@ -633,7 +706,7 @@ double TMCMC::calculateAcceptanceProbability(const size_t sampleId)
   double P = 0.0;
   if (std::isfinite(_chainCandidatesLogPriors[sampleId]) && std::isfinite(_chainCandidatesLogLikelihoods[sampleId]))
   {
-    if (_version == "TMCMC")
+    if (_version != "mTMCMC")
     {
       P = exp((_chainCandidatesLogLikelihoods[sampleId] - _chainLeadersLogLikelihoods[sampleId]) * _annealingExponent + (_chainCandidatesLogPriors[sampleId] - _chainLeadersLogPriors[sampleId]));
     }
@@ -642,8 +715,8 @@ double TMCMC::calculateAcceptanceProbability(const size_t sampleId)
       // TODO: refine error treatment granularity
       if ((_chainLeadersErrors[sampleId] == 0) && (_chainCandidatesErrors[sampleId] == 0))
       {
-        gsl_vector_const_view leader = gsl_vector_const_view_array(&_chainLeaders[sampleId][0], _variableCount);
-        gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[sampleId][0], _variableCount);
+        gsl_vector_const_view leader = gsl_vector_const_view_array(&_chainLeaders[sampleId * _variableCount], _variableCount);
+        gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[sampleId * _variableCount], _variableCount);
 
         gsl_vector *meanLeader = gsl_vector_alloc(_variableCount);
         gsl_vector_memcpy(meanLeader, &leader.vector);
@@ -651,10 +724,10 @@ double TMCMC::calculateAcceptanceProbability(const size_t sampleId)
         gsl_vector *meanCandidate = gsl_vector_alloc(_variableCount);
         gsl_vector_memcpy(meanCandidate, &candidate.vector);
 
-        gsl_vector_const_view gradLeader = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId][0], _variableCount);
-        gsl_vector_const_view gradCandidate = gsl_vector_const_view_array(&_chainCandidatesGradients[sampleId][0], _variableCount);
+        gsl_vector_const_view gradLeader = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId * _variableCount], _variableCount);
+        gsl_vector_const_view gradCandidate = gsl_vector_const_view_array(&_chainCandidatesGradients[sampleId * _variableCount], _variableCount);
 
-        gsl_matrix_const_view covLeader = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId][0], _variableCount, _variableCount);
+        gsl_matrix_const_view covLeader = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId * _variableCount * _variableCount], _variableCount, _variableCount);
 
         gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &covLeader.matrix, &gradLeader.vector, 1.0, meanLeader);
         gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &covLeader.matrix, &gradCandidate.vector, 1.0, meanCandidate);
@@ -788,6 +861,8 @@ void TMCMC::setBurnIn()
 {
   if (_k->_currentGeneration <= 1)
     _currentBurnIn = 0;
+  else if (_version == "SMC")
+    _currentBurnIn = _movesPerParticle - 1;
   else if (_k->_currentGeneration - 2 < _perGenerationBurnIn.size())
     _currentBurnIn = _perGenerationBurnIn[_k->_currentGeneration - 2];
   else
@@ -796,8 +871,10 @@ void TMCMC::setBurnIn()
 
 void TMCMC::finalize()
 {
-  // Setting results
-  (*_k)["Results"]["Sample Database"] = _sampleDatabase;
+  // Setting results, one row per sample
+  std::vector<std::vector<double>> sampleDatabase(_databaseEntries);
+  for (size_t i = 0; i < _databaseEntries; i++) sampleDatabase[i].assign(&_sampleDatabase[i * _variableCount], &_sampleDatabase[i * _variableCount] + _variableCount);
+  (*_k)["Results"]["Sample Database"] = sampleDatabase;
 }
 
 void TMCMC::printGenerationBefore()
@@ -823,6 +900,8 @@ void TMCMC::printGenerationAfter()
     _k->_logger->logInfo("Detailed", "Number Of Cholesky Decomposition Errors: %zu\n", _numCholeskyDecompositionFailuresProposal);
   }
 
+  if (_version == "SMC") _k->_logger->logInfo("Normal", "MCMC Moves Per Particle: %zu\n", _movesPerParticle);
+
   _k->_logger->logInfo("Detailed", "Sample Mean:\n");
   for (size_t i = 0; i < _variableCount; i++) _k->_logger->logData("Detailed", " %s = %+6.3e\n", _k->_variables[i]->_name.c_str(), _meanTheta[i]);
   _k->_logger->logInfo("Detailed", "Sample Covariance:\n");
@@ -870,6 +949,14 @@ void TMCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Uniform Generator");
  }
 
+ if (isDefined(js, "Moves Per Particle"))
+ {
+ try { _movesPerParticle = js["Moves Per Particle"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Moves Per Particle']\n%s", e.what()); } 
+   eraseValue(js, "Moves Per Particle");
+ }
+
  if (isDefined(js, "Current Burn In"))
  {
  try { _currentBurnIn = js["Current Burn In"].get<size_t>();
@@ -896,7 +983,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates"))
  {
- try { _chainCandidates = js["Chain Candidates"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidates = js["Chain Candidates"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates");
@@ -920,7 +1007,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates Gradients"))
  {
- try { _chainCandidatesGradients = js["Chain Candidates Gradients"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidatesGradients = js["Chain Candidates Gradients"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates Gradients']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates Gradients");
@@ -936,7 +1023,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates Covariance"))
  {
- try { _chainCandidatesCovariance = js["Chain Candidates Covariance"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidatesCovariance = js["Chain Candidates Covariance"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates Covariance']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates Covariance");
@@ -944,7 +1031,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders"))
  {
- try { _chainLeaders = js["Chain Leaders"].get<std::vector<std::vector<double>>>();
+ try { _chainLeaders = js["Chain Leaders"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders");
@@ -968,7 +1055,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders Gradients"))
  {
- try { _chainLeadersGradients = js["Chain Leaders Gradients"].get<std::vector<std::vector<double>>>();
+ try { _chainLeadersGradients = js["Chain Leaders Gradients"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders Gradients']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders Gradients");
@@ -984,7 +1071,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders Covariance"))
  {
- try { _chainLeadersCovariance = js["Chain Leaders Covariance"].get<std::vector<std::vector<double>>>();
+ try { _chainLeadersCovariance = js["Chain Leaders Covariance"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders Covariance']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders Covariance");
@@ -1120,12 +1207,20 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Database"))
  {
- try { _sampleDatabase = js["Sample Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleDatabase = js["Sample Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Database");
  }
 
+ if (isDefined(js, "Database Entries"))
+ {
+ try { _databaseEntries = js["Database Entries"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Database Entries']\n%s", e.what()); } 
+   eraseValue(js, "Database Entries");
+ }
+
  if (isDefined(js, "Sample LogLikelihood Database"))
  {
  try { _sampleLogLikelihoodDatabase = js["Sample LogLikelihood Database"].get<std::vector<double>>();
@@ -1144,7 +1239,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Gradient Database"))
  {
- try { _sampleGradientDatabase = js["Sample Gradient Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleGradientDatabase = js["Sample Gradient Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Gradient Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Gradient Database");
@@ -1160,7 +1255,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Covariances Database"))
  {
- try { _sampleCovariancesDatabase = js["Sample Covariances Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleCovariancesDatabase = js["Sample Covariances Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Covariances Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Covariances Database");
@@ -1239,6 +1334,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
  bool validOption = false; 
  if (_version == "TMCMC") validOption = true; 
  if (_version == "mTMCMC") validOption = true; 
+ if (_version == "SMC") validOption = true; 
  if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Version'] required by TMCMC.\n", _version.c_str()); 
 }
    eraseValue(js, "Version");
@@ -1290,6 +1386,40 @@ void TMCMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Target Coefficient Of Variation'] required by TMCMC.\n"); 
 
+ if (isDefined(js, "Resampling Method"))
+ {
+ try { _resamplingMethod = js["Resampling Method"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Resampling Method']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_resamplingMethod == "Multinomial") validOption = true; 
+ if (_resamplingMethod == "Systematic") validOption = true; 
+ if (_resamplingMethod == "Residual") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Resampling Method'] required by TMCMC.\n", _resamplingMethod.c_str()); 
+}
+   eraseValue(js, "Resampling Method");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Resampling Method'] required by TMCMC.\n"); 
+
+ if (isDefined(js, "Target Unmoved Probability"))
+ {
+ try { _targetUnmovedProbability = js["Target Unmoved Probability"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Target Unmoved Probability']\n%s", e.what()); } 
+   eraseValue(js, "Target Unmoved Probability");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Target Unmoved Probability'] required by TMCMC.\n"); 
+
+ if (isDefined(js, "Max Moves Per Particle"))
+ {
+ try { _maxMovesPerParticle = js["Max Moves Per Particle"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Max Moves Per Particle']\n%s", e.what()); } 
+   eraseValue(js, "Max Moves Per Particle");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Max Moves Per Particle'] required by TMCMC.\n"); 
+
  if (isDefined(js, "Covariance Scaling"))
  {
  try { _covarianceScaling = js["Covariance Scaling"].get<double>();
@@ -1360,6 +1490,9 @@ void TMCMC::getConfiguration(knlohmann::json& js)
    js["Burn In"] = _burnIn;
    js["Per Generation Burn In"] = _perGenerationBurnIn;
    js["Target Coefficient Of Variation"] = _targetCoefficientOfVariation;
+   js["Resampling Method"] = _resamplingMethod;
+   js["Target Unmoved Probability"] = _targetUnmovedProbability;
+   js["Max Moves Per Particle"] = _maxMovesPerParticle;
    js["Covariance Scaling"] = _covarianceScaling;
    js["Min Annealing Exponent Update"] = _minAnnealingExponentUpdate;
    js["Max Annealing Exponent Update"] = _maxAnnealingExponentUpdate;
@@ -1369,6 +1502,7 @@ void TMCMC::getConfiguration(knlohmann::json& js)
  if(_multinomialGenerator != NULL) _multinomialGenerator->getConfiguration(js["Multinomial Generator"]);
  if(_multivariateGenerator != NULL) _multivariateGenerator->getConfiguration(js["Multivariate Generator"]);
  if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+   js["Moves Per Particle"] = _movesPerParticle;
    js["Current Burn In"] = _currentBurnIn;
    js["Chain Pending Evaluation"] = _chainPendingEvaluation;
    js["Chain Pending Gradient"] = _chainPendingGradient;
@@ -1401,6 +1535,7 @@ void TMCMC::getConfiguration(knlohmann::json& js)
    js["Max Loglikelihood"] = _maxLoglikelihood;
    js["Mean Theta"] = _meanTheta;
    js["Sample Database"] = _sampleDatabase;
+   js["Database Entries"] = _databaseEntries;
    js["Sample LogLikelihood Database"] = _sampleLogLikelihoodDatabase;
    js["Sample LogPrior Database"] = _sampleLogPriorDatabase;
    js["Sample Gradient Database"] = _sampleGradientDatabase;
@@ -1420,7 +1555,7 @@ void TMCMC::getConfiguration(knlohmann::json& js)
 void TMCMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Multinomial Generator\": {\"Type\": \"Specific/Multinomial\"}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Version\": \"TMCMC\", \"Max Chain Length\": 1, \"Burn In\": 0, \"Per Generation Burn In\": [], \"Target Coefficient Of Variation\": 1.0, \"Covariance Scaling\": 0.04, \"Min Annealing Exponent Update\": 1e-05, \"Max Annealing Exponent Update\": 1.0, \"Domain Extension Factor\": 0.2, \"Step Size\": 0.1, \"Termination Criteria\": {\"Target Annealing Exponent\": 1.0}}";
+ std::string defaultString = "{\"Multinomial Generator\": {\"Type\": \"Specific/Multinomial\"}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Version\": \"TMCMC\", \"Max Chain Length\": 1, \"Resampling Method\": \"Multinomial\", \"Target Unmoved Probability\": 0.01, \"Max Moves Per Particle\": 20, \"Burn In\": 0, \"Per Generation Burn In\": [], \"Target Coefficient Of Variation\": 1.0, \"Covariance Scaling\": 0.04, \"Min Annealing Exponent Update\": 1e-05, \"Max Annealing Exponent Update\": 1.0, \"Domain Extension Factor\": 0.2, \"Step Size\": 0.1, \"Termination Criteria\": {\"Target Annealing Exponent\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
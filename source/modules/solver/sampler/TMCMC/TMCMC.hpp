@@ -58,6 +58,12 @@ typedef struct fparam_s
 */
 class TMCMC : public Sampler
 {
+  private:
+  /**
+   * @brief Database rows centered by the sample mean and scaled by the square root of their weights (row-major), used to compute the proposal covariance
+   */
+  std::vector<double> _weightedCenteredSamples;
+
   public: 
   /**
   * @brief Indicates which variant of the TMCMC algorithm to use.
@@ -84,6 +90,18 @@ class TMCMC : public Sampler
   */
    double _targetCoefficientOfVariation;
   /**
+  * @brief Scheme used to select the samples of the next generation based on their plausibility weights.
+  */
+   std::string _resamplingMethod;
+  /**
+  * @brief Target probability that a particle did not accept any of its MCMC moves. The number of moves per particle is chosen from the acceptance rate of the previous generation (only relevant for SMC).
+  */
+   double _targetUnmovedProbability;
+  /**
+  * @brief Maximal number of MCMC moves per particle per generation, also used in the first generation with MCMC moves (only relevant for SMC).
+  */
+   size_t _maxMovesPerParticle;
+  /**
   * @brief Scaling factor :math:`\beta^2` of Covariance Matrix (by default, this value is 0.04 as suggested in [Ching2007]).
   */
    double _covarianceScaling;
@@ -116,6 +134,10 @@ class TMCMC : public Sampler
   */
    korali::distribution::univariate::Uniform* _uniformGenerator;
   /**
+  * @brief [Internal Use] Number of MCMC moves per particle in the current generation (only relevant for SMC).
+  */
+   size_t _movesPerParticle;
+  /**
   * @brief [Internal Use] Actual placeholder for burn in steps per generation, calculated from Burn In Default, Burn In and Current Generation.
   */
    size_t _currentBurnIn;
@@ -128,9 +150,9 @@ class TMCMC : public Sampler
   */
    std::vector<int> _chainPendingGradient;
   /**
-  * @brief [Internal Use] All candidates of all chains to evaluate in order to advance the markov chains.
+  * @brief [Internal Use] All candidates of all chains to evaluate in order to advance the markov chains, stored contiguously (row-major, one row of Variable Count entries per chain).
   */
-   std::vector<std::vector<double>> _chainCandidates;
+   std::vector<double> _chainCandidates;
   /**
   * @brief [Internal Use] The loglikelihoods of the chain candidates.
   */
@@ -140,21 +162,21 @@ class TMCMC : public Sampler
   */
    std::vector<double> _chainCandidatesLogPriors;
   /**
-  * @brief [Internal Use] Candidate gradient of statistical model wrt. sample variables.
+  * @brief [Internal Use] Candidate gradient of statistical model wrt. sample variables, stored contiguously (row-major, one row per chain).
   */
-   std::vector<std::vector<double>> _chainCandidatesGradients;
+   std::vector<double> _chainCandidatesGradients;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for candidate (only relevant for mTMCMC).
   */
    std::vector<int> _chainCandidatesErrors;
   /**
-  * @brief [Internal Use] Candidates covariance of normal proposal distribution.
+  * @brief [Internal Use] Candidates covariance of normal proposal distribution, stored contiguously (one row-major Variable Count x Variable Count block per chain).
   */
-   std::vector<std::vector<double>> _chainCandidatesCovariance;
+   std::vector<double> _chainCandidatesCovariance;
   /**
-  * @brief [Internal Use] Leading parameters of all chains to be accepted.
+  * @brief [Internal Use] Leading parameters of all chains to be accepted, stored contiguously (row-major, one row of Variable Count entries per chain).
   */
-   std::vector<std::vector<double>> _chainLeaders;
+   std::vector<double> _chainLeaders;
   /**
   * @brief [Internal Use] The loglikelihoods of the chain leaders.
   */
@@ -164,17 +186,17 @@ class TMCMC : public Sampler
   */
    std::vector<double> _chainLeadersLogPriors;
   /**
-  * @brief [Internal Use] Leader gradient of statistical model wrt. sample variables.
+  * @brief [Internal Use] Leader gradient of statistical model wrt. sample variables, stored contiguously (row-major, one row per chain).
   */
-   std::vector<std::vector<double>> _chainLeadersGradients;
+   std::vector<double> _chainLeadersGradients;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for leader (only relevant for mTMCMC).
   */
    std::vector<int> _chainLeadersErrors;
   /**
-  * @brief [Internal Use] Leader covariance of normal proposal distribution.
+  * @brief [Internal Use] Leader covariance of normal proposal distribution, stored contiguously (one row-major Variable Count x Variable Count block per chain).
   */
-   std::vector<std::vector<double>> _chainLeadersCovariance;
+   std::vector<double> _chainLeadersCovariance;
   /**
   * @brief [Internal Use] Number of finished chains.
   */
@@ -240,9 +262,13 @@ class TMCMC : public Sampler
   */
    std::vector<double> _meanTheta;
   /**
-  * @brief [Internal Use] Parameters stored in the database (taken from the chain leaders).
+  * @brief [Internal Use] Parameters stored in the database (taken from the chain leaders), stored contiguously (row-major, one row of Variable Count entries per sample).
+  */
+   std::vector<double> _sampleDatabase;
+  /**
+  * @brief [Internal Use] Number of samples stored in the database in the current generation.
   */
-   std::vector<std::vector<double>> _sampleDatabase;
+   size_t _databaseEntries;
   /**
   * @brief [Internal Use] LogLikelihood Evaluation of the parameters stored in the database.
   */
@@ -252,17 +278,17 @@ class TMCMC : public Sampler
   */
    std::vector<double> _sampleLogPriorDatabase;
   /**
-  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC).
+  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC), stored contiguously (row-major, one row per sample).
   */
-   std::vector<std::vector<double>> _sampleGradientDatabase;
+   std::vector<double> _sampleGradientDatabase;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for sample (only relevant for mTMCMC).
   */
    std::vector<int> _sampleErrorDatabase;
   /**
-  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC).
+  * @brief [Internal Use] Proposal covariances stored in the database (taken from the chain leaders, only mTMCMC), stored contiguously (one row-major Variable Count x Variable Count block per sample).
   */
-   std::vector<std::vector<double>> _sampleCovariancesDatabase;
+   std::vector<double> _sampleCovariancesDatabase;
   /**
   * @brief [Internal Use] Calculated upper domain boundaries (only relevant for mTMCMC).
   */
@@ -383,6 +409,18 @@ class TMCMC : public Sampler
    */
   void updateDatabase(const size_t sampleId);
 
+  /**
+   * @brief Selects the samples of the next generation according to the Resampling Method.
+   * @param weight Normalized plausibility weights of the database entries
+   * @param numselections Number of times each database entry is selected (sums to Population Size)
+   */
+  void resample(const std::vector<double> &weight, std::vector<unsigned int> &numselections);
+
+  /**
+   * @brief Sets the number of MCMC moves per particle from the acceptance rate of the last generation (only relevant for SMC).
+   */
+  void updateMovesPerParticle();
+
   /**
    * @brief Calculate acceptance probability.
    * @param sampleId Id of the sample to calculate acceptance probability
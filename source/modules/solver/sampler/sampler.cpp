@@ -1,11 +1,93 @@
 #include "modules/solver/sampler/sampler.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace korali
 {
 namespace solver
 {
 ;
 
+void Sampler::computeConvergenceDiagnostics(const std::vector<std::vector<double>> &samples, const size_t chainCount, std::vector<double> &potentialScaleReduction, std::vector<double> &effectiveSampleSize) const
+{
+  const size_t dim = samples.empty() ? 0 : samples[0].size();
+  const size_t chainLength = chainCount == 0 ? 0 : samples.size() / chainCount;
+
+  potentialScaleReduction.assign(dim, std::numeric_limits<double>::infinity());
+  effectiveSampleSize.assign(dim, 0.0);
+
+  // Not enough samples to estimate the autocorrelation
+  if (chainLength < 4) return;
+
+  const double n = (double)chainLength;
+  const double m = (double)chainCount;
+
+  std::vector<double> chainMeans(chainCount);
+
+  for (size_t d = 0; d < dim; d++)
+  {
+    // Within-chain (W) and between-chain (B) variances, as in Gelman et al., Bayesian Data Analysis (2013)
+    double mean = 0.0;
+    for (size_t c = 0; c < chainCount; c++)
+    {
+      double chainMean = 0.0;
+      for (size_t i = 0; i < chainLength; i++) chainMean += samples[i * chainCount + c][d];
+      chainMeans[c] = chainMean / n;
+      mean += chainMeans[c];
+    }
+    mean /= m;
+
+    double W = 0.0;
+    for (size_t c = 0; c < chainCount; c++)
+      for (size_t i = 0; i < chainLength; i++)
+      {
+        const double diff = samples[i * chainCount + c][d] - chainMeans[c];
+        W += diff * diff;
+      }
+    W /= m * (n - 1.0);
+
+    double B = 0.0;
+    if (chainCount > 1)
+    {
+      for (size_t c = 0; c < chainCount; c++) B += (chainMeans[c] - mean) * (chainMeans[c] - mean);
+      B *= n / (m - 1.0);
+    }
+
+    // Constant chains carry no information
+    if (W <= 0.0) continue;
+
+    const double varPlus = (n - 1.0) / n * W + B / n;
+    potentialScaleReduction[d] = std::sqrt(varPlus / W);
+
+    // Autocorrelation at a given lag, combining the autocovariances of all chains
+    auto autocorrelation = [&](const size_t lag) {
+      double autocovariance = 0.0;
+      for (size_t c = 0; c < chainCount; c++)
+        for (size_t i = 0; i + lag < chainLength; i++)
+          autocovariance += (samples[i * chainCount + c][d] - chainMeans[c]) * (samples[(i + lag) * chainCount + c][d] - chainMeans[c]);
+      autocovariance /= m * n;
+      return 1.0 - (W - autocovariance) / varPlus;
+    };
+
+    // Geyer's initial monotone sequence estimator of the integrated autocorrelation time
+    double pairSum = 0.0;
+    double previousPair = std::numeric_limits<double>::infinity();
+    for (size_t lag = 0; lag + 1 < chainLength; lag += 2)
+    {
+      double pair = autocorrelation(lag) + autocorrelation(lag + 1);
+      if (pair < 0.0) break;
+      pair = std::min(pair, previousPair);
+      previousPair = pair;
+      pairSum += pair;
+    }
+
+    const double tau = std::max(2.0 * pairSum - 1.0, 1.0 / std::log10(m * n));
+    effectiveSampleSize[d] = m * n / tau;
+  }
+}
+
 void Sampler::setConfiguration(knlohmann::json& js) 
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
@@ -90,4 +172,4 @@ bool Sampler::checkTermination()
 
 } //solver
 } //korali
-;
\ No newline at end of file
+;
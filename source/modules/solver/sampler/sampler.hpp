@@ -13,6 +13,7 @@
 #pragma once
 
 #include "modules/solver/solver.hpp"
+#include <vector>
 
 namespace korali
 {
@@ -54,6 +55,14 @@ class Sampler : public Solver
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Computes convergence diagnostics of a set of Markov chains of equal length.
+   * @param samples Samples of all chains, interleaved by chain (entry i * chainCount + c belongs to chain c)
+   * @param chainCount Number of chains
+   * @param potentialScaleReduction Storage for the Gelman-Rubin Potential Scale Reduction (R-hat) of each variable
+   * @param effectiveSampleSize Storage for the Effective Sample Size of each variable, pooled over all chains
+   */
+  void computeConvergenceDiagnostics(const std::vector<std::vector<double>> &samples, const size_t chainCount, std::vector<double> &potentialScaleReduction, std::vector<double> &effectiveSampleSize) const;
 };
 
 } //solver
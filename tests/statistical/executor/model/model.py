@@ -8,3 +8,10 @@ def model_propagation(s):
     var = s['Parameters'][1]
 
     print(np.random.normal(mu, var, 1))
+
+evaluationCount = 0
+
+def model_counted(s):
+    global evaluationCount
+    evaluationCount += 1
+    s['Evaluation'] = s['Parameters'][0] + s['Parameters'][1]
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+import os
+import sys
+sys.path.append('./model/')
+import model
+import numpy as np
+
+### Evaluation cache: repeated parameters are evaluated only once
+
+import korali
+cachePath = '_korali_cache_executor.json'
+if os.path.exists(cachePath): os.remove(cachePath)
+
+def createExperiment():
+  e = korali.Experiment()
+
+  e["Problem"]["Type"] = "Propagation"
+  e["Problem"]["Execution Model"] = model.model_counted
+
+  # Every parameter combination appears twice
+  e["Variables"][0]["Name"] = "X"
+  e["Variables"][0]["Precomputed Values"] = list(range(50)) * 2
+  e["Variables"][1]["Name"] = "Y"
+  e["Variables"][1]["Precomputed Values"] = list(range(50, 100)) * 2
+
+  e["Solver"]["Type"] = "Executor"
+  e["Solver"]["Executions Per Generation"] = 10
+
+  e["Evaluation Cache"]["Enabled"] = True
+  e["Evaluation Cache"]["Path"] = cachePath
+  e["Console Output"]["Verbosity"] = "Normal"
+  e["File Output"]["Enabled"] = False
+  return e
+
+k = korali.Engine()
+
+e = createExperiment()
+k.run(e)
+assert model.evaluationCount == 50, "Expected 50 model evaluations, got {0}".format(model.evaluationCount)
+assert e["Evaluation Cache"]["Hit Count"] == 50
+assert e["Evaluation Cache"]["Miss Count"] == 50
+
+# A restarted run reuses the persisted evaluations
+e = createExperiment()
+k.run(e)
+assert model.evaluationCount == 50, "Expected no new model evaluations, got {0}".format(model.evaluationCount - 50)
+assert e["Evaluation Cache"]["Hit Count"] == 100
+
+os.remove(cachePath)
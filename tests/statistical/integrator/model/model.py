@@ -6,3 +6,7 @@ import numpy as np
 def model_integration(s):
   x = s["Parameters"][0]
   s["Evaluation"] = x**2
+
+def model_gaussian(s):
+  x = np.array(s["Parameters"])
+  s["Evaluation"] = np.exp(-np.sum(x**2))
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+import os
+import sys
+import math
+sys.path.append('./model/')
+from model import model_gaussian
+import numpy as np
+
+### Adaptive methods on a 10-dimensional integrand with a tolerance
+
+import korali
+k = korali.Engine()
+
+dim = 10
+exact = (0.5 * math.sqrt(math.pi) * math.erf(1.0))**dim
+
+for method, tolerance in [ ("Sparse Grid", 1e-6), ("Sobol", 1e-4), ("Halton", 1e-4) ]:
+  e = korali.Experiment()
+
+  e["Problem"]["Type"] = "Integration"
+  e["Problem"]["Integrand"] = model_gaussian
+  e["Problem"]["Integration Method"] = method
+
+  for i in range(dim):
+    e["Variables"][i]["Name"] = "X" + str(i)
+    e["Variables"][i]["Lower Bound"] = 0.0
+    e["Variables"][i]["Upper Bound"] = 1.0
+    e["Variables"][i]["Number Of Gridpoints"] = 1
+
+  e["Solver"]["Type"] = "Integrator"
+  e["Solver"]["Termination Criteria"]["Error Tolerance"] = tolerance
+  e["Solver"]["Termination Criteria"]["Max Model Evaluations"] = 2000000
+
+  e["Random Seed"] = 0xC0FFEE
+  e["Console Output"]["Verbosity"] = "Minimal"
+  e["File Output"]["Enabled"] = False
+
+  k.run(e)
+
+  integral = e["Results"]["Integral"]
+  error = e["Results"]["Error Estimate"]
+  evaluations = e["Solver"]["Model Evaluation Count"]
+
+  # A full 10-dimensional tensor grid with 5 points per axis already needs ~10^7 evaluations
+  assert error <= tolerance, "{0}: error estimate {1} above tolerance {2}".format(method, error, tolerance)
+  assert abs(integral - exact) <= 100 * tolerance, "{0}: integral {1} differs from {2}".format(method, integral, exact)
+  assert evaluations < 2000000, "{0}: tolerance not reached within the evaluation budget".format(method)
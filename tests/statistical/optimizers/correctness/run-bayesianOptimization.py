@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+import os
+import sys
+import korali
+
+sys.path.append('./model')
+sys.path.append('./helpers')
+
+from model import *
+from helpers import *
+
+#################################################
+# Bayesian Optimization problem definition & run
+#################################################
+
+e = korali.Experiment()
+
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = evalmodel
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Lower Bound"] = -10.0
+e["Variables"][0]["Upper Bound"] = +10.0
+
+e["Solver"]["Type"] = "Optimizer/BayesianOptimization"
+e["Solver"]["Initial Design Size"] = 10
+e["Solver"]["Termination Criteria"]["Max Model Evaluations"] = 40
+
+e["Console Output"]["Verbosity"] = "Detailed"
+e["File Output"]["Enabled"] = False
+e["Random Seed"] = 1337
+
+k = korali.Engine()
+k.run(e)
+
+checkMin(e, 0.23246, 1e-2)
+
+#################################################
+# Fixed batch size, proposed with local penalization
+#################################################
+
+e = korali.Experiment()
+
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = evalmodel
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Lower Bound"] = -10.0
+e["Variables"][0]["Upper Bound"] = +10.0
+
+e["Solver"]["Type"] = "Optimizer/BayesianOptimization"
+e["Solver"]["Initial Design Size"] = 10
+e["Solver"]["Batch Size"] = 4
+e["Solver"]["Termination Criteria"]["Max Model Evaluations"] = 60
+
+e["Console Output"]["Verbosity"] = "Detailed"
+e["File Output"]["Enabled"] = False
+e["Random Seed"] = 1337
+
+k = korali.Engine()
+k.run(e)
+
+checkMin(e, 0.23246, 1e-2)
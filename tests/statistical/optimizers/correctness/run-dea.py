@@ -201,3 +201,33 @@ k = korali.Engine()
 k.run(e)
 
 checkMin(e, 0.23246, 1e-2)
+
+#################################################
+# Asynchronous Version
+#################################################
+
+e = korali.Experiment()
+
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = evalmodel
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Lower Bound"] = -10.0
+e["Variables"][0]["Upper Bound"] = +10.0
+
+e["Solver"]["Type"] = "Optimizer/DEA"
+e["Solver"]["Version"] = "Asynchronous"
+e["Solver"]["Population Size"] = 10
+e["Solver"]["Termination Criteria"]["Max Generations"] = 100
+
+e["Solver"]["Parent Selection Rule"] = "Random"
+e["Solver"]["Accept Rule"] = "Greedy"
+
+e["Console Output"]["Verbosity"] = "Detailed"
+e["File Output"]["Enabled"] = False
+e["Random Seed"] = 1337
+
+k = korali.Engine()
+k.run(e)
+
+checkMin(e, 0.23246, 1e-2)
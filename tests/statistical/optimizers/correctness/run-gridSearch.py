@@ -51,3 +51,30 @@ k = korali.Engine()
 k.run(e)
 
 checkEvals(e, 10)
+
+# Testing streamed evaluation over several generations
+values = np.linspace(-10, 10, 1000).tolist()
+
+e = korali.Experiment()
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = evalmodel
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Values"] = values
+
+e["Solver"]["Type"] = "Optimizer/GridSearch"
+e["Solver"]["Executions Per Generation"] = 300
+e["Solver"]["Concurrent Evaluations"] = 16
+e["Solver"]["Top Sample Count"] = 5
+
+e["Console Output"]["Verbosity"] = "Detailed"
+e["File Output"]["Enabled"] = False
+
+k = korali.Engine()
+k.run(e)
+
+checkMin(e, 0.23246, 1e-2)
+checkEvals(e, 1000)
+assert e["Solver"]["Grid Cursor"] == 1000
+assert len(e["Solver"]["Top Values"]) == 5
+assert e["Solver"]["Top Values"][0] == e["Solver"]["Best Ever Value"]
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "korali.hpp"
 #include "auxiliar/jsonInterface.hpp"
+#include "auxiliar/kcache.hpp"
 
 namespace
 {
@@ -16,6 +17,35 @@ namespace
   ASSERT_NO_THROW(getValue(js, "Unknown"));
  }
 
+ TEST(Auxiliar, floatArrayEncoding)
+ {
+  knlohmann::json js;
+  js["Weights"] = std::vector<float>({0.0f, -1.5f, 3.25f, 1e-7f, 65504.0f});
+  js["Layers"]["Bias"] = std::vector<float>({0.5f});
+
+  // Single precision encoding is lossless
+  knlohmann::json encoded;
+  ASSERT_NO_THROW(encoded = encodeFloatArrays(js, false));
+  ASSERT_TRUE(encoded["Weights"].is_string());
+  ASSERT_TRUE(encoded["Layers"]["Bias"].is_string());
+  ASSERT_EQ(decodeFloatArrays(encoded, false), js);
+
+  // Half precision keeps about three significant digits
+  ASSERT_NO_THROW(encoded = encodeFloatArrays(js, true));
+  auto decoded = decodeFloatArrays(encoded, true);
+  auto weights = decoded["Weights"].get<std::vector<float>>();
+  ASSERT_EQ(weights.size(), 5);
+  ASSERT_EQ(weights[1], -1.5f);
+  ASSERT_EQ(weights[4], 65504.0f);
+  ASSERT_NEAR(weights[3], 1e-7f, 1e-7f * 0.25f);
+
+  // Malformed buffers are rejected
+  encoded["Weights"] = "A";
+  ASSERT_ANY_THROW(decodeFloatArrays(encoded, true));
+  encoded["Weights"] = "A!==";
+  ASSERT_ANY_THROW(decodeFloatArrays(encoded, true));
+ }
+
  TEST(Auxiliar, KoraliJson)
  {
   KoraliJson kjs;
@@ -26,6 +56,39 @@ namespace
   ASSERT_NO_THROW(std::string v = kjs["Key"]);
  }
 
+ TEST(Auxiliar, kCache)
+ {
+  kCache<std::string, double, size_t> cache(1);
+  ASSERT_FALSE(cache.contains("A"));
+  ASSERT_EQ(cache.access("A", []() { return 1.0; }), 1.0);
+  ASSERT_EQ(cache.access("A", []() { return 2.0; }), 1.0);
+
+  // Least recently used elements are evicted first
+  cache.setCapacity(2);
+  cache.set("B", 2.0);
+  double val;
+  ASSERT_TRUE(cache.tryGet("A", val));
+  cache.set("C", 3.0);
+  ASSERT_TRUE(cache.contains("A"));
+  ASSERT_FALSE(cache.contains("B"));
+  ASSERT_TRUE(cache.contains("C"));
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.getKeys(), std::vector<std::string>({"A", "C"}));
+
+  // Elements expire with the external timer
+  size_t timer = 0;
+  cache.setTimer(&timer);
+  cache.setMaxAge(2);
+  cache.set("D", 4.0);
+  timer = 1;
+  ASSERT_TRUE(cache.contains("D"));
+  timer = 2;
+  ASSERT_FALSE(cache.contains("D"));
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+ }
+
  TEST(Auxiliar, Math)
  {
   ASSERT_ANY_THROW(safeLogMinus(1.0, 2.0));
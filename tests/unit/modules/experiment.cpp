@@ -270,6 +270,111 @@ namespace
   expJs.erase("Variables");
   ASSERT_NO_THROW(e->setConfiguration(expJs));
 
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"].erase("Enabled");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Enabled"] = "Not a Number";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Enabled"] = true;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"].erase("Capacity");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Capacity"] = "Not a Number";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Capacity"] = 16;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"].erase("Path");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Path"] = 1.0;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Path"] = "_korali_cache.json";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"].erase("Hit Count");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Hit Count"] = "Not a Number";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Hit Count"] = 4;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"].erase("Miss Count");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Miss Count"] = "Not a Number";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["Evaluation Cache"]["Miss Count"] = 4;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
   expJs = backJs;
   ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
   expJs["Console Output"].erase("Verbosity");
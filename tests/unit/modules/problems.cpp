@@ -767,6 +767,14 @@ namespace
   e._variables[0]->_samplePoints = std::vector<double>({0.0});
   ASSERT_ANY_THROW(pObj->initialize());
 
+  // Adaptive methods ignore the grid settings but still require valid bounds
+  pObj->_integrationMethod = "Sparse Grid";
+  e._variables[0]->_numberOfGridpoints = 0;
+  ASSERT_NO_THROW(pObj->initialize());
+
+  e._variables[0]->_upperBound = e._variables[0]->_lowerBound;
+  ASSERT_ANY_THROW(pObj->initialize());
+
   problemJs = baseProbJs;
   experimentJs = baseExpJs;
   problemJs.erase("Integrand");
@@ -802,6 +810,21 @@ namespace
   problemJs["Integration Method"] = "Rectangle";
   ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
 
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Integration Method"] = "Sparse Grid";
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Integration Method"] = "Sobol";
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Integration Method"] = "Halton";
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
   problemJs = baseProbJs;
   experimentJs = baseExpJs;
   e["Variables"][0].erase("Lower Bound");
@@ -2140,6 +2163,21 @@ namespace
   problemJs["Actions Between Policy Updates"] = 1;
   ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
 
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs.erase("Experiences Per Chunk");
+  ASSERT_ANY_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Experiences Per Chunk"] = "Not a Number";
+  ASSERT_ANY_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Experiences Per Chunk"] = 16;
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
   problemJs = baseProbJs;
   experimentJs = baseExpJs;
   problemJs.erase("Custom Settings");
@@ -171,6 +171,33 @@ namespace
   a->processEpisode(episode);
   // ASSERT_NO_THROW(a->processEpisode(episode));
 
+  // Binary serialization round trip, with an incremental append in between
+  e._fileOutputPath = "_korali_agent_replay";
+  a->_experienceReplaySerializationFormat = "Binary";
+  ASSERT_NO_THROW(a->serializeExperienceReplay());
+  episode["Experiences"][0]["Reward"] = 2.0f;
+  ASSERT_NO_THROW(a->processEpisode(episode));
+  ASSERT_NO_THROW(a->serializeExperienceReplay());
+  ASSERT_NO_THROW(a->waitForExperienceReplaySerialization());
+  size_t replaySize = a->_stateVector.size();
+  float lastRetrace = a->_retraceValueVector[replaySize - 1];
+  a->_retraceValueVector[replaySize - 1] = -1.0f;
+  ASSERT_NO_THROW(a->deserializeExperienceReplay());
+  ASSERT_EQ(a->_stateVector.size(), replaySize);
+  ASSERT_EQ(a->_rewardVector.size(), replaySize);
+  ASSERT_EQ(a->_rewardVector[replaySize - 2], 1.0f);
+  ASSERT_EQ(a->_rewardVector[replaySize - 1], 2.0f);
+  ASSERT_EQ(a->_retraceValueVector[replaySize - 1], lastRetrace);
+  episode["Experiences"][0]["Reward"] = 1.0f;
+
+  // Experiences whose state or action does not match the problem are rejected
+  episode["Experiences"][0]["State"] = std::vector<float>({0.0f, 0.0f});
+  ASSERT_ANY_THROW(a->processEpisode(episode));
+  episode["Experiences"][0]["State"] = std::vector<float>({0.0f});
+  episode["Experiences"][0]["Action"] = std::vector<float>({});
+  ASSERT_ANY_THROW(a->processEpisode(episode));
+  episode["Experiences"][0]["Action"] = std::vector<float>({0.0f});
+
   // No state value provided error
   episode["Experiences"][0]["Policy"].erase("State Value");
   ASSERT_ANY_THROW(a->processEpisode(episode));
@@ -196,6 +223,70 @@ namespace
   ASSERT_ANY_THROW(a->processEpisode(episode));
   episode["Experiences"][0]["Truncated State"] = std::vector<float>({0.0f});
 
+  // Episodes streamed in chunks are staged until the episode finishes
+  episode_t stagedEpisode;
+  knlohmann::json chunk;
+  chunk["Environment Id"] = 0;
+  chunk["Experience Count"] = 2;
+  chunk["States"] = std::vector<float>({0.0f, 0.0f});
+  chunk["Actions"] = std::vector<float>({0.0f, 0.0f});
+  chunk["Rewards"] = std::vector<float>({1.0f, 1.0f});
+  chunk["Policy"]["State Values"] = std::vector<float>({1.0f, 1.0f});
+  chunk["Termination"] = "Non Terminal";
+  ASSERT_NO_THROW(a->appendExperienceChunk(stagedEpisode, chunk));
+  chunk["Termination"] = "Unknown";
+  ASSERT_ANY_THROW(a->appendExperienceChunk(stagedEpisode, chunk));
+  chunk["Termination"] = "Truncated";
+  ASSERT_ANY_THROW(a->appendExperienceChunk(stagedEpisode, chunk));
+  chunk["Truncated State"] = std::vector<float>({0.0f});
+  ASSERT_NO_THROW(a->appendExperienceChunk(stagedEpisode, chunk));
+  ASSERT_EQ(stagedEpisode.experienceCount, 4);
+  ASSERT_EQ(stagedEpisode.termination, e_truncated);
+  ASSERT_NO_THROW(a->processEpisode(stagedEpisode));
+  replaySize = a->_terminationVector.size();
+  ASSERT_EQ(a->_terminationVector[replaySize - 1], e_truncated);
+  ASSERT_EQ(a->_terminationVector[replaySize - 2], e_nonTerminal);
+  ASSERT_EQ(a->_episodePosVector[replaySize - 1], 3);
+  chunk["Experience Count"] = 3;
+  ASSERT_ANY_THROW(a->appendExperienceChunk(stagedEpisode, chunk));
+
+  // The learner thread waits for enough experiences and stops on request
+  size_t startSize = a->_experienceReplayStartSize;
+  a->_experienceReplayStartSize = a->_experienceReplayMaximumSize + 1;
+  size_t policyUpdateCount = a->_policyUpdateCount;
+  ASSERT_NO_THROW(a->startLearnerThread());
+  ASSERT_NO_THROW(a->fetchLearnerPolicy());
+  ASSERT_NO_THROW(a->stopLearnerThread());
+  ASSERT_NO_THROW(a->stopLearnerThread());
+  ASSERT_EQ(a->_policyUpdateCount, policyUpdateCount);
+
+  // The learner thread runs a policy update once enough experiences arrive, and publishes the new policy
+  float experiencesBetweenPolicyUpdates = a->_experiencesBetweenPolicyUpdates;
+  a->_experienceReplayStartSize = 0;
+  a->_experiencesBetweenPolicyUpdates = 1;
+  a->_sessionExperienceCount = 0;
+  a->_sessionPolicyUpdateCount = 0;
+  a->_sessionExperiencesUntilStartSize = 0;
+  size_t policyVersion = a->_trainingCurrentPolicyVersion;
+  size_t publishedPolicyVersion = a->_learnerPublishedPolicyVersion;
+  ASSERT_NO_THROW(a->startLearnerThread());
+  a->_receivedExperienceCount += 1;
+  a->notifyLearner();
+  for (size_t i = 0; i < 10000 && a->_learnerPublishedPolicyVersion == publishedPolicyVersion; i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ASSERT_NO_THROW(a->stopLearnerThread());
+  ASSERT_NO_THROW(a->fetchLearnerPolicy());
+  ASSERT_EQ(a->_policyUpdateCount, policyUpdateCount + 1);
+  ASSERT_EQ(a->_learnerPublishedPolicyVersion, publishedPolicyVersion + 1);
+  ASSERT_EQ(a->_trainingCurrentPolicyVersion, policyVersion + 1);
+  ASSERT_EQ(a->_trainingCurrentPolicy, a->getAgentPolicy());
+
+  // Without new experiences, there is no new policy to take
+  ASSERT_NO_THROW(a->fetchLearnerPolicy());
+  ASSERT_EQ(a->_trainingCurrentPolicyVersion, policyVersion + 1);
+  a->_experiencesBetweenPolicyUpdates = experiencesBetweenPolicyUpdates;
+  a->_experienceReplayStartSize = startSize;
+
   // Check truncated state sequence for sequences > 1
   episode["Experiences"][0]["Environment Id"] = 0;
   episode["Experiences"][0]["State"] = std::vector<float>({0.0f});
@@ -220,8 +311,72 @@ namespace
   episode["Experiences"][2]["Truncated State"] = std::vector<float>({0.0f});
 
   ASSERT_NO_THROW(a->processEpisode(episode));
+
+  // Inference on more states than the inference batch size is evaluated in batches
+  auto truncatedSequence = a->getTruncatedStateSequence(a->_terminationVector.size() - 1);
+  std::vector<policy_t> inferencePolicies;
+  ASSERT_NO_THROW(inferencePolicies = a->runInferencePolicy({truncatedSequence, truncatedSequence, truncatedSequence}));
+  ASSERT_EQ(inferencePolicies.size(), 3);
+  ASSERT_EQ(inferencePolicies[0].stateValue, inferencePolicies[2].stateValue);
+
   a->_timeSequenceLength = 2;
   ASSERT_NO_THROW(a->getTruncatedStateSequence(a->_terminationVector.size()-1));
+  a->_timeSequenceLength = 1;
+
+  // A sharded replay can not be serialized
+  size_t maximumSize = a->_experienceReplayMaximumSize;
+  a->_experienceReplayShardingEnabled = true;
+  ASSERT_ANY_THROW(a->initialize());
+
+  // Until the shards are allocated, the engine keeps all states
+  a->_experienceReplaySerialize = false;
+  a->_experienceReplayMaximumSize = 4;
+  ASSERT_NO_THROW(a->initialize());
+  episode["Experiences"][0]["State"] = std::vector<float>({1.0f});
+  episode["Experiences"][1]["State"] = std::vector<float>({2.0f});
+  ASSERT_NO_THROW(a->processEpisode(episode));
+  ASSERT_EQ(a->_stateShardLocalStates.size(), 3);
+  std::vector<float> loadedStates(2);
+  ASSERT_NO_THROW(a->loadStates({0, 1}, loadedStates.data()));
+  ASSERT_EQ(loadedStates, std::vector<float>({1.0f, 2.0f}));
+
+  // States in a shard are released once no earlier state of the shard remains in the replay memory
+  a->_stateShardReleasedCounts.assign(1, 0);
+  a->_stateShardEvictedIndexes.assign(1, {});
+  knlohmann::json shardedChunk = chunk;
+  shardedChunk.erase("States");
+  shardedChunk.erase("Truncated State");
+  shardedChunk["Experience Count"] = 2;
+  shardedChunk["Termination"] = "Terminal";
+  shardedChunk["State Shard"]["Id"] = 1;
+  shardedChunk["State Shard"]["First Index"] = 2;
+  episode_t shardedEpisode;
+  ASSERT_ANY_THROW(a->appendExperienceChunk(shardedEpisode, shardedChunk));
+  shardedChunk["State Shard"]["Id"] = 0;
+  shardedEpisode = episode_t();
+  ASSERT_NO_THROW(a->appendExperienceChunk(shardedEpisode, shardedChunk));
+  ASSERT_NO_THROW(a->processEpisode(shardedEpisode));
+  shardedChunk["State Shard"]["First Index"] = 0;
+  shardedEpisode = episode_t();
+  ASSERT_NO_THROW(a->appendExperienceChunk(shardedEpisode, shardedChunk));
+  ASSERT_NO_THROW(a->processEpisode(shardedEpisode));
+  ASSERT_EQ(a->_stateShardLocalStates.size(), 0);
+  ASSERT_EQ(a->_stateShardReleasedCounts[0], 0);
+  ASSERT_NO_THROW(a->processEpisode(episode));
+  ASSERT_EQ(a->_stateShardReleasedCounts[0], 1);
+  episode["Experiences"].erase(1);
+  episode["Experiences"].erase(1);
+  ASSERT_NO_THROW(a->processEpisode(episode));
+  ASSERT_EQ(a->_stateShardReleasedCounts[0], 4);
+  ASSERT_EQ(a->_stateShardLocalStates.size(), 4);
+
+  // Without a sharded replay, states stored in shards are rejected
+  a->_experienceReplayShardingEnabled = false;
+  a->_experienceReplaySerialize = true;
+  a->_experienceReplayMaximumSize = maximumSize;
+  ASSERT_NO_THROW(a->initialize());
+  shardedEpisode = episode_t();
+  ASSERT_ANY_THROW(a->appendExperienceChunk(shardedEpisode, shardedChunk));
 
   // Triggering bad path in serialization routine
   e._fileOutputPath = "/dev/null/\%*Incorrect Path*";
@@ -556,6 +711,26 @@ namespace
   agentJs["Mini Batch"]["Strategy"] = "Uniform";
   ASSERT_NO_THROW(a->setConfiguration(agentJs));
 
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Mini Batch"]["Strategy"] = "Prioritized";
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Mini Batch"].erase("Data Parallel Learners");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Mini Batch"]["Data Parallel Learners"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Mini Batch"]["Data Parallel Learners"] = 2;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
   agentJs = baseOptJs;
   experimentJs = baseExpJs;
   agentJs.erase("Time Sequence Length");
@@ -776,6 +951,51 @@ namespace
   agentJs["Experience Replay"]["Off Policy"]["Annealing Rate"] = 1.0;
   ASSERT_NO_THROW(a->setConfiguration(agentJs));
 
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"].erase("Exponent");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Exponent"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Exponent"] = 0.5;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"].erase("Importance Weight Exponent");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Importance Weight Exponent"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Importance Weight Exponent"] = 0.5;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"].erase("Importance Weight Annealing Rate");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Importance Weight Annealing Rate"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Priority"]["Importance Weight Annealing Rate"] = 0.5;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
   agentJs = baseOptJs;
   experimentJs = baseExpJs;
   agentJs["Experience Replay"]["Off Policy"].erase("REFER Beta");
@@ -806,6 +1026,66 @@ namespace
   agentJs["Experiences Between Policy Updates"] = 1;
   ASSERT_NO_THROW(a->setConfiguration(agentJs));
 
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs.erase("Asynchronous Policy Updates");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Asynchronous Policy Updates"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Asynchronous Policy Updates"] = true;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"].erase("Enabled");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"]["Enabled"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"]["Enabled"] = true;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"].erase("Shard Size");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"]["Shard Size"] = "Not a Number";
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Experience Replay"]["Sharding"]["Shard Size"] = 1024;
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Policy Broadcast"].erase("Precision");
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Policy Broadcast"]["Precision"] = 1.0;
+  ASSERT_ANY_THROW(a->setConfiguration(agentJs));
+
+  agentJs = baseOptJs;
+  experimentJs = baseExpJs;
+  agentJs["Policy Broadcast"]["Precision"] = "Half";
+  ASSERT_NO_THROW(a->setConfiguration(agentJs));
+
   agentJs = baseOptJs;
   experimentJs = baseExpJs;
   agentJs["State Rescaling"].erase("Enabled");
@@ -1389,6 +1669,24 @@ namespace
    Sample s;
    auto curPolicy = a->getAgentPolicy();
    s["Policy Hyperparameters"] = a->getAgentPolicy();
+
+   // The policy broadcast to the environments restores the hyperparameters exactly in single precision
+   knlohmann::json policyMessage;
+   a->_trainingCurrentPolicy = curPolicy;
+   a->_trainingCurrentPolicyVersion = 1;
+   a->_policyBroadcastPrecision = "Single";
+   ASSERT_NO_THROW(policyMessage = a->getTrainingPolicyMessage());
+   ASSERT_EQ(policyMessage["Version"].get<size_t>(), 1);
+   ASSERT_NO_THROW(a->setTrainingPolicyMessage(policyMessage));
+   ASSERT_EQ(a->getAgentPolicy(), curPolicy);
+
+   // Only a new version is re-encoded
+   a->_policyBroadcastPrecision = "Half";
+   ASSERT_EQ(a->getTrainingPolicyMessage()["Precision"], "Single");
+   a->_trainingCurrentPolicyVersion = 2;
+   ASSERT_EQ(a->getTrainingPolicyMessage()["Precision"], "Half");
+   ASSERT_NO_THROW(a->setTrainingPolicyMessage(a->getTrainingPolicyMessage()));
+   ASSERT_NO_THROW(a->setAgentPolicy(curPolicy));
    s["Sample Id"] = 0;
    s["State Rescaling"]["Means"] = std::vector<float>({0.0});
    s["State Rescaling"]["Standard Deviations"] = std::vector<float>({1.0});
@@ -1627,4 +1925,73 @@ namespace
     ASSERT_NO_THROW(a->setConfiguration(agentJs));
    }
 
+ TEST(a, cStridedBuffer)
+ {
+  cStridedBuffer<float> b(2, 3);
+  ASSERT_EQ(b.size(), 0);
+  ASSERT_EQ(b.stride(), 3);
+
+  // Rows are stored contiguously, short rows are padded with zeros
+  b.add({1.0f, 2.0f, 3.0f});
+  b.add({4.0f});
+  ASSERT_EQ(b.size(), 2);
+  ASSERT_EQ(b[1], b[0] + 3);
+  ASSERT_EQ(b.getVector(0), std::vector<float>({1.0f, 2.0f, 3.0f}));
+  ASSERT_EQ(b.getVector(1), std::vector<float>({4.0f, 0.0f, 0.0f}));
+
+  // Adding beyond the maximum size overwrites the oldest row
+  b.add({5.0f, 6.0f, 7.0f});
+  ASSERT_EQ(b.size(), 2);
+  ASSERT_EQ(b.getVector(0), std::vector<float>({4.0f, 0.0f, 0.0f}));
+  ASSERT_EQ(b.getVector(1), std::vector<float>({5.0f, 6.0f, 7.0f}));
+
+  b.set(0, {8.0f, 9.0f, 10.0f});
+  ASSERT_EQ(b[0][2], 10.0f);
+
+  b.clear();
+  ASSERT_EQ(b.size(), 0);
+ }
+
+ TEST(a, sumTree)
+ {
+  sumTree t(3);
+  ASSERT_EQ(t.size(), 0);
+  ASSERT_EQ(t.getTotal(), 0.0);
+
+  t.add(1.0f);
+  t.add(2.0f);
+  ASSERT_EQ(t.size(), 2);
+  ASSERT_EQ(t.getTotal(), 3.0);
+
+  // Values fall into the entry whose cumulative interval contains them
+  ASSERT_EQ(t.sample(0.5), 0);
+  ASSERT_EQ(t.sample(1.5), 1);
+  ASSERT_EQ(t.sample(2.99), 1);
+
+  // Rounding beyond the total never returns an empty entry
+  ASSERT_EQ(t.sample(10.0), 1);
+
+  t.update(0, 4.0f);
+  ASSERT_EQ(t[0], 4.0f);
+  ASSERT_EQ(t.getTotal(), 6.0);
+
+  // Adding beyond the maximum size overwrites the oldest entry, like cBuffer
+  t.add(3.0f);
+  t.add(5.0f);
+  ASSERT_EQ(t.size(), 3);
+  ASSERT_EQ(t[0], 2.0f);
+  ASSERT_EQ(t[1], 3.0f);
+  ASSERT_EQ(t[2], 5.0f);
+  ASSERT_EQ(t.getTotal(), 10.0);
+
+  // Sampling walks the storage order, where the newest entry now comes first
+  ASSERT_EQ(t.sample(1.0), 2);
+  ASSERT_EQ(t.sample(6.0), 0);
+  ASSERT_EQ(t.sample(9.0), 1);
+
+  t.clear();
+  ASSERT_EQ(t.size(), 0);
+  ASSERT_EQ(t.getTotal(), 0.0);
+ }
+
 } // namespace
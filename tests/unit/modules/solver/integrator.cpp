@@ -83,6 +83,131 @@ namespace
    experimentJs = baseExpJs;
    integratorJs["Executions Per Generation"] = 1;
    ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs.erase("Max Refinement Level");
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Max Refinement Level"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Max Refinement Level"] = 8;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs.erase("Randomization Count");
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Randomization Count"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Randomization Count"] = 4;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs.erase("Initial Sequence Length");
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Initial Sequence Length"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Initial Sequence Length"] = 128;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"].erase("Error Tolerance");
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"]["Error Tolerance"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"]["Error Tolerance"] = 1e-6;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"].erase("Grid Completed");
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"]["Grid Completed"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Termination Criteria"]["Grid Completed"] = false;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Error Estimate"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Error Estimate"] = 1.0;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Active Indices"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Active Indices"] = std::vector<std::vector<size_t>>({{1, 2}});
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Active Contributions"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Active Contributions"] = std::vector<double>({1.0});
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Sequence Length"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Sequence Length"] = 64;
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Randomization Shifts"] = "Not a Number";
+   ASSERT_ANY_THROW(itr->setConfiguration(integratorJs));
+
+   integratorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   integratorJs["Randomization Shifts"] = std::vector<std::vector<double>>({{0.5, 0.25}});
+   ASSERT_NO_THROW(itr->setConfiguration(integratorJs));
   }
 
 
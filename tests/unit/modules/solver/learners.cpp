@@ -210,6 +210,21 @@ namespace
    learnerJs["Steps Per Generation"] = 10;
    ASSERT_NO_THROW(learner->setConfiguration(learnerJs));
 
+   learnerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   learnerJs.erase("Data Parallel Learners");
+   ASSERT_ANY_THROW(learner->setConfiguration(learnerJs));
+
+   learnerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   learnerJs["Data Parallel Learners"] = "Not a Number";
+   ASSERT_ANY_THROW(learner->setConfiguration(learnerJs));
+
+   learnerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   learnerJs["Data Parallel Learners"] = 2;
+   ASSERT_NO_THROW(learner->setConfiguration(learnerJs));
+
    learnerJs = baseOptJs;
    experimentJs = baseExpJs;
    learnerJs.erase("Learning Rate");
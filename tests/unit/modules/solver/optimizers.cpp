@@ -2,6 +2,7 @@
 #include "korali.hpp"
 #include "modules/solver/optimizer/Adam/Adam.hpp"
 #include "modules/solver/optimizer/AdaBelief/AdaBelief.hpp"
+#include "modules/solver/optimizer/BayesianOptimization/BayesianOptimization.hpp"
 #include "modules/solver/optimizer/DEA/DEA.hpp"
 #include "modules/solver/optimizer/CMAES/CMAES.hpp"
 #include "modules/solver/optimizer/MOCMAES/MOCMAES.hpp"
@@ -693,6 +694,232 @@ namespace
 
  //////////////// CMAES ////////////////////////
 
+ TEST(optimizers, BayesianOptimization)
+ {
+  // Creating base experiment
+  Experiment e;
+  auto& experimentJs = e._js.getJson();
+
+  // Creating initial variable
+  Variable v;
+  e._variables.push_back(&v);
+  e["Variables"][0]["Name"] = "Var 1";
+  e["Variables"][0]["Lower Bound"] = 0.0;
+  e["Variables"][0]["Upper Bound"] = 1.0;
+
+  // Creating optimizer configuration Json
+  knlohmann::json optimizerJs;
+  optimizerJs["Type"] = "Optimizer/BayesianOptimization";
+
+  // Creating module
+  BayesianOptimization* opt;
+  ASSERT_NO_THROW(opt = dynamic_cast<BayesianOptimization *>(Module::getModule(optimizerJs, &e)));
+
+  // Defaults should be applied without a problem
+  ASSERT_NO_THROW(opt->applyModuleDefaults(optimizerJs));
+
+  // Covering variable functions (no effect)
+  ASSERT_NO_THROW(opt->applyVariableDefaults());
+
+  // Backup the correct base configuration
+  auto baseOptJs = optimizerJs;
+  auto baseExpJs = experimentJs;
+
+  // Setting up optimizer correctly
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  // Testing unbounded and inverted domains fail
+  v._lowerBound = -Inf;
+  v._upperBound = 5.0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  v._lowerBound = 5.0;
+  v._upperBound = -5.0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing initial configuration success
+  v._lowerBound = -5.0;
+  v._upperBound = 5.0;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing invalid sizes fail
+  opt->_initialDesignSize = 0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_initialDesignSize = 10;
+
+  opt->_acquisitionCandidateCount = 0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_acquisitionCandidateCount = 100;
+
+  opt->_hyperparameterUpdateFrequency = 0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_hyperparameterUpdateFrequency = 5;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing mandatory parameters
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Initial Design Size");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Initial Design Size"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Initial Design Size"] = 20;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Batch Size");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Batch Size"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Batch Size"] = 4;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Covariance Function");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Covariance Function"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Covariance Function"] = "CovSEiso";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Exploration Weight");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Exploration Weight"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Exploration Weight"] = 0.1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Acquisition Candidate Count");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Acquisition Candidate Count"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Acquisition Candidate Count"] = 500;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Hyperparameter Update Frequency");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Hyperparameter Update Frequency"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Hyperparameter Update Frequency"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  // Testing optional parameters
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluated Parameters"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluated Parameters"] = std::vector<std::vector<double>>({{ 2.0 }});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluated Values"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluated Values"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Hyperparameters"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Hyperparameters"] = std::vector<double>({ 0.0, 0.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Mean"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Mean"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Scale"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Scale"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Observations Since Update"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Observations Since Update"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Best Variables"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Best Variables"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+ }
+
  TEST(optimizers, CMAES)
  {
   // Creating base experiment
@@ -1814,6 +2041,14 @@ namespace
   v._upperBound = 5.0;
   ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+  // The asynchronous version only supports greedy selection
+  opt->_version = "Asynchronous";
+  opt->_acceptRule = "Best";
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_acceptRule = "Greedy";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  opt->_version = "Synchronous";
+
   // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -1837,7 +2072,7 @@ namespace
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Sample Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Sample Population"] = std::vector<double>({ 2.0 });
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
@@ -1847,7 +2082,7 @@ namespace
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Candidate Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Candidate Population"] = std::vector<double>({ 2.0 });
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
@@ -1935,6 +2170,26 @@ namespace
   optimizerJs["Current Minimum Step Size"] = std::vector<double>({ 2.0 });
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Version"] = "Asynchronous";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Version");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Version"] = "Undefined";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Version"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
   optimizerJs["Population Size"] = 1;
@@ -3255,6 +3510,14 @@ namespace
     auto baseExpJs = experimentJs;
 
     // Testing initial configuration fail
+    opt->_executionsPerGeneration = 0;
+    opt->_concurrentEvaluations = 1;
+    ASSERT_ANY_THROW(opt->setInitialConfiguration());
+    opt->_executionsPerGeneration = 1;
+    opt->_concurrentEvaluations = 0;
+    ASSERT_ANY_THROW(opt->setInitialConfiguration());
+    opt->_concurrentEvaluations = 1;
+
     opt->_numberOfValues = 10;
     opt->_maxModelEvaluations = 5;
     ASSERT_NO_THROW(opt->setInitialConfiguration());
@@ -3276,12 +3539,77 @@ namespace
 
     optimizerJs = baseOptJs;
     experimentJs = baseExpJs;
-    optimizerJs["Objective"] = std::vector<double>({ 2.0 });
+    optimizerJs["Grid Cursor"] = 1;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Grid Cursor"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Values"] = std::vector<double>({ 2.0 });
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Values"] = 2.0;
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Parameters"] = std::vector<std::vector<double>>({{ 2.0 }});
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Parameters"] = 2.0;
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Executions Per Generation"] = 10;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Executions Per Generation");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Executions Per Generation"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Concurrent Evaluations"] = 10;
     ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
     optimizerJs = baseOptJs;
     experimentJs = baseExpJs;
-    optimizerJs["Objective"] = 2.0;
+    optimizerJs.erase("Concurrent Evaluations");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Concurrent Evaluations"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Sample Count"] = 5;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Top Sample Count");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Sample Count"] = "Not a Number";
     ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
     optimizerJs = baseOptJs;
@@ -4,8 +4,10 @@
 #include "modules/problem/sampling/sampling.hpp"
 #include "modules/problem/bayesian/reference/reference.hpp"
 #include "modules/solver/sampler/Nested/Nested.hpp"
+#include "modules/solver/sampler/Ensemble/Ensemble.hpp"
 #include "modules/solver/sampler/HMC/HMC.hpp"
 #include "modules/solver/sampler/MCMC/MCMC.hpp"
+#include "modules/solver/sampler/ParallelTempering/ParallelTempering.hpp"
 #include "modules/solver/sampler/TMCMC/TMCMC.hpp"
 
 namespace
@@ -138,9 +140,588 @@ namespace
    ASSERT_NO_THROW(m->Module::applyModuleDefaults(js));
   }
 
+  //////////////// CONVERGENCE DIAGNOSTICS ////////////////////////
+
+  TEST(samplers, convergenceDiagnostics)
+  {
+   // Creating base experiment
+   Experiment e;
+
+   // Creating initial variable
+   Variable v;
+   e._variables.push_back(&v);
+   e["Variables"][0]["Name"] = "Var 1";
+   e["Variables"][0]["Initial Mean"] = 0.0;
+   e["Variables"][0]["Initial Standard Deviation"] = 0.25;
+
+   knlohmann::json samplerJs;
+   samplerJs["Type"] = "Sampler/MCMC";
+
+   MCMC* sampler;
+   ASSERT_NO_THROW(sampler = dynamic_cast<MCMC *>(Module::getModule(samplerJs, &e)));
+
+   std::vector<double> rHat;
+   std::vector<double> ess;
+
+   // Too short chains provide no diagnostics
+   std::vector<std::vector<double>> samples({{0.0}, {1.0}, {0.0}, {1.0}});
+   sampler->computeConvergenceDiagnostics(samples, 2, rHat, ess);
+   ASSERT_EQ(rHat.size(), 1);
+   ASSERT_EQ(std::isinf(rHat[0]), true);
+   ASSERT_EQ(ess[0], 0.0);
+
+   // Two interleaved chains exploring the same (anti-correlated) sequence
+   samples.clear();
+   for (size_t i = 0; i < 100; i++)
+    for (size_t c = 0; c < 2; c++) samples.push_back({(double)(i % 2)});
+   sampler->computeConvergenceDiagnostics(samples, 2, rHat, ess);
+   ASSERT_LT(rHat[0], 1.01);
+   ASSERT_GT(ess[0], 200.0);
+
+   // Two chains stuck at different locations
+   samples.clear();
+   for (size_t i = 0; i < 100; i++)
+    for (size_t c = 0; c < 2; c++) samples.push_back({10.0 * c + 0.1 * (i % 2)});
+   sampler->computeConvergenceDiagnostics(samples, 2, rHat, ess);
+   ASSERT_GT(rHat[0], 10.0);
+  }
+
   //////////////// MCMC CLASS ////////////////////////
 
-  TEST(samplers, MCMC)
+  TEST(samplers, MCMC)
+  {
+   // Creating base experiment
+   Experiment e;
+   auto& experimentJs = e._js.getJson();
+
+   // Creating initial variable
+   Variable v;
+   e._variables.push_back(&v);
+   e["Variables"][0]["Name"] = "Var 1";
+   e["Variables"][0]["Initial Mean"] = 0.0;
+   e["Variables"][0]["Initial Standard Deviation"] = 0.25;
+   e["Variables"][0]["Lower Bound"] = -1.0;
+   e["Variables"][0]["Upper Bound"] = 1.0;
+
+   // Creating optimizer configuration Json
+   knlohmann::json samplerJs;
+   samplerJs["Type"] = "Sampler/MCMC";
+
+   // Creating module
+   MCMC* sampler;
+   ASSERT_NO_THROW(sampler = dynamic_cast<MCMC *>(Module::getModule(samplerJs, &e)));
+
+   // Defaults should be applied without a problem
+   ASSERT_NO_THROW(sampler->applyModuleDefaults(samplerJs));
+
+   // Covering variable functions (no effect)
+   ASSERT_NO_THROW(sampler->applyVariableDefaults());
+
+   // Backup the correct base configuration
+   auto baseOptJs = samplerJs;
+   auto baseExpJs = experimentJs;
+
+   // Setting up optimizer correctly
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   auto inMat = std::vector<double>({1.0, 2.0, 2.0, 13.0});
+   auto outMat = std::vector<double>({1.0, 2.0, 2.0, 13.0});
+   sampler->_variableCount = 2;
+   ASSERT_NO_THROW(sampler->choleskyDecomp(inMat, outMat));
+
+   // Testing optional parameters
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Covariance"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Covariance"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Chain Covariance"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Chain Covariance"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader Evaluation"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader Evaluation"] = 0.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Candidates Evaluations"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Candidates Evaluations"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Alphas"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Alphas"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Rate"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Rate"] = 0.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Count"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposed Sample Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposed Sample Count"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Database"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Database"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Candidate"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Candidate"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Evaluation Database"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Evaluation Database"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Mean"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Mean"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance Placeholder"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance Placeholder"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Length"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Length"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Burn In");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Burn In"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Burn In"] = 1;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Leap");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Leap"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Leap"] = 1;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Rejection Levels");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Levels"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Levels"] = 1;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Use Adaptive Sampling");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Use Adaptive Sampling"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Use Adaptive Sampling"] = true;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Non Adaption Period");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Non Adaption Period"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Non Adaption Period"] = 1;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Covariance Scaling");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance Scaling"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariance Scaling"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Max Samples");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Samples"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Samples"] = 1;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Max Model Evaluations");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Model Evaluations"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Model Evaluations"] = 10000;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Max Generations");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Generations"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Max Generations"] = 10000;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = 4;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Diagnostics Frequency");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Diagnostics Frequency"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Diagnostics Frequency"] = 10;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Target Potential Scale Reduction");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Potential Scale Reduction"] = 1.01;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Target Effective Sample Size");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Effective Sample Size"] = 400.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Potential Scale Reduction"] = std::vector<double>({1.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Effective Sample Size"] = std::vector<double>({1.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Max Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Max Potential Scale Reduction"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Min Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Min Effective Sample Size"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leaders"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leaders"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader Evaluations"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Leader Evaluations"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Acceptance Counts"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Acceptance Counts"] = std::vector<size_t>({0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Means"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Means"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariances"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Covariances"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Chain Covariances"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Cholesky Decomposition Chain Covariances"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   ///// Variable Tests
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0].erase("Initial Mean");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0]["Initial Mean"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0]["Initial Mean"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0].erase("Initial Standard Deviation");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0]["Initial Standard Deviation"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   e["Variables"][0]["Initial Standard Deviation"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+  }
+
+  //////////////// PARALLEL TEMPERING CLASS ////////////////////////
+
+  TEST(samplers, ParallelTempering)
   {
    // Creating base experiment
    Experiment e;
@@ -152,16 +733,16 @@ namespace
    e["Variables"][0]["Name"] = "Var 1";
    e["Variables"][0]["Initial Mean"] = 0.0;
    e["Variables"][0]["Initial Standard Deviation"] = 0.25;
-   e["Variables"][0]["Lower Bound"] = -1.0;
-   e["Variables"][0]["Upper Bound"] = 1.0;
+   v._initialMean = 0.0;
+   v._initialStandardDeviation = 0.25;
 
    // Creating optimizer configuration Json
    knlohmann::json samplerJs;
-   samplerJs["Type"] = "Sampler/MCMC";
+   samplerJs["Type"] = "Sampler/ParallelTempering";
 
    // Creating module
-   MCMC* sampler;
-   ASSERT_NO_THROW(sampler = dynamic_cast<MCMC *>(Module::getModule(samplerJs, &e)));
+   ParallelTempering* sampler;
+   ASSERT_NO_THROW(sampler = dynamic_cast<ParallelTempering *>(Module::getModule(samplerJs, &e)));
 
    // Defaults should be applied without a problem
    ASSERT_NO_THROW(sampler->applyModuleDefaults(samplerJs));
@@ -176,170 +757,325 @@ namespace
    // Setting up optimizer correctly
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
-   auto inMat = std::vector<double>({1.0, 2.0, 2.0, 13.0});
-   auto outMat = std::vector<double>({1.0, 2.0, 2.0, 13.0});
-   sampler->_variableCount = 2;
-   ASSERT_NO_THROW(sampler->choleskyDecomp(inMat, outMat));
+   // Testing the initial temperature ladder is geometric between 1 and the max temperature
+   sampler->_replicaCount = 3;
+   sampler->_maxTemperature = 100.0;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+   ASSERT_EQ(sampler->_temperatures.size(), 3);
+   ASSERT_DOUBLE_EQ(sampler->_temperatures[0], 1.0);
+   ASSERT_DOUBLE_EQ(sampler->_temperatures[1], 10.0);
+   ASSERT_DOUBLE_EQ(sampler->_temperatures[2], 100.0);
+   ASSERT_EQ(sampler->_replicaLeaders.size(), 3);
+   ASSERT_EQ(sampler->_swapProposalCounts.size(), 2);
+
+   // Testing incorrect settings fail
+   sampler->_replicaCount = 1;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_replicaCount = 3;
+
+   sampler->_maxTemperature = 1.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_maxTemperature = 100.0;
+
+   sampler->_temperatureAdaptionLag = 0.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_temperatureAdaptionLag = 1000.0;
+
+   sampler->_temperatureAdaptionRate = -1.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_temperatureAdaptionRate = 0.01;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+
+   // Testing mandatory parameters
 
-   // Testing optional parameters
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Cholesky Decomposition Covariance"] = "Not a Number";
+   samplerJs.erase("Replica Count");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Cholesky Decomposition Covariance"] = std::vector<double>({0.0});
+   samplerJs["Replica Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Replica Count"] = 4;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Cholesky Decomposition Chain Covariance"] = "Not a Number";
+   samplerJs.erase("Max Temperature");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Cholesky Decomposition Chain Covariance"] = std::vector<double>({0.0});
+   samplerJs["Max Temperature"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Max Temperature"] = 50.0;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader Evaluation"] = "Not a Number";
+   samplerJs.erase("Adapt Temperatures");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader Evaluation"] = 0.0;
+   samplerJs["Adapt Temperatures"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Adapt Temperatures"] = false;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Evaluations"] = "Not a Number";
+   samplerJs.erase("Temperature Adaption Rate");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Evaluations"] = std::vector<double>({0.0});
+   samplerJs["Temperature Adaption Rate"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Temperature Adaption Rate"] = 0.1;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Rejection Alphas"] = "Not a Number";
+   samplerJs.erase("Temperature Adaption Lag");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Rejection Alphas"] = std::vector<double>({0.0});
+   samplerJs["Temperature Adaption Lag"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Temperature Adaption Lag"] = 100.0;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   // Testing optional parameters
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Acceptance Rate"] = "Not a Number";
+   samplerJs["Temperatures"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Acceptance Rate"] = 0.0;
+   samplerJs["Temperatures"] = std::vector<double>({1.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Acceptance Count"] = "Not a Number";
+   samplerJs["Replica Leaders"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Acceptance Count"] = 0;
+   samplerJs["Replica Leaders"] = std::vector<std::vector<double>>({{0.0}});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Proposed Sample Count"] = "Not a Number";
+   samplerJs["Replica Leader LogPriors"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Proposed Sample Count"] = 0;
+   samplerJs["Replica Leader LogPriors"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Database"] = "Not a Number";
+   samplerJs["Replica Leader LogLikelihoods"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Replica Leader LogLikelihoods"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader"] = "Not a Number";
+   samplerJs["Replica Sample Counts"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader"] = std::vector<double>({0.0});
+   samplerJs["Replica Sample Counts"] = std::vector<size_t>({0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidate"] = "Not a Number";
+   samplerJs["Replica Acceptance Counts"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidate"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Replica Acceptance Counts"] = std::vector<size_t>({0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Evaluation Database"] = "Not a Number";
+   samplerJs["Replica Chain Means"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Evaluation Database"] = std::vector<double>({0.0});
+   samplerJs["Replica Chain Means"] = std::vector<std::vector<double>>({{0.0}});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Mean"] = "Not a Number";
+   samplerJs["Replica Chain Covariances"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Mean"] = std::vector<double>({0.0});
+   samplerJs["Replica Chain Covariances"] = std::vector<std::vector<double>>({{0.0}});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance Placeholder"] = "Not a Number";
+   samplerJs["Replica Cholesky Decompositions"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance Placeholder"] = std::vector<double>({0.0});
+   samplerJs["Replica Cholesky Decompositions"] = std::vector<std::vector<double>>({{0.0}});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance"] = "Not a Number";
+   samplerJs["Swap Proposal Counts"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance"] = std::vector<double>({0.0});
+   samplerJs["Swap Proposal Counts"] = std::vector<size_t>({0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Length"] = "Not a Number";
+   samplerJs["Swap Acceptance Counts"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Length"] = 0;
+   samplerJs["Swap Acceptance Counts"] = std::vector<size_t>({0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   // Testing inherited MCMC parameters
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Rejection Levels");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Levels"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Rejection Levels"] = 2;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+  }
+
+  //////////////// ENSEMBLE CLASS ////////////////////////
+
+  TEST(samplers, Ensemble)
+  {
+   // Creating base experiment
+   Experiment e;
+   auto& experimentJs = e._js.getJson();
+
+   // Creating initial variable
+   Variable v;
+   e._variables.push_back(&v);
+   e["Variables"][0]["Name"] = "Var 1";
+   e["Variables"][0]["Initial Mean"] = 0.0;
+   e["Variables"][0]["Initial Standard Deviation"] = 0.25;
+   v._initialMean = 0.0;
+   v._initialStandardDeviation = 0.25;
+
+   // Creating optimizer configuration Json
+   knlohmann::json samplerJs;
+   samplerJs["Type"] = "Sampler/Ensemble";
+
+   // Creating module
+   Ensemble* sampler;
+   ASSERT_NO_THROW(sampler = dynamic_cast<Ensemble *>(Module::getModule(samplerJs, &e)));
+
+   // Defaults should be applied without a problem
+   ASSERT_NO_THROW(sampler->applyModuleDefaults(samplerJs));
+
+   // Covering variable functions (no effect)
+   ASSERT_NO_THROW(sampler->applyVariableDefaults());
+
+   // Backup the correct base configuration
+   auto baseOptJs = samplerJs;
+   auto baseExpJs = experimentJs;
+
+   // Setting up optimizer correctly
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   // Testing the walkers are stored contiguously and the default differential evolution scale is set
+   sampler->_walkerCount = 8;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+   ASSERT_EQ(sampler->_walkers.size(), 8);
+   ASSERT_EQ(sampler->_proposals.size(), 4);
+   ASSERT_DOUBLE_EQ(sampler->_differentialEvolutionScale, 2.38 / std::sqrt(2.0));
+
+   // Testing incorrect settings fail
+   sampler->_walkerCount = 7;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_walkerCount = 2;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_walkerCount = 8;
+
+   sampler->_stretchScale = 1.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_stretchScale = 2.0;
+
+   sampler->_differentialEvolutionProbability = 1.5;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_differentialEvolutionProbability = 0.0;
+
+   sampler->_leap = 0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_leap = 1;
+
+   v._initialStandardDeviation = 0.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   v._initialStandardDeviation = 0.25;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+
+   // Testing mandatory parameters
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Walker Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Walker Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Walker Count"] = 64;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -354,7 +1090,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Burn In"] = 1;
+   samplerJs["Burn In"] = 10;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -369,146 +1105,182 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Leap"] = 1;
+   samplerJs["Leap"] = 2;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs.erase("Rejection Levels");
+   samplerJs.erase("Stretch Scale");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Rejection Levels"] = "Not a Number";
+   samplerJs["Stretch Scale"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Rejection Levels"] = 1;
+   samplerJs["Stretch Scale"] = 2.5;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs.erase("Use Adaptive Sampling");
+   samplerJs.erase("Differential Evolution Probability");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Use Adaptive Sampling"] = "Not a Number";
+   samplerJs["Differential Evolution Probability"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Use Adaptive Sampling"] = true;
+   samplerJs["Differential Evolution Probability"] = 0.1;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs.erase("Non Adaption Period");
+   samplerJs.erase("Differential Evolution Scale");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Non Adaption Period"] = "Not a Number";
+   samplerJs["Differential Evolution Scale"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Non Adaption Period"] = 1;
+   samplerJs["Differential Evolution Scale"] = 0.5;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs.erase("Chain Covariance Scaling");
+   samplerJs.erase("Differential Evolution Noise");
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance Scaling"] = "Not a Number";
+   samplerJs["Differential Evolution Noise"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Covariance Scaling"] = 1.0;
+   samplerJs["Differential Evolution Noise"] = 1e-4;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   // Testing termination criteria
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"].erase("Max Samples");
+   samplerJs["Termination Criteria"]["Max Samples"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Samples"] = "Not a Number";
+   samplerJs["Termination Criteria"]["Max Samples"] = 1000;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   // Testing internal settings
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Walkers"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Samples"] = 1;
+   samplerJs["Walkers"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"].erase("Max Model Evaluations");
+   samplerJs["Walker Evaluations"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Model Evaluations"] = "Not a Number";
+   samplerJs["Walker Evaluations"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposals"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Model Evaluations"] = 10000;
+   samplerJs["Proposals"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"].erase("Max Generations");
+   samplerJs["Proposal Log Jacobians"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Generations"] = "Not a Number";
+   samplerJs["Proposal Log Jacobians"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Count"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Termination Criteria"]["Max Generations"] = 10000;
+   samplerJs["Acceptance Count"] = 0;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
-   ///// Variable Tests
-
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0].erase("Initial Mean");
+   samplerJs["Proposed Sample Count"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0]["Initial Mean"] = "Not a Number";
+   samplerJs["Proposed Sample Count"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Acceptance Rate"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0]["Initial Mean"] = 1.0;
+   samplerJs["Acceptance Rate"] = 0.5;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0].erase("Initial Standard Deviation");
+   samplerJs["Chain Length"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0]["Initial Standard Deviation"] = "Not a Number";
+   samplerJs["Chain Length"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Database"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   e["Variables"][0]["Initial Standard Deviation"] = 1.0;
+   samplerJs["Sample Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Evaluation Database"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Evaluation Database"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
   }
 
   //////////////// TMCMC CLASS ////////////////////////
@@ -583,7 +1355,48 @@ namespace
    e["Problem"]["Type"] = "Bayesian/Reference";
    ASSERT_NO_THROW(sampler->setInitialConfiguration());
 
+   // Test SMC configuration
+   sampler->_version = "SMC";
+   sampler->_targetUnmovedProbability = 0.0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_targetUnmovedProbability = 0.01;
+   sampler->_maxMovesPerParticle = 0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_maxMovesPerParticle = 20;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+   ASSERT_EQ(sampler->_movesPerParticle, 20);
+
+   // Test resampling methods select exactly Population Size samples
+   std::vector<double> resamplingWeights(sampler->_populationSize, 1.0 / (double)sampler->_populationSize);
+   std::vector<unsigned int> resamplingSelections(sampler->_populationSize);
+   for (const auto &method : {"Multinomial", "Systematic", "Residual"})
+   {
+     sampler->_resamplingMethod = method;
+     ASSERT_NO_THROW(sampler->resample(resamplingWeights, resamplingSelections));
+     ASSERT_EQ(std::accumulate(resamplingSelections.begin(), resamplingSelections.end(), (size_t)0), sampler->_populationSize);
+   }
+
+   // Uniform weights are selected exactly once by the systematic and residual schemes
+   for (const auto &method : {"Systematic", "Residual"})
+   {
+     sampler->_resamplingMethod = method;
+     sampler->resample(resamplingWeights, resamplingSelections);
+     for (const auto &n : resamplingSelections) ASSERT_EQ(n, 1);
+   }
+   sampler->_version = "TMCMC";
+   sampler->_resamplingMethod = "Multinomial";
+
    // Testing optional parameters
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Moves Per Particle"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Moves Per Particle"] = 5;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs["Current Burn In"] = "Not a Number";
@@ -621,7 +1434,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -651,7 +1464,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Gradients"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates Gradients"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -671,7 +1484,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Covariance"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates Covariance"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -681,7 +1494,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -711,7 +1524,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders Covariance"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders Covariance"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -721,7 +1534,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders Gradients"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders Gradients"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -886,22 +1699,32 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Mean Theta"] = "Not a Number";
+   samplerJs["Mean Theta"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Mean Theta"] = std::vector<double>({0.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Sample Database"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Mean Theta"] = std::vector<double>({0.0});
+   samplerJs["Sample Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Database"] = "Not a Number";
+   samplerJs["Database Entries"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Database Entries"] = 1;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -931,7 +1754,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Gradient Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Sample Gradient Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -951,7 +1774,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Covariances Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Sample Covariances Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -1061,6 +1884,56 @@ namespace
    samplerJs["Version"] = "mTMCMC";
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Version"] = "SMC";
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Resampling Method");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Resampling Method"] = "Not a Method";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Resampling Method"] = "Systematic";
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Target Unmoved Probability");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Target Unmoved Probability"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Target Unmoved Probability"] = 0.05;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Max Moves Per Particle");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Max Moves Per Particle"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Max Moves Per Particle"] = 10;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs.erase("Population Size");
@@ -1904,6 +2777,106 @@ namespace
    samplerJs["Termination Criteria"]["Max Samples"] = 32;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = 4;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Diagnostics Frequency");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Diagnostics Frequency"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Diagnostics Frequency"] = 10;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Target Potential Scale Reduction");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Potential Scale Reduction"] = 1.01;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"].erase("Target Effective Sample Size");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Termination Criteria"]["Target Effective Sample Size"] = 400.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Potential Scale Reduction"] = std::vector<double>({1.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Effective Sample Size"] = std::vector<double>({1.0});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Max Potential Scale Reduction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Max Potential Scale Reduction"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Min Effective Sample Size"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Current Min Effective Sample Size"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    ///// Variable Tests
 
    samplerJs = baseOptJs;
@@ -1996,6 +2969,15 @@ namespace
    h->samplingProblemPtr = pS;
    h->bayesianProblemPtr = NULL;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
+
+   // Evaluations at an unchanged position are reused
+   size_t evaluationCount = h->_modelEvaluationCount;
+   ASSERT_TRUE(h->isEvaluated(unitVec));
+   ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
+   ASSERT_EQ(h->_modelEvaluationCount, evaluationCount);
+   ASSERT_FALSE(h->isEvaluated(std::vector<double>({0.0})));
+
+   h->_evaluatedPosition.clear();
    h->samplingProblemPtr = NULL;
    h->bayesianProblemPtr = pR;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
@@ -2016,6 +2998,7 @@ namespace
    h->samplingProblemPtr = pS;
    h->bayesianProblemPtr = NULL;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
+   h->_evaluatedPosition.clear();
    h->samplingProblemPtr = NULL;
    h->bayesianProblemPtr = pR;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
@@ -2039,6 +3022,7 @@ namespace
    h->samplingProblemPtr = pS;
    h->bayesianProblemPtr = NULL;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
+   h->_evaluatedPosition.clear();
    h->samplingProblemPtr = NULL;
    h->bayesianProblemPtr = pR;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
@@ -2065,6 +3049,9 @@ namespace
    h->samplingProblemPtr = pS;
    h->bayesianProblemPtr = NULL;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
+
+   // The metric is position dependent, hence evaluations are never reused
+   ASSERT_FALSE(h->isEvaluated(unitVec));
    h->samplingProblemPtr = NULL;
    h->bayesianProblemPtr = pR;
    ASSERT_NO_THROW(h->updateHamiltonian(unitVec,unitVec,unitVec));
@@ -2077,16 +3064,24 @@ namespace
    TreeHelperEuclidean tE;
    ASSERT_NO_THROW(tE.computeCriterion(*h));
    ASSERT_ANY_THROW(tE.computeCriterion(*h, unitVec, unitVec, unitVec, unitVec));
+   ASSERT_NO_THROW(tE.allocate(1));
+   ASSERT_EQ(tE.qProposedOut.size(), 1);
+   ASSERT_NO_THROW(tE.computeSubtreeCriterion(*h, unitVec));
 
    TreeHelperRiemannian tR;
    ASSERT_ANY_THROW(tR.computeCriterion(*h));
    ASSERT_NO_THROW(tR.computeCriterion(*h, unitVec, unitVec, unitVec, unitVec));
+   ASSERT_NO_THROW(tR.allocate(1));
+   tR.directionIn = 1;
+   ASSERT_NO_THROW(tR.computeSubtreeCriterion(*h, unitVec));
 
    std::shared_ptr<HamiltonianRiemannianDiag> sh;
    ASSERT_NO_THROW(sh = std::make_shared<HamiltonianRiemannianDiag>(HamiltonianRiemannianDiag(1, sampler->_normalGenerator, 1.0, &e)));
    LeapfrogExplicit  *leap;
    ASSERT_NO_THROW(leap = new LeapfrogExplicit(sh));
    ASSERT_NO_THROW(leap->step(unitVec, unitVec, unitVec, unitVec, 1.0));
+   ASSERT_NO_THROW(leap->kickDrift(unitVec, unitVec, unitVec, 1.0));
+   ASSERT_NO_THROW(leap->kick(unitVec, 1.0));
    ASSERT_NO_THROW(delete leap);
 
    ASSERT_NO_THROW(delete h);
@@ -2096,6 +3091,61 @@ namespace
    e._problem = pS;
   }
 
+  TEST(samplers, HMCExecution)
+  {
+   knlohmann::json expJs;
+   expJs["Type"] = "Experiment";
+   expJs["Random Seed"] = 1234;
+   expJs["File Output"]["Enabled"] = false;
+   expJs["Console Output"]["Verbosity"] = "Silent";
+   expJs["Problem"]["Type"] = "Sampling";
+   expJs["Problem"]["Probability Function"] = _functionVector.size();
+   expJs["Variables"][0]["Name"] = "Var 1";
+   expJs["Variables"][0]["Initial Mean"] = 0.0;
+   expJs["Variables"][0]["Initial Standard Deviation"] = 1.0;
+
+   // With default settings, the evaluation of the leader from the previous generation is reused
+   expJs["Solver"]["Type"] = "Sampler/HMC";
+   expJs["Solver"]["Termination Criteria"]["Max Samples"] = 20;
+
+   std::function<void(korali::Sample&)> modelFc = [](Sample& s)
+   {
+    const double x = s["Parameters"][0].get<double>();
+    s["logP(x)"] = -0.5 * x * x;
+    s["grad(logP(x))"] = std::vector<double>({-x});
+   };
+   _functionVector.push_back(&modelFc);
+
+   // Running plain HMC and NUTS past the burn in with a single chain, and with several chains whose step sizes
+   // are adapted separately (and whose NUTS trajectories finish in different rounds)
+   for (size_t run = 0; run < 4; run++)
+   {
+    Engine k;
+    expJs["Solver"]["Use NUTS"] = run >= 2;
+    expJs["Solver"]["Chain Count"] = run % 2 == 0 ? 1 : 3;
+
+    Experiment* e;
+    ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+    auto runJs = expJs;
+    ASSERT_NO_THROW(e->applyModuleDefaults(runJs));
+    ASSERT_NO_THROW(e->applyVariableDefaults());
+    runJs["Type"] = "Experiment";
+    e->_js.getJson() = runJs;
+
+    e->_experimentId = 0;
+    e->_engine = &k;
+    e->_isFinished = false;
+    ASSERT_NO_THROW(e->initialize());
+    ASSERT_NO_THROW(k.run(*e));
+
+    auto sampler = dynamic_cast<HMC *>(e->_solver);
+    ASSERT_GT(e->_currentGeneration, sampler->_burnIn);
+    ASSERT_GE(sampler->_sampleDatabase.size(), 20);
+
+    ASSERT_NO_THROW(delete e);
+   }
+  }
+
   //////////////// Nested CLASS ////////////////////////
 
   TEST(samplers, Nested)
@@ -2423,7 +3473,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Live Samples"] = std::vector<std::vector<double>>({{1.0}});
+   samplerJs["Live Samples"] = std::vector<double>({1.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -2666,6 +3716,141 @@ namespace
    samplerJs["Proposal Update Frequency"] = 512;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Proposal Update Shrinkage");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposal Update Shrinkage"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposal Update Shrinkage"] = 0.5;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Proposal Steps");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposal Steps"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Proposal Steps"] = 10;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Random Walk Scale"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Random Walk Scale"] = 1.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Dynamic Batch Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Batch Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Batch Count"] = 2;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Dynamic Posterior Fraction");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Posterior Fraction"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Posterior Fraction"] = 0.8;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Dynamic Importance Threshold");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Importance Threshold"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Importance Threshold"] = 0.9;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Batch"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Batch"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Fill Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Fill Count"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Lower Bound"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Lower Bound"] = 0.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Upper Bound"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Upper Bound"] = 0.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Lower LogVolume"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Dynamic Lower LogVolume"] = 0.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs.erase("Ellipsoidal Scaling");
@@ -2730,6 +3915,10 @@ namespace
    ellipse_t ellipse(1);
    ASSERT_NO_THROW(ellipse.initSphere());
    ASSERT_NO_THROW(ellipse.scaleVolume(1.0));
+   ASSERT_NO_THROW(ellipse.scaleVolume(4.0));
+
+   // The axes remain the cholesky factor of the covariance
+   ASSERT_DOUBLE_EQ(ellipse.axes[0] * ellipse.axes[0], ellipse.cov[0]);
 
    // Testing termination criteria
    e._currentGeneration = 2;
@@ -2742,4 +3931,61 @@ namespace
    sampler->_maxLogLikelihood= 2.0;
   }
 
+  TEST(samplers, NestedExecution)
+  {
+   knlohmann::json expJs;
+   expJs["Type"] = "Experiment";
+   expJs["Random Seed"] = 1337;
+   expJs["File Output"]["Enabled"] = false;
+   expJs["Console Output"]["Verbosity"] = "Silent";
+   expJs["Problem"]["Type"] = "Bayesian/Custom";
+   expJs["Problem"]["Likelihood Model"] = _functionVector.size();
+   expJs["Distributions"][0]["Name"] = "Uniform 0";
+   expJs["Distributions"][0]["Type"] = "Univariate/Uniform";
+   expJs["Distributions"][0]["Minimum"] = -2.0;
+   expJs["Distributions"][0]["Maximum"] = +2.0;
+   for (size_t i = 0; i < 2; i++)
+   {
+    expJs["Variables"][i]["Name"] = "Var " + std::to_string(i);
+    expJs["Variables"][i]["Prior Distribution"] = "Uniform 0";
+   }
+
+   // Chains of a batch take different numbers of evaluations before they finish
+   expJs["Solver"]["Type"] = "Sampler/Nested";
+   expJs["Solver"]["Number Live Points"] = 50;
+   expJs["Solver"]["Batch Size"] = 4;
+   expJs["Solver"]["Proposal Steps"] = 10;
+   expJs["Solver"]["Termination Criteria"]["Max Generations"] = 20;
+
+   std::function<void(korali::Sample&)> modelFc = [](Sample& s)
+   {
+    const auto x = s["Parameters"].get<std::vector<double>>();
+    s["logLikelihood"] = -0.5 * (x[0] * x[0] + x[1] * x[1]);
+   };
+   _functionVector.push_back(&modelFc);
+
+   for (const std::string resamplingMethod : {"Slice", "Random Walk"})
+   {
+    Engine k;
+    expJs["Solver"]["Resampling Method"] = resamplingMethod;
+
+    Experiment* e;
+    ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+    auto runJs = expJs;
+    ASSERT_NO_THROW(e->applyModuleDefaults(runJs));
+    ASSERT_NO_THROW(e->applyVariableDefaults());
+    runJs["Type"] = "Experiment";
+    e->_js.getJson() = runJs;
+
+    e->_experimentId = 0;
+    e->_engine = &k;
+    e->_isFinished = false;
+    ASSERT_NO_THROW(e->initialize());
+    ASSERT_NO_THROW(k.run(*e));
+    ASSERT_GT(e->_currentGeneration, 1);
+
+    ASSERT_NO_THROW(delete e);
+   }
+  }
+
 } // namespace